@@ -0,0 +1,186 @@
+/**
+ * @file benchmark_can_bitrate_switch.cpp
+ * @brief CAN FD 数据段波特率切换（BRS）基准：空口时间模型帧率和按空口时间节拍的实际发送间隔
+ *
+ * 仿真总线按 can_frame_airtime 估算空口时间，在 send() 中记录控制帧的发送时刻。驱动开启空口时间节拍后
+ * 连续下发控制命令，分别在开启 / 关闭 BRS 时统计相邻两帧的发送间隔：
+ *   - 模型帧率：单电机控制帧和批量控制帧在有无 BRS 时的理论帧率
+ *   - 发送间隔百分位，以及短于一帧空口时间的间隔数（节拍失效时会背靠背发送）
+ * 可选在 vcan 接口上测量实际发送帧率（不受空口时间限制，仅作参考）。
+ *
+ * 用法：
+ *   benchmark_can_bitrate_switch [--commands=1000] [--repeat=5] [--vcan=vcan0] [--output=result.json]
+ */
+#include "benchmark_common.hpp"
+#include "bus/canfd_bus_impl.hpp"
+#include "driver/motor_driver_impl.hpp"
+#include "hardware_driver/bus/can_airtime.hpp"
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace hardware_driver;
+using benchmark::Clock;
+
+namespace {
+
+constexpr uint32_t NOMINAL_BITRATE = 1000000;
+constexpr uint32_t DATA_BITRATE = 5000000;
+constexpr size_t BATCH_FRAME_LEN = 50;     // 6 电机批量控制帧
+constexpr size_t CONTROL_FRAME_LEN = 15;   // 单电机控制帧
+
+std::chrono::nanoseconds model_airtime(size_t len, bool brs) {
+    return bus::can_frame_airtime(len, true, brs, true, NOMINAL_BITRATE, DATA_BITRATE);
+}
+
+double frames_per_second(std::chrono::nanoseconds airtime) {
+    return 1e9 / static_cast<double>(airtime.count());
+}
+
+// 按空口时间模型估算发送耗时的仿真总线，记录控制帧的发送时刻
+class AirtimeBus : public bus::BusInterface {
+public:
+    explicit AirtimeBus(bool brs) : brs_(brs) {}
+
+    void init() override {}
+    bool send(const bus::GenericBusPacket& packet) override {
+        if (packet.id == 1 && packet.len == CONTROL_FRAME_LEN) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            send_times_.push_back(Clock::now());
+        }
+        return true;
+    }
+    bool receive(bus::GenericBusPacket& /*packet*/) override { return false; }
+    void async_receive(const std::function<void(const bus::GenericBusPacket&)>& /*callback*/) override {}
+    std::vector<std::string> get_interface_names() const override { return {"can0"}; }
+
+    std::chrono::nanoseconds frame_airtime(const bus::GenericBusPacket& packet) const override {
+        return model_airtime(packet.len, brs_);
+    }
+
+    std::vector<Clock::time_point> send_times() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return send_times_;
+    }
+
+private:
+    bool brs_;
+    mutable std::mutex mutex_;
+    std::vector<Clock::time_point> send_times_;
+};
+
+struct PacingResult {
+    uint64_t issued{0};
+    uint64_t sent{0};
+    uint64_t shorter_than_airtime{0};
+    double min_interval_us{0.0};
+    std::unique_ptr<benchmark::LatencyHistogram> interval = std::make_unique<benchmark::LatencyHistogram>();
+};
+
+// 开启空口时间节拍，连续下发控制命令，统计相邻两帧的发送间隔
+void run_pacing(bool brs, int commands, PacingResult& result) {
+    auto bus = std::make_shared<AirtimeBus>(brs);
+    auto driver = std::make_shared<motor_driver::MotorDriverImpl>(bus);
+    driver->set_airtime_pacing(true);
+
+    for (int i = 0; i < commands; ++i) {
+        driver->send_velocity_cmd("can0", 1, 0.01f * (i + 1), 0.05f, 0.005f);
+    }
+    result.issued += static_cast<uint64_t>(commands);
+    const auto deadline = Clock::now() + std::chrono::seconds(10);
+    while (bus->send_times().size() < static_cast<size_t>(commands) && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    const auto times = bus->send_times();
+    const auto airtime = model_airtime(CONTROL_FRAME_LEN, brs);
+    result.sent += times.size();
+    for (size_t i = 1; i < times.size(); ++i) {
+        const auto interval = times[i] - times[i - 1];
+        const double interval_us = std::chrono::duration<double, std::micro>(interval).count();
+        result.interval->record_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count());
+        if (interval < airtime) result.shorter_than_airtime++;
+        if (result.interval->count() == 1 || interval_us < result.min_interval_us) result.min_interval_us = interval_us;
+    }
+}
+
+// vcan 上的实际发送帧率，接口不存在时返回 false
+bool measure_vcan(const std::string& interface, double& frames_per_s) {
+    if (if_nametoindex(interface.c_str()) == 0) return false;
+    bus::CanFdBus bus({interface}, NOMINAL_BITRATE, DATA_BITRATE);
+    bus::GenericBusPacket packet;
+    packet.interface = interface;
+    packet.id = 1;
+    packet.protocol_type = bus::BusProtocolType::CAN_FD;
+    packet.len = BATCH_FRAME_LEN;
+    packet.data.fill(0);
+
+    const auto start = Clock::now();
+    uint64_t sent = 0;
+    while (Clock::now() - start < std::chrono::milliseconds(200)) {
+        if (bus.try_send(packet) == bus::TxStatus::OK) ++sent;
+    }
+    frames_per_s = static_cast<double>(sent) / std::chrono::duration<double>(Clock::now() - start).count();
+    return true;
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Arguments args(argc, argv);
+    // 驱动日志走 std::cout，重定向到标准错误，保证标准输出只有 JSON
+    std::streambuf* stdout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+
+    const int commands = static_cast<int>(args.get_double("commands", 1000));
+    const int repeat = static_cast<int>(args.get_double("repeat", 5));
+    const std::string vcan = args.get("vcan", "vcan0");
+
+    benchmark::JsonWriter json;
+    json.begin_object();
+    json.value("benchmark", std::string("can_bitrate_switch"));
+    json.value("nominal_bitrate", static_cast<uint64_t>(NOMINAL_BITRATE));
+    json.value("data_bitrate", static_cast<uint64_t>(DATA_BITRATE));
+
+    json.begin_array("model");
+    for (size_t len : {CONTROL_FRAME_LEN, BATCH_FRAME_LEN}) {
+        json.begin_object();
+        json.value("frame_len", static_cast<uint64_t>(len));
+        json.value("frames_per_s_without_brs", frames_per_second(model_airtime(len, false)));
+        json.value("frames_per_s_with_brs", frames_per_second(model_airtime(len, true)));
+        json.end_object();
+    }
+    json.end_array();
+
+    json.begin_array("pacing");
+    for (bool brs : {false, true}) {
+        std::cerr << "[benchmark_can_bitrate_switch] brs=" << brs << " commands=" << commands
+                  << " repeat=" << repeat << std::endl;
+        PacingResult r;
+        for (int i = 0; i < repeat; ++i) run_pacing(brs, commands, r);
+
+        json.begin_object();
+        json.value("brs", static_cast<int>(brs));
+        json.value("issued", r.issued);
+        json.value("sent", r.sent);
+        json.value("airtime_us", std::chrono::duration<double, std::micro>(model_airtime(CONTROL_FRAME_LEN, brs)).count());
+        json.value("min_interval_us", r.min_interval_us);
+        json.value("shorter_than_airtime", r.shorter_than_airtime);
+        json.latency("interval_us", *r.interval);
+        json.end_object();
+    }
+    json.end_array();
+
+    double vcan_rate = 0.0;
+    if (measure_vcan(vcan, vcan_rate)) {
+        json.begin_object("vcan");
+        json.value("interface", vcan);
+        json.value("frames_per_s", vcan_rate);
+        json.end_object();
+    }
+
+    json.end_object();
+
+    std::cout.rdbuf(stdout_buf);
+    return benchmark::write_output(args, json.str()) ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+#ifndef __BENCHMARK_COMMON_HPP__
+#define __BENCHMARK_COMMON_HPP__
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// 基准程序公用工具：无锁延迟直方图、按线程 CPU 占用、内存占用、命令行参数和 JSON 输出
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+inline int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief 无锁延迟直方图：0~10ms 按 1us 分桶，超出计入溢出桶
+ * 热路径只做一次原子自增，多个回调线程可以同时记录
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 10000;
+
+    void record_ns(int64_t latency_ns) {
+        if (latency_ns < 0) latency_ns = 0;
+        const size_t bucket = static_cast<size_t>(latency_ns / 1000);
+        buckets_[std::min(bucket, BUCKETS)].fetch_add(1, std::memory_order_relaxed);
+        int64_t max = max_ns_.load(std::memory_order_relaxed);
+        while (latency_ns > max && !max_ns_.compare_exchange_weak(max, latency_ns, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t count() const {
+        uint64_t total = 0;
+        for (const auto& bucket : buckets_) total += bucket.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // 百分位（us），取所在桶的上界
+    double percentile(double p) const {
+        const uint64_t total = count();
+        if (total == 0) return 0.0;
+        const uint64_t target = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i <= BUCKETS; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= target) return i == BUCKETS ? max_us() : static_cast<double>(i + 1);
+        }
+        return max_us();
+    }
+
+    double max_us() const { return static_cast<double>(max_ns_.load(std::memory_order_relaxed)) / 1000.0; }
+
+    void reset() {
+        for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS + 1> buckets_{};
+    std::atomic<int64_t> max_ns_{0};
+};
+
+// /proc/self/task 下每个线程的名称和累计 CPU 时间
+struct ThreadCpuSample {
+    std::string name;
+    double cpu_seconds{0.0};
+};
+
+inline std::map<int, ThreadCpuSample> sample_thread_cpu() {
+    std::map<int, ThreadCpuSample> samples;
+    const double ticks = static_cast<double>(sysconf(_SC_CLK_TCK));
+    DIR* dir = opendir("/proc/self/task");
+    if (!dir) return samples;
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+        const int tid = std::atoi(entry->d_name);
+        std::ifstream stat("/proc/self/task/" + std::string(entry->d_name) + "/stat");
+        std::string line;
+        if (!std::getline(stat, line)) continue;
+        // 格式：tid (comm) state ... utime(14) stime(15)，comm 中可能有空格
+        const auto open = line.find('(');
+        const auto close = line.rfind(')');
+        if (open == std::string::npos || close == std::string::npos) continue;
+        std::istringstream rest(line.substr(close + 2));
+        std::string field;
+        uint64_t utime = 0, stime = 0;
+        for (int i = 3; i <= 15 && rest >> field; ++i) {
+            if (i == 14) utime = std::strtoull(field.c_str(), nullptr, 10);
+            if (i == 15) stime = std::strtoull(field.c_str(), nullptr, 10);
+        }
+        samples[tid] = {line.substr(open + 1, close - open - 1), static_cast<double>(utime + stime) / ticks};
+    }
+    closedir(dir);
+    return samples;
+}
+
+// 常驻内存（KB）
+inline long resident_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) return std::atol(line.c_str() + 6);
+    }
+    return 0;
+}
+
+/**
+ * @brief 解析 --name=v1,v2 形式的参数
+ */
+class Arguments {
+public:
+    Arguments(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) continue;
+            const auto eq = arg.find('=');
+            if (eq == std::string::npos) values_[arg.substr(2)] = "1";
+            else values_[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+        }
+    }
+
+    bool has(const std::string& name) const { return values_.count(name) > 0; }
+
+    std::string get(const std::string& name, const std::string& fallback) const {
+        auto it = values_.find(name);
+        return it != values_.end() ? it->second : fallback;
+    }
+
+    double get_double(const std::string& name, double fallback) const {
+        auto it = values_.find(name);
+        return it != values_.end() ? std::atof(it->second.c_str()) : fallback;
+    }
+
+    std::vector<int> get_list(const std::string& name, const std::vector<int>& fallback) const {
+        auto it = values_.find(name);
+        if (it == values_.end()) return fallback;
+        std::vector<int> list;
+        std::istringstream stream(it->second);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) list.push_back(std::atoi(item.c_str()));
+        }
+        return list;
+    }
+
+private:
+    std::map<std::string, std::string> values_;
+};
+
+/**
+ * @brief 最小 JSON 写出器，按调用顺序输出对象、数组和键值
+ */
+class JsonWriter {
+public:
+    JsonWriter& begin_object(const std::string& key = "") { open(key, '{'); return *this; }
+    JsonWriter& end_object() { close('}'); return *this; }
+    JsonWriter& begin_array(const std::string& key = "") { open(key, '['); return *this; }
+    JsonWriter& end_array() { close(']'); return *this; }
+
+    JsonWriter& value(const std::string& key, double v) {
+        prefix(key);
+        out_ << std::fixed << std::setprecision(3) << v;
+        return *this;
+    }
+    JsonWriter& value(const std::string& key, uint64_t v) { prefix(key); out_ << v; return *this; }
+    JsonWriter& value(const std::string& key, int64_t v) { prefix(key); out_ << v; return *this; }
+    JsonWriter& value(const std::string& key, int v) { prefix(key); out_ << v; return *this; }
+    JsonWriter& value(const std::string& key, const std::string& v) {
+        prefix(key);
+        out_ << '"';
+        for (char c : v) {
+            if (c == '"' || c == '\\') out_ << '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out_ << c;
+        }
+        out_ << '"';
+        return *this;
+    }
+
+    JsonWriter& latency(const std::string& key, const LatencyHistogram& histogram) {
+        begin_object(key);
+        value("samples", histogram.count());
+        value("p50", histogram.percentile(50));
+        value("p90", histogram.percentile(90));
+        value("p99", histogram.percentile(99));
+        value("p999", histogram.percentile(99.9));
+        value("max", histogram.max_us());
+        return end_object();
+    }
+
+    std::string str() const { return out_.str() + "\n"; }
+
+private:
+    void prefix(const std::string& key) {
+        if (!first_.empty()) {
+            if (!first_.back()) out_ << ',';
+            first_.back() = false;
+            out_ << '\n' << std::string(first_.size() * 2, ' ');
+        }
+        if (!key.empty()) out_ << '"' << key << "\": ";
+    }
+    void open(const std::string& key, char bracket) {
+        prefix(key);
+        out_ << bracket;
+        first_.push_back(true);
+    }
+    void close(char bracket) {
+        const bool empty = first_.back();
+        first_.pop_back();
+        if (!empty) out_ << '\n' << std::string(first_.size() * 2, ' ');
+        out_ << bracket;
+    }
+
+    std::ostringstream out_;
+    std::vector<bool> first_;
+};
+
+// 写到 --output 指定的文件，未指定时输出到标准输出
+inline bool write_output(const Arguments& args, const std::string& json) {
+    const std::string path = args.get("output", "");
+    if (path.empty()) {
+        std::fwrite(json.data(), 1, json.size(), stdout);
+        return true;
+    }
+    std::ofstream file(path);
+    file << json;
+    return static_cast<bool>(file);
+}
+
+}   // namespace benchmark
+
+#endif   // __BENCHMARK_COMMON_HPP__
@@ -0,0 +1,134 @@
+/**
+ * @file benchmark_receive_mode.cpp
+ * @brief 接收模式基准：总线回调收到数据包到反馈回调被调用的延迟，QUEUED 与 RUN_TO_COMPLETION 对比
+ *
+ * 仿真总线在调用线程上直接调用接收回调，逐帧注入状态反馈并等待反馈回调，统计每帧的延迟百分位和超时帧数。
+ *
+ * 用法：
+ *   benchmark_receive_mode [--samples=20000] [--modes=queued,direct] [--output=result.json]
+ */
+#include "benchmark_common.hpp"
+#include "driver/motor_driver_impl.hpp"
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace hardware_driver;
+using benchmark::Clock;
+
+namespace {
+
+class LoopbackBus : public bus::BusInterface {
+public:
+    void init() override {}
+    bool send(const bus::GenericBusPacket& /*packet*/) override { return true; }
+    bool receive(bus::GenericBusPacket& /*packet*/) override { return false; }
+    void async_receive(const std::function<void(const bus::GenericBusPacket&)>& callback) override {
+        callback_ = callback;
+    }
+    std::vector<std::string> get_interface_names() const override { return {"can0"}; }
+
+    void inject(const bus::GenericBusPacket& packet) { callback_(packet); }
+
+private:
+    std::function<void(const bus::GenericBusPacket&)> callback_;
+};
+
+bus::GenericBusPacket make_status_packet(uint32_t motor_id) {
+    bus::GenericBusPacket packet;
+    packet.interface = "can0";
+    packet.id = 0x300 | motor_id;
+    packet.protocol_type = bus::BusProtocolType::CAN_FD;
+    packet.len = 24;
+    packet.data.fill(0);
+    packet.data[1] = 1;
+    packet.data[2] = 5;
+    return packet;
+}
+
+struct ModeResult {
+    uint64_t samples{0};
+    uint64_t timeouts{0};
+    std::unique_ptr<benchmark::LatencyHistogram> latency = std::make_unique<benchmark::LatencyHistogram>();
+};
+
+void run(motor_driver::ReceiveMode mode, int samples, ModeResult& result) {
+    auto bus = std::make_shared<LoopbackBus>();
+    auto driver = std::make_shared<motor_driver::MotorDriverImpl>(bus);
+    driver->set_receive_mode(mode);
+
+    std::atomic<int64_t> delivered_ns{0};
+    std::atomic<int> delivered{0};
+    driver->register_feedback_callback([&](const std::string&, uint32_t, const motor_driver::Motor_Status&) {
+        delivered_ns.store(benchmark::now_ns(), std::memory_order_relaxed);
+        delivered.fetch_add(1, std::memory_order_release);
+    });
+
+    const auto packet = make_status_packet(1);
+    for (int i = 0; i < samples; ++i) {
+        const int expected = i + 1;
+        const int64_t start_ns = benchmark::now_ns();
+        bus->inject(packet);
+        const auto deadline = Clock::now() + std::chrono::milliseconds(100);
+        while (delivered.load(std::memory_order_acquire) < expected && Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        result.samples++;
+        if (delivered.load(std::memory_order_acquire) < expected) {
+            result.timeouts++;
+            // 超时的帧稍后仍可能送达，等它送达后再继续，避免计数错位
+            while (delivered.load(std::memory_order_acquire) < expected) std::this_thread::yield();
+            continue;
+        }
+        result.latency->record_ns(delivered_ns.load(std::memory_order_relaxed) - start_ns);
+    }
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Arguments args(argc, argv);
+    // 驱动日志走 std::cout，重定向到标准错误，保证标准输出只有 JSON
+    std::streambuf* stdout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+
+    const int samples = static_cast<int>(args.get_double("samples", 20000));
+    std::vector<std::string> modes;
+    {
+        std::istringstream stream(args.get("modes", "queued,direct"));
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) modes.push_back(item);
+        }
+    }
+
+    benchmark::JsonWriter json;
+    json.begin_object();
+    json.value("benchmark", std::string("receive_mode"));
+    json.value("samples", samples);
+    json.begin_array("results");
+
+    for (const auto& name : modes) {
+        if (name != "queued" && name != "direct") {
+            std::cerr << "[benchmark_receive_mode] unknown mode " << name << std::endl;
+            continue;
+        }
+        const auto mode = name == "queued" ? motor_driver::ReceiveMode::QUEUED
+                                           : motor_driver::ReceiveMode::RUN_TO_COMPLETION;
+        std::cerr << "[benchmark_receive_mode] mode=" << name << " samples=" << samples << std::endl;
+        ModeResult r;
+        run(mode, samples, r);
+
+        json.begin_object();
+        json.value("mode", name);
+        json.value("samples", r.samples);
+        json.value("timeouts", r.timeouts);
+        json.latency("latency_us", *r.latency);
+        json.end_object();
+    }
+
+    json.end_array();
+    json.end_object();
+
+    std::cout.rdbuf(stdout_buf);
+    return benchmark::write_output(args, json.str()) ? 0 : 1;
+}
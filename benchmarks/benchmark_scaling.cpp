@@ -0,0 +1,382 @@
+/**
+ * @file benchmark_scaling.cpp
+ * @brief 扩展性基准：接口数 × 电机数 × 反馈频率 × 事件订阅者数
+ *
+ * 仿真总线按设定频率为每个电机注入状态反馈（每个接口一个注入线程，对应 CanFdBus 的接收线程），
+ * 控制线程以同一频率为每个电机下发速度命令。每个场景输出：
+ *   - 反馈端到端延迟（注入 -> RobotHardware 回调）和事件延迟（注入 -> EventBus 订阅者）百分位
+ *   - 控制吞吐：下发与实际上总线的控制帧数、控制线程的超时周期
+ *   - 反馈、事件、控制的丢失数
+ *   - 每个线程的 CPU 占用、常驻内存
+ *
+ * 用法：
+ *   benchmark_scaling [--interfaces=1,2,4,8] [--motors=7] [--rates=200,1000] [--subscribers=0,4]
+ *                     [--duration=1.0] [--output=result.json]
+ * 结果以 JSON 写到标准输出或 --output；驱动的日志输出被重定向到标准错误。
+ */
+#include "benchmark_common.hpp"
+#include "driver/motor_driver_impl.hpp"
+#include "hardware_driver/event/event_bus.hpp"
+#include "hardware_driver/event/motor_events.hpp"
+#include "hardware_driver/interface/robot_hardware.hpp"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+
+using namespace hardware_driver;
+using benchmark::Clock;
+
+namespace {
+
+constexpr uint32_t MAX_MOTORS = 32;
+constexpr size_t CONTROL_FRAME_LEN = 15;
+
+// 仿真总线：统计发出的帧，由注入线程模拟电机反馈
+class SimulatedBus : public bus::BusInterface {
+public:
+    explicit SimulatedBus(int interfaces) {
+        for (int i = 0; i < interfaces; ++i) names_.push_back("can" + std::to_string(i));
+    }
+
+    void init() override {}
+    bool send(const bus::GenericBusPacket& packet) override {
+        if (packet.len == CONTROL_FRAME_LEN && packet.id >= 1 && packet.id <= MAX_MOTORS) {
+            control_frames.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            other_frames.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    bool receive(bus::GenericBusPacket& /*packet*/) override { return false; }
+    void async_receive(const std::function<void(const bus::GenericBusPacket&)>& callback) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback_ = callback;
+    }
+    std::vector<std::string> get_interface_names() const override { return names_; }
+
+    void inject(const bus::GenericBusPacket& packet) {
+        std::function<void(const bus::GenericBusPacket&)> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callback = callback_;
+        }
+        if (callback) callback(packet);
+    }
+
+    std::atomic<uint64_t> control_frames{0};
+    std::atomic<uint64_t> other_frames{0};
+
+private:
+    std::vector<std::string> names_;
+    std::mutex mutex_;
+    std::function<void(const bus::GenericBusPacket&)> callback_;
+};
+
+struct Scenario {
+    int interfaces;
+    int motors;
+    int rate_hz;
+    int subscribers;
+};
+
+struct ScenarioResult {
+    Scenario scenario{};
+    double seconds{0.0};
+    uint64_t feedback_injected{0};
+    uint64_t feedback_delivered{0};
+    uint64_t events_delivered{0};
+    uint64_t control_issued{0};
+    uint64_t control_sent{0};
+    uint64_t control_late_ticks{0};
+    uint64_t other_frames{0};
+    long rss_kb{0};
+    long rss_delta_kb{0};
+    std::vector<std::pair<std::string, double>> thread_cpu;   // 名称（tid）, CPU%
+    double cpu_total{0.0};
+    std::unique_ptr<benchmark::LatencyHistogram> feedback_latency = std::make_unique<benchmark::LatencyHistogram>();
+    std::unique_ptr<benchmark::LatencyHistogram> event_latency = std::make_unique<benchmark::LatencyHistogram>();
+};
+
+// 每个 (接口, 电机) 按帧序号记录注入时间；帧序号写在反馈帧载荷中，
+// 回调据此取回该帧自己的注入时间，积压时延迟不会被后续注入覆盖
+struct InjectLog {
+    InjectLog(int interfaces, size_t frames_per_motor)
+        : capacity(frames_per_motor), stamps(static_cast<size_t>(interfaces) * (MAX_MOTORS + 1) * frames_per_motor) {}
+    std::atomic<int64_t>& at(int interface, uint32_t motor, uint32_t sequence) {
+        return stamps[(static_cast<size_t>(interface) * (MAX_MOTORS + 1) + motor) * capacity + sequence];
+    }
+    size_t capacity;
+    std::vector<std::atomic<int64_t>> stamps;
+};
+
+int interface_index(const std::string& name) {
+    return std::atoi(name.c_str() + 3);   // "canN"
+}
+
+// 帧序号以浮点数写入位置字段（大端，2^24 以内精确），回调从 Motor_Status::position 取回
+bus::GenericBusPacket make_status_packet(const std::string& interface, uint32_t motor_id, uint32_t sequence) {
+    bus::GenericBusPacket packet;
+    packet.interface = interface;
+    packet.id = 0x300 | motor_id;
+    packet.protocol_type = bus::BusProtocolType::CAN_FD;
+    packet.len = 24;
+    packet.data.fill(0);
+    packet.data[1] = 1;     // 使能
+    packet.data[2] = 5;
+    const float position = static_cast<float>(sequence);
+    uint32_t bits;
+    std::memcpy(&bits, &position, sizeof(bits));
+    for (int i = 0; i < 4; ++i) packet.data[3 + i] = static_cast<uint8_t>(bits >> (24 - 8 * i));
+    return packet;
+}
+
+void name_thread(const char* name) {
+    pthread_setname_np(pthread_self(), name);
+}
+
+ScenarioResult run_scenario(const Scenario& s, double duration_s) {
+    ScenarioResult result;
+    result.scenario = s;
+    const long rss_before = benchmark::resident_kb();
+
+    auto sim = std::make_shared<SimulatedBus>(s.interfaces);
+    auto driver = std::make_shared<motor_driver::MotorDriverImpl>(sim);
+
+    std::map<std::string, std::vector<uint32_t>> config;
+    for (int i = 0; i < s.interfaces; ++i) {
+        auto& ids = config["can" + std::to_string(i)];
+        for (int m = 1; m <= s.motors; ++m) ids.push_back(static_cast<uint32_t>(m));
+    }
+
+    // 统计窗口：预热 200ms 后持续 duration_s；反馈按其注入时间是否落在窗口内计数，
+    // 注入计数与交付计数使用同一时间戳判定
+    const auto window_start = Clock::now() + std::chrono::milliseconds(200);
+    const auto window_end = window_start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration_s));
+    const int64_t window_start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(window_start.time_since_epoch()).count();
+    const int64_t window_end_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(window_end.time_since_epoch()).count();
+    auto in_window = [=](int64_t stamp_ns) { return stamp_ns >= window_start_ns && stamp_ns < window_end_ns; };
+
+    // 每个电机可注入的帧数：预热 + 窗口 + 1s 余量，超出后注入线程停止
+    const size_t frames_per_motor = std::min<size_t>(static_cast<size_t>(s.rate_hz * (duration_s + 1.2)), size_t{1} << 24);
+    InjectLog inject_log(s.interfaces, frames_per_motor);
+    auto& feedback_latency = *result.feedback_latency;
+    auto& event_latency = *result.event_latency;
+    std::atomic<bool> measuring{false};
+    std::atomic<uint64_t> feedback_delivered{0};
+    std::atomic<uint64_t> events_delivered{0};
+
+    auto hardware = std::make_shared<RobotHardware>(driver, config,
+        [&](const std::string& interface, uint32_t motor_id, const motor_driver::Motor_Status& status) {
+            const auto sequence = static_cast<uint32_t>(status.position);
+            if (motor_id > MAX_MOTORS || sequence >= inject_log.capacity) return;
+            const int64_t injected_ns = inject_log.at(interface_index(interface), motor_id, sequence).load(std::memory_order_relaxed);
+            if (!in_window(injected_ns)) return;
+            feedback_latency.record_ns(benchmark::now_ns() - injected_ns);
+            feedback_delivered.fetch_add(1, std::memory_order_relaxed);
+        });
+
+    std::shared_ptr<event::EventBus> event_bus;
+    std::vector<std::shared_ptr<event::EventHandler>> subscriptions;
+    if (s.subscribers > 0) {
+        event_bus = std::make_shared<event::EventBus>();
+        driver->set_event_bus(event_bus);
+        for (int i = 0; i < s.subscribers; ++i) {
+            subscriptions.push_back(event_bus->subscribe<event::MotorStatusEvent>(
+                [&](const std::shared_ptr<event::MotorStatusEvent>& event) {
+                    const auto sequence = static_cast<uint32_t>(event->get_status().position);
+                    if (event->get_motor_id() > MAX_MOTORS || sequence >= inject_log.capacity) return;
+                    const int64_t injected_ns = inject_log.at(interface_index(event->get_interface()), event->get_motor_id(), sequence)
+                                                    .load(std::memory_order_relaxed);
+                    if (!in_window(injected_ns)) return;
+                    event_latency.record_ns(benchmark::now_ns() - injected_ns);
+                    events_delivered.fetch_add(1, std::memory_order_relaxed);
+                }));
+        }
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> injected{0};
+    std::atomic<uint64_t> control_issued{0};
+    std::atomic<uint64_t> late_ticks{0};
+    const auto period = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / s.rate_hz));
+
+    // 每个接口一个注入线程
+    std::vector<std::thread> injectors;
+    for (int i = 0; i < s.interfaces; ++i) {
+        injectors.emplace_back([&, i] {
+            name_thread("sim-feedback");
+            const std::string interface = "can" + std::to_string(i);
+            auto next = Clock::now();
+            for (uint32_t sequence = 0; sequence < inject_log.capacity && running.load(std::memory_order_relaxed); ++sequence) {
+                for (int m = 1; m <= s.motors; ++m) {
+                    auto packet = make_status_packet(interface, static_cast<uint32_t>(m), sequence);
+                    const int64_t stamp_ns = benchmark::now_ns();
+                    inject_log.at(i, static_cast<uint32_t>(m), sequence).store(stamp_ns, std::memory_order_relaxed);
+                    if (in_window(stamp_ns)) injected.fetch_add(1, std::memory_order_relaxed);
+                    sim->inject(packet);
+                }
+                next += period;
+                std::this_thread::sleep_until(next);
+            }
+        });
+    }
+
+    // 控制线程：每周期为所有电机下发速度命令，命令值逐周期变化以免被重复命令过滤
+    std::thread control([&] {
+        name_thread("bench-control");
+        auto next = Clock::now();
+        float velocity = 0.0f;
+        while (running.load(std::memory_order_relaxed)) {
+            for (int i = 0; i < s.interfaces; ++i) {
+                const std::string interface = "can" + std::to_string(i);
+                for (int m = 1; m <= s.motors; ++m) {
+                    hardware->control_motor_in_velocity_mode(interface, static_cast<uint32_t>(m), velocity);
+                    if (measuring.load(std::memory_order_relaxed)) control_issued.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            velocity += 0.001f;
+            next += period;
+            if (Clock::now() > next) {
+                if (measuring.load(std::memory_order_relaxed)) late_ticks.fetch_add(1, std::memory_order_relaxed);
+                next = Clock::now();   // 不追赶，按实际可达频率继续
+            }
+            std::this_thread::sleep_until(next);
+        }
+    });
+
+    // 预热后开始统计
+    std::this_thread::sleep_until(window_start);
+    const auto cpu_before = benchmark::sample_thread_cpu();
+    const uint64_t control_before = sim->control_frames.load();
+    const uint64_t other_before = sim->other_frames.load();
+    const auto start = Clock::now();
+    measuring = true;
+
+    std::this_thread::sleep_until(window_end);
+
+    measuring = false;
+    const auto end = Clock::now();
+    const auto cpu_after = benchmark::sample_thread_cpu();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.control_sent = sim->control_frames.load() - control_before;
+    result.other_frames = sim->other_frames.load() - other_before;
+    result.rss_kb = benchmark::resident_kb();
+    result.rss_delta_kb = result.rss_kb - rss_before;
+
+    running = false;
+    for (auto& t : injectors) t.join();
+    control.join();
+    // 窗口末尾注入的帧可能仍在接收/分发队列中，等待其交付后再读取计数
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    result.feedback_injected = injected.load();
+    result.feedback_delivered = feedback_delivered.load();
+    result.events_delivered = events_delivered.load();
+    result.control_issued = control_issued.load();
+    result.control_late_ticks = late_ticks.load();
+
+    for (const auto& [tid, after] : cpu_after) {
+        auto it = cpu_before.find(tid);
+        const double before = it != cpu_before.end() ? it->second.cpu_seconds : 0.0;
+        const double percent = (after.cpu_seconds - before) / result.seconds * 100.0;
+        result.cpu_total += percent;
+        result.thread_cpu.emplace_back(after.name + " (" + std::to_string(tid) + ")", percent);
+    }
+
+    subscriptions.clear();
+    hardware.reset();
+    driver.reset();
+    return result;
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Arguments args(argc, argv);
+    // 驱动日志走 std::cout，重定向到标准错误，保证标准输出只有 JSON
+    std::streambuf* stdout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+
+    const auto interfaces = args.get_list("interfaces", {1, 2, 4, 8});
+    const auto motors = args.get_list("motors", {7});
+    const auto rates = args.get_list("rates", {200, 1000});
+    const auto subscribers = args.get_list("subscribers", {0, 4});
+    const double duration = args.get_double("duration", 1.0);
+
+    benchmark::JsonWriter json;
+    json.begin_object();
+    json.value("benchmark", std::string("scaling"));
+    json.value("duration_s", duration);
+    json.value("hardware_concurrency", static_cast<int>(std::thread::hardware_concurrency()));
+    json.begin_array("results");
+
+    for (int interface_count : interfaces) {
+        for (int motor_count : motors) {
+            for (int rate : rates) {
+                for (int subscriber_count : subscribers) {
+                    Scenario scenario{interface_count, std::min<int>(motor_count, MAX_MOTORS), rate, subscriber_count};
+                    std::cerr << "[benchmark_scaling] interfaces=" << scenario.interfaces << " motors=" << scenario.motors
+                              << " rate=" << scenario.rate_hz << " subscribers=" << scenario.subscribers << std::endl;
+                    auto r = run_scenario(scenario, duration);
+
+                    const uint64_t expected_events = r.feedback_delivered * static_cast<uint64_t>(scenario.subscribers);
+                    json.begin_object();
+                    json.value("interfaces", scenario.interfaces);
+                    json.value("motors", scenario.motors);
+                    json.value("feedback_rate_hz", scenario.rate_hz);
+                    json.value("subscribers", scenario.subscribers);
+                    json.value("seconds", r.seconds);
+
+                    json.begin_object("feedback");
+                    json.value("injected", r.feedback_injected);
+                    json.value("delivered", r.feedback_delivered);
+                    json.value("dropped", r.feedback_injected > r.feedback_delivered ? r.feedback_injected - r.feedback_delivered : uint64_t{0});
+                    json.latency("latency_us", *r.feedback_latency);
+                    json.end_object();
+
+                    json.begin_object("events");
+                    json.value("expected", expected_events);
+                    json.value("delivered", r.events_delivered);
+                    json.value("dropped", expected_events > r.events_delivered ? expected_events - r.events_delivered : uint64_t{0});
+                    json.latency("latency_us", *r.event_latency);
+                    json.end_object();
+
+                    json.begin_object("control");
+                    json.value("issued", r.control_issued);
+                    json.value("sent", r.control_sent);
+                    json.value("target_per_s", static_cast<double>(scenario.interfaces) * scenario.motors * scenario.rate_hz);
+                    json.value("issued_per_s", r.control_issued / r.seconds);
+                    json.value("sent_per_s", r.control_sent / r.seconds);
+                    json.value("backlog", r.control_issued > r.control_sent ? r.control_issued - r.control_sent : uint64_t{0});
+                    json.value("late_ticks", r.control_late_ticks);
+                    json.value("other_frames", r.other_frames);
+                    json.end_object();
+
+                    json.begin_object("memory");
+                    json.value("rss_kb", static_cast<int64_t>(r.rss_kb));
+                    json.value("rss_delta_kb", static_cast<int64_t>(r.rss_delta_kb));
+                    json.end_object();
+
+                    json.value("cpu_total_percent", r.cpu_total);
+                    json.begin_array("threads");
+                    for (const auto& [name, percent] : r.thread_cpu) {
+                        json.begin_object();
+                        json.value("name", name);
+                        json.value("cpu_percent", percent);
+                        json.end_object();
+                    }
+                    json.end_array();
+                    json.end_object();
+                }
+            }
+        }
+    }
+
+    json.end_array();
+    json.end_object();
+
+    std::cout.rdbuf(stdout_buf);
+    return benchmark::write_output(args, json.str()) ? 0 : 1;
+}
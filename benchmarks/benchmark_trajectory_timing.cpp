@@ -0,0 +1,245 @@
+/**
+ * @file benchmark_trajectory_timing.cpp
+ * @brief 轨迹执行时序精度基准：轨迹点实际上总线时刻相对 time_from_start 的偏差
+ *
+ * 轨迹经 RobotHardware 执行，仿真总线在 send() 中记录每个批量控制帧的时间戳。轨迹点序号编码在
+ * 第一个关节的位置里，据此把发送时刻对应回轨迹点。对每种执行方式分别统计：
+ *   - 发送时刻误差分布：send_time - (start + time_from_start)
+ *   - 点间抖动：|实际点间隔 - 期望点间隔|
+ *   - 累计漂移：最后一点与第一点误差之差，以及丢失的点数
+ * 可选在其余核上运行忙等线程模拟 CPU 压力。
+ *
+ * 执行方式：sync（execute_trajectory）、async（execute_trajectory_async）、queue（enqueue_trajectory）
+ *
+ * 用法：
+ *   benchmark_trajectory_timing [--periods-us=1000,2000,5000] [--lengths-ms=500,2000]
+ *                               [--modes=sync,async,queue] [--stress=0,4] [--output=result.json]
+ */
+#include "benchmark_common.hpp"
+#include "driver/motor_driver_impl.hpp"
+#include "hardware_driver/interface/robot_hardware.hpp"
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace hardware_driver;
+using benchmark::Clock;
+
+namespace {
+
+const std::string INTERFACE = "can0";
+const std::vector<uint32_t> MOTOR_IDS = {1, 2, 3, 4, 5, 6};
+constexpr uint8_t CONTROL_ALL_FLAG = 0x03;
+
+// 仿真总线：记录批量控制帧的发送时刻和其中编码的轨迹点序号
+class TimestampingBus : public bus::BusInterface {
+public:
+    void init() override {}
+    bool send(const bus::GenericBusPacket& packet) override {
+        if (packet.id != 0 || packet.len < 4 || packet.data[1] != CONTROL_ALL_FLAG) return true;
+        const auto sent_at = Clock::now();
+        const int16_t encoded = static_cast<int16_t>((packet.data[2] << 8) | packet.data[3]);
+        std::lock_guard<std::mutex> lock(mutex_);
+        sends_.emplace_back(static_cast<int>(encoded), sent_at);
+        return true;
+    }
+    bool receive(bus::GenericBusPacket& /*packet*/) override { return false; }
+    void async_receive(const std::function<void(const bus::GenericBusPacket&)>& /*callback*/) override {}
+    std::vector<std::string> get_interface_names() const override { return {INTERFACE}; }
+
+    std::vector<std::pair<int, Clock::time_point>> take() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::move(sends_);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::pair<int, Clock::time_point>> sends_;
+};
+
+// 第一个关节位置 = 序号 * 0.01，批量帧按 0.01 精度截断为 int16，加 0.5 避免舍入误差
+Trajectory make_trajectory(int period_us, int length_ms) {
+    Trajectory trajectory;
+    const int points = std::max(2, length_ms * 1000 / period_us);
+    for (int i = 0; i < points && i < 32000; ++i) {
+        TrajectoryPoint point;
+        point.time_from_start = i * period_us * 1e-6;
+        point.positions.assign(MOTOR_IDS.size(), 0.0);
+        point.positions[0] = (i + 0.5) * 0.01;
+        trajectory.points.push_back(point);
+    }
+    return trajectory;
+}
+
+struct RunResult {
+    std::string mode;
+    int period_us{0};
+    int length_ms{0};
+    int stress_threads{0};
+    size_t points{0};
+    size_t sent{0};
+    double mean_error_us{0.0};
+    double first_error_us{0.0};
+    double last_error_us{0.0};
+    std::unique_ptr<benchmark::LatencyHistogram> error = std::make_unique<benchmark::LatencyHistogram>();
+    std::unique_ptr<benchmark::LatencyHistogram> jitter = std::make_unique<benchmark::LatencyHistogram>();
+};
+
+bool execute(RobotHardware& hardware, const std::string& mode, const Trajectory& trajectory) {
+    if (mode == "sync") {
+        return hardware.execute_trajectory(INTERFACE, trajectory);
+    }
+    if (mode == "async") {
+        const std::string id = hardware.execute_trajectory_async(INTERFACE, trajectory, false);
+        if (id.empty()) return false;
+        TrajectoryExecutionProgress progress;
+        while (hardware.get_execution_progress(id, progress) &&
+               (progress.state == TrajectoryExecutionState::RUNNING || progress.state == TrajectoryExecutionState::IDLE)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        // 结束后由 wait_for_completion 回收执行线程
+        hardware.wait_for_completion(id, 1000);
+        return progress.state == TrajectoryExecutionState::COMPLETED;
+    }
+    if (mode == "queue") {
+        if (!hardware.enqueue_trajectory(INTERFACE, trajectory)) return false;
+        return hardware.wait_for_trajectory_queue(INTERFACE, 60000);
+    }
+    std::cerr << "[benchmark_trajectory_timing] unknown mode " << mode << std::endl;
+    return false;
+}
+
+RunResult run(const std::string& mode, int period_us, int length_ms, int stress_threads) {
+    RunResult result;
+    result.mode = mode;
+    result.period_us = period_us;
+    result.length_ms = length_ms;
+    result.stress_threads = stress_threads;
+
+    auto bus = std::make_shared<TimestampingBus>();
+    auto driver = std::make_shared<motor_driver::MotorDriverImpl>(bus);
+    RobotHardware hardware(driver, {{INTERFACE, MOTOR_IDS}});
+    const auto trajectory = make_trajectory(period_us, length_ms);
+    result.points = trajectory.points.size();
+
+    // 忙等线程占满其余核
+    std::atomic<bool> stressing{true};
+    std::vector<std::thread> stress;
+    for (int i = 0; i < stress_threads; ++i) {
+        stress.emplace_back([&stressing] {
+            volatile uint64_t counter = 0;
+            while (stressing.load(std::memory_order_relaxed)) counter = counter + 1;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    bus->take();
+    const auto start = Clock::now();
+    const bool ok = execute(hardware, mode, trajectory);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));   // 等控制队列发完
+    auto sends = bus->take();
+
+    stressing = false;
+    for (auto& t : stress) t.join();
+    if (!ok) {
+        std::cerr << "[benchmark_trajectory_timing] " << mode << " execution failed" << std::endl;
+    }
+
+    // 每个点只取第一次发送
+    std::vector<int64_t> error_ns(trajectory.points.size(), INT64_MIN);
+    for (const auto& [index, sent_at] : sends) {
+        if (index < 0 || static_cast<size_t>(index) >= error_ns.size() || error_ns[index] != INT64_MIN) continue;
+        const auto target = start + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(trajectory.points[index].time_from_start));
+        error_ns[index] = std::chrono::duration_cast<std::chrono::nanoseconds>(sent_at - target).count();
+    }
+
+    double error_sum = 0.0;
+    int64_t previous = INT64_MIN;
+    bool first = true;
+    for (size_t i = 0; i < error_ns.size(); ++i) {
+        if (error_ns[i] == INT64_MIN) {
+            previous = INT64_MIN;
+            continue;
+        }
+        result.sent++;
+        error_sum += error_ns[i] / 1000.0;
+        result.error->record_ns(std::llabs(error_ns[i]));
+        if (first) {
+            result.first_error_us = error_ns[i] / 1000.0;
+            first = false;
+        }
+        result.last_error_us = error_ns[i] / 1000.0;
+        // 相邻两点误差之差即实际间隔与期望间隔之差
+        if (previous != INT64_MIN) {
+            result.jitter->record_ns(std::llabs(error_ns[i] - previous));
+        }
+        previous = error_ns[i];
+    }
+    result.mean_error_us = result.sent > 0 ? error_sum / result.sent : 0.0;
+    return result;
+}
+
+std::vector<std::string> split(const std::string& text) {
+    std::vector<std::string> items;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Arguments args(argc, argv);
+    // 驱动日志走 std::cout，重定向到标准错误，保证标准输出只有 JSON
+    std::streambuf* stdout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+
+    const int cores = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    const auto periods = args.get_list("periods-us", {1000, 2000, 5000});
+    const auto lengths = args.get_list("lengths-ms", {500, 2000});
+    const auto modes = split(args.get("modes", "sync,async,queue"));
+    const auto stress_levels = args.get_list("stress", {0, cores - 1});
+
+    benchmark::JsonWriter json;
+    json.begin_object();
+    json.value("benchmark", std::string("trajectory_timing"));
+    json.value("hardware_concurrency", cores);
+    json.begin_array("results");
+
+    for (const auto& mode : modes) {
+        for (int stress : stress_levels) {
+            for (int period : periods) {
+                for (int length : lengths) {
+                    std::cerr << "[benchmark_trajectory_timing] mode=" << mode << " stress=" << stress
+                              << " period_us=" << period << " length_ms=" << length << std::endl;
+                    auto r = run(mode, period, length, stress);
+
+                    json.begin_object();
+                    json.value("mode", r.mode);
+                    json.value("stress_threads", r.stress_threads);
+                    json.value("period_us", r.period_us);
+                    json.value("length_ms", r.length_ms);
+                    json.value("points", static_cast<uint64_t>(r.points));
+                    json.value("sent", static_cast<uint64_t>(r.sent));
+                    json.value("missing", static_cast<uint64_t>(r.points - r.sent));
+                    json.value("mean_error_us", r.mean_error_us);
+                    json.latency("abs_error_us", *r.error);
+                    json.latency("jitter_us", *r.jitter);
+                    json.value("drift_us", r.last_error_us - r.first_error_us);
+                    json.end_object();
+                }
+            }
+        }
+    }
+
+    json.end_array();
+    json.end_object();
+
+    std::cout.rdbuf(stdout_buf);
+    return benchmark::write_output(args, json.str()) ? 0 : 1;
+}
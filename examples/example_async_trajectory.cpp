@@ -54,6 +54,18 @@ int main() {
     // 创建RobotHardware实例
     RobotHardware robot_hardware(motor_driver, interface_motor_config);
 
+    // 并行清错、使能全部电机，等反馈确认后再执行轨迹
+    auto bring_up = robot_hardware.bring_up_motors();
+    for (const auto& motor : bring_up.motors) {
+        std::cout << motor.interface << " 电机 " << motor.motor_id << ": "
+                  << (motor.outcome == hardware_driver::motor_driver::BringUpOutcome::CONFIRMED ? "已确认" : "未确认")
+                  << "，耗时 " << motor.elapsed.count() / 1000.0 << " ms" << std::endl;
+    }
+    if (!bring_up.ok()) {
+        std::cerr << "电机上电未全部确认，退出" << std::endl;
+        return 1;
+    }
+
     std::cout << "\n========== 异步轨迹执行示例 ==========" << std::endl;
 
     // ============ 示例1：基本的异步执行 ============
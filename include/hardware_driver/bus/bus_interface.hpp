@@ -6,6 +6,8 @@
 #include <vector>
 #include <cstdint>
 #include <functional>
+#include <chrono>
+#include <stdexcept>
 
 namespace hardware_driver {
 namespace bus {
@@ -20,6 +22,16 @@ enum class BusProtocolType {
 
 constexpr size_t MAX_BUS_DATA_SIZE = 64;     ///< 最大总线数据大小
 
+/**
+ * @brief 发送优先级类别，支持的总线按类别使用不同的内核发送队列
+ */
+enum class TxClass : uint8_t {
+    BULK = 0,      ///< 周期控制命令，可被限流
+    NORMAL = 1,    ///< 反馈请求、参数读写
+    URGENT = 2     ///< 使能/失能、紧急停止，不受在途帧数限制
+};
+constexpr size_t TX_CLASS_COUNT = 3;
+
 /**
  * @brief 通用总线数据包结构体，用于发送和接收数据
  */
@@ -29,11 +41,40 @@ struct GenericBusPacket {
     std::array<uint8_t, MAX_BUS_DATA_SIZE> data;      ///< 数据
     size_t len;                    ///< 数据长度
     BusProtocolType protocol_type; ///< 协议类型
+    std::chrono::steady_clock::time_point timestamp;  ///< 接收时间戳（CLOCK_MONOTONIC），发送时忽略
+    TxClass tx_class;              ///< 发送优先级类别，接收时忽略
 
     // 使用默认构造函数并初始化成员
-    GenericBusPacket() : id(0), len(0), protocol_type(BusProtocolType::UNKNOWN) {}
+    GenericBusPacket() : id(0), len(0), protocol_type(BusProtocolType::UNKNOWN), tx_class(TxClass::NORMAL) {}
+};
+
+/**
+ * @brief 发送结果分类
+ */
+enum class TxStatus : uint8_t {
+    OK = 0,
+    BACKPRESSURE = 1,    ///< 内核发送队列满（ENOBUFS/EAGAIN），稍后重试可能成功
+    NO_INTERFACE = 2,    ///< 接口不存在或未打开
+    INVALID_FRAME = 3,   ///< 帧长度等参数不合法
+    DEVICE_ERROR = 4     ///< 设备关闭或故障（ENETDOWN、ENXIO 等），重试无效
 };
 
+// 暂时性失败，可按命令优先级和有效期重试
+inline bool is_transient(TxStatus status) {
+    return status == TxStatus::BACKPRESSURE;
+}
+
+inline const char* to_string(TxStatus status) {
+    switch (status) {
+        case TxStatus::OK: return "OK";
+        case TxStatus::BACKPRESSURE: return "BACKPRESSURE";
+        case TxStatus::NO_INTERFACE: return "NO_INTERFACE";
+        case TxStatus::INVALID_FRAME: return "INVALID_FRAME";
+        case TxStatus::DEVICE_ERROR: return "DEVICE_ERROR";
+    }
+    return "UNKNOWN";
+}
+
 class BusInterface {
 public:
     virtual ~BusInterface() = default;
@@ -42,12 +83,32 @@ public:
 
     virtual bool send(const GenericBusPacket& packet) = 0;
 
+    /**
+     * @brief 发送并返回失败原因，不抛异常
+     * 默认实现基于 send()：返回 false 或抛异常都归为 DEVICE_ERROR，能区分背压的总线应重写
+     */
+    virtual TxStatus try_send(const GenericBusPacket& packet) {
+        try {
+            return send(packet) ? TxStatus::OK : TxStatus::DEVICE_ERROR;
+        } catch (const std::exception&) {
+            return TxStatus::DEVICE_ERROR;
+        }
+    }
+
     virtual bool receive(GenericBusPacket& packet) = 0;
     
     virtual void async_receive(const std::function<void(const GenericBusPacket&)>& callback) = 0;
 
     virtual std::vector<std::string> get_interface_names() const = 0;
 
+    /**
+     * @brief 估算数据包占用总线的时间，驱动据此调整控制命令的发送间隔
+     * @return 0 表示总线无法估算
+     */
+    virtual std::chrono::nanoseconds frame_airtime(const GenericBusPacket& /*packet*/) const {
+        return std::chrono::nanoseconds(0);
+    }
+
 };
 
 }   // namespace bus
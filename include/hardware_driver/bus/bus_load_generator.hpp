@@ -0,0 +1,144 @@
+#ifndef __BUS_LOAD_GENERATOR_HPP__
+#define __BUS_LOAD_GENERATOR_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hardware_driver/bus/bus_interface.hpp"
+
+namespace hardware_driver {
+namespace bus {
+
+// 负载帧类型，帧内容与驱动/关节模组的实际协议一致
+enum class LoadFrameKind : uint8_t {
+    STATUS_REPLY,       // 0x300 + id，24 字节状态反馈（模拟电机应答）
+    CONTROL_ALL,        // ID 0，批量控制
+    CONTROL,            // 单电机 MIT 控制
+    FEEDBACK_REQUEST,   // 0x200 + id 反馈请求
+    PARAMETER,          // 0x600 + id 参数读与 0x700 + id 读结果交替
+    FOREIGN             // 其他设备的帧，ID 取 foreign_ids
+};
+
+struct LoadMixEntry {
+    LoadFrameKind kind;
+    double weight;      // 按帧数的相对比例
+};
+
+/**
+ * @brief 负载配置
+ * utilization 为目标总线占用率（空口时间 / 墙钟时间），空口时间按 can_frame_airtime 估算，
+ * 与驱动的空口节拍使用同一模型。
+ */
+struct LoadProfile {
+    std::string interface{"can0"};
+    double utilization{0.5};
+    uint32_t nominal_bitrate{1000000};
+    uint32_t data_bitrate{5000000};
+    bool fd{true};
+    bool brs{true};
+    bool extended{false};           // 所有帧按 29 位扩展帧计算空口时间；ID 超过 0x7FF 的帧总是按扩展帧
+    std::vector<LoadMixEntry> mix;  // 为空时使用 default_mix()
+    std::vector<uint32_t> motor_ids{1, 2, 3, 4, 5, 6};
+    std::vector<uint32_t> foreign_ids{0x7A0};
+    size_t foreign_len{8};
+    // 落后计划超过该值时重新对齐计划，而不是突发补发
+    std::chrono::microseconds max_lateness{2000};
+
+    // 接近控制循环的典型组成：每个控制周期一帧批量控制和六个电机的状态反馈，少量参数与外部帧
+    static std::vector<LoadMixEntry> default_mix();
+};
+
+const char* load_frame_kind_name(LoadFrameKind kind);
+
+/**
+ * @brief 解析负载组成，如 "status:6,control_all:1,param:0.2,foreign:1"
+ * 类型名：status、control_all、control、feedback_req、param、foreign
+ */
+bool parse_load_mix(const std::string& text, std::vector<LoadMixEntry>& mix);
+
+// 实际达到的负载
+struct LoadStats {
+    uint64_t frames_sent{0};
+    uint64_t send_failures{0};                  // 发送失败（如发送队列满），不重发
+    uint64_t schedule_resets{0};                // 落后超过 max_lateness 而重新对齐的次数
+    std::chrono::nanoseconds airtime{0};        // 成功发送帧的空口时间之和
+    std::chrono::nanoseconds elapsed{0};
+    std::chrono::nanoseconds late_avg{0};       // 实际发送时刻晚于计划的平均值
+    std::chrono::nanoseconds late_max{0};
+    double utilization{0.0};                    // airtime / elapsed
+    double frame_rate{0.0};                     // 帧/秒
+};
+
+/**
+ * @brief 按负载配置生成精确节拍的总线流量
+ *
+ * 发送线程按每帧的空口时间 / 目标占用率推进计划时刻，用 clock_nanosleep(TIMER_ABSTIME) 睡到计划时刻再发送。
+ * 计划时刻按绝对时间累加，唤醒延迟不会累积成速率误差：晚于计划时下一帧立即发出，直到追上计划。
+ * 帧通过 SendFunction 发出，可以是原始 SocketCAN 套接字，也可以是任意 BusInterface::send。
+ *
+ * 注意：STATUS_REPLY 帧会被同一总线上的驱动当作电机反馈处理，测试时应使用驱动未配置的电机 ID。
+ */
+class BusLoadGenerator {
+public:
+    using SendFunction = std::function<bool(const GenericBusPacket&)>;
+
+    BusLoadGenerator(LoadProfile profile, SendFunction send);
+    ~BusLoadGenerator();
+
+    BusLoadGenerator(const BusLoadGenerator&) = delete;
+    BusLoadGenerator& operator=(const BusLoadGenerator&) = delete;
+
+    // 启动发送线程；配置无效或已在运行时返回 false
+    bool start();
+    void stop();
+    bool is_running() const { return running_.load(); }
+
+    // 运行中调整目标占用率（0.01 ~ 1.0），从下一帧开始生效
+    void set_utilization(double utilization);
+    double get_utilization() const { return utilization_.load(); }
+
+    // 按当前组成和占用率计算的计划帧率
+    double planned_frame_rate() const;
+
+    LoadStats get_stats() const;
+
+    // 生成组成序列中的下一帧（发送线程使用，公开以便测试帧内容）
+    GenericBusPacket next_frame();
+    // 按配置的波特率估算一帧的空口时间
+    std::chrono::nanoseconds frame_airtime(const GenericBusPacket& packet) const;
+
+private:
+    void run();
+
+    LoadProfile profile_;
+    SendFunction send_;
+    std::atomic<double> utilization_;
+
+    // 平滑加权轮询，保证任意时间窗内的帧组成接近配置比例
+    std::vector<double> current_weight_;
+    double total_weight_{0.0};
+    std::vector<size_t> next_motor_;
+    size_t next_foreign_{0};
+    uint64_t sequence_{0};
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> send_failures_{0};
+    std::atomic<uint64_t> schedule_resets_{0};
+    std::atomic<int64_t> airtime_ns_{0};
+    std::atomic<int64_t> late_sum_ns_{0};
+    std::atomic<int64_t> late_max_ns_{0};
+    std::atomic<int64_t> start_ns_{0};
+    std::atomic<int64_t> stop_ns_{0};
+};
+
+}   // namespace bus
+}   // namespace hardware_driver
+
+#endif   // __BUS_LOAD_GENERATOR_HPP__
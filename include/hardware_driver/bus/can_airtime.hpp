@@ -0,0 +1,63 @@
+#ifndef __CAN_AIRTIME_HPP__
+#define __CAN_AIRTIME_HPP__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace hardware_driver {
+namespace bus {
+
+// CAN FD 数据长度向上取整到合法的 DLC 长度
+inline size_t canfd_padded_length(size_t len) {
+    if (len <= 8) return len;
+    if (len <= 12) return 12;
+    if (len <= 16) return 16;
+    if (len <= 20) return 20;
+    if (len <= 24) return 24;
+    if (len <= 32) return 32;
+    if (len <= 48) return 48;
+    return 64;
+}
+
+/**
+ * @brief 估算一帧占用总线的时间（按最坏情况位填充）
+ * @param fd            CAN FD 帧
+ * @param brs           数据段是否切换到 data_bitrate（仅 CAN FD 有效）
+ * @param extended      29 位扩展帧
+ * @param nominal_bitrate 仲裁段波特率
+ * @param data_bitrate  数据段波特率，为 0 时按仲裁段波特率计算
+ *
+ * 仲裁段：SOF、ID、控制位；数据段：ESI/DLC、数据、填充计数和 CRC；之后的 ACK、EOF、帧间隔按仲裁段波特率。
+ */
+inline std::chrono::nanoseconds can_frame_airtime(size_t len, bool fd, bool brs, bool extended,
+                                                  uint32_t nominal_bitrate, uint32_t data_bitrate) {
+    if (nominal_bitrate == 0) return std::chrono::nanoseconds(0);
+
+    double nominal_bits = 0.0;
+    double data_bits = 0.0;
+    if (!fd) {
+        // 经典 CAN：SOF + 仲裁/控制 + 数据 + CRC15，位填充覆盖到 CRC 结束
+        const double stuffed = (extended ? 54.0 : 34.0) + 8.0 * (len > 8 ? 8 : len);
+        nominal_bits = stuffed + (stuffed - 1.0) / 4.0 + 13.0;   // CRC 定界 + ACK + EOF + 帧间隔
+    } else {
+        const size_t padded = canfd_padded_length(len);
+        // 标准帧：SOF + ID11 + RRS + IDE + FDF + res + BRS = 17 位
+        // 扩展帧：SOF + ID11 + SRR + IDE + ID18 + RRS + FDF + res + BRS = 36 位
+        const double arbitration = extended ? 36.0 : 17.0;
+        nominal_bits = arbitration + (arbitration - 1.0) / 4.0 + 13.0;
+        // ESI + DLC + 数据（动态填充），填充计数 + CRC17/21（固定填充，每 4 位 1 位）
+        const double payload = 5.0 + 8.0 * padded;
+        const double crc = padded <= 16 ? 17.0 + 4.0 : 21.0 + 4.0;
+        data_bits = payload + payload / 4.0 + crc + crc / 4.0;
+    }
+
+    const double data_rate = (fd && brs && data_bitrate > 0) ? data_bitrate : nominal_bitrate;
+    const double seconds = nominal_bits / nominal_bitrate + data_bits / data_rate;
+    return std::chrono::nanoseconds(static_cast<int64_t>(seconds * 1e9));
+}
+
+}   // namespace bus
+}   // namespace hardware_driver
+
+#endif   // __CAN_AIRTIME_HPP__
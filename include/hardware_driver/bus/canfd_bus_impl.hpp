@@ -8,6 +8,7 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <array>
 #include <linux/can.h>
 #include <linux/can/raw.h>
 #include <linux/can/error.h>
@@ -21,6 +22,7 @@
 #include <cstring>
 #include <iostream>
 #include "hardware_driver/bus/bus_interface.hpp"
+#include "hardware_driver/runtime/runtime.hpp"
 
 namespace hardware_driver {
 namespace bus {
@@ -39,14 +41,20 @@ public:
     // 默认波特率常量
     static constexpr uint32_t DEFAULT_ARBITRATION_BITRATE = 1000000;  // 1 Mbps
     static constexpr uint32_t DEFAULT_DATA_BITRATE = 5000000;         // 5 Mbps
+    // 非紧急类别在内核中最多排队的帧数，紧急帧前面最多只有这么多帧
+    static constexpr size_t DEFAULT_TX_INFLIGHT_LIMIT = 8;
     
     // 构造函数重载
     CanFdBus(const std::vector<std::string>& interfaces, uint32_t arbitration_bitrate, uint32_t data_bitrate);
     CanFdBus(const std::vector<std::string>& interfaces); // 使用默认波特率
+    // 挂到共享运行时：socket 由运行时 I/O 线程 epoll 等待，不再为每个接口创建接收线程
+    CanFdBus(const std::vector<std::string>& interfaces, std::shared_ptr<runtime::Runtime> runtime,
+             uint32_t arbitration_bitrate = DEFAULT_ARBITRATION_BITRATE, uint32_t data_bitrate = DEFAULT_DATA_BITRATE);
     ~CanFdBus();
 
     void init() override;
     bool send(const GenericBusPacket& packet) override;
+    TxStatus try_send(const GenericBusPacket& packet) override;   // 按 errno 区分背压与硬错误
     bool receive(GenericBusPacket& packet) override;
     void async_receive(const std::function<void(const GenericBusPacket&)>& callback) override;
     
@@ -55,15 +63,56 @@ public:
     void set_extended_frame(const std::string& interface, bool use_extended);
     void set_fd_mode(const std::string& interface, bool use_fd);
 
+    /**
+     * @brief 每个接口按 TxClass 各开一个发送 socket（SO_PRIORITY 6/0/2，对应 prio/pfifo_fast 的 0/1/2 频带），
+     * 非紧急类别通过 SIOCOUTQ 限制内核中排队的帧数，超限时 try_send 返回 BACKPRESSURE
+     * @param frames 0 表示不限制
+     */
+    void set_tx_inflight_limit(size_t frames);
+    // 接口上所有发送 socket 在内核中尚未发出的帧数（估计值）
+    size_t get_tx_inflight(const std::string& interface) const;
+
+    // 启动时通过 netlink 读到的接口位定时
+    struct BitTiming {
+        uint32_t nominal_bitrate{0};    // 仲裁段，读不到时取构造参数
+        uint32_t data_bitrate{0};       // 数据段，未配置时为 0
+        bool fd_enabled{false};
+        bool verified{false};           // 是否成功从内核读到接口信息
+    };
+    bool get_bit_timing(const std::string& interface, BitTiming& timing) const;
+
+    /**
+     * @brief 数据段波特率切换（CANFD_BRS），可按发送类别分别设置
+     * 启动时接口已配置 FD 和数据段波特率则默认开启，否则关闭；未配置数据段波特率的接口无法开启，返回 false
+     */
+    bool set_bit_rate_switch(const std::string& interface, bool enable);
+    bool set_bit_rate_switch(const std::string& interface, TxClass tx_class, bool enable);
+    bool get_bit_rate_switch(const std::string& interface, TxClass tx_class) const;
+
+    std::chrono::nanoseconds frame_airtime(const GenericBusPacket& packet) const override;
+
 private:
     using SocketPtr = std::unique_ptr<int, SocketDeleter>;
     SocketPtr bind_can_socket(const std::string& interface, bool enable_loopback = false);
     
     void receive_loop(const std::string& interface);
+    void drain_socket(const std::string& interface);    // 运行时 I/O 回调：读出当前可读的帧
+    void bind_tx_sockets(const std::string& interface);
+    void verify_bit_timing(const std::string& interface);
 private:
     std::unordered_map<std::string, SocketPtr> interface_sockets_;
+
+    // 按优先级类别的发送 socket；不接收任何帧，创建失败时退回接收 socket 发送
+    struct TxSocket {
+        SocketPtr sock;
+        std::atomic<size_t> skb_bytes{0};   // 单帧在发送队列中占用的字节数，首次发送时标定
+    };
+    std::unordered_map<std::string, std::array<std::unique_ptr<TxSocket>, TX_CLASS_COUNT>> tx_sockets_;
+    std::atomic<size_t> tx_inflight_limit_{DEFAULT_TX_INFLIGHT_LIMIT};
     std::unordered_map<std::string, bool> extended_frame_flags_;    // extended frame flag for each interface
     std::unordered_map<std::string, bool> canfd_flags_;            // canfd flag for each interface
+    std::unordered_map<std::string, std::array<bool, TX_CLASS_COUNT>> brs_flags_;   // 按发送类别的 BRS 开关
+    std::unordered_map<std::string, BitTiming> bit_timing_;
     std::vector<std::string> interface_names_;
     uint32_t arbitration_bitrate_;
     uint32_t data_bitrate_;
@@ -71,6 +120,8 @@ private:
     std::function<void(const GenericBusPacket&)> receive_callback_;
     std::vector<std::thread> receive_threads_;
     std::atomic<bool> running_{false};
+    std::shared_ptr<runtime::Runtime> runtime_;
+    std::vector<int> runtime_fds_;                     // 已注册到运行时的 socket
 
 };
 
@@ -0,0 +1,85 @@
+#ifndef __COMMAND_TRANSACTION_HPP__
+#define __COMMAND_TRANSACTION_HPP__
+
+#include "hardware_driver/bus/bus_interface.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hardware_driver {
+namespace motor_driver {
+
+// 事务提交结果
+struct CommandTransactionResult {
+    size_t sent{0};      // 发送成功的帧数
+    size_t failed{0};    // 发送失败的帧数（总线返回失败或抛出异常）
+
+    bool ok() const { return failed == 0; }
+};
+
+/**
+ * @brief 命令事务：先构建一组命令，再整体提交
+ *
+ * 上电使能、切换模式等场景会连续下发多条使能、参数写入和控制命令。逐条调用时每条命令
+ * 单独入队、单独唤醒控制线程并占用一个发送间隔，且可能与其他线程的命令交错。
+ * 事务提交时只入队一次、唤醒一次，命令按添加顺序连续发出，中间不会插入其他命令。
+ *
+ * 构建方法与 MotorDriverImpl 同名接口的打包方式一致，打包失败的命令不会加入事务。
+ * 事务中的命令不经过重复命令过滤和命令闸门（GatePolicy），由调用方保证顺序和内容合理。
+ */
+class CommandTransaction {
+public:
+    // 条目类型：使能/失能命令在提交时同步更新驱动记录的电机模式
+    enum class EntryKind : uint8_t {
+        COMMAND,
+        ENABLE,
+        DISABLE
+    };
+
+    struct Entry {
+        bus::GenericBusPacket packet;
+        EntryKind kind{EntryKind::COMMAND};
+        uint32_t motor_id{0};
+        uint8_t mode{0};
+    };
+
+    CommandTransaction() = default;
+
+    CommandTransaction& enable_motor(const std::string& interface, uint32_t motor_id, uint8_t mode);
+    CommandTransaction& disable_motor(const std::string& interface, uint32_t motor_id, uint8_t mode);
+
+    CommandTransaction& send_position_cmd(const std::string& interface, uint32_t motor_id,
+        float position, float kp, float kd);
+    CommandTransaction& send_velocity_cmd(const std::string& interface, uint32_t motor_id,
+        float velocity, float kp, float kd);
+    CommandTransaction& send_effort_cmd(const std::string& interface, uint32_t motor_id,
+        float effort, float kp, float kd);
+    CommandTransaction& send_mit_cmd(const std::string& interface, uint32_t motor_id,
+        float position, float velocity, float effort, float kp, float kd);
+
+    CommandTransaction& motor_parameter_read(const std::string& interface, uint32_t motor_id, uint16_t address);
+    CommandTransaction& motor_parameter_write(const std::string& interface, uint32_t motor_id, uint16_t address, int32_t value);
+    CommandTransaction& motor_parameter_write(const std::string& interface, uint32_t motor_id, uint16_t address, float value);
+    CommandTransaction& motor_function_operation(const std::string& interface, uint32_t motor_id, uint8_t operation);
+    // 单电机反馈请求（0x200 + 电机号）
+    CommandTransaction& request_feedback(const std::string& interface, uint32_t motor_id);
+
+    // 直接追加已打包的数据帧
+    CommandTransaction& append(const bus::GenericBusPacket& packet);
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    void clear() { entries_.clear(); }
+    const std::vector<Entry>& entries() const { return entries_; }
+
+private:
+    void push(bus::GenericBusPacket&& packet, EntryKind kind, uint32_t motor_id, uint8_t mode);
+
+    std::vector<Entry> entries_;
+};
+
+}  // namespace motor_driver
+}  // namespace hardware_driver
+
+#endif  // __COMMAND_TRANSACTION_HPP__
@@ -0,0 +1,164 @@
+#ifndef __DIAGNOSTICS_SHM_HPP__
+#define __DIAGNOSTICS_SHM_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hardware_driver/driver/motor_driver_interface.hpp"
+
+namespace hardware_driver {
+namespace diagnostics {
+
+/**
+ * 驱动诊断数据的共享内存布局
+ *
+ * 驱动进程按固定周期把 DriverDiagnostics 写入 POSIX 共享内存 /hwdriver.<pid>，hwdriver-top 等工具只读映射，
+ * 不需要与驱动进程通信。整帧由序号保护（seqlock）：写入前序号置为奇数，写完后置为偶数，读者拷贝前后序号一致才有效。
+ * 布局只含定长字段，版本号变化时读者拒绝打开。
+ */
+constexpr uint32_t SHM_MAGIC = 0x54445748;   // "HWDT"
+constexpr uint32_t SHM_VERSION = 1;
+constexpr size_t MAX_INTERFACES = 16;
+constexpr size_t MAX_MOTORS = 128;
+constexpr size_t NAME_LEN = 16;
+constexpr const char* SHM_PREFIX = "/hwdriver.";
+
+// 进程默认使用的共享内存名
+std::string default_shm_name(int pid);
+
+struct ShmInterface {
+    char name[NAME_LEN];
+    uint64_t tx_sent;
+    uint64_t tx_backpressure;
+    uint64_t tx_retried;
+    uint64_t tx_dropped;
+    uint64_t tx_hard_errors;
+    uint64_t feedback_frames;
+    uint64_t hook_overruns;
+};
+
+struct ShmMotor {
+    uint16_t interface_index;        // ShmFrame::interfaces 下标
+    uint8_t enabled;
+    uint8_t motor_mode;
+    uint32_t motor_id;
+    uint32_t feedback_count;
+    uint32_t error_code;
+    int64_t last_feedback_ns;        // steady_clock（CLOCK_MONOTONIC）纳秒，0 表示从未收到
+    float position;
+    float velocity;
+    float effort;
+    uint32_t reserved;
+};
+
+struct ShmFrame {
+    int32_t pid;
+    uint32_t period_ms;
+    uint64_t sample_count;
+    int64_t sampled_ns;              // steady_clock 纳秒，读者据此判断导出是否停滞
+    uint8_t high_freq_mode;
+    uint8_t feedback_paused;
+    uint8_t airtime_pacing;
+    uint8_t receive_mode;
+    uint32_t interface_count;
+    uint32_t motor_count;
+    uint32_t motors_truncated;       // 超出 MAX_MOTORS 未导出的电机数
+    uint64_t control_queue_depth;
+    uint64_t receive_queue_depth;
+    uint64_t event_backlog;
+    uint64_t control_deadline_misses;
+    uint64_t events_published;
+    int64_t event_lag_last_ns;
+    int64_t event_lag_max_ns;
+    ShmInterface interfaces[MAX_INTERFACES];
+    ShmMotor motors[MAX_MOTORS];
+};
+
+struct ShmSegment {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> seq;
+    uint32_t frame_size;
+    ShmFrame frame;
+};
+
+// 把诊断快照转成共享内存帧
+void encode_frame(const motor_driver::DriverDiagnostics& diagnostics, int pid,
+                  std::chrono::milliseconds period, uint64_t sample_count, ShmFrame& frame);
+
+/**
+ * @brief 诊断导出器：独立的低优先级线程按周期采样并写入共享内存
+ * 采样函数在导出线程上执行；线程以 SCHED_IDLE 运行，不与控制、接收线程争用 CPU，
+ * 因此采样函数只能读取原子量和无锁快照，不能获取控制、接收线程会等待的锁
+ */
+class DiagnosticsExporter {
+public:
+    using SampleFunction = std::function<void(motor_driver::DriverDiagnostics&)>;
+
+    DiagnosticsExporter(std::string shm_name, SampleFunction sample,
+                        std::chrono::milliseconds period = std::chrono::milliseconds(100));
+    ~DiagnosticsExporter();
+
+    DiagnosticsExporter(const DiagnosticsExporter&) = delete;
+    DiagnosticsExporter& operator=(const DiagnosticsExporter&) = delete;
+
+    // 创建共享内存并启动导出线程，失败时返回 false
+    bool start();
+    // 停止线程并删除共享内存
+    void stop();
+
+    const std::string& name() const { return shm_name_; }
+
+private:
+    void run();
+    void publish(const motor_driver::DriverDiagnostics& diagnostics);
+
+    std::string shm_name_;
+    SampleFunction sample_;
+    std::chrono::milliseconds period_;
+    ShmSegment* segment_{nullptr};
+    ShmFrame staging_{};                 // 编码缓冲，写共享内存时整帧拷贝，缩短序号为奇数的窗口
+    uint64_t sample_count_{0};
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_{false};
+};
+
+/**
+ * @brief 只读打开其他进程导出的诊断共享内存
+ */
+class DiagnosticsReader {
+public:
+    DiagnosticsReader() = default;
+    ~DiagnosticsReader();
+
+    DiagnosticsReader(const DiagnosticsReader&) = delete;
+    DiagnosticsReader& operator=(const DiagnosticsReader&) = delete;
+
+    // 魔数或版本不符时返回 false
+    bool open(const std::string& shm_name);
+    void close();
+    bool is_open() const { return segment_ != nullptr; }
+
+    // 拷贝一帧一致的数据；连续多次读到写入中途时返回 false
+    bool read(ShmFrame& frame) const;
+
+    // 列出 /dev/shm 下所有诊断共享内存名
+    static std::vector<std::string> list_segments();
+
+private:
+    const ShmSegment* segment_{nullptr};
+};
+
+}   // namespace diagnostics
+}   // namespace hardware_driver
+
+#endif   // __DIAGNOSTICS_SHM_HPP__
@@ -0,0 +1,91 @@
+#ifndef __JOINT_STATE_ESTIMATOR_HPP__
+#define __JOINT_STATE_ESTIMATOR_HPP__
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace hardware_driver {
+namespace motor_driver {
+
+/**
+ * @brief 关节状态估计器参数（alpha-beta-gamma 滤波）
+ *
+ * 反馈到达控制器时已经滞后 1~5ms（请求周期 + 总线传输 + 处理队列 + 回调），
+ * 估计器根据每帧的接收时间戳滤波，并把状态外推到下一次命令发送时刻。
+ */
+struct JointEstimatorConfig {
+    double alpha = 0.5;                    ///< 位置残差修正增益 (0, 1]
+    double beta = 0.1;                     ///< 速度残差修正增益
+    double gamma = 0.01;                   ///< 加速度残差修正增益
+    double velocity_gain = 0.5;            ///< 电机上报速度的融合权重 [0, 1]，0表示不使用
+    double max_prediction_horizon = 0.02;  ///< 最大外推时长(s)，超出部分按匀速处理
+    double max_update_interval = 0.1;      ///< 两次测量间隔超过该值(s)时重新初始化
+};
+
+/**
+ * @brief 单个关节的估计结果
+ */
+struct JointStateEstimate {
+    double position = 0.0;
+    double velocity = 0.0;
+    double acceleration = 0.0;
+    std::chrono::steady_clock::time_point stamp;   ///< 最近一次测量的时间戳
+    bool valid = false;                            ///< 是否已经收到过测量
+};
+
+/**
+ * @brief 多关节 alpha-beta-gamma 状态估计器
+ *
+ * 状态按结构体数组（SoA）存放，predict() 对所有关节做无分支的批量外推，
+ * 便于编译器向量化。非线程安全，由调用方负责同步。
+ */
+class JointStateEstimator {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit JointStateEstimator(size_t joint_count = 0,
+                                 const JointEstimatorConfig& config = JointEstimatorConfig{});
+
+    void resize(size_t joint_count);
+    void reset();
+    size_t size() const { return position_.size(); }
+
+    void set_config(const JointEstimatorConfig& config) { config_ = config; }
+    const JointEstimatorConfig& get_config() const { return config_; }
+
+    // 用一次带时间戳的测量更新单个关节
+    void update(size_t joint, Clock::time_point stamp, double measured_position, double measured_velocity);
+
+    // 获取最近一次滤波结果（测量时刻的状态）
+    JointStateEstimate get(size_t joint) const;
+
+    // 外推单个关节到时刻 t
+    JointStateEstimate predict(size_t joint, Clock::time_point t) const;
+
+    /**
+     * @brief 批量外推所有关节到时刻 t
+     * @param positions 输出位置，长度至少为 count
+     * @param velocities 输出速度，可为 nullptr
+     * @param count 输出数组长度，超出 size() 的部分不写入
+     * @return 实际写入的关节数
+     */
+    size_t predict(Clock::time_point t, double* positions, double* velocities, size_t count) const;
+
+private:
+    JointEstimatorConfig config_;
+
+    // SoA 存储
+    std::vector<double> position_;
+    std::vector<double> velocity_;
+    std::vector<double> acceleration_;
+    std::vector<Clock::time_point> stamp_;
+    std::vector<unsigned char> valid_;
+
+    double clamp_horizon(double dt) const;
+};
+
+}   // namespace motor_driver
+}   // namespace hardware_driver
+
+#endif   // __JOINT_STATE_ESTIMATOR_HPP__
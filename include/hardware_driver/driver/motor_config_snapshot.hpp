@@ -0,0 +1,77 @@
+#ifndef __MOTOR_CONFIG_SNAPSHOT_HPP__
+#define __MOTOR_CONFIG_SNAPSHOT_HPP__
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hardware_driver {
+namespace motor_driver {
+
+// 单个接口的电机表，关节下标与配置中的电机顺序一致
+struct InterfaceMotorTable {
+    std::string interface;
+    std::vector<uint32_t> motor_ids;
+    std::vector<int16_t> joint_index_by_id;   // 按电机ID直接索引，-1 表示未配置
+
+    // 电机ID对应的关节下标，未配置时返回 -1
+    int joint_index(uint32_t motor_id) const;
+};
+
+/**
+ * @brief 不可变的电机配置快照，构造时预先生成每个接口的电机表和ID索引表
+ */
+class MotorConfigSnapshot {
+public:
+    using ConfigMap = std::map<std::string, std::vector<uint32_t>>;
+
+    MotorConfigSnapshot() = default;
+    explicit MotorConfigSnapshot(const ConfigMap& config);
+
+    // 查找接口的电机表，未配置时返回 nullptr
+    const InterfaceMotorTable* find(const std::string& interface) const;
+
+    const std::vector<InterfaceMotorTable>& interfaces() const { return interfaces_; }
+    const ConfigMap& config() const { return config_; }
+    bool empty() const { return interfaces_.empty(); }
+
+private:
+    ConfigMap config_;
+    std::vector<InterfaceMotorTable> interfaces_;
+};
+
+/**
+ * @brief 原子发布电机配置快照（RCU 方式）
+ *
+ * 读端只做一次 acquire 读取，无锁且不增减引用计数；写端构造新快照后整体替换。
+ * 旧快照保留到发布者析构，读端拿到的引用在发布者生命周期内始终有效，
+ * 不会读到半更新的配置。重配置是低频操作，保留旧快照的内存开销可以忽略。
+ */
+class MotorConfigPublisher {
+public:
+    explicit MotorConfigPublisher(const MotorConfigSnapshot::ConfigMap& initial = {});
+
+    MotorConfigPublisher(const MotorConfigPublisher&) = delete;
+    MotorConfigPublisher& operator=(const MotorConfigPublisher&) = delete;
+
+    const MotorConfigSnapshot& current() const {
+        return *current_.load(std::memory_order_acquire);
+    }
+
+    // 发布新配置；与当前配置相同时不替换，返回 false
+    bool publish(const MotorConfigSnapshot::ConfigMap& config);
+
+private:
+    std::atomic<const MotorConfigSnapshot*> current_{nullptr};
+    std::vector<std::unique_ptr<const MotorConfigSnapshot>> retained_;
+    std::mutex publish_mutex_;
+};
+
+}  // namespace motor_driver
+}  // namespace hardware_driver
+
+#endif  // __MOTOR_CONFIG_SNAPSHOT_HPP__
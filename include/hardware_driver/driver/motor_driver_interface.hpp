@@ -6,6 +6,11 @@
 #include <map>
 #include <any>
 #include <memory>
+#include <array>
+#include <cstdint>
+#include <chrono>
+#include <functional>
+#include "hardware_driver/bus/bus_interface.hpp"
 
 namespace hardware_driver {
 namespace motor_driver {
@@ -43,6 +48,247 @@ enum class IAPStatus : uint32_t {
     AJ01 = 0x414A3031,  // "AJ01" - APP收到IAP更新指令
 };
 
+// 控制命令与电机上报状态不符时的处理策略
+enum class CommandGatePolicy : uint8_t {
+    PASS_THROUGH = 0,   // 不检查，所有命令直接入队（旧行为）
+    REJECT = 1,         // 丢弃无法生效的命令；使能请求尚未确认时暂存
+    DEFER = 2,          // 暂存每个电机最新的一条命令，电机就绪后再发送
+    AUTO_ENABLE = 3     // 电机失能时按期望模式自动使能，命令暂存到就绪后发送
+};
+
+// 接收数据包的处理线程
+enum class ReceiveMode : uint8_t {
+    QUEUED = 0,             // 总线接收线程只入队，由数据处理线程按突发解码（默认）
+    RUN_TO_COMPLETION = 1   // 在总线接收线程上直接解码并分发，省去一次线程切换；事件总线发布仍异步
+};
+
+// 命令门控配置
+struct CommandGateConfig {
+    CommandGatePolicy policy{CommandGatePolicy::REJECT};
+    std::chrono::milliseconds state_timeout{500};        // 上报状态超过该时长未更新视为未知（放行）
+    std::chrono::milliseconds deferred_ttl{100};         // 暂存命令的有效期，过期后丢弃
+    std::chrono::milliseconds enable_pending{100};       // 使能请求发出后等待确认的时长
+};
+
+// 命令门控统计
+struct CommandGateStats {
+    uint64_t accepted{0};           // 放行入队
+    uint64_t rejected_disabled{0};  // 电机失能被拒
+    uint64_t rejected_fault{0};     // 电机故障被拒
+    uint64_t rejected_mode{0};      // 上报模式与期望模式不符被拒
+    uint64_t deferred{0};           // 暂存
+    uint64_t deferred_sent{0};      // 暂存后在电机就绪时发出
+    uint64_t deferred_dropped{0};   // 暂存被覆盖或过期
+    uint64_t auto_enabled{0};       // 自动使能次数
+};
+
+// 发送失败处理配置
+struct TxRetryConfig {
+    std::chrono::microseconds backoff{200};     // 发送队列满时的退避间隔，期间可被更高优先级命令抢先
+    uint32_t max_retries{5};                    // 单条命令最多重试次数
+    // 命令有效期，按 CommandPriority 下标（LOW/NORMAL/HIGH/EMERGENCY）；超过有效期的命令不再重试
+    std::array<std::chrono::microseconds, 4> ttl{{
+        std::chrono::microseconds(2000), std::chrono::microseconds(20000),
+        std::chrono::microseconds(100000), std::chrono::microseconds(200000)}};
+    uint32_t escalate_after{3};                 // 连续硬错误达到该次数时上报（回调、事件总线）
+};
+
+// 单个接口的发送统计
+struct TxStats {
+    uint64_t sent{0};                 // 发送成功的帧
+    uint64_t backpressure{0};         // 遇到发送队列满的次数（含重试）
+    uint64_t retried{0};              // 重新排队/重发的次数
+    uint64_t retry_succeeded{0};      // 重试后发送成功的命令
+    uint64_t dropped{0};              // 重试次数用尽或超过有效期而丢弃的命令
+    uint64_t hard_errors{0};          // 接口不存在、帧非法、设备故障
+    uint64_t escalations{0};          // 上报次数
+    uint32_t consecutive_hard_errors{0};
+    bus::TxStatus last_error{bus::TxStatus::OK};
+};
+
+// 发送硬错误上报回调
+using TxErrorCallback = std::function<void(const std::string& interface, bus::TxStatus status, const TxStats& stats)>;
+
+// 从反馈中跟踪到的电机实际状态
+struct MotorRuntimeState {
+    bool reported{false};           // 是否收到过反馈
+    bool enabled{false};
+    uint8_t motor_mode{0};
+    uint32_t error_code{0};
+    std::chrono::steady_clock::time_point last_feedback;
+};
+
+// 上电流程配置
+struct BringUpConfig {
+    uint8_t mode{0x03};                                      // 默认使能模式（MIT）
+    std::map<std::string, std::map<uint32_t, uint8_t>> motor_modes;   // 按接口、电机覆盖 mode
+    bool clear_errors{true};                                 // 使能前先清除错误码
+    std::chrono::milliseconds timeout{2000};                 // 全部电机的最长等待
+    std::chrono::milliseconds retry_interval{200};           // 未确认的电机重发清错与使能的间隔
+};
+
+// 单个电机的上电结果
+enum class BringUpOutcome : uint8_t {
+    CONFIRMED,      // 反馈确认已使能、模式正确且无故障
+    FAULT,          // 超时时反馈仍带错误码
+    NOT_ENABLED,    // 超时时反馈仍为失能或模式不符
+    NO_FEEDBACK     // 发出命令后没有收到反馈
+};
+
+struct MotorBringUpResult {
+    std::string interface;
+    uint32_t motor_id{0};
+    uint8_t mode{0};                        // 请求的模式
+    BringUpOutcome outcome{BringUpOutcome::NO_FEEDBACK};
+    std::chrono::microseconds elapsed{0};   // 从开始到确认反馈的接收时刻；未确认时为总等待时长
+    uint32_t attempts{0};                   // 发出清错与使能的次数
+    MotorRuntimeState state;                // 最后一次反馈的状态
+};
+
+struct BringUpReport {
+    std::vector<MotorBringUpResult> motors;     // 顺序与电机配置一致
+    std::chrono::microseconds elapsed{0};
+
+    // 没有配置电机时不视为成功
+    bool ok() const {
+        if (motors.empty()) return false;
+        for (const auto& motor : motors) {
+            if (motor.outcome != BringUpOutcome::CONFIRMED) return false;
+        }
+        return true;
+    }
+};
+
+// 诊断快照：单个电机
+struct MotorDiagnostics {
+    std::string interface;
+    uint32_t motor_id{0};
+    uint32_t feedback_count{0};                          // 累计收到的反馈帧，0 表示从未收到
+    std::chrono::steady_clock::time_point last_feedback;
+    float position{0.0f};
+    float velocity{0.0f};
+    float effort{0.0f};
+    uint32_t error_code{0};
+    bool enabled{false};
+    uint8_t motor_mode{0};
+};
+
+// 诊断快照：单个接口
+struct InterfaceDiagnostics {
+    std::string interface;
+    TxStats tx;
+    uint64_t feedback_frames{0};     // 该接口所有电机的反馈帧之和
+    uint64_t hook_overruns{0};       // 控制钩子超时次数
+};
+
+// 诊断快照：驱动整体，见 MotorDriverImpl::sample_diagnostics
+struct DriverDiagnostics {
+    std::chrono::steady_clock::time_point sampled_at;
+    bool high_freq_mode{false};
+    bool feedback_paused{false};
+    bool airtime_pacing{false};
+    ReceiveMode receive_mode{ReceiveMode::QUEUED};
+    size_t control_queue_depth{0};
+    size_t receive_queue_depth{0};
+    size_t event_backlog{0};                    // 直通模式下待发布的状态事件
+    uint64_t control_deadline_misses{0};        // 控制命令晚于计划发送时刻超过一个 control_interval 的次数
+    uint64_t events_published{0};               // 事件总线累计发布数
+    std::chrono::nanoseconds event_lag_last{0};   // 状态事件发布时距反馈接收的时延
+    std::chrono::nanoseconds event_lag_max{0};    // 上次采样以来的最大值
+    std::vector<InterfaceDiagnostics> interfaces;
+    std::vector<MotorDiagnostics> motors;
+};
+
+/**
+ * @brief 紧凑的电机状态记录，批量分发的基本单元
+ * 接口以序号表示（见 MotorDriverImpl::get_interface_name），避免每条记录携带字符串
+ */
+struct MotorStatusRecord {
+    uint16_t interface_index{0};
+    uint32_t motor_id{0};
+    std::chrono::steady_clock::time_point stamp;    // 接收时刻
+    Motor_Status status{};
+};
+
+// 连续状态记录的只读视图（C++17 下代替 std::span），仅在回调期间有效
+class MotorStatusSpan {
+public:
+    MotorStatusSpan() = default;
+    MotorStatusSpan(const MotorStatusRecord* data, size_t size) : data_(data), size_(size) {}
+
+    const MotorStatusRecord* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const MotorStatusRecord* begin() const { return data_; }
+    const MotorStatusRecord* end() const { return data_ + size_; }
+    const MotorStatusRecord& operator[](size_t index) const { return data_[index]; }
+
+private:
+    const MotorStatusRecord* data_{nullptr};
+    size_t size_{0};
+};
+
+// 控制钩子输出的单关节 MIT 命令
+struct JointCommand {
+    float position{0.0f};
+    float velocity{0.0f};
+    float effort{0.0f};
+    float kp{0.05f};
+    float kd{0.005f};
+};
+
+// 可写的关节命令视图，仅在钩子调用期间有效
+class JointCommandSpan {
+public:
+    JointCommandSpan() = default;
+    JointCommandSpan(JointCommand* data, size_t size) : data_(data), size_(size) {}
+
+    JointCommand* data() const { return data_; }
+    size_t size() const { return size_; }
+    JointCommand* begin() const { return data_; }
+    JointCommand* end() const { return data_ + size_; }
+    JointCommand& operator[](size_t index) const { return data_[index]; }
+
+private:
+    JointCommand* data_{nullptr};
+    size_t size_{0};
+};
+
+/**
+ * @brief 驱动内实时控制钩子
+ * 接口上所有已配置电机在本周期都上报状态后，由解码线程同步调用；
+ * state/command 下标与 set_motor_config 中该接口的电机顺序一致，command 保留上一周期的值。
+ * 返回 true 时驱动立即编码并发送一条批量 MIT 命令（不经过控制队列与命令门控），返回 false 表示本周期不发送。
+ * 钩子不得分配内存或阻塞。
+ */
+using ControlHook = std::function<bool(MotorStatusSpan state, JointCommandSpan command)>;
+
+struct ControlHookConfig {
+    std::chrono::microseconds deadline{200};     // 钩子执行时间预算，超出计为超时
+};
+
+struct ControlHookStats {
+    uint64_t cycles{0};                 // 调用次数
+    uint64_t commands_sent{0};          // 发送的批量命令数
+    uint64_t skipped{0};                // 钩子返回 false 的次数
+    uint64_t overruns{0};               // 执行时间超出 deadline 的次数
+    uint64_t incomplete_cycles{0};      // 有电机未上报即进入下一周期的次数
+    std::chrono::nanoseconds last_exec{0};
+    std::chrono::nanoseconds max_exec{0};
+    std::chrono::nanoseconds total_exec{0};
+};
+
+/**
+ * @brief 批量电机状态观察者接口
+ * 每次接收突发（数据处理线程一次取出的全部数据包；直通模式下为单个数据包）解码出的状态只回调一次，
+ * 是高频场景下的首选路径；单电机观察者、回调和事件由驱动在其上逐条适配。
+ */
+class MotorStatusBatchObserver {
+public:
+    virtual ~MotorStatusBatchObserver() = default;
+    virtual void on_motor_status_batch(MotorStatusSpan records) = 0;
+};
+
 // 电机状态观察者接口
 class MotorStatusObserver {
 public:
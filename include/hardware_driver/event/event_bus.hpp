@@ -12,10 +12,30 @@
 #include <any>
 #include <atomic>
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <type_traits>
 
 namespace hardware_driver {
 namespace event {
 
+// 事件种类，用于过滤订阅的种类掩码
+enum class EventKind : uint8_t {
+    MOTOR_STATUS,
+    MOTOR_BATCH_STATUS,
+    MOTOR_STATUS_RECORDS,
+    MOTOR_FUNCTION_RESULT,
+    MOTOR_PARAMETER_RESULT,
+    BUS_TX_ERROR,
+    OTHER,
+    COUNT
+};
+
+constexpr uint32_t event_kind_bit(EventKind kind) { return 1u << static_cast<uint32_t>(kind); }
+constexpr uint32_t ALL_EVENT_KINDS = (1u << static_cast<uint32_t>(EventKind::COUNT)) - 1;
+constexpr uint32_t NO_MOTOR_ID = UINT32_MAX;
+
 // 通用事件基类
 class Event {
 public:
@@ -26,6 +46,48 @@ public:
     
     // 获取事件主题（可选，用于主题过滤）
     virtual std::string get_topic() const { return ""; }
+
+    // 过滤订阅使用的事件属性：种类、来源接口（无则为 nullptr）、来源电机（无则为 NO_MOTOR_ID）
+    virtual EventKind get_kind() const { return EventKind::OTHER; }
+    virtual const std::string* get_source_interface() const { return nullptr; }
+    virtual uint32_t get_source_motor_id() const { return NO_MOTOR_ID; }
+};
+
+/**
+ * @brief 订阅过滤条件，由事件总线在调用处理器之前判断
+ * 各条件只约束事件带有的属性：没有来源接口的事件不按接口过滤，没有来源电机的事件
+ * （如批量状态）只要接口匹配即投递。
+ */
+struct SubscriptionFilter {
+    static constexpr size_t MAX_MOTOR_ID = 256;
+
+    std::vector<std::string> interfaces;        // 为空表示全部接口
+    std::bitset<MAX_MOTOR_ID> motors;           // 为空表示全部电机；非空时 ID 不小于 MAX_MOTOR_ID 的电机不匹配
+    uint32_t kinds{ALL_EVENT_KINDS};            // event_kind_bit 的组合
+
+    SubscriptionFilter& on_interface(const std::string& interface) {
+        interfaces.push_back(interface);
+        return *this;
+    }
+    SubscriptionFilter& on_motor(uint32_t motor_id) {
+        if (motor_id < MAX_MOTOR_ID) motors.set(motor_id);
+        return *this;
+    }
+    SubscriptionFilter& of_kinds(uint32_t kind_mask) {
+        kinds = kind_mask;
+        return *this;
+    }
+};
+
+// 事件类型声明了 KIND 时，过滤订阅只登记该种类
+template<typename EventType, typename = void>
+struct EventKindMask {
+    static constexpr uint32_t value = ALL_EVENT_KINDS;
+};
+
+template<typename EventType>
+struct EventKindMask<EventType, std::void_t<decltype(EventType::KIND)>> {
+    static constexpr uint32_t value = event_kind_bit(EventType::KIND);
 };
 
 // 事件处理器基类
@@ -87,6 +149,35 @@ public:
         return typed_handler;
     }
     
+    /**
+     * @brief 带过滤条件订阅：总线按预先计算的（接口, 电机）位图和种类位图选出处理器，
+     *        发布一条事件的开销与感兴趣的订阅者数量成正比，不随订阅者总数增长
+     * @note EventType 为 Event 时可以用 filter.kinds 同时订阅多种事件
+     */
+    template<typename EventType>
+    std::shared_ptr<EventHandler> subscribe_filtered(const SubscriptionFilter& filter,
+                        std::function<void(const std::shared_ptr<EventType>&)> handler) {
+        std::lock_guard<std::mutex> lock(filtered_mutex_);
+
+        auto typed_handler = std::make_shared<TypedEventHandler<EventType>>(handler);
+        FilteredHandler entry{filter, std::type_index(typeid(EventType)), typed_handler};
+        entry.filter.kinds &= EventKindMask<EventType>::value;
+        filtered_handlers_.push_back(std::move(entry));
+        add_filtered_route(filtered_handlers_.size() - 1);
+        return typed_handler;
+    }
+
+    void unsubscribe_filtered(const std::shared_ptr<EventHandler>& handler) {
+        std::lock_guard<std::mutex> lock(filtered_mutex_);
+        filtered_handlers_.erase(
+            std::remove_if(filtered_handlers_.begin(), filtered_handlers_.end(),
+                [&handler](const FilteredHandler& entry) {
+                    return entry.handler.lock() == handler;
+                }),
+            filtered_handlers_.end());
+        rebuild_filtered_routes();
+    }
+
     // 取消订阅
     template<typename EventType>
     void unsubscribe(std::shared_ptr<EventHandler> handler) {
@@ -110,6 +201,9 @@ public:
         
         // 按类型分发
         publish_by_type(event);
+
+        // 按过滤条件分发
+        publish_filtered(event);
         
         // 按主题分发
         std::string topic = event->get_topic();
@@ -125,10 +219,36 @@ public:
         publish(event);
     }
     
+    // 是否有按类型或按过滤条件订阅的有效处理器（不含主题订阅），发布方可据此跳过构造事件
+    template<typename EventType>
+    bool has_subscribers() const {
+        {
+            std::lock_guard<std::mutex> lock(handlers_mutex_);
+            auto it = handlers_.find(std::type_index(typeid(EventType)));
+            if (it != handlers_.end() && std::any_of(it->second.begin(), it->second.end(),
+                    [](const std::weak_ptr<EventHandler>& weak_handler) { return !weak_handler.expired(); })) {
+                return true;
+            }
+        }
+        std::lock_guard<std::mutex> lock(filtered_mutex_);
+        const std::type_index type_idx(typeid(EventType));
+        const std::type_index base_idx(typeid(Event));
+        return std::any_of(filtered_handlers_.begin(), filtered_handlers_.end(),
+            [&](const FilteredHandler& entry) {
+                if (entry.handler.expired()) return false;
+                if (entry.type == type_idx) return true;
+                return entry.type == base_idx && (entry.filter.kinds & EventKindMask<EventType>::value) != 0;
+            });
+    }
+
+    // 累计发布数，不加锁读取
+    size_t events_published() const { return events_published_.load(std::memory_order_relaxed); }
+
     // 获取统计信息
     struct Statistics {
         size_t total_handlers = 0;
         size_t total_topic_handlers = 0;
+        size_t total_filtered_handlers = 0;
         size_t events_published = 0;
     };
     
@@ -149,6 +269,11 @@ public:
                 stats.total_topic_handlers += handler_list.size();
             }
         }
+
+        {
+            std::lock_guard<std::mutex> lock(filtered_mutex_);
+            stats.total_filtered_handlers = filtered_handlers_.size();
+        }
         
         stats.events_published = events_published_;
         return stats;
@@ -180,9 +305,112 @@ public:
                     handler_list.end());
             }
         }
+
+        {
+            std::lock_guard<std::mutex> lock(filtered_mutex_);
+            filtered_handlers_.erase(
+                std::remove_if(filtered_handlers_.begin(), filtered_handlers_.end(),
+                    [](const FilteredHandler& entry) { return entry.handler.expired(); }),
+                filtered_handlers_.end());
+            rebuild_filtered_routes();
+        }
     }
     
 private:
+    // 按订阅序号排列的位图，每个 uint64_t 对应 64 个过滤订阅
+    using SubscriberBits = std::vector<uint64_t>;
+
+    struct FilteredHandler {
+        SubscriptionFilter filter;
+        std::type_index type;
+        std::weak_ptr<EventHandler> handler;
+    };
+
+    // 每个接口的路由行：0 ~ MAX_MOTOR_ID-1 按电机号，其后为超出范围的电机和不带电机的事件
+    static constexpr size_t OUT_OF_RANGE_ROW = SubscriptionFilter::MAX_MOTOR_ID;
+    static constexpr size_t NO_MOTOR_ROW = SubscriptionFilter::MAX_MOTOR_ID + 1;
+    static constexpr size_t ROUTE_ROWS = SubscriptionFilter::MAX_MOTOR_ID + 2;
+
+    static void set_bit(SubscriberBits& bits, size_t index) {
+        bits[index / 64] |= uint64_t(1) << (index % 64);
+    }
+
+    // 把第 index 个过滤订阅加入路由位图（调用方持有 filtered_mutex_）
+    void add_filtered_route(size_t index) {
+        const size_t words = index / 64 + 1;
+        auto grow = [words](SubscriberBits& bits) { bits.resize(words, 0); };
+        if (wildcard_rows_.empty()) wildcard_rows_.resize(ROUTE_ROWS);
+        for (auto& bits : kind_bits_) grow(bits);
+        for (auto& row : wildcard_rows_) grow(row);
+        for (auto& [interface, rows] : interface_rows_) {
+            for (auto& row : rows) grow(row);
+        }
+
+        const SubscriptionFilter& filter = filtered_handlers_[index].filter;
+        // 首次被点名的接口从通配行开始，已包含不限接口的订阅
+        for (const auto& interface : filter.interfaces) {
+            interface_rows_.emplace(interface, wildcard_rows_);
+        }
+        for (size_t kind = 0; kind < kind_bits_.size(); ++kind) {
+            if (filter.kinds & (1u << kind)) set_bit(kind_bits_[kind], index);
+        }
+        auto fill = [&](std::vector<SubscriberBits>& rows) {
+            const bool all_motors = filter.motors.none();
+            for (size_t motor = 0; motor < SubscriptionFilter::MAX_MOTOR_ID; ++motor) {
+                if (all_motors || filter.motors.test(motor)) set_bit(rows[motor], index);
+            }
+            if (all_motors) set_bit(rows[OUT_OF_RANGE_ROW], index);
+            set_bit(rows[NO_MOTOR_ROW], index);
+        };
+        if (filter.interfaces.empty()) {
+            fill(wildcard_rows_);
+            for (auto& [interface, rows] : interface_rows_) fill(rows);
+        } else {
+            for (const auto& interface : filter.interfaces) fill(interface_rows_[interface]);
+        }
+    }
+
+    // 取消订阅后订阅序号变化，整体重建
+    void rebuild_filtered_routes() {
+        for (auto& bits : kind_bits_) bits.clear();
+        wildcard_rows_.clear();
+        interface_rows_.clear();
+        for (size_t index = 0; index < filtered_handlers_.size(); ++index) {
+            add_filtered_route(index);
+        }
+    }
+
+    void publish_filtered(const std::shared_ptr<Event>& event) {
+        std::lock_guard<std::mutex> lock(filtered_mutex_);
+        if (filtered_handlers_.empty()) return;
+
+        const SubscriberBits& kind_bits = kind_bits_[static_cast<size_t>(event->get_kind())];
+        const SubscriberBits* route = nullptr;
+        if (const std::string* interface = event->get_source_interface()) {
+            auto it = interface_rows_.find(*interface);
+            const auto& rows = it != interface_rows_.end() ? it->second : wildcard_rows_;
+            const uint32_t motor_id = event->get_source_motor_id();
+            const size_t row = motor_id == NO_MOTOR_ID ? NO_MOTOR_ROW
+                             : motor_id < SubscriptionFilter::MAX_MOTOR_ID ? motor_id : OUT_OF_RANGE_ROW;
+            route = &rows[row];
+        }
+
+        for (size_t word = 0; word < kind_bits.size(); ++word) {
+            uint64_t bits = route ? kind_bits[word] & (*route)[word] : kind_bits[word];
+            while (bits) {
+                const size_t index = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                if (auto handler = filtered_handlers_[index].handler.lock()) {
+                    try {
+                        handler->handle_event(event);
+                    } catch (const std::exception& e) {
+                        // 记录错误但不中断其他处理器
+                    }
+                }
+            }
+        }
+    }
+
     void publish_by_type(const std::shared_ptr<Event>& event) {
         std::lock_guard<std::mutex> lock(handlers_mutex_);
         std::type_index type_idx(typeid(*event));
@@ -227,6 +455,13 @@ private:
     // 按主题存储处理器
     std::unordered_map<std::string, std::vector<std::weak_ptr<EventHandler>>> topic_handlers_;
     mutable std::mutex topic_handlers_mutex_;
+
+    // 过滤订阅及其路由位图
+    std::vector<FilteredHandler> filtered_handlers_;
+    std::array<SubscriberBits, static_cast<size_t>(EventKind::COUNT)> kind_bits_;
+    std::unordered_map<std::string, std::vector<SubscriberBits>> interface_rows_;
+    std::vector<SubscriberBits> wildcard_rows_;                 // 未被任何过滤条件点名的接口
+    mutable std::mutex filtered_mutex_;
     
     // 统计信息
     mutable std::atomic<size_t> events_published_{0};
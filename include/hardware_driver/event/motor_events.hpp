@@ -12,6 +12,8 @@ namespace event {
 // 电机状态更新事件
 class MotorStatusEvent : public Event {
 public:
+    static constexpr EventKind KIND = EventKind::MOTOR_STATUS;
+
     MotorStatusEvent(const std::string& interface, uint32_t motor_id, 
                      const motor_driver::Motor_Status& status)
         : interface_(interface), motor_id_(motor_id), status_(status),
@@ -20,6 +22,10 @@ public:
     std::string get_type_name() const override {
         return "MotorStatusEvent";
     }
+
+    EventKind get_kind() const override { return KIND; }
+    const std::string* get_source_interface() const override { return &interface_; }
+    uint32_t get_source_motor_id() const override { return motor_id_; }
     
     std::string get_topic() const override {
         return "motor." + interface_ + "." + std::to_string(motor_id_) + ".status";
@@ -41,6 +47,8 @@ private:
 // 批量电机状态更新事件 - 一个接口的所有电机
 class MotorBatchStatusEvent : public Event {
 public:
+    static constexpr EventKind KIND = EventKind::MOTOR_BATCH_STATUS;
+
     MotorBatchStatusEvent(const std::string& interface, 
                          const std::map<uint32_t, motor_driver::Motor_Status>& status_all)
         : interface_(interface), status_all_(status_all),
@@ -49,6 +57,9 @@ public:
     std::string get_type_name() const override {
         return "MotorBatchStatusEvent";
     }
+
+    EventKind get_kind() const override { return KIND; }
+    const std::string* get_source_interface() const override { return &interface_; }
     
     std::string get_topic() const override {
         return "motor." + interface_ + ".batch.status";
@@ -65,9 +76,70 @@ private:
     std::chrono::high_resolution_clock::time_point timestamp_;
 };
 
+// 一次接收突发内的全部电机状态记录 - 每个突发只发布一次
+class MotorStatusRecordsEvent : public Event {
+public:
+    static constexpr EventKind KIND = EventKind::MOTOR_STATUS_RECORDS;
+
+    MotorStatusRecordsEvent(std::vector<motor_driver::MotorStatusRecord> records,
+                            std::vector<std::string> interface_names)
+        : records_(std::move(records)), interface_names_(std::move(interface_names)) {}
+
+    std::string get_type_name() const override {
+        return "MotorStatusRecordsEvent";
+    }
+
+    EventKind get_kind() const override { return KIND; }
+
+    // 访问器
+    motor_driver::MotorStatusSpan get_records() const { return {records_.data(), records_.size()}; }
+    const std::string& get_interface_name(uint16_t index) const {
+        static const std::string empty;
+        return index < interface_names_.size() ? interface_names_[index] : empty;
+    }
+
+private:
+    std::vector<motor_driver::MotorStatusRecord> records_;
+    std::vector<std::string> interface_names_;     // 按 interface_index 索引
+};
+
+// 总线发送错误事件：同一接口连续硬错误达到上报阈值时发布
+class BusTxErrorEvent : public Event {
+public:
+    static constexpr EventKind KIND = EventKind::BUS_TX_ERROR;
+
+    BusTxErrorEvent(const std::string& interface, bus::TxStatus status, uint32_t consecutive_errors)
+        : interface_(interface), status_(status), consecutive_errors_(consecutive_errors),
+          timestamp_(std::chrono::high_resolution_clock::now()) {}
+
+    std::string get_type_name() const override {
+        return "BusTxErrorEvent";
+    }
+
+    EventKind get_kind() const override { return KIND; }
+    const std::string* get_source_interface() const override { return &interface_; }
+
+    std::string get_topic() const override {
+        return "bus." + interface_ + ".tx_error";
+    }
+
+    const std::string& get_interface() const { return interface_; }
+    bus::TxStatus get_status() const { return status_; }
+    uint32_t get_consecutive_errors() const { return consecutive_errors_; }
+    std::chrono::high_resolution_clock::time_point get_timestamp() const { return timestamp_; }
+
+private:
+    std::string interface_;
+    bus::TxStatus status_;
+    uint32_t consecutive_errors_;
+    std::chrono::high_resolution_clock::time_point timestamp_;
+};
+
 // 电机函数操作结果事件
 class MotorFunctionResultEvent : public Event {
 public:
+    static constexpr EventKind KIND = EventKind::MOTOR_FUNCTION_RESULT;
+
     MotorFunctionResultEvent(const std::string& interface, uint32_t motor_id,
                             uint8_t op_code, bool success)
         : interface_(interface), motor_id_(motor_id), op_code_(op_code), 
@@ -76,6 +148,10 @@ public:
     std::string get_type_name() const override {
         return "MotorFunctionResultEvent";
     }
+
+    EventKind get_kind() const override { return KIND; }
+    const std::string* get_source_interface() const override { return &interface_; }
+    uint32_t get_source_motor_id() const override { return motor_id_; }
     
     std::string get_topic() const override {
         return "motor." + interface_ + "." + std::to_string(motor_id_) + ".function";
@@ -99,6 +175,8 @@ private:
 // 电机参数操作结果事件
 class MotorParameterResultEvent : public Event {
 public:
+    static constexpr EventKind KIND = EventKind::MOTOR_PARAMETER_RESULT;
+
     MotorParameterResultEvent(const std::string& interface, uint32_t motor_id,
                              uint16_t address, uint8_t data_type, const std::any& data)
         : interface_(interface), motor_id_(motor_id), address_(address), 
@@ -108,6 +186,10 @@ public:
     std::string get_type_name() const override {
         return "MotorParameterResultEvent";
     }
+
+    EventKind get_kind() const override { return KIND; }
+    const std::string* get_source_interface() const override { return &interface_; }
+    uint32_t get_source_motor_id() const override { return motor_id_; }
     
     std::string get_topic() const override {
         return "motor." + interface_ + "." + std::to_string(motor_id_) + ".parameter";
@@ -0,0 +1,82 @@
+#ifndef __HARDWARE_DRIVER_JOINT_BUFFERS_HPP__
+#define __HARDWARE_DRIVER_JOINT_BUFFERS_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hardware_driver {
+namespace motor_driver {
+    class MotorDriverInterface;
+    class MotorFeedbackSlot;
+}
+
+/**
+ * @brief 单个接口的关节状态/命令连续缓冲区
+ *
+ * 缓冲区地址在对象生命周期内不变，Python 绑定等调用方可以直接映射这些内存（零拷贝）。
+ * read() 把各电机的最新反馈一次性写入状态缓冲（无锁读取，不经过回调），
+ * write() 把命令缓冲作为一条批量 MIT 命令发出。两者都不分配内存。
+ * 同一对象不应被多个线程同时 read()/write()。
+ */
+class JointBuffers {
+public:
+    static constexpr size_t kMaxJoints = 6;
+
+    JointBuffers(std::shared_ptr<motor_driver::MotorDriverInterface> motor_driver,
+                 std::string interface, std::vector<uint32_t> motor_ids,
+                 const std::vector<const motor_driver::MotorFeedbackSlot*>& slots);
+
+    const std::string& interface() const { return interface_; }
+    const std::vector<uint32_t>& motor_ids() const { return motor_ids_; }
+    size_t joint_count() const { return joint_count_; }
+
+    // 状态缓冲（由 read() 写入）
+    double* position() { return position_.data(); }
+    double* velocity() { return velocity_.data(); }
+    double* effort() { return effort_.data(); }
+    uint32_t* error_code() { return error_code_.data(); }
+    int64_t* stamp_ns() { return stamp_ns_.data(); }     // 反馈时刻（steady_clock 纳秒），0 表示尚无反馈
+
+    // 命令缓冲（由 write() 读取）
+    double* command_position() { return command_position_.data(); }
+    double* command_velocity() { return command_velocity_.data(); }
+    double* command_effort() { return command_effort_.data(); }
+    double* kp() { return kp_.data(); }
+    double* kd() { return kd_.data(); }
+
+    /**
+     * @brief 读取所有电机的最新反馈
+     * @return 自上次 read() 以来有新反馈（反馈时刻前进）的关节数；没有新反馈的关节保持上一次的值
+     */
+    size_t read();
+
+    // 以命令缓冲发送一条批量 MIT 命令
+    void write();
+
+private:
+    std::shared_ptr<motor_driver::MotorDriverInterface> motor_driver_;
+    std::string interface_;
+    std::vector<uint32_t> motor_ids_;
+    size_t joint_count_{0};
+    std::array<const motor_driver::MotorFeedbackSlot*, kMaxJoints> slots_{};
+
+    std::array<double, kMaxJoints> position_{};
+    std::array<double, kMaxJoints> velocity_{};
+    std::array<double, kMaxJoints> effort_{};
+    std::array<uint32_t, kMaxJoints> error_code_{};
+    std::array<int64_t, kMaxJoints> stamp_ns_{};
+
+    std::array<double, kMaxJoints> command_position_{};
+    std::array<double, kMaxJoints> command_velocity_{};
+    std::array<double, kMaxJoints> command_effort_{};
+    std::array<double, kMaxJoints> kp_{};
+    std::array<double, kMaxJoints> kd_{};
+};
+
+}   // namespace hardware_driver
+
+#endif // __HARDWARE_DRIVER_JOINT_BUFFERS_HPP__
@@ -12,14 +12,23 @@
 #include <map>
 #include <condition_variable>
 #include <functional>
+#include <future>
 
 #include <chrono>
 #include <array>
 #include <shared_mutex>
 #include "hardware_driver/driver/motor_driver_interface.hpp"
+#include "hardware_driver/driver/command_transaction.hpp"
+#include "hardware_driver/driver/motor_config_snapshot.hpp"
+#include "hardware_driver/driver/joint_state_estimator.hpp"
 #include "hardware_driver/driver/gripper_driver_interface.hpp"
 #include "hardware_driver/driver/button_driver_interface.hpp"
 #include "hardware_driver/event/event_bus.hpp"
+#include "hardware_driver/interface/trajectory.hpp"
+#include "hardware_driver/interface/trajectory_blending.hpp"
+#include "hardware_driver/interface/trajectory_validation.hpp"
+#include "hardware_driver/interface/trajectory_tracking.hpp"
+#include "hardware_driver/interface/joint_buffers.hpp"
 
 // 前向声明，避免在头文件中包含实现类
 namespace hardware_driver {
@@ -35,6 +44,9 @@ namespace hardware_driver {
     namespace button_driver {
         class ButtonDriverImpl;
     }
+    namespace trajectory {
+        class TrackingMonitor;
+    }
     namespace bus {
         class BusInterface;  // 前向声明基类
         class CanFdBus;
@@ -65,21 +77,6 @@ namespace hardware_driver {
     //     const std::vector<std::string>& device_sns);
 }
 
-// 轨迹数据结构定义
-// 简化的轨迹点结构（不依赖ROS2消息）
-struct TrajectoryPoint {
-    double time_from_start;
-    std::vector<double> positions;
-    std::vector<double> velocities;
-    std::vector<double> accelerations;
-};
-
-// 简化的轨迹结构（不依赖ROS2消息）
-struct Trajectory {
-    std::vector<std::string> joint_names;
-    std::vector<TrajectoryPoint> points;
-};
-
 // ========== 轨迹执行状态枚举 ==========
 enum class TrajectoryExecutionState {
     IDLE,           // 闲置状态，未执行
@@ -135,6 +132,10 @@ public:
     
     ~RobotHardware();
 
+    // 运行中替换电机配置：原子发布新快照并同步到驱动，已在执行的轨迹继续使用旧快照
+    void set_motor_config(const std::map<std::string, std::vector<uint32_t>>& interface_motor_config);
+    const hardware_driver::motor_driver::MotorConfigSnapshot& get_motor_config() const { return motor_config_.current(); }
+
     // 状态获取通过回调机制实现，不需要主动查询接口
     
     // ========== 电机控制接口 ==========
@@ -273,6 +274,150 @@ public:
      */
     size_t get_active_trajectory_count() const;
 
+    /**
+     * 设置异步轨迹执行的跟踪误差监控（对之后启动的执行生效）
+     * @note 监控每周期比较设定值与电机最新反馈，超限后按配置报告、平滑停下暂停或平滑停下终止
+     */
+    void set_tracking_monitor_config(const hardware_driver::trajectory::TrackingMonitorConfig& config);
+
+    /**
+     * 获取执行任务的跟踪精度报告（各关节最大误差与 RMS 误差）
+     * @return 执行ID不存在、未开启监控或任务尚未结束时返回 false
+     */
+    bool get_tracking_report(const std::string& execution_id, hardware_driver::trajectory::TrackingReport& report);
+
+    // ========== 轨迹校验接口 ==========
+
+    /**
+     * @brief 为接口开启执行前校验
+     * @note 开启后 execute_trajectory / execute_trajectory_async / enqueue_trajectory 会拒绝未通过校验的轨迹
+     */
+    void set_trajectory_validation(const std::string& interface,
+                                   const hardware_driver::trajectory::TrajectoryValidationLimits& limits);
+    void disable_trajectory_validation(const std::string& interface);
+
+    /**
+     * @brief 按接口的限制校验轨迹（关节数取接口的电机数，起点距离相对电机最近上报的位置）
+     * @note 接口未设置限制时只做结构检查
+     */
+    bool validate_trajectory(const std::string& interface, const Trajectory& trajectory,
+                             hardware_driver::trajectory::TrajectoryValidationResult& result) const;
+
+    /**
+     * @brief 接口最近一次执行前校验的结果（用于查看被拒绝的原因）
+     */
+    hardware_driver::trajectory::TrajectoryValidationResult get_last_trajectory_validation(const std::string& interface) const;
+
+    // ========== 轨迹队列接口 ==========
+
+    /**
+     * @brief 设置轨迹队列的衔接参数（窗口、采样周期、提前量）
+     */
+    void set_trajectory_blend_config(const hardware_driver::trajectory::TrajectoryBlendConfig& config);
+
+    /**
+     * @brief 把轨迹加入接口的执行队列
+     * @note 若接口上已有轨迹在执行，新轨迹在当前轨迹结束前的衔接窗口内平滑接入，速度连续、不停顿
+     * @return 接口不存在或轨迹无效时返回 false
+     */
+    bool enqueue_trajectory(const std::string& interface, const Trajectory& trajectory);
+
+    /**
+     * @brief 队列中尚未执行的时长（秒）
+     */
+    double get_trajectory_queue_remaining_time(const std::string& interface) const;
+
+    /**
+     * @brief 等待接口的轨迹队列执行完毕
+     * @param timeout_ms 超时时间（毫秒，0表示无限等待）
+     */
+    bool wait_for_trajectory_queue(const std::string& interface, int timeout_ms = 0);
+
+    /**
+     * @brief 清空接口的轨迹队列，电机保持在最后发送的位置
+     */
+    void clear_trajectory_queue(const std::string& interface);
+
+    // ========== 关节状态估计接口 ==========
+
+    /**
+     * @brief 开启关节状态估计（延迟补偿），默认关闭
+     * @param config alpha-beta-gamma 滤波参数
+     */
+    void enable_state_estimation(const hardware_driver::motor_driver::JointEstimatorConfig& config =
+                                     hardware_driver::motor_driver::JointEstimatorConfig{});
+    void disable_state_estimation();
+
+    /**
+     * @brief 获取单个电机最近一次测量时刻的滤波状态
+     * @return 估计未开启或尚无测量时返回 false
+     */
+    bool get_estimated_joint_state(const std::string& interface, uint32_t motor_id,
+                                   hardware_driver::motor_driver::JointStateEstimate& estimate) const;
+
+    /**
+     * @brief 把接口上所有关节的状态外推到时刻 t（通常是下一次命令发送时刻）
+     * @note 数组下标与调用时电机配置中该接口的电机顺序一致
+     */
+    bool predict_joint_states(const std::string& interface,
+                              std::chrono::steady_clock::time_point t,
+                              std::array<double, 6>& positions,
+                              std::array<double, 6>& velocities) const;
+
+    // ========== 批量读写缓冲接口 ==========
+
+    /**
+     * @brief 为接口创建关节状态/命令缓冲区（批量 read()/write()，供 Python 绑定零拷贝映射）
+     * @note 缓冲区下标与创建时电机配置中该接口的电机顺序一致
+     * @return 接口不存在时返回 nullptr
+     */
+    std::shared_ptr<hardware_driver::JointBuffers> create_joint_buffers(const std::string& interface);
+
+    // ========== 命令门控接口 ==========
+
+    /**
+     * @brief 设置控制命令门控策略
+     * @note 电机上报失能、故障或模式不符时，控制命令按策略拒绝、暂存或自动使能
+     */
+    void set_command_gate_config(const hardware_driver::motor_driver::CommandGateConfig& config);
+    hardware_driver::motor_driver::CommandGateStats get_command_gate_stats() const;
+
+    // ========== 发送错误处理 ==========
+
+    /**
+     * @brief 设置发送背压重试策略（退避间隔、重试次数、按优先级的命令有效期）
+     * @note 发送统计按接口区分；连续硬错误达到阈值时通过回调和 BusTxErrorEvent 上报
+     */
+    void set_tx_retry_config(const hardware_driver::motor_driver::TxRetryConfig& config);
+    std::map<std::string, hardware_driver::motor_driver::TxStats> get_tx_stats() const;
+    void register_tx_error_callback(hardware_driver::motor_driver::TxErrorCallback callback);
+
+    /**
+     * @brief 按总线空口时间节拍控制命令（CAN FD 开启 BRS 后短帧可快于固定控制间隔）
+     */
+    void set_airtime_pacing(bool enable);
+
+    /**
+     * @brief 把驱动诊断数据导出到共享内存，现场用 hwdriver-top 查看
+     * @param shm_name 共享内存名，为空时使用 /hwdriver.<pid>
+     */
+    bool start_diagnostics_export(const std::string& shm_name = "");
+    void stop_diagnostics_export();
+
+    /**
+     * @brief 获取从反馈中跟踪到的电机实际状态（使能、模式、故障码）
+     * @return 尚未收到该电机反馈时返回 false
+     */
+    bool get_motor_runtime_state(const std::string& interface, uint32_t motor_id,
+                                 hardware_driver::motor_driver::MotorRuntimeState& state) const;
+
+    /**
+     * @brief 确认式上电：所有接口的所有电机并行清错、使能，并等待状态反馈确认
+     * @return 每个电机的结果；report.ok() 为 true 表示全部确认
+     */
+    hardware_driver::motor_driver::BringUpReport bring_up_motors(
+        const hardware_driver::motor_driver::BringUpConfig& config = hardware_driver::motor_driver::BringUpConfig{});
+
     // ========== 状态监控控制方法 ==========
 
     // //  轨迹执行接口 
@@ -320,6 +465,37 @@ public:
     void pause_status_monitoring();
     void resume_status_monitoring();
 
+    /**
+     * @brief 添加/移除批量状态观察者（每个接收突发回调一次，适合高频订阅）
+     * @note 记录中的接口序号用 get_interface_name() 转换为接口名
+     */
+    bool add_status_batch_observer(std::shared_ptr<hardware_driver::motor_driver::MotorStatusBatchObserver> observer);
+    void remove_status_batch_observer(std::shared_ptr<hardware_driver::motor_driver::MotorStatusBatchObserver> observer);
+    std::string get_interface_name(uint16_t interface_index) const;
+
+    // 接收处理模式（见 ReceiveMode），对延迟敏感的部署可切换到 RUN_TO_COMPLETION
+    void set_receive_mode(hardware_driver::motor_driver::ReceiveMode mode);
+
+    // ========== 实时控制钩子 ==========
+
+    /**
+     * @brief 在驱动内每个反馈周期运行的控制钩子（阻抗、重力补偿等），命令在同一周期直接发出
+     * @note 钩子在驱动解码线程上执行，不得分配内存或阻塞；执行耗时与超时见 get_control_hook_stats
+     */
+    bool set_control_hook(const std::string& interface, hardware_driver::motor_driver::ControlHook hook,
+                          const hardware_driver::motor_driver::ControlHookConfig& config = hardware_driver::motor_driver::ControlHookConfig{});
+    void clear_control_hook(const std::string& interface);
+    bool get_control_hook_stats(const std::string& interface, hardware_driver::motor_driver::ControlHookStats& stats) const;
+
+    // ========== 命令事务 ==========
+
+    /**
+     * @brief 整体提交一组命令（上电使能、模式切换等），命令按顺序连续发出，不与其他命令交错
+     * @return 全部发送完成后就绪；驱动不支持事务时立即就绪并将全部命令计为失败
+     */
+    std::future<hardware_driver::motor_driver::CommandTransactionResult> submit_command_transaction(
+        const hardware_driver::motor_driver::CommandTransaction& transaction);
+
     // 夹爪驱动设置方法
     void set_gripper_driver(std::shared_ptr<hardware_driver::gripper_driver::GripperDriverInterface> gripper_driver);
 
@@ -352,7 +528,7 @@ private:
     std::shared_ptr<hardware_driver::motor_driver::MotorDriverInterface> motor_driver_;
     std::shared_ptr<hardware_driver::gripper_driver::GripperDriverInterface> gripper_driver_;
     std::shared_ptr<hardware_driver::button_driver::ButtonDriverInterface> button_driver_;  // 按键驱动
-    std::map<std::string, std::vector<uint32_t>> interface_motor_config_;  // 每个接口对应的电机ID列表
+    hardware_driver::motor_driver::MotorConfigPublisher motor_config_;  // 每个接口对应的电机ID列表（原子发布的快照）
 
     // 状态回调函数（传递给motor_driver_impl）
     MotorStatusCallback status_callback_;
@@ -401,6 +577,8 @@ private:
 
         // 结果
         std::string error_message;
+        hardware_driver::trajectory::TrackingReport tracking_report;
+        bool tracking_report_ready{false};
     };
 
     // 执行任务管理
@@ -417,6 +595,46 @@ private:
     std::chrono::milliseconds get_trajectory_total_time(const Trajectory& trajectory) const;
     void cleanup_completed_trajectory_tasks();
 
+    // 跟踪误差监控
+    hardware_driver::trajectory::TrackingMonitorConfig tracking_monitor_config_;
+    mutable std::mutex tracking_monitor_mutex_;
+
+    // 超限后沿轨迹平滑减速停下，返回最后发送的点下标
+    size_t stop_trajectory_smoothly(const std::shared_ptr<TrajectoryExecutionTask>& task,
+                                    const hardware_driver::trajectory::TrackingMonitor& monitor,
+                                    double stop_time, size_t from_index, size_t motor_count);
+
+    // ========== 轨迹校验相关私有成员 ==========
+    std::map<std::string, hardware_driver::trajectory::TrajectoryValidationLimits> trajectory_validation_limits_;
+    std::map<std::string, hardware_driver::trajectory::TrajectoryValidationResult> last_trajectory_validation_;
+    mutable std::mutex trajectory_validation_mutex_;
+
+    // 接口开启了校验时执行校验并记录结果；未开启时直接通过
+    bool check_trajectory_before_execution(const std::string& interface, const Trajectory& trajectory,
+                                           bool check_start_distance = true);
+    bool validate_trajectory(const std::string& interface, const Trajectory& trajectory,
+                             hardware_driver::trajectory::TrajectoryValidationResult& result,
+                             bool check_start_distance) const;
+
+    // ========== 轨迹队列相关私有成员 ==========
+    // 每个接口一条执行流：新入队的轨迹在入队时即与剩余部分衔接合并
+    struct TrajectoryQueue {
+        Trajectory stream;                                   // 合并后的轨迹，时间相对 start_time
+        std::chrono::steady_clock::time_point start_time;
+        size_t next_index{0};                                // 下一个待发送点
+        bool active{false};
+        bool stop{false};
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    std::map<std::string, std::unique_ptr<TrajectoryQueue>> trajectory_queues_;
+    mutable std::mutex trajectory_queues_mutex_;
+    hardware_driver::trajectory::TrajectoryBlendConfig trajectory_blend_config_;
+
+    TrajectoryQueue* get_trajectory_queue(const std::string& interface, bool create);
+    void trajectory_queue_worker(TrajectoryQueue* queue, std::string interface);
+
     // 内部状态聚合方法
     void handle_motor_status_with_aggregation(const std::string& interface, uint32_t motor_id,
                                             const hardware_driver::motor_driver::Motor_Status& status);
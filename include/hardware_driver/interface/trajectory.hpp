@@ -0,0 +1,22 @@
+#ifndef __HARDWARE_DRIVER_TRAJECTORY_HPP__
+#define __HARDWARE_DRIVER_TRAJECTORY_HPP__
+
+#include <string>
+#include <vector>
+
+// 轨迹数据结构定义
+// 简化的轨迹点结构（不依赖ROS2消息）
+struct TrajectoryPoint {
+    double time_from_start;
+    std::vector<double> positions;
+    std::vector<double> velocities;
+    std::vector<double> accelerations;
+};
+
+// 简化的轨迹结构（不依赖ROS2消息）
+struct Trajectory {
+    std::vector<std::string> joint_names;
+    std::vector<TrajectoryPoint> points;
+};
+
+#endif // __HARDWARE_DRIVER_TRAJECTORY_HPP__
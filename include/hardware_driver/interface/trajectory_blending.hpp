@@ -0,0 +1,41 @@
+#ifndef __HARDWARE_DRIVER_TRAJECTORY_BLENDING_HPP__
+#define __HARDWARE_DRIVER_TRAJECTORY_BLENDING_HPP__
+
+#include <cstddef>
+#include <vector>
+#include "hardware_driver/interface/trajectory.hpp"
+
+namespace hardware_driver {
+namespace trajectory {
+
+// 轨迹队列的衔接参数
+struct TrajectoryBlendConfig {
+    double blend_window{0.2};         // 衔接窗口（秒），0 表示首尾直接拼接
+    double sample_period{0.005};      // 衔接段的采样周期（秒）
+    double min_lead_time{0.01};       // 衔接起点距当前执行时刻的最小提前量（秒）
+};
+
+/**
+ * @brief 计算轨迹在时刻 t 的位置/速度/加速度（相邻点线性插值）
+ * @note 轨迹点缺少 velocities/accelerations 时由位置差分得到
+ */
+void sample_trajectory(const Trajectory& trajectory, double t,
+                       std::vector<double>& position, std::vector<double>& velocity, std::vector<double>& acceleration);
+
+/**
+ * @brief 把 second 衔接到 first 之后，两者在衔接窗口内重叠
+ *
+ * second 的起点提前到 first 结束前 blend_window 处，重叠区间用五次 Hermite 曲线替换，
+ * 两端的位置、速度、加速度与原轨迹一致，因此衔接处不停顿也不跳变。
+ * 结果沿用 first 的时间基准；first 在衔接起点之前的点原样保留。
+ *
+ * @param earliest_blend_start 衔接起点不早于该时刻（用于正在执行的轨迹，保证已发送的点不被修改）
+ * @return 合并后的轨迹；窗口不足时退化为首尾拼接
+ */
+Trajectory blend_trajectories(const Trajectory& first, const Trajectory& second,
+                              const TrajectoryBlendConfig& config, double earliest_blend_start = 0.0);
+
+}   // namespace trajectory
+}   // namespace hardware_driver
+
+#endif // __HARDWARE_DRIVER_TRAJECTORY_BLENDING_HPP__
@@ -0,0 +1,92 @@
+#ifndef __HARDWARE_DRIVER_TRAJECTORY_TIME_PARAMETERIZATION_HPP__
+#define __HARDWARE_DRIVER_TRAJECTORY_TIME_PARAMETERIZATION_HPP__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "hardware_driver/interface/trajectory.hpp"
+
+namespace hardware_driver {
+namespace trajectory {
+
+// 每个关节的运动学限制，向量长度需与关节数一致
+struct JointLimits {
+    std::vector<double> max_velocity;       // 必须 > 0
+    std::vector<double> max_acceleration;   // 必须 > 0
+    std::vector<double> max_jerk;           // 可为空；<= 0 表示该关节不限制加加速度
+};
+
+struct TimeParameterizationOptions {
+    double resample_period{0.0};            // > 0 时按固定周期（秒）重采样输出，否则每个路径点输出一个轨迹点
+    size_t max_jerk_iterations{50};         // 加加速度约束的最大收紧迭代次数
+    double jerk_tightening_factor{0.7};     // 每次迭代对超限区间加速度上限的缩放系数
+};
+
+struct TimeParameterizationResult {
+    bool success{false};
+    double duration{0.0};                   // 轨迹总时长（秒）
+    size_t jerk_iterations{0};              // 实际执行的收紧迭代次数
+    bool jerk_satisfied{true};              // 迭代结束后是否满足加加速度约束
+    std::string error_message;
+};
+
+/**
+ * @brief 路径时间参数化：给定关节空间的几何路径，在速度/加速度/加加速度约束下求最短时间的时间律
+ *
+ * 以累计弦长作为路径参数 s，在路径点上离散化，用 TOPP-RA 式的可达集递推求解：
+ * 反向遍历计算每个点可控的 sdot^2 上界，正向遍历以最大可行加速度积分。
+ * 加加速度约束通过对超限区间迭代收紧加速度上限近似满足。
+ * 内部缓冲区在多次调用间复用，适合在线使用。
+ */
+class TrajectoryTimeParameterizer {
+public:
+    explicit TrajectoryTimeParameterizer(const JointLimits& limits,
+                                         const TimeParameterizationOptions& options = TimeParameterizationOptions{});
+
+    void set_limits(const JointLimits& limits) { limits_ = limits; }
+    void set_options(const TimeParameterizationOptions& options) { options_ = options; }
+
+    /**
+     * @brief 对路径做时间参数化
+     * @param path 路径点序列，每个元素为一组关节位置；轨迹从静止开始并在终点静止
+     * @param trajectory 输出轨迹（覆盖 points，保留 joint_names）
+     */
+    TimeParameterizationResult compute(const std::vector<std::vector<double>>& path, Trajectory& trajectory);
+
+    /**
+     * @brief 用已有轨迹的位置序列重新计算 time_from_start / velocities / accelerations
+     */
+    TimeParameterizationResult retime(Trajectory& trajectory);
+
+private:
+    JointLimits limits_;
+    TimeParameterizationOptions options_;
+
+    // 按点连续存放的关节数据（下标 i * dof + j）
+    size_t dof_{0};
+    size_t count_{0};
+    std::vector<double> q_;
+    std::vector<double> dq_;     // dq/ds
+    std::vector<double> ddq_;    // d2q/ds2
+    std::vector<double> ds_;     // 相邻点路径长度
+    std::vector<double> x_cap_;  // 速度约束给出的 sdot^2 上界
+    std::vector<double> acc_scale_;
+    std::vector<double> x_max_;  // 可控集上界
+    std::vector<double> x_;      // 最终 sdot^2
+    std::vector<double> u_;      // 区间内 sddot
+    std::vector<double> t_;      // 各点时刻
+
+    bool validate(const std::vector<std::vector<double>>& path, std::string& error) const;
+    void build_path(const std::vector<std::vector<double>>& path);
+    void compute_velocity_caps();
+    void acceleration_bounds(size_t i, double x, double& u_lo, double& u_hi) const;
+    bool solve_profile(std::string& error);
+    bool enforce_jerk();
+    void write_trajectory(Trajectory& trajectory) const;
+    void resample_trajectory(Trajectory& trajectory) const;
+};
+
+}   // namespace trajectory
+}   // namespace hardware_driver
+
+#endif // __HARDWARE_DRIVER_TRAJECTORY_TIME_PARAMETERIZATION_HPP__
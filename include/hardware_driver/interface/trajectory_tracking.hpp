@@ -0,0 +1,46 @@
+#ifndef __HARDWARE_DRIVER_TRAJECTORY_TRACKING_HPP__
+#define __HARDWARE_DRIVER_TRAJECTORY_TRACKING_HPP__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hardware_driver {
+namespace trajectory {
+
+// 跟踪误差超限后的处理方式
+enum class TrackingErrorAction : uint8_t {
+    REPORT_ONLY = 0,    // 只记录，不影响执行
+    HOLD = 1,           // 平滑减速停下后暂停，可用 resume_trajectory 继续
+    ABORT = 2           // 平滑减速停下后结束执行，状态置为 ERROR
+};
+
+// 轨迹执行中的跟踪误差监控配置
+struct TrackingMonitorConfig {
+    bool enabled{false};
+    std::vector<double> max_error;          // 各关节误差阈值，为空或不足时用 default_max_error
+    double default_max_error{0.2};
+    size_t trip_cycles{3};                  // 连续超限的周期数达到该值才触发，滤除单次抖动
+    size_t setpoint_delay_cycles{0};        // 与 N 个周期前的设定值比较，抵消反馈的固有延迟
+    std::chrono::milliseconds feedback_timeout{50};  // 反馈早于该时长视为过期，不参与比较
+    TrackingErrorAction action{TrackingErrorAction::HOLD};
+    double stop_time{0.2};                  // 减速停止时长（秒）：执行速度线性降到 0
+};
+
+// 一次轨迹执行的跟踪精度报告
+struct TrackingReport {
+    std::vector<double> max_error;          // 各关节最大绝对误差
+    std::vector<double> rms_error;          // 各关节误差均方根
+    size_t samples{0};                      // 参与统计的周期数
+    size_t stale_samples{0};                // 因反馈过期或缺失被跳过的周期数
+    bool tripped{false};                    // 是否触发了超限处理
+    size_t trip_point_index{0};
+    size_t trip_joint_index{0};
+    double trip_error{0.0};
+};
+
+}   // namespace trajectory
+}   // namespace hardware_driver
+
+#endif // __HARDWARE_DRIVER_TRAJECTORY_TRACKING_HPP__
@@ -0,0 +1,113 @@
+#ifndef __HARDWARE_DRIVER_TRAJECTORY_VALIDATION_HPP__
+#define __HARDWARE_DRIVER_TRAJECTORY_VALIDATION_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "hardware_driver/interface/trajectory.hpp"
+
+namespace hardware_driver {
+namespace trajectory {
+
+enum class TrajectoryViolation : uint8_t {
+    NONE = 0,
+    EMPTY,                  // 轨迹没有点
+    DIMENSION_MISMATCH,     // positions/velocities/accelerations 长度与关节数不符
+    NON_FINITE,             // 时间或位置为 NaN/Inf
+    NON_MONOTONIC_TIME,     // time_from_start 为负或未严格递增
+    POSITION_LIMIT,
+    VELOCITY_LIMIT,         // 相邻点位置差分得到的速度超限
+    ACCELERATION_LIMIT,     // 二阶差分得到的加速度超限
+    START_DISTANCE          // 第一个点离当前位置过远
+};
+
+const char* to_string(TrajectoryViolation violation);
+
+// 校验用的关节限制，向量长度需与关节数一致；为空表示不检查该项
+struct TrajectoryValidationLimits {
+    std::vector<double> min_position;
+    std::vector<double> max_position;
+    std::vector<double> max_velocity;
+    std::vector<double> max_acceleration;
+    double max_start_distance{0.0};     // 第一个点与当前位置的最大关节差，<= 0 不检查
+    double tolerance{1e-6};             // 速度/加速度限制的相对容差
+};
+
+struct TrajectoryValidationOptions {
+    size_t parallel_min_points{20000};  // 点数不少于该值时分块多线程校验
+    size_t max_threads{0};              // 0 表示使用 hardware_concurrency
+    size_t max_issues{16};              // 最多记录的问题条数
+};
+
+struct TrajectoryIssue {
+    TrajectoryViolation violation{TrajectoryViolation::NONE};
+    size_t point_index{0};
+    size_t joint_index{0};
+    double value{0.0};                  // 实际值（时间、位置、速度、加速度或距离）
+    double limit{0.0};                  // 被违反的限制
+};
+
+struct TrajectoryValidationResult {
+    bool valid{false};
+    std::vector<TrajectoryIssue> issues;    // 按点序排列，最多 max_issues 条
+    size_t issue_count{0};                  // 发现的问题总数，可能多于 issues.size()
+    bool start_checked{false};              // 是否执行了起点距离检查
+    size_t threads_used{1};
+    double elapsed_us{0.0};
+
+    std::string summary() const;
+};
+
+/**
+ * @brief 轨迹执行前校验
+ *
+ * 先检查结构（维度、有限值、时间单调），结构无误后再用差分检查位置/速度/加速度限制和起点距离。
+ * 位置在内部按关节连续存放，每个关节的检查是对连续数组的归约，便于编译器向量化；
+ * 归约发现超限后才逐点扫描生成诊断。长轨迹按点分块在多个线程上并行校验。
+ * 内部缓冲区在多次调用间复用。
+ */
+class TrajectoryValidator {
+public:
+    explicit TrajectoryValidator(const TrajectoryValidationLimits& limits = TrajectoryValidationLimits{},
+                                 const TrajectoryValidationOptions& options = TrajectoryValidationOptions{});
+
+    void set_limits(const TrajectoryValidationLimits& limits) { limits_ = limits; }
+    void set_options(const TrajectoryValidationOptions& options) { options_ = options; }
+
+    /**
+     * @param expected_dof 期望的关节数，0 表示以第一个点为准
+     * @param current_positions 当前关节位置，为空时跳过起点距离检查
+     */
+    TrajectoryValidationResult validate(const Trajectory& trajectory, size_t expected_dof,
+                                        const std::vector<double>* current_positions = nullptr);
+
+private:
+    struct IssueList {
+        std::vector<TrajectoryIssue> issues;
+        size_t count{0};
+    };
+
+    TrajectoryValidationLimits limits_;
+    TrajectoryValidationOptions options_;
+
+    size_t dof_{0};
+    size_t count_{0};
+    std::vector<double> t_;         // 各点时刻
+    std::vector<double> inv_dt_;    // 1 / (t[i+1] - t[i])
+    std::vector<double> q_;         // 按关节连续存放：q_[j * count_ + i]
+
+    void add_issue(IssueList& list, TrajectoryViolation violation, size_t point, size_t joint,
+                   double value, double limit) const;
+    void check_structure(const Trajectory& trajectory, size_t begin, size_t end, IssueList& list);
+    void check_limits(size_t begin, size_t end, IssueList& list) const;
+    size_t chunk_count() const;
+    template <typename Check>
+    void run_chunks(size_t chunks, std::vector<IssueList>& lists, Check check);
+    void collect(std::vector<IssueList>& lists, TrajectoryValidationResult& result) const;
+};
+
+}   // namespace trajectory
+}   // namespace hardware_driver
+
+#endif // __HARDWARE_DRIVER_TRAJECTORY_VALIDATION_HPP__
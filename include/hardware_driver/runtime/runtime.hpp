@@ -0,0 +1,109 @@
+#ifndef __HARDWARE_DRIVER_RUNTIME_HPP__
+#define __HARDWARE_DRIVER_RUNTIME_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace hardware_driver {
+namespace runtime {
+
+// 运行时线程配置
+struct RuntimeConfig {
+    size_t worker_threads{1};           // 处理线程数（解码、分发等短任务）
+    std::vector<int> worker_cpus;       // 各处理线程绑定的CPU，不足时后续线程不绑定
+    int io_cpu{-1};                     // I/O线程CPU绑定 (-1表示不绑定)
+    int timer_cpu{-1};                  // 定时器线程CPU绑定，控制命令在此线程按间隔发出
+    std::chrono::microseconds timer_spin{50};   // 定时器到期前的忙等待窗口，与控制线程的混合时序一致
+};
+
+/**
+ * @brief 进程内共享的执行器：一个 I/O 线程（epoll）、一个定时器线程和固定数量的处理线程
+ *
+ * 多个总线/驱动实例挂到同一个 Runtime 上时不再各自创建线程，线程数与实例数无关。
+ * 回调都在运行时线程上执行，必须短小且不阻塞。
+ * remove_reader()/cancel_timer() 返回后对应回调保证不再执行（在回调内部调用时除外），
+ * 实例析构前调用它们即可安全释放。
+ */
+class Runtime {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;
+    // 定时器回调返回下次触发时刻；返回 Clock::time_point{} 表示结束
+    using TimerCallback = std::function<Clock::time_point()>;
+
+    explicit Runtime(RuntimeConfig config = RuntimeConfig{});
+    ~Runtime();
+
+    Runtime(const Runtime&) = delete;
+    Runtime& operator=(const Runtime&) = delete;
+
+    // 投递任务到处理线程
+    void post(std::function<void()> task);
+
+    // 注册定时器，first 时刻首次触发
+    TimerId add_timer(Clock::time_point first, TimerCallback callback);
+    void cancel_timer(TimerId id);
+
+    // fd 可读时在 I/O 线程调用 on_readable（电平触发，回调应读空或读到 EAGAIN）
+    bool add_reader(int fd, std::function<void()> on_readable);
+    void remove_reader(int fd);
+
+    // 运行时拥有的线程总数
+    size_t thread_count() const { return workers_.size() + 2; }
+    const RuntimeConfig& config() const { return config_; }
+
+private:
+    void io_loop();
+    void timer_loop();
+    void worker_loop(size_t index);
+    static void pin_current_thread(int cpu);
+
+    RuntimeConfig config_;
+    std::atomic<bool> running_{true};
+
+    // 处理线程池
+    std::deque<std::function<void()>> tasks_;
+    std::mutex tasks_mutex_;
+    std::condition_variable tasks_cv_;
+    std::vector<std::thread> workers_;
+
+    // 定时器：按到期时刻排序
+    struct TimerEntry {
+        std::shared_ptr<TimerCallback> callback;
+        Clock::time_point due;
+    };
+    std::unordered_map<TimerId, TimerEntry> timers_;
+    std::multimap<Clock::time_point, TimerId> timer_queue_;
+    TimerId next_timer_id_{1};
+    TimerId running_timer_{0};                  // 正在执行的定时器，cancel 时等待其结束
+    std::mutex timer_mutex_;
+    std::condition_variable timer_cv_;
+    std::condition_variable timer_done_cv_;
+    std::thread timer_thread_;
+
+    // I/O
+    int epoll_fd_{-1};
+    int wakeup_fd_{-1};                         // eventfd，用于唤醒 epoll_wait 退出
+    std::unordered_map<int, std::shared_ptr<std::function<void()>>> readers_;
+    int running_reader_{-1};
+    std::mutex io_mutex_;
+    std::condition_variable io_done_cv_;
+    std::thread io_thread_;
+    std::thread::id io_thread_id_;              // 由 I/O 线程启动时写入，io_mutex_ 保护
+    std::thread::id timer_thread_id_;           // 由定时器线程启动时写入，timer_mutex_ 保护
+};
+
+}   // namespace runtime
+}   // namespace hardware_driver
+
+#endif // __HARDWARE_DRIVER_RUNTIME_HPP__
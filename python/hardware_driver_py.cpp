@@ -0,0 +1,274 @@
+// Python 绑定：状态/命令缓冲以 NumPy 数组直接映射驱动内存，批量读写和阻塞调用期间释放 GIL
+#include <pybind11/pybind11.h>
+#include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "hardware_driver/interface/robot_hardware.hpp"
+
+namespace py = pybind11;
+
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+// 包装驱动内存，不拷贝；数组持有 owner 的引用，保证缓冲区在数组存活期间有效
+template <typename T>
+py::array_t<T> buffer_view(T* data, size_t size, py::handle owner, bool writable) {
+    py::array_t<T> array({static_cast<py::ssize_t>(size)}, {static_cast<py::ssize_t>(sizeof(T))}, data, owner);
+    if (!writable) {
+        array.attr("setflags")(py::arg("write") = false);
+    }
+    return array;
+}
+
+// times (N,) + positions (N, dof) [+ velocities / accelerations (N, dof)] -> Trajectory
+Trajectory make_trajectory(const DoubleArray& times, const DoubleArray& positions,
+                           const py::object& velocities, const py::object& accelerations) {
+    if (times.ndim() != 1 || positions.ndim() != 2 || positions.shape(0) != times.shape(0)) {
+        throw py::value_error("times must be (N,) and positions must be (N, dof)");
+    }
+    const py::ssize_t count = times.shape(0);
+    const py::ssize_t dof = positions.shape(1);
+
+    auto optional_array = [&](const py::object& object, const char* name) {
+        DoubleArray array;
+        if (!object.is_none()) {
+            array = DoubleArray::ensure(object);
+            if (!array || array.ndim() != 2 || array.shape(0) != count || array.shape(1) != dof) {
+                throw py::value_error(std::string(name) + " must have the same shape as positions");
+            }
+        }
+        return array;
+    };
+    const bool has_velocities = !velocities.is_none();
+    const bool has_accelerations = !accelerations.is_none();
+    DoubleArray vel = optional_array(velocities, "velocities");
+    DoubleArray acc = optional_array(accelerations, "accelerations");
+
+    Trajectory trajectory;
+    trajectory.points.resize(static_cast<size_t>(count));
+    auto t = times.unchecked<1>();
+    auto p = positions.unchecked<2>();
+    for (py::ssize_t i = 0; i < count; ++i) {
+        auto& point = trajectory.points[static_cast<size_t>(i)];
+        point.time_from_start = t(i);
+        point.positions.assign(p.data(i, 0), p.data(i, 0) + dof);
+        if (has_velocities) {
+            auto v = vel.unchecked<2>();
+            point.velocities.assign(v.data(i, 0), v.data(i, 0) + dof);
+        }
+        if (has_accelerations) {
+            auto a = acc.unchecked<2>();
+            point.accelerations.assign(a.data(i, 0), a.data(i, 0) + dof);
+        }
+    }
+    return trajectory;
+}
+
+const char* state_name(TrajectoryExecutionState state) {
+    switch (state) {
+        case TrajectoryExecutionState::IDLE: return "idle";
+        case TrajectoryExecutionState::RUNNING: return "running";
+        case TrajectoryExecutionState::PAUSED: return "paused";
+        case TrajectoryExecutionState::CANCELLED: return "cancelled";
+        case TrajectoryExecutionState::COMPLETED: return "completed";
+        case TrajectoryExecutionState::ERROR: return "error";
+    }
+    return "unknown";
+}
+
+}   // namespace
+
+PYBIND11_MODULE(hardware_driver_py, m) {
+    m.doc() = "hardware_driver Python bindings";
+
+    using hardware_driver::JointBuffers;
+    using hardware_driver::trajectory::TrackingErrorAction;
+    using hardware_driver::trajectory::TrackingMonitorConfig;
+    using hardware_driver::trajectory::TrackingReport;
+
+    // ========== 批量读写缓冲 ==========
+    py::class_<JointBuffers, std::shared_ptr<JointBuffers>>(m, "JointBuffers")
+        .def_property_readonly("interface", &JointBuffers::interface)
+        .def_property_readonly("motor_ids", &JointBuffers::motor_ids)
+        .def_property_readonly("joint_count", &JointBuffers::joint_count)
+        .def_property_readonly("position", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.position(), buffers.joint_count(), self, false);
+        })
+        .def_property_readonly("velocity", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.velocity(), buffers.joint_count(), self, false);
+        })
+        .def_property_readonly("effort", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.effort(), buffers.joint_count(), self, false);
+        })
+        .def_property_readonly("error_code", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.error_code(), buffers.joint_count(), self, false);
+        })
+        .def_property_readonly("stamp_ns", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.stamp_ns(), buffers.joint_count(), self, false);
+        })
+        .def_property_readonly("command_position", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.command_position(), buffers.joint_count(), self, true);
+        })
+        .def_property_readonly("command_velocity", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.command_velocity(), buffers.joint_count(), self, true);
+        })
+        .def_property_readonly("command_effort", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.command_effort(), buffers.joint_count(), self, true);
+        })
+        .def_property_readonly("kp", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.kp(), buffers.joint_count(), self, true);
+        })
+        .def_property_readonly("kd", [](py::object self) {
+            auto& buffers = self.cast<JointBuffers&>();
+            return buffer_view(buffers.kd(), buffers.joint_count(), self, true);
+        })
+        .def("read", &JointBuffers::read, py::call_guard<py::gil_scoped_release>(),
+             "Refresh the state arrays from the latest feedback; returns the number of joints with new feedback since the last read")
+        .def("write", &JointBuffers::write, py::call_guard<py::gil_scoped_release>(),
+             "Send the command arrays as one batched MIT command");
+
+    // ========== 跟踪误差监控 ==========
+    py::enum_<TrackingErrorAction>(m, "TrackingErrorAction")
+        .value("REPORT_ONLY", TrackingErrorAction::REPORT_ONLY)
+        .value("HOLD", TrackingErrorAction::HOLD)
+        .value("ABORT", TrackingErrorAction::ABORT);
+
+    py::class_<TrackingMonitorConfig>(m, "TrackingMonitorConfig")
+        .def(py::init<>())
+        .def_readwrite("enabled", &TrackingMonitorConfig::enabled)
+        .def_readwrite("max_error", &TrackingMonitorConfig::max_error)
+        .def_readwrite("default_max_error", &TrackingMonitorConfig::default_max_error)
+        .def_readwrite("trip_cycles", &TrackingMonitorConfig::trip_cycles)
+        .def_readwrite("setpoint_delay_cycles", &TrackingMonitorConfig::setpoint_delay_cycles)
+        .def_readwrite("feedback_timeout", &TrackingMonitorConfig::feedback_timeout)
+        .def_readwrite("action", &TrackingMonitorConfig::action)
+        .def_readwrite("stop_time", &TrackingMonitorConfig::stop_time);
+
+    py::class_<TrackingReport>(m, "TrackingReport")
+        .def_readonly("max_error", &TrackingReport::max_error)
+        .def_readonly("rms_error", &TrackingReport::rms_error)
+        .def_readonly("samples", &TrackingReport::samples)
+        .def_readonly("stale_samples", &TrackingReport::stale_samples)
+        .def_readonly("tripped", &TrackingReport::tripped)
+        .def_readonly("trip_point_index", &TrackingReport::trip_point_index)
+        .def_readonly("trip_joint_index", &TrackingReport::trip_joint_index)
+        .def_readonly("trip_error", &TrackingReport::trip_error);
+
+    // ========== RobotHardware ==========
+    py::class_<RobotHardware>(m, "RobotHardware")
+        .def(py::init([](const std::map<std::string, std::vector<uint32_t>>& interface_motor_config) {
+                 std::vector<std::string> interfaces;
+                 for (const auto& [interface, motor_ids] : interface_motor_config) {
+                     interfaces.push_back(interface);
+                 }
+                 auto motor_driver = hardware_driver::createCanFdMotorDriver(interfaces);
+                 return std::make_unique<RobotHardware>(motor_driver, interface_motor_config);
+             }),
+             py::arg("interface_motor_config"),
+             "Open the CAN-FD interfaces, e.g. RobotHardware({'can0': [1, 2, 3, 4, 5, 6]})")
+
+        .def("enable_motors", &RobotHardware::enable_motors,
+             py::arg("interface"), py::arg("motor_ids"), py::arg("mode"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("disable_motors", &RobotHardware::disable_motors,
+             py::arg("interface"), py::arg("motor_ids"), py::arg("mode"),
+             py::call_guard<py::gil_scoped_release>())
+
+        .def("create_joint_buffers", &RobotHardware::create_joint_buffers, py::arg("interface"))
+
+        // 轨迹接口：times (N,)，positions (N, dof)，可选 velocities / accelerations
+        .def("execute_trajectory",
+             [](RobotHardware& hw, const std::string& interface, const DoubleArray& times,
+                const DoubleArray& positions, const py::object& velocities, const py::object& accelerations) {
+                 auto trajectory = make_trajectory(times, positions, velocities, accelerations);
+                 py::gil_scoped_release release;
+                 return hw.execute_trajectory(interface, trajectory);
+             },
+             py::arg("interface"), py::arg("times"), py::arg("positions"),
+             py::arg("velocities") = py::none(), py::arg("accelerations") = py::none())
+        .def("execute_trajectory_async",
+             [](RobotHardware& hw, const std::string& interface, const DoubleArray& times,
+                const DoubleArray& positions, const py::object& velocities, const py::object& accelerations,
+                bool show_progress) {
+                 auto trajectory = make_trajectory(times, positions, velocities, accelerations);
+                 py::gil_scoped_release release;
+                 return hw.execute_trajectory_async(interface, trajectory, show_progress);
+             },
+             py::arg("interface"), py::arg("times"), py::arg("positions"),
+             py::arg("velocities") = py::none(), py::arg("accelerations") = py::none(),
+             py::arg("show_progress") = false)
+        .def("enqueue_trajectory",
+             [](RobotHardware& hw, const std::string& interface, const DoubleArray& times,
+                const DoubleArray& positions, const py::object& velocities, const py::object& accelerations) {
+                 auto trajectory = make_trajectory(times, positions, velocities, accelerations);
+                 py::gil_scoped_release release;
+                 return hw.enqueue_trajectory(interface, trajectory);
+             },
+             py::arg("interface"), py::arg("times"), py::arg("positions"),
+             py::arg("velocities") = py::none(), py::arg("accelerations") = py::none())
+        .def("validate_trajectory",
+             [](RobotHardware& hw, const std::string& interface, const DoubleArray& times,
+                const DoubleArray& positions) {
+                 auto trajectory = make_trajectory(times, positions, py::none(), py::none());
+                 hardware_driver::trajectory::TrajectoryValidationResult result;
+                 {
+                     py::gil_scoped_release release;
+                     hw.validate_trajectory(interface, trajectory, result);
+                 }
+                 return py::make_tuple(result.valid, result.summary());
+             },
+             py::arg("interface"), py::arg("times"), py::arg("positions"))
+
+        .def("pause_trajectory", &RobotHardware::pause_trajectory, py::arg("execution_id"))
+        .def("resume_trajectory", &RobotHardware::resume_trajectory, py::arg("execution_id"))
+        .def("cancel_trajectory", &RobotHardware::cancel_trajectory, py::arg("execution_id"))
+        .def("wait_for_completion", &RobotHardware::wait_for_completion,
+             py::arg("execution_id"), py::arg("timeout_ms") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("get_execution_progress",
+             [](RobotHardware& hw, const std::string& execution_id) -> py::object {
+                 TrajectoryExecutionProgress progress{};
+                 if (!hw.get_execution_progress(execution_id, progress)) {
+                     return py::none();
+                 }
+                 py::dict result;
+                 result["state"] = state_name(progress.state);
+                 result["current_point_index"] = progress.current_point_index;
+                 result["total_points"] = progress.total_points;
+                 result["progress_percentage"] = progress.progress_percentage;
+                 result["elapsed_time"] = progress.elapsed_time;
+                 result["estimated_remaining_time"] = progress.estimated_remaining_time;
+                 result["error_message"] = progress.error_message;
+                 return std::move(result);
+             },
+             py::arg("execution_id"))
+
+        .def("wait_for_trajectory_queue", &RobotHardware::wait_for_trajectory_queue,
+             py::arg("interface"), py::arg("timeout_ms") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("clear_trajectory_queue", &RobotHardware::clear_trajectory_queue, py::arg("interface"))
+        .def("get_trajectory_queue_remaining_time", &RobotHardware::get_trajectory_queue_remaining_time,
+             py::arg("interface"))
+
+        .def("set_tracking_monitor_config", &RobotHardware::set_tracking_monitor_config, py::arg("config"))
+        .def("get_tracking_report",
+             [](RobotHardware& hw, const std::string& execution_id) -> py::object {
+                 TrackingReport report;
+                 if (!hw.get_tracking_report(execution_id, report)) {
+                     return py::none();
+                 }
+                 return py::cast(report);
+             },
+             py::arg("execution_id"));
+}
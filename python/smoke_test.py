@@ -0,0 +1,65 @@
+"""hardware_driver_py 冒烟测试：不需要 CAN 硬件，检查模块可导入、缓冲区零拷贝映射和参数校验。
+
+由 ctest（BUILD_TESTS=ON 且 BUILD_PYTHON_BINDINGS=ON）运行，PYTHONPATH 指向构建目录下的 python/。
+"""
+import sys
+
+import numpy as np
+
+import hardware_driver_py as hd
+
+
+def main():
+    # 接口不存在时总线只打印警告，驱动照常创建
+    robot = hd.RobotHardware({"can0": [1, 2, 3, 4, 5, 6]})
+    buffers = robot.create_joint_buffers("can0")
+    assert buffers.joint_count == 6
+    assert list(buffers.motor_ids) == [1, 2, 3, 4, 5, 6]
+
+    # 没有反馈时 read() 不计入任何关节
+    assert buffers.read() == 0
+    assert buffers.position.shape == (6,)
+    assert buffers.stamp_ns.dtype == np.int64
+    assert not buffers.position.flags.writeable
+
+    # 状态数组只读
+    try:
+        buffers.position[0] = 1.0
+    except ValueError:
+        pass
+    else:
+        raise AssertionError("state arrays must be read-only")
+
+    # 命令数组直接映射驱动内存：写入后重新取得的视图能看到同一份数据
+    assert np.allclose(buffers.kp, 0.05)
+    command = buffers.command_position
+    command[:] = np.arange(6) * 0.1
+    assert np.allclose(buffers.command_position, np.arange(6) * 0.1)
+    assert not buffers.command_position.flags.owndata
+    buffers.write()
+
+    # 轨迹数组形状校验
+    try:
+        robot.validate_trajectory("can0", np.zeros(3), np.zeros((2, 6)))
+    except ValueError:
+        pass
+    else:
+        raise AssertionError("mismatched trajectory shapes must raise ValueError")
+
+    times = np.linspace(0.0, 1.0, 11)
+    valid, summary = robot.validate_trajectory("can0", times, np.zeros((11, 6)))
+    assert isinstance(valid, bool) and isinstance(summary, str)
+
+    config = hd.TrackingMonitorConfig()
+    config.enabled = True
+    config.action = hd.TrackingErrorAction.REPORT_ONLY
+    robot.set_tracking_monitor_config(config)
+    assert robot.get_tracking_report("missing") is None
+    assert robot.get_execution_progress("missing") is None
+
+    print("hardware_driver_py smoke test passed")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
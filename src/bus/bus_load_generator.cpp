@@ -0,0 +1,305 @@
+#include "hardware_driver/bus/bus_load_generator.hpp"
+#include "hardware_driver/bus/can_airtime.hpp"
+#include "protocol/motor_protocol.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+
+namespace hardware_driver {
+namespace bus {
+
+namespace {
+
+constexpr double MIN_UTILIZATION = 0.01;
+
+int64_t monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void sleep_until_ns(int64_t deadline_ns) {
+    struct timespec ts;
+    ts.tv_sec = deadline_ns / 1000000000LL;
+    ts.tv_nsec = deadline_ns % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+}
+
+void put_be_float(float value, uint8_t* out) {
+    uint32_t raw;
+    std::memcpy(&raw, &value, sizeof(raw));
+    out[0] = static_cast<uint8_t>(raw >> 24);
+    out[1] = static_cast<uint8_t>(raw >> 16);
+    out[2] = static_cast<uint8_t>(raw >> 8);
+    out[3] = static_cast<uint8_t>(raw);
+}
+
+constexpr struct {
+    LoadFrameKind kind;
+    const char* name;
+} KIND_NAMES[] = {
+    {LoadFrameKind::STATUS_REPLY, "status"},
+    {LoadFrameKind::CONTROL_ALL, "control_all"},
+    {LoadFrameKind::CONTROL, "control"},
+    {LoadFrameKind::FEEDBACK_REQUEST, "feedback_req"},
+    {LoadFrameKind::PARAMETER, "param"},
+    {LoadFrameKind::FOREIGN, "foreign"},
+};
+
+}   // namespace
+
+std::vector<LoadMixEntry> LoadProfile::default_mix() {
+    return {
+        {LoadFrameKind::STATUS_REPLY, 6.0},
+        {LoadFrameKind::CONTROL_ALL, 1.0},
+        {LoadFrameKind::PARAMETER, 0.2},
+        {LoadFrameKind::FOREIGN, 0.5},
+    };
+}
+
+const char* load_frame_kind_name(LoadFrameKind kind) {
+    for (const auto& entry : KIND_NAMES) {
+        if (entry.kind == kind) return entry.name;
+    }
+    return "unknown";
+}
+
+bool parse_load_mix(const std::string& text, std::vector<LoadMixEntry>& mix) {
+    std::vector<LoadMixEntry> parsed;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) continue;
+        const auto colon = item.find(':');
+        const std::string name = item.substr(0, colon);
+        double weight = 1.0;
+        if (colon != std::string::npos) {
+            try {
+                weight = std::stod(item.substr(colon + 1));
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+        if (!(weight > 0.0)) return false;
+        bool found = false;
+        for (const auto& entry : KIND_NAMES) {
+            if (name == entry.name) {
+                parsed.push_back({entry.kind, weight});
+                found = true;
+                break;
+            }
+        }
+        if (!found) return false;
+    }
+    if (parsed.empty()) return false;
+    mix = std::move(parsed);
+    return true;
+}
+
+BusLoadGenerator::BusLoadGenerator(LoadProfile profile, SendFunction send)
+    : profile_(std::move(profile)), send_(std::move(send)), utilization_(MIN_UTILIZATION) {
+    if (profile_.mix.empty()) profile_.mix = LoadProfile::default_mix();
+    current_weight_.assign(profile_.mix.size(), 0.0);
+    next_motor_.assign(profile_.mix.size(), 0);
+    for (const auto& entry : profile_.mix) total_weight_ += std::max(0.0, entry.weight);
+    set_utilization(profile_.utilization);
+}
+
+BusLoadGenerator::~BusLoadGenerator() {
+    stop();
+}
+
+void BusLoadGenerator::set_utilization(double utilization) {
+    utilization_.store(std::clamp(utilization, MIN_UTILIZATION, 1.0));
+}
+
+std::chrono::nanoseconds BusLoadGenerator::frame_airtime(const GenericBusPacket& packet) const {
+    return can_frame_airtime(packet.len, profile_.fd, profile_.brs, profile_.extended || packet.id > 0x7FF,
+                             profile_.nominal_bitrate, profile_.data_bitrate);
+}
+
+GenericBusPacket BusLoadGenerator::next_frame() {
+    // 平滑加权轮询：每轮各项加上权重，取最大者并减去总权重
+    size_t pick = 0;
+    for (size_t i = 0; i < profile_.mix.size(); ++i) {
+        current_weight_[i] += profile_.mix[i].weight;
+        if (current_weight_[i] > current_weight_[pick]) pick = i;
+    }
+    current_weight_[pick] -= total_weight_;
+
+    const LoadFrameKind kind = profile_.mix[pick].kind;
+    const auto& motors = profile_.motor_ids;
+    const size_t counter = next_motor_[pick]++;
+    // 参数帧成对出现（请求、结果），两帧对应同一电机
+    const size_t motor_index = kind == LoadFrameKind::PARAMETER ? counter / 2 : counter;
+    const uint32_t motor_id = motors.empty() ? 1 : motors[motor_index % motors.size()];
+    const uint64_t seq = sequence_++;
+
+    GenericBusPacket packet;
+    packet.interface = profile_.interface;
+    packet.protocol_type = profile_.fd ? BusProtocolType::CAN_FD : BusProtocolType::CAN;
+    packet.data.fill(0);
+
+    switch (kind) {
+        case LoadFrameKind::STATUS_REPLY: {
+            packet.id = 0x300 | motor_id;
+            packet.len = 24;
+            packet.data[0] = 0x17;
+            packet.data[1] = 1;
+            packet.data[2] = static_cast<uint8_t>(motor_protocol::MotorControlMode::MIT_MODE);
+            const float phase = static_cast<float>(seq % 1000) * 0.00628f;
+            put_be_float(std::sin(phase), packet.data.data() + 3);
+            put_be_float(std::cos(phase), packet.data.data() + 7);
+            put_be_float(0.1f, packet.data.data() + 11);
+            packet.data[20] = 48;   // 电压
+            packet.data[22] = 35;   // 温度
+            break;
+        }
+        case LoadFrameKind::CONTROL_ALL: {
+            packet.id = 0x000;
+            std::array<float, 6> values{};
+            values.fill(static_cast<float>(seq % 100) * 0.01f);
+            std::array<float, 6> gains{};
+            gains.fill(0.05f);
+            motor_protocol::pack_control_all_command(packet.data, packet.len, values, values, values, gains, gains);
+            break;
+        }
+        case LoadFrameKind::CONTROL:
+            packet.id = motor_id;
+            motor_protocol::pack_control_command(packet.data, packet.len, 0.5f, 0.1f, 0.0f, 0.05f, 0.01f);
+            break;
+        case LoadFrameKind::FEEDBACK_REQUEST:
+            packet.id = 0x200 | motor_id;
+            motor_protocol::pack_motor_feedback_request(packet.data, packet.len);
+            break;
+        case LoadFrameKind::PARAMETER: {
+            // 读请求与读结果交替，模拟一次完整的参数访问
+            const uint16_t addr = static_cast<uint16_t>(motor_protocol::ParameterEnum::LIMIT_VELOCITY_MAX);
+            if (counter & 1) {
+                packet.id = 0x700 | motor_id;
+                packet.data[0] = 0x08;
+                packet.data[1] = static_cast<uint8_t>(motor_protocol::OperationMethod::READ);
+                packet.data[2] = static_cast<uint8_t>(addr >> 8);
+                packet.data[3] = static_cast<uint8_t>(addr);
+                packet.data[4] = 0x02;
+                put_be_float(10.0f, packet.data.data() + 5);
+                packet.len = 9;
+            } else {
+                packet.id = 0x600 | motor_id;
+                motor_protocol::pack_param_read(packet.data, packet.len, addr);
+            }
+            break;
+        }
+        case LoadFrameKind::FOREIGN: {
+            const auto& ids = profile_.foreign_ids;
+            packet.id = ids.empty() ? 0x7A0 : ids[next_foreign_++ % ids.size()];
+            packet.len = std::min(profile_.foreign_len, profile_.fd ? MAX_BUS_DATA_SIZE : size_t(8));
+            for (size_t i = 0; i < packet.len; ++i) packet.data[i] = static_cast<uint8_t>(seq >> (8 * (i % 8)));
+            break;
+        }
+    }
+    return packet;
+}
+
+double BusLoadGenerator::planned_frame_rate() const {
+    // 用一个完整的轮询周期估算平均空口时间，不改变生成器状态
+    BusLoadGenerator probe(profile_, nullptr);
+    const size_t frames = std::max<size_t>(64, static_cast<size_t>(std::ceil(total_weight_)) * 16);
+    std::chrono::nanoseconds total{0};
+    for (size_t i = 0; i < frames; ++i) total += probe.frame_airtime(probe.next_frame());
+    if (total.count() == 0) return 0.0;
+    return utilization_.load() * static_cast<double>(frames) / (total.count() / 1e9);
+}
+
+bool BusLoadGenerator::start() {
+    if (running_.load()) return false;
+    if (!send_ || total_weight_ <= 0.0 || profile_.nominal_bitrate == 0) {
+        std::cerr << "[BusLoadGenerator] Invalid load profile" << std::endl;
+        return false;
+    }
+    frames_sent_ = 0;
+    send_failures_ = 0;
+    schedule_resets_ = 0;
+    airtime_ns_ = 0;
+    late_sum_ns_ = 0;
+    late_max_ns_ = 0;
+    stop_ns_ = 0;
+    start_ns_ = monotonic_ns();
+    running_ = true;
+    thread_ = std::thread(&BusLoadGenerator::run, this);
+    return true;
+}
+
+void BusLoadGenerator::stop() {
+    if (!running_.exchange(false)) return;
+    if (thread_.joinable()) thread_.join();
+    stop_ns_ = monotonic_ns();
+}
+
+LoadStats BusLoadGenerator::get_stats() const {
+    LoadStats stats;
+    const int64_t start = start_ns_.load();
+    if (start == 0) return stats;
+    const int64_t end = stop_ns_.load() ? stop_ns_.load() : monotonic_ns();
+
+    stats.frames_sent = frames_sent_.load();
+    stats.send_failures = send_failures_.load();
+    stats.schedule_resets = schedule_resets_.load();
+    stats.airtime = std::chrono::nanoseconds(airtime_ns_.load());
+    stats.elapsed = std::chrono::nanoseconds(end - start);
+    const uint64_t attempts = stats.frames_sent + stats.send_failures;
+    if (attempts > 0) stats.late_avg = std::chrono::nanoseconds(late_sum_ns_.load() / static_cast<int64_t>(attempts));
+    stats.late_max = std::chrono::nanoseconds(late_max_ns_.load());
+    if (stats.elapsed.count() > 0) {
+        const double seconds = stats.elapsed.count() / 1e9;
+        stats.utilization = (stats.airtime.count() / 1e9) / seconds;
+        stats.frame_rate = stats.frames_sent / seconds;
+    }
+    return stats;
+}
+
+void BusLoadGenerator::run() {
+    const int64_t max_lateness_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(profile_.max_lateness).count();
+    int64_t next_ns = start_ns_.load();
+
+    while (running_.load(std::memory_order_relaxed)) {
+        const GenericBusPacket packet = next_frame();
+        const int64_t airtime_ns = frame_airtime(packet).count();
+
+        int64_t now = monotonic_ns();
+        if (next_ns > now) {
+            sleep_until_ns(next_ns);
+            now = monotonic_ns();
+        }
+        int64_t late = now - next_ns;
+        if (late > max_lateness_ns) {
+            // 长时间被抢占或发送阻塞后不突发补发，从当前时刻重新计划
+            schedule_resets_.fetch_add(1, std::memory_order_relaxed);
+            next_ns = now;
+            late = 0;
+        }
+
+        if (send_(packet)) {
+            frames_sent_.fetch_add(1, std::memory_order_relaxed);
+            airtime_ns_.fetch_add(airtime_ns, std::memory_order_relaxed);
+        } else {
+            send_failures_.fetch_add(1, std::memory_order_relaxed);
+        }
+        late_sum_ns_.fetch_add(late, std::memory_order_relaxed);
+        if (late > late_max_ns_.load(std::memory_order_relaxed)) {
+            late_max_ns_.store(late, std::memory_order_relaxed);
+        }
+
+        next_ns += static_cast<int64_t>(airtime_ns / utilization_.load(std::memory_order_relaxed));
+    }
+}
+
+}   // namespace bus
+}   // namespace hardware_driver
@@ -0,0 +1,555 @@
+#include "bus/can_udp_bus_impl.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <linux/can.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace hardware_driver {
+namespace bus {
+
+namespace {
+    // cannelloni 数据报：version(1) op_code(1) seq_no(1) count(2, 网络字节序)，随后逐帧
+    // can_id(4, 网络字节序) len(1, CAN FD 帧最高位置 1) [flags(1), 仅 CAN FD] data(len)
+    constexpr uint8_t CANNELLONI_VERSION = 2;
+    constexpr size_t CANNELLONI_HEADER_SIZE = 5;
+    constexpr uint8_t CANNELLONI_FD_FLAG = 0x80;
+    constexpr uint8_t OP_DATA = 0;
+    // 扩展操作码：RTT 探测，负载为发送时刻（steady_clock 纳秒，网络字节序），对端原样回送
+    constexpr uint8_t OP_PROBE = 0x80;
+    constexpr uint8_t OP_PROBE_REPLY = 0x81;
+    constexpr size_t PROBE_SIZE = CANNELLONI_HEADER_SIZE + 8;
+    constexpr size_t MAX_ENCODED_FRAME = 4 + 1 + 1 + CANFD_MAX_DLEN;
+
+    int64_t steady_now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void write_u64(uint8_t* out, uint64_t value) {
+        for (int i = 7; i >= 0; --i) {
+            out[i] = static_cast<uint8_t>(value & 0xFF);
+            value >>= 8;
+        }
+    }
+
+    uint64_t read_u64(const uint8_t* in) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) value = (value << 8) | in[i];
+        return value;
+    }
+
+    TxStatus classify_send_error(int err) {
+        switch (err) {
+            case EAGAIN:
+            case ENOBUFS:
+            case EINTR:
+                return TxStatus::BACKPRESSURE;   // socket 发送缓冲区满
+            case EMSGSIZE:
+                return TxStatus::INVALID_FRAME;
+            default:
+                return TxStatus::DEVICE_ERROR;   // ENETUNREACH、EHOSTUNREACH 等
+        }
+    }
+}
+
+CanUdpBus::CanUdpBus(const std::vector<CanUdpEndpoint>& endpoints)
+    : endpoints_(endpoints)
+{
+    for (const auto& endpoint : endpoints_) {
+        interface_names_.push_back(endpoint.interface);
+    }
+    init();
+}
+
+CanUdpBus::~CanUdpBus() {
+    running_ = false;
+    for (auto& [interface, link] : links_) {
+        wake(*link);
+    }
+    for (auto& [interface, link] : links_) {
+        if (link->io_thread.joinable()) {
+            link->io_thread.join();
+        }
+        if (link->sock >= 0) ::close(link->sock);
+        if (link->wake_fd >= 0) ::close(link->wake_fd);
+    }
+}
+
+void CanUdpBus::init() {
+    for (const auto& endpoint : endpoints_) {
+        auto link = std::make_unique<Link>();
+        link->endpoint = endpoint;
+        for (auto& brs : link->brs) brs.store(endpoint.bit_rate_switch, std::memory_order_relaxed);
+        try {
+            open_link(*link);
+        } catch (const std::exception& e) {
+            std::cerr << "[CanUdpBus] Warning: Failed to open tunnel for interface " << endpoint.interface
+                      << ": " << e.what() << std::endl;
+            if (link->sock >= 0) ::close(link->sock);
+            if (link->wake_fd >= 0) ::close(link->wake_fd);
+            continue;   // 不抛出异常，继续处理其他接口
+        }
+        links_[endpoint.interface] = std::move(link);
+    }
+
+    running_ = true;
+    for (auto& [interface, link] : links_) {
+        link->io_thread = std::thread(&CanUdpBus::io_loop, this, std::ref(*link));
+    }
+}
+
+void CanUdpBus::open_link(Link& link) {
+    link.remote.sin_family = AF_INET;
+    link.remote.sin_port = htons(link.endpoint.remote_port);
+    if (inet_pton(AF_INET, link.endpoint.remote_address.c_str(), &link.remote.sin_addr) != 1) {
+        throw std::runtime_error("invalid remote address " + link.endpoint.remote_address);
+    }
+
+    link.sock = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (link.sock < 0) {
+        throw std::runtime_error("failed to create UDP socket");
+    }
+    int reuse = 1;
+    setsockopt(link.sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(link.endpoint.local_port);
+    if (bind(link.sock, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+        throw std::runtime_error("failed to bind UDP port " + std::to_string(link.endpoint.local_port) +
+                                 ": " + std::strerror(errno));
+    }
+
+    link.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (link.wake_fd < 0) {
+        throw std::runtime_error("failed to create eventfd");
+    }
+    link.batch.reserve(DEFAULT_MAX_DATAGRAM);
+    link.next_probe = std::chrono::steady_clock::now();
+}
+
+CanUdpBus::Link* CanUdpBus::find_link(const std::string& interface) const {
+    auto it = links_.find(interface);
+    return it != links_.end() ? it->second.get() : nullptr;
+}
+
+bool CanUdpBus::send(const GenericBusPacket& packet) {
+    switch (try_send(packet)) {
+        case TxStatus::OK:
+            return true;
+        case TxStatus::NO_INTERFACE:
+            throw std::runtime_error("CAN UDP interface " + packet.interface + " not found");
+        case TxStatus::INVALID_FRAME:
+            throw std::runtime_error("CAN message too large (" + std::to_string(packet.len) + " bytes) on " + packet.interface);
+        default:
+            return false;
+    }
+}
+
+TxStatus CanUdpBus::try_send(const GenericBusPacket& packet) {
+    Link* link = find_link(packet.interface);
+    if (!link) {
+        return TxStatus::NO_INTERFACE;
+    }
+    // 帧格式可能被其他线程修改，编码前取一次快照
+    const bool use_fd = link->use_fd.load(std::memory_order_relaxed);
+    const bool use_extended = link->use_extended.load(std::memory_order_relaxed);
+    const size_t cls = static_cast<size_t>(packet.tx_class);
+    if (packet.len > (use_fd ? CANFD_MAX_DLEN : CAN_MAX_DLEN)) {
+        return TxStatus::INVALID_FRAME;
+    }
+
+    // 先在栈上编码，持锁时只做拷贝
+    uint8_t frame[MAX_ENCODED_FRAME];
+    const uint32_t can_id = use_extended ? (packet.id | CAN_EFF_FLAG) : (packet.id & CAN_SFF_MASK);
+    const uint32_t can_id_be = htonl(can_id);
+    std::memcpy(frame, &can_id_be, 4);
+    size_t frame_size = 4;
+    if (use_fd) {
+        const bool brs = cls < TX_CLASS_COUNT && link->brs[cls].load(std::memory_order_relaxed);
+        frame[frame_size++] = static_cast<uint8_t>(packet.len) | CANNELLONI_FD_FLAG;
+        frame[frame_size++] = brs ? CANFD_BRS : 0;   // 远端按此标志决定数据段是否切换波特率
+    } else {
+        frame[frame_size++] = static_cast<uint8_t>(packet.len);
+    }
+    std::memcpy(frame + frame_size, packet.data.data(), packet.len);
+    frame_size += packet.len;
+
+    const auto latency = std::chrono::nanoseconds(batch_latency_ns_.load(std::memory_order_relaxed));
+    const size_t max_datagram = max_datagram_.load(std::memory_order_relaxed);
+    bool start_batch = false;
+    TxStatus status = TxStatus::OK;
+    {
+        std::lock_guard<std::mutex> lock(link->tx_mutex);
+        // 放不下时先发出当前批次
+        if (link->batch_count > 0 && link->batch.size() + frame_size > max_datagram) {
+            status = flush_batch(*link);
+            if (status != TxStatus::OK) return status;
+        }
+        if (link->batch_count == 0) {
+            link->batch.assign(CANNELLONI_HEADER_SIZE, 0);
+            link->batch_deadline = std::chrono::steady_clock::now() + latency;
+            start_batch = true;
+        }
+        const size_t previous_size = link->batch.size();
+        link->batch.insert(link->batch.end(), frame, frame + frame_size);
+        link->batch_count++;
+
+        // 紧急帧和不攒批时立即发出；失败时撤回本帧，由上层按背压重试
+        if (packet.tx_class == TxClass::URGENT || latency.count() == 0) {
+            status = flush_batch(*link);
+            if (status != TxStatus::OK) {
+                link->batch.resize(previous_size);
+                link->batch_count--;
+            }
+            start_batch = link->batch_count > 0;
+        }
+    }
+    if (start_batch) {
+        wake(*link);   // I/O 线程按新批次的截止时间调整等待
+    }
+    return status;
+}
+
+TxStatus CanUdpBus::flush_batch(Link& link) {
+    if (link.batch_count == 0) return TxStatus::OK;
+
+    link.batch[0] = CANNELLONI_VERSION;
+    link.batch[1] = OP_DATA;
+    link.batch[2] = link.tx_seq;
+    link.batch[3] = static_cast<uint8_t>(link.batch_count >> 8);
+    link.batch[4] = static_cast<uint8_t>(link.batch_count & 0xFF);
+
+    ssize_t written = ::sendto(link.sock, link.batch.data(), link.batch.size(), MSG_DONTWAIT,
+                               reinterpret_cast<const sockaddr*>(&link.remote), sizeof(link.remote));
+    if (written != static_cast<ssize_t>(link.batch.size())) {
+        return written < 0 ? classify_send_error(errno) : TxStatus::DEVICE_ERROR;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(link.stats_mutex);
+        link.stats.tx_frames += link.batch_count;
+        link.stats.tx_datagrams++;
+    }
+    link.tx_seq++;
+    link.batch.clear();
+    link.batch_count = 0;
+    return TxStatus::OK;
+}
+
+void CanUdpBus::flush() {
+    for (auto& [interface, link] : links_) {
+        std::lock_guard<std::mutex> lock(link->tx_mutex);
+        flush_batch(*link);
+    }
+}
+
+void CanUdpBus::wake(Link& link) {
+    uint64_t one = 1;
+    ssize_t ignored = ::write(link.wake_fd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void CanUdpBus::io_loop(Link& link) {
+    std::vector<uint8_t> buffer(65536);
+    pollfd fds[2] = {{link.sock, POLLIN, 0}, {link.wake_fd, POLLIN, 0}};
+
+    while (running_) {
+        // 等待到最近的批次截止时间或探测时间，最长 100ms
+        auto now = std::chrono::steady_clock::now();
+        auto wake_at = now + std::chrono::milliseconds(100);
+        const auto probe_interval = std::chrono::milliseconds(probe_interval_ms_.load(std::memory_order_relaxed));
+        if (probe_interval.count() > 0) {
+            wake_at = std::min(wake_at, link.next_probe);
+        }
+        {
+            std::lock_guard<std::mutex> lock(link.tx_mutex);
+            if (link.batch_count > 0) wake_at = std::min(wake_at, link.batch_deadline);
+        }
+        const auto wait_ns = std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(wake_at - now).count());
+        timespec timeout{static_cast<time_t>(wait_ns / 1000000000), static_cast<long>(wait_ns % 1000000000)};
+
+        fds[0].revents = fds[1].revents = 0;
+        if (ppoll(fds, 2, &timeout, nullptr) < 0 && errno != EINTR) {
+            std::cerr << "[CanUdpBus] ppoll failed on " << link.endpoint.interface << ": " << std::strerror(errno) << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (!running_) break;
+        if (fds[1].revents & POLLIN) {
+            uint64_t value;
+            ssize_t ignored = ::read(link.wake_fd, &value, sizeof(value));
+            (void)ignored;
+        }
+        if (fds[0].revents & POLLIN) {
+            drain_socket(link, buffer);
+        }
+
+        now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(link.tx_mutex);
+            if (link.batch_count > 0 && now >= link.batch_deadline) {
+                TxStatus status = flush_batch(link);
+                if (is_transient(status)) {
+                    link.batch_deadline = now + std::chrono::nanoseconds(batch_latency_ns_.load(std::memory_order_relaxed));
+                } else if (status != TxStatus::OK) {
+                    std::cerr << "[CanUdpBus] Dropping " << link.batch_count << " frames on " << link.endpoint.interface
+                              << ": " << to_string(status) << std::endl;
+                    {
+                        std::lock_guard<std::mutex> stats_lock(link.stats_mutex);
+                        link.stats.tx_dropped += link.batch_count;
+                    }
+                    link.batch.clear();
+                    link.batch_count = 0;
+                }
+            }
+        }
+        if (probe_interval.count() > 0 && now >= link.next_probe) {
+            send_probe(link);
+            link.next_probe = now + probe_interval;
+        }
+    }
+}
+
+void CanUdpBus::drain_socket(Link& link, std::vector<uint8_t>& buffer) {
+    while (running_) {
+        sockaddr_in source{};
+        socklen_t source_len = sizeof(source);
+        ssize_t n = ::recvfrom(link.sock, buffer.data(), buffer.size(), MSG_DONTWAIT,
+                               reinterpret_cast<sockaddr*>(&source), &source_len);
+        if (n < 0) {
+            // 发往未监听端口时本地会收到 ICMP 错误，不影响后续收发
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED) break;
+            std::cerr << "[CanUdpBus] recvfrom failed on " << link.endpoint.interface << ": " << std::strerror(errno) << std::endl;
+            break;
+        }
+        handle_datagram(link, buffer.data(), static_cast<size_t>(n), source);
+    }
+}
+
+void CanUdpBus::send_probe(Link& link) {
+    uint8_t probe[PROBE_SIZE] = {CANNELLONI_VERSION, OP_PROBE, link.probe_seq++, 0, 0};
+    write_u64(probe + CANNELLONI_HEADER_SIZE, static_cast<uint64_t>(steady_now_ns()));
+    if (::sendto(link.sock, probe, sizeof(probe), MSG_DONTWAIT,
+                 reinterpret_cast<const sockaddr*>(&link.remote), sizeof(link.remote)) == static_cast<ssize_t>(sizeof(probe))) {
+        std::lock_guard<std::mutex> lock(link.stats_mutex);
+        link.stats.probes_sent++;
+    }
+}
+
+void CanUdpBus::handle_datagram(Link& link, const uint8_t* data, size_t size, const sockaddr_in& source) {
+    const auto received_at = std::chrono::steady_clock::now();
+    if (size < CANNELLONI_HEADER_SIZE || data[0] != CANNELLONI_VERSION) {
+        std::lock_guard<std::mutex> lock(link.stats_mutex);
+        link.stats.rx_malformed++;
+        return;
+    }
+
+    const uint8_t op_code = data[1];
+    if (op_code == OP_PROBE) {
+        if (size < PROBE_SIZE) return;
+        uint8_t reply[PROBE_SIZE];
+        std::memcpy(reply, data, PROBE_SIZE);
+        reply[1] = OP_PROBE_REPLY;
+        ::sendto(link.sock, reply, sizeof(reply), MSG_DONTWAIT,
+                 reinterpret_cast<const sockaddr*>(&source), sizeof(source));
+        return;
+    }
+    if (op_code == OP_PROBE_REPLY) {
+        if (size < PROBE_SIZE) return;
+        const int64_t sent_ns = static_cast<int64_t>(read_u64(data + CANNELLONI_HEADER_SIZE));
+        const std::chrono::nanoseconds rtt(steady_now_ns() - sent_ns);
+        if (rtt.count() < 0) return;
+        std::lock_guard<std::mutex> lock(link.stats_mutex);
+        auto& stats = link.stats;
+        stats.rtt_last = rtt;
+        stats.rtt_max = std::max(stats.rtt_max, rtt);
+        stats.rtt_min = stats.probes_answered == 0 ? rtt : std::min(stats.rtt_min, rtt);
+        stats.rtt_avg = stats.probes_answered == 0 ? rtt : (stats.rtt_avg * 7 + rtt) / 8;
+        stats.probes_answered++;
+        return;
+    }
+    if (op_code != OP_DATA) {
+        return;   // cannelloni 的 ACK/NACK 等，UDP 模式下不使用
+    }
+
+    // 按 8 位序号推算丢包：向前跳跃计为丢失，落后半个序号空间以内视为迟到或重复
+    uint64_t lost = 0;
+    bool out_of_order = false;
+    const uint8_t seq = data[2];
+    if (link.rx_synced) {
+        const uint8_t gap = static_cast<uint8_t>(seq - link.rx_expected_seq);
+        if (gap < 128) {
+            lost = gap;
+            link.rx_expected_seq = static_cast<uint8_t>(seq + 1);
+        } else {
+            out_of_order = true;
+        }
+    } else {
+        link.rx_synced = true;
+        link.rx_expected_seq = static_cast<uint8_t>(seq + 1);
+    }
+
+    const uint16_t count = static_cast<uint16_t>((data[3] << 8) | data[4]);
+    std::vector<GenericBusPacket> packets;
+    packets.reserve(count);
+    size_t pos = CANNELLONI_HEADER_SIZE;
+    bool malformed = false;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (pos + 5 > size) { malformed = true; break; }
+        uint32_t can_id_be;
+        std::memcpy(&can_id_be, data + pos, 4);
+        const uint32_t can_id = ntohl(can_id_be);
+        const uint8_t len_byte = data[pos + 4];
+        pos += 5;
+
+        const bool fd = (len_byte & CANNELLONI_FD_FLAG) != 0;
+        const size_t len = len_byte & ~CANNELLONI_FD_FLAG;
+        if (fd) pos++;   // flags
+        if (len > (fd ? CANFD_MAX_DLEN : CAN_MAX_DLEN)) { malformed = true; break; }
+        // 经典 CAN 远程帧不携带数据
+        const size_t payload = (!fd && (can_id & CAN_RTR_FLAG)) ? 0 : len;
+        if (pos + payload > size) { malformed = true; break; }
+
+        GenericBusPacket packet;
+        packet.interface = link.endpoint.interface;
+        packet.id = can_id & (can_id & CAN_EFF_FLAG ? CAN_EFF_MASK : CAN_SFF_MASK);
+        packet.len = len;
+        packet.protocol_type = fd ? BusProtocolType::CAN_FD : BusProtocolType::CAN;
+        packet.timestamp = received_at;
+        packet.data.fill(0);
+        std::memcpy(packet.data.data(), data + pos, payload);
+        pos += payload;
+        packets.push_back(packet);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(link.stats_mutex);
+        link.stats.rx_datagrams++;
+        link.stats.rx_frames += packets.size();
+        link.stats.rx_lost += lost;
+        if (out_of_order) link.stats.rx_out_of_order++;
+        if (malformed) link.stats.rx_malformed++;
+    }
+    for (const auto& packet : packets) {
+        deliver(packet);
+    }
+}
+
+void CanUdpBus::deliver(const GenericBusPacket& packet) {
+    std::unique_lock<std::mutex> lock(rx_mutex_);
+    if (receive_callback_) {
+        auto callback = receive_callback_;
+        lock.unlock();
+        callback(packet);
+        return;
+    }
+    if (rx_queue_.size() >= MAX_RX_QUEUE) {
+        rx_queue_.pop_front();   // 丢弃最旧的帧
+    }
+    rx_queue_.push_back(packet);
+}
+
+bool CanUdpBus::receive(GenericBusPacket& packet) {
+    if (!packet.interface.empty() && !find_link(packet.interface)) {
+        throw std::runtime_error("CAN UDP interface '" + packet.interface + "' not found");
+    }
+    std::lock_guard<std::mutex> lock(rx_mutex_);
+    auto it = std::find_if(rx_queue_.begin(), rx_queue_.end(), [&packet](const GenericBusPacket& queued) {
+        return packet.interface.empty() || queued.interface == packet.interface;
+    });
+    if (it == rx_queue_.end()) {
+        return false;
+    }
+    packet = *it;
+    rx_queue_.erase(it);
+    return true;
+}
+
+void CanUdpBus::async_receive(const std::function<void(const GenericBusPacket&)>& callback) {
+    std::lock_guard<std::mutex> lock(rx_mutex_);
+    receive_callback_ = callback;
+}
+
+std::vector<std::string> CanUdpBus::get_interface_names() const {
+    return interface_names_;
+}
+
+void CanUdpBus::set_extended_frame(const std::string& interface, bool use_extended) {
+    Link* link = find_link(interface);
+    if (!link) {
+        throw std::runtime_error("CAN UDP interface " + interface + " not found");
+    }
+    link->use_extended.store(use_extended, std::memory_order_relaxed);
+}
+
+void CanUdpBus::set_fd_mode(const std::string& interface, bool use_fd) {
+    Link* link = find_link(interface);
+    if (!link) {
+        throw std::runtime_error("CAN UDP interface " + interface + " not found");
+    }
+    link->use_fd.store(use_fd, std::memory_order_relaxed);
+}
+
+void CanUdpBus::set_bit_rate_switch(const std::string& interface, bool enable) {
+    for (size_t cls = 0; cls < TX_CLASS_COUNT; ++cls) {
+        set_bit_rate_switch(interface, static_cast<TxClass>(cls), enable);
+    }
+}
+
+void CanUdpBus::set_bit_rate_switch(const std::string& interface, TxClass tx_class, bool enable) {
+    Link* link = find_link(interface);
+    if (!link) {
+        throw std::runtime_error("CAN UDP interface " + interface + " not found");
+    }
+    link->brs[static_cast<size_t>(tx_class)].store(enable, std::memory_order_relaxed);
+}
+
+bool CanUdpBus::get_bit_rate_switch(const std::string& interface, TxClass tx_class) const {
+    Link* link = find_link(interface);
+    return link && link->brs[static_cast<size_t>(tx_class)].load(std::memory_order_relaxed);
+}
+
+void CanUdpBus::set_batch_latency(std::chrono::microseconds latency) {
+    batch_latency_ns_.store(std::chrono::nanoseconds(latency).count(), std::memory_order_relaxed);
+}
+
+void CanUdpBus::set_max_datagram_size(size_t bytes) {
+    // 至少能放下一个完整的 CAN FD 帧
+    max_datagram_.store(std::max(bytes, CANNELLONI_HEADER_SIZE + MAX_ENCODED_FRAME), std::memory_order_relaxed);
+}
+
+void CanUdpBus::set_probe_interval(std::chrono::milliseconds interval) {
+    probe_interval_ms_.store(interval.count(), std::memory_order_relaxed);
+    for (auto& [interface, link] : links_) {
+        wake(*link);
+    }
+}
+
+bool CanUdpBus::get_link_stats(const std::string& interface, CanUdpLinkStats& stats) const {
+    Link* link = find_link(interface);
+    if (!link) return false;
+    std::lock_guard<std::mutex> lock(link->stats_mutex);
+    stats = link->stats;
+    return true;
+}
+
+uint16_t CanUdpBus::get_local_port(const std::string& interface) const {
+    Link* link = find_link(interface);
+    if (!link) return 0;
+    sockaddr_in local{};
+    socklen_t len = sizeof(local);
+    if (getsockname(link->sock, reinterpret_cast<sockaddr*>(&local), &len) < 0) return 0;
+    return ntohs(local.sin_port);
+}
+
+}   // namespace bus
+}   // namespace hardware_driver
@@ -0,0 +1,152 @@
+#ifndef __CAN_UDP_BUS_IMPL_HPP__
+#define __CAN_UDP_BUS_IMPL_HPP__
+
+#include <array>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <chrono>
+#include <netinet/in.h>
+#include "hardware_driver/bus/bus_interface.hpp"
+
+namespace hardware_driver {
+namespace bus {
+
+// 一个逻辑 CAN 接口对应的 UDP 隧道端点
+struct CanUdpEndpoint {
+    std::string interface;          // 本地使用的接口名，如 "can0"，数据包按此名路由
+    std::string remote_address;     // 远端 IPv4 地址
+    uint16_t remote_port{20000};
+    uint16_t local_port{20000};     // 0 表示由系统分配
+    bool bit_rate_switch{false};    // 远端接口配置了数据段波特率时开启，所有发送类别的 FD 帧带 BRS
+};
+
+// 单个隧道的链路统计
+struct CanUdpLinkStats {
+    uint64_t tx_frames{0};
+    uint64_t tx_datagrams{0};
+    uint64_t tx_dropped{0};          // 定时发出批次失败而丢弃的帧
+    uint64_t rx_frames{0};
+    uint64_t rx_datagrams{0};
+    uint64_t rx_lost{0};             // 按序号推算丢失的数据报
+    uint64_t rx_out_of_order{0};     // 迟到或重复的数据报
+    uint64_t rx_malformed{0};
+    uint64_t probes_sent{0};
+    uint64_t probes_answered{0};
+    std::chrono::nanoseconds rtt_last{0};
+    std::chrono::nanoseconds rtt_min{0};
+    std::chrono::nanoseconds rtt_max{0};
+    std::chrono::nanoseconds rtt_avg{0};   // 指数滑动平均
+};
+
+/**
+ * @brief CAN FD over UDP 总线，数据报格式与 cannelloni 兼容
+ *
+ * 每个接口一个 UDP socket 和一个 I/O 线程。发送的帧先放入当前批次，批次在以下任一条件满足时作为一个
+ * 数据报发出：首帧等待超过 batch_latency、下一帧放不下、或是 URGENT 类别的帧。
+ * 接收端按 cannelloni 序号统计丢包；RTT 通过扩展操作码的探测包测量，标准 cannelloni 对端会忽略探测包，
+ * 此时 RTT 保持为 0。
+ */
+class CanUdpBus : public BusInterface {
+public:
+    static constexpr size_t DEFAULT_MAX_DATAGRAM = 1472;   // 1500 MTU - IP/UDP 头
+    static constexpr std::chrono::microseconds DEFAULT_BATCH_LATENCY{50};
+    static constexpr std::chrono::milliseconds DEFAULT_PROBE_INTERVAL{100};
+    static constexpr size_t MAX_RX_QUEUE = 1024;           // 未注册回调时缓存的接收帧上限
+
+    explicit CanUdpBus(const std::vector<CanUdpEndpoint>& endpoints);
+    ~CanUdpBus();
+
+    void init() override;
+    bool send(const GenericBusPacket& packet) override;
+    TxStatus try_send(const GenericBusPacket& packet) override;
+    bool receive(GenericBusPacket& packet) override;
+    void async_receive(const std::function<void(const GenericBusPacket&)>& callback) override;
+
+    std::vector<std::string> get_interface_names() const override;
+
+    void set_extended_frame(const std::string& interface, bool use_extended);
+    void set_fd_mode(const std::string& interface, bool use_fd);
+
+    // 按发送类别设置 FD 帧的 BRS 标志，与 CanFdBus 相同；远端的数据段波特率无法在本地验证，由调用方保证
+    void set_bit_rate_switch(const std::string& interface, bool enable);
+    void set_bit_rate_switch(const std::string& interface, TxClass tx_class, bool enable);
+    bool get_bit_rate_switch(const std::string& interface, TxClass tx_class) const;
+
+    // 批次首帧最多等待的时间，0 表示不攒批、每帧单独发送
+    void set_batch_latency(std::chrono::microseconds latency);
+    // 单个数据报的最大字节数（含头部）
+    void set_max_datagram_size(size_t bytes);
+    // RTT 探测间隔，0 表示不探测
+    void set_probe_interval(std::chrono::milliseconds interval);
+
+    // 立即发出所有接口上未满的批次
+    void flush();
+
+    bool get_link_stats(const std::string& interface, CanUdpLinkStats& stats) const;
+    // 实际绑定的本地端口（local_port 为 0 时由系统分配）
+    uint16_t get_local_port(const std::string& interface) const;
+
+private:
+    struct Link {
+        CanUdpEndpoint endpoint;
+        int sock{-1};
+        int wake_fd{-1};                          // eventfd：新批次开始或关闭时唤醒 I/O 线程
+        sockaddr_in remote{};
+        std::atomic<bool> use_extended{true};
+        std::atomic<bool> use_fd{true};
+        std::array<std::atomic<bool>, TX_CLASS_COUNT> brs{};   // 按发送类别的 BRS 开关
+
+        std::mutex tx_mutex;
+        std::vector<uint8_t> batch;               // 当前批次（含头部），由 tx_mutex 保护
+        uint16_t batch_count{0};
+        std::chrono::steady_clock::time_point batch_deadline;
+        uint8_t tx_seq{0};
+
+        bool rx_synced{false};                    // 以下由 I/O 线程独占
+        uint8_t rx_expected_seq{0};
+        std::chrono::steady_clock::time_point next_probe;
+        uint8_t probe_seq{0};
+
+        mutable std::mutex stats_mutex;
+        CanUdpLinkStats stats;
+
+        std::thread io_thread;
+    };
+
+    Link* find_link(const std::string& interface) const;
+    void open_link(Link& link);
+    void io_loop(Link& link);
+    void drain_socket(Link& link, std::vector<uint8_t>& buffer);
+    void handle_datagram(Link& link, const uint8_t* data, size_t size, const sockaddr_in& source);
+    void deliver(const GenericBusPacket& packet);
+    TxStatus flush_batch(Link& link);             // 调用方需持有 link.tx_mutex；失败时保留批次
+    void send_probe(Link& link);
+    void wake(Link& link);
+
+private:
+    std::vector<CanUdpEndpoint> endpoints_;
+    std::vector<std::string> interface_names_;
+    std::unordered_map<std::string, std::unique_ptr<Link>> links_;
+
+    std::atomic<int64_t> batch_latency_ns_{std::chrono::nanoseconds(DEFAULT_BATCH_LATENCY).count()};
+    std::atomic<size_t> max_datagram_{DEFAULT_MAX_DATAGRAM};
+    std::atomic<int64_t> probe_interval_ms_{DEFAULT_PROBE_INTERVAL.count()};
+
+    std::mutex rx_mutex_;
+    std::function<void(const GenericBusPacket&)> receive_callback_;
+    std::deque<GenericBusPacket> rx_queue_;       // 未注册回调时缓存，供 receive() 读取
+
+    std::atomic<bool> running_{false};
+};
+
+}   // namespace bus
+}   // namespace hardware_driver
+
+#endif   // __CAN_UDP_BUS_IMPL_HPP__
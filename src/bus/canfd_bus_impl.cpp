@@ -1,4 +1,50 @@
 #include "bus/canfd_bus_impl.hpp"
+#include <cerrno>
+#include <linux/sockios.h>
+#include <linux/rtnetlink.h>
+#include "hardware_driver/bus/can_airtime.hpp"
+#include <ctime>
+
+namespace {
+    // 读取一帧并取出内核接收时间戳（SO_TIMESTAMPNS，CLOCK_REALTIME）
+    ssize_t recv_with_timestamp(int sock, void* frame, size_t frame_size, timespec& kernel_ts) {
+        iovec iov{frame, frame_size};
+        alignas(cmsghdr) char ctrl[CMSG_SPACE(sizeof(timespec))];
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+
+        kernel_ts = timespec{0, 0};
+        ssize_t n = ::recvmsg(sock, &msg, 0);
+        if (n < 0) return n;
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS) {
+                std::memcpy(&kernel_ts, CMSG_DATA(cmsg), sizeof(kernel_ts));
+            }
+        }
+        return n;
+    }
+
+    // 将内核 CLOCK_REALTIME 时间戳换算到 steady_clock（CLOCK_MONOTONIC）
+    // 接收线程轮询存在最多1ms的延迟，内核时间戳才是帧真正到达的时刻
+    std::chrono::steady_clock::time_point to_steady_time(const timespec& kernel_ts) {
+        auto steady_now = std::chrono::steady_clock::now();
+        if (kernel_ts.tv_sec == 0 && kernel_ts.tv_nsec == 0) {
+            return steady_now;
+        }
+        timespec rt_now{};
+        clock_gettime(CLOCK_REALTIME, &rt_now);
+        int64_t age_ns = (static_cast<int64_t>(rt_now.tv_sec) - kernel_ts.tv_sec) * 1000000000LL
+                       + (static_cast<int64_t>(rt_now.tv_nsec) - kernel_ts.tv_nsec);
+        // 系统时间被调整时退化为当前时间
+        if (age_ns < 0 || age_ns > 1000000000LL) {
+            return steady_now;
+        }
+        return steady_now - std::chrono::nanoseconds(age_ns);
+    }
+}
 
 namespace hardware_driver {
 namespace bus {
@@ -19,8 +65,26 @@ CanFdBus::CanFdBus(const std::vector<std::string>& interfaces)
     init();
 }
 
+CanFdBus::CanFdBus(const std::vector<std::string>& interfaces, std::shared_ptr<runtime::Runtime> runtime,
+                   uint32_t arbitration_bitrate, uint32_t data_bitrate)
+    : interface_names_(interfaces), 
+      arbitration_bitrate_(arbitration_bitrate), 
+      data_bitrate_(data_bitrate),
+      runtime_(std::move(runtime))
+{
+    init();
+}
+
 CanFdBus::~CanFdBus() {
     running_ = false;
+
+    // 先从运行时撤下 socket，返回后 I/O 线程不再访问本对象
+    if (runtime_) {
+        for (int fd : runtime_fds_) {
+            runtime_->remove_reader(fd);
+        }
+        runtime_fds_.clear();
+    }
     
     // 等待一小段时间让接收循环自然结束
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
@@ -73,6 +137,8 @@ void CanFdBus::init() {
         // 绑定socket
         try {
             interface_sockets_[interface_name] = bind_can_socket(interface_name);
+            bind_tx_sockets(interface_name);
+            verify_bit_timing(interface_name);
         } catch (const std::exception& e) {
             std::cerr << "[CanFdBus] Warning: Failed to bind socket for interface " << interface_name 
                       << ": " << e.what() << std::endl;
@@ -121,6 +187,12 @@ CanFdBus::SocketPtr CanFdBus::bind_can_socket(const std::string& interface, bool
         throw std::runtime_error("Failed to set CAN FD mode for " + interface);
     }
 
+    // 开启内核接收时间戳，失败时退化为用户态时间戳
+    int timestamp_enable = 1;
+    if (setsockopt(*temp_sock, SOL_SOCKET, SO_TIMESTAMPNS, &timestamp_enable, sizeof(timestamp_enable)) < 0) {
+        std::cerr << "[CanFdBus] Warning: SO_TIMESTAMPNS not supported on " << interface << std::endl;
+    }
+
     // bind to the CAN interface selected
     struct sockaddr_can addr {};
     addr.can_family = AF_CAN;
@@ -131,38 +203,269 @@ CanFdBus::SocketPtr CanFdBus::bind_can_socket(const std::string& interface, bool
     return temp_sock;
 }
 
+namespace {
+    // 各发送类别的 SO_PRIORITY，按默认 priomap 落到 prio/pfifo_fast 的 0/1/2 频带
+    constexpr int TX_SOCKET_PRIORITY[TX_CLASS_COUNT] = {
+        2,   // BULK   -> 频带 2
+        0,   // NORMAL -> 频带 1
+        6    // URGENT -> 频带 0
+    };
+
+    // socket 发送队列中尚未被驱动取走的字节数
+    int socket_outq(int sock) {
+        int bytes = 0;
+        return ioctl(sock, SIOCOUTQ, &bytes) == 0 ? bytes : -1;
+    }
+}
+
+namespace {
+    // 通过 RTM_GETLINK 读取 CAN 接口的位定时和 FD 模式（等价于 ip -details link show）
+    bool query_can_bit_timing(const std::string& interface, CanFdBus::BitTiming& timing) {
+        const unsigned int ifindex = if_nametoindex(interface.c_str());
+        if (ifindex == 0) return false;
+        int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+        if (fd < 0) return false;
+
+        struct {
+            nlmsghdr header;
+            ifinfomsg info;
+        } request{};
+        request.header.nlmsg_len = NLMSG_LENGTH(sizeof(ifinfomsg));
+        request.header.nlmsg_type = RTM_GETLINK;
+        request.header.nlmsg_flags = NLM_F_REQUEST;
+        request.info.ifi_family = AF_UNSPEC;
+        request.info.ifi_index = static_cast<int>(ifindex);
+
+        bool found = false;
+        alignas(nlmsghdr) char buffer[16384];
+        if (::send(fd, &request, request.header.nlmsg_len, 0) >= 0) {
+            int len = static_cast<int>(::recv(fd, buffer, sizeof(buffer), 0));
+            for (auto* msg = reinterpret_cast<nlmsghdr*>(buffer); len > 0 && NLMSG_OK(msg, len); msg = NLMSG_NEXT(msg, len)) {
+                if (msg->nlmsg_type != RTM_NEWLINK) continue;
+                found = true;
+                auto* info = static_cast<ifinfomsg*>(NLMSG_DATA(msg));
+                int attr_len = IFLA_PAYLOAD(msg);
+                for (auto* attr = IFLA_RTA(info); RTA_OK(attr, attr_len); attr = RTA_NEXT(attr, attr_len)) {
+                    if (attr->rta_type != IFLA_LINKINFO) continue;
+                    int link_len = RTA_PAYLOAD(attr);
+                    for (auto* link = static_cast<rtattr*>(RTA_DATA(attr)); RTA_OK(link, link_len); link = RTA_NEXT(link, link_len)) {
+                        if (link->rta_type != IFLA_INFO_DATA) continue;
+                        int can_len = RTA_PAYLOAD(link);
+                        for (auto* can = static_cast<rtattr*>(RTA_DATA(link)); RTA_OK(can, can_len); can = RTA_NEXT(can, can_len)) {
+                            if (can->rta_type == IFLA_CAN_BITTIMING && RTA_PAYLOAD(can) >= sizeof(can_bittiming)) {
+                                timing.nominal_bitrate = static_cast<const can_bittiming*>(RTA_DATA(can))->bitrate;
+                            } else if (can->rta_type == IFLA_CAN_DATA_BITTIMING && RTA_PAYLOAD(can) >= sizeof(can_bittiming)) {
+                                timing.data_bitrate = static_cast<const can_bittiming*>(RTA_DATA(can))->bitrate;
+                            } else if (can->rta_type == IFLA_CAN_CTRLMODE && RTA_PAYLOAD(can) >= sizeof(can_ctrlmode)) {
+                                timing.fd_enabled = (static_cast<const can_ctrlmode*>(RTA_DATA(can))->flags & CAN_CTRLMODE_FD) != 0;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        ::close(fd);
+        return found;
+    }
+}
+
+void CanFdBus::verify_bit_timing(const std::string& interface) {
+    BitTiming timing;
+    timing.verified = query_can_bit_timing(interface, timing);
+    if (timing.nominal_bitrate == 0) {
+        timing.nominal_bitrate = arbitration_bitrate_;   // vcan 等虚拟接口没有位定时，按配置值估算空口时间
+    }
+
+    const bool brs = timing.fd_enabled && timing.data_bitrate > 0;
+    if (!brs) {
+        std::cerr << "[CanFdBus] " << interface << ": no CAN FD data bitrate configured, "
+                  << "bit rate switching disabled" << std::endl;
+    } else if (timing.data_bitrate != data_bitrate_) {
+        std::cerr << "[CanFdBus] " << interface << ": data bitrate is " << timing.data_bitrate
+                  << " (expected " << data_bitrate_ << ")" << std::endl;
+    }
+    bit_timing_[interface] = timing;
+    for (auto& flag : brs_flags_[interface]) flag.store(brs, std::memory_order_relaxed);
+}
+
+bool CanFdBus::get_bit_timing(const std::string& interface, BitTiming& timing) const {
+    auto it = bit_timing_.find(interface);
+    if (it == bit_timing_.end()) return false;
+    timing = it->second;
+    return true;
+}
+
+bool CanFdBus::set_bit_rate_switch(const std::string& interface, bool enable) {
+    bool ok = true;
+    for (size_t cls = 0; cls < TX_CLASS_COUNT; ++cls) {
+        ok = set_bit_rate_switch(interface, static_cast<TxClass>(cls), enable) && ok;
+    }
+    return ok;
+}
+
+bool CanFdBus::set_bit_rate_switch(const std::string& interface, TxClass tx_class, bool enable) {
+    auto it = brs_flags_.find(interface);
+    if (it == brs_flags_.end()) {
+        throw std::runtime_error("CAN interface " + interface + " not found");
+    }
+    const auto& timing = bit_timing_[interface];
+    if (enable && (!timing.fd_enabled || timing.data_bitrate == 0)) {
+        std::cerr << "[CanFdBus] " << interface << ": cannot enable bit rate switching without a data bitrate" << std::endl;
+        return false;
+    }
+    it->second[static_cast<size_t>(tx_class)].store(enable, std::memory_order_relaxed);
+    return true;
+}
+
+bool CanFdBus::get_bit_rate_switch(const std::string& interface, TxClass tx_class) const {
+    auto it = brs_flags_.find(interface);
+    return it != brs_flags_.end() && it->second[static_cast<size_t>(tx_class)].load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds CanFdBus::frame_airtime(const GenericBusPacket& packet) const {
+    auto it = bit_timing_.find(packet.interface);
+    if (it == bit_timing_.end()) return std::chrono::nanoseconds(0);
+    const bool use_canfd = canfd_flags_.count(packet.interface) ? canfd_flags_.at(packet.interface) : true;
+    const bool use_extended = extended_frame_flags_.count(packet.interface) ? extended_frame_flags_.at(packet.interface) : true;
+    return can_frame_airtime(packet.len, use_canfd, get_bit_rate_switch(packet.interface, packet.tx_class), use_extended,
+                             it->second.nominal_bitrate, it->second.data_bitrate);
+}
+
+void CanFdBus::bind_tx_sockets(const std::string& interface) {
+    auto& sockets = tx_sockets_[interface];
+    for (size_t cls = 0; cls < TX_CLASS_COUNT; ++cls) {
+        try {
+            auto sock = bind_can_socket(interface);
+            // 只用于发送：清空过滤器，不接收任何帧
+            if (setsockopt(*sock, SOL_CAN_RAW, CAN_RAW_FILTER, nullptr, 0) < 0) {
+                throw std::runtime_error("Failed to clear CAN filter");
+            }
+            if (setsockopt(*sock, SOL_SOCKET, SO_PRIORITY, &TX_SOCKET_PRIORITY[cls], sizeof(int)) < 0) {
+                throw std::runtime_error("Failed to set SO_PRIORITY");
+            }
+            sockets[cls] = std::make_unique<TxSocket>();
+            sockets[cls]->sock = std::move(sock);
+        } catch (const std::exception& e) {
+            std::cerr << "[CanFdBus] Warning: TX socket class " << cls << " on " << interface
+                      << " unavailable, sending on receive socket: " << e.what() << std::endl;
+            sockets[cls].reset();
+        }
+    }
+}
+
+void CanFdBus::set_tx_inflight_limit(size_t frames) {
+    tx_inflight_limit_.store(frames, std::memory_order_relaxed);
+}
+
+size_t CanFdBus::get_tx_inflight(const std::string& interface) const {
+    auto it = tx_sockets_.find(interface);
+    if (it == tx_sockets_.end()) return 0;
+    size_t frames = 0;
+    for (const auto& tx : it->second) {
+        if (!tx) continue;
+        const int bytes = socket_outq(*tx->sock);
+        const size_t skb_bytes = tx->skb_bytes.load(std::memory_order_relaxed);
+        if (bytes > 0 && skb_bytes > 0) {
+            frames += (static_cast<size_t>(bytes) + skb_bytes - 1) / skb_bytes;
+        }
+    }
+    return frames;
+}
+
 bool CanFdBus::send(const bus::GenericBusPacket& packet) {
+    switch (try_send(packet)) {
+        case TxStatus::OK:
+            return true;
+        case TxStatus::NO_INTERFACE:
+            throw std::runtime_error("CAN interface " + packet.interface + " not found");
+        case TxStatus::INVALID_FRAME:
+            throw std::runtime_error("CAN message too large (" + std::to_string(packet.len) + " bytes) on " + packet.interface);
+        default:
+            return false;
+    }
+}
+
+TxStatus CanFdBus::try_send(const bus::GenericBusPacket& packet) {
     auto it = interface_sockets_.find(packet.interface);
     if (it == interface_sockets_.end()) {
-        throw std::runtime_error("CAN interface " + packet.interface + " not found");
+        return TxStatus::NO_INTERFACE;
     }
 
     int sock = *(it->second);
 
+    // 按类别选择发送 socket；非紧急类别在内核排队帧数超限时按背压处理，由上层退避重试
+    TxSocket* tx = nullptr;
+    int queued_bytes = -1;
+    auto tx_it = tx_sockets_.find(packet.interface);
+    const size_t cls = static_cast<size_t>(packet.tx_class);
+    if (tx_it != tx_sockets_.end() && cls < TX_CLASS_COUNT && tx_it->second[cls]) {
+        tx = tx_it->second[cls].get();
+        sock = *tx->sock;
+        const size_t limit = tx_inflight_limit_.load(std::memory_order_relaxed);
+        const size_t skb_bytes = tx->skb_bytes.load(std::memory_order_relaxed);
+        if (limit > 0 && packet.tx_class != TxClass::URGENT) {
+            queued_bytes = socket_outq(sock);
+            if (skb_bytes > 0 && queued_bytes >= static_cast<int>(limit * skb_bytes)) {
+                return TxStatus::BACKPRESSURE;
+            }
+        }
+    }
+
     const bool use_canfd = canfd_flags_.count(packet.interface) ? canfd_flags_.at(packet.interface) : true;
     const bool use_extended = extended_frame_flags_.count(packet.interface) ? extended_frame_flags_.at(packet.interface) : true;
     const uint32_t id = packet.id;
-    
+
+    ssize_t written = 0;
+    size_t expected = 0;
     if (use_canfd) {
         if (packet.len > CANFD_MAX_DLEN) {
-            throw std::runtime_error("CAN FD message too large (" + std::to_string(packet.len) + " > 64 bytes)");
+            return TxStatus::INVALID_FRAME;
         }
         struct canfd_frame frame {};
         frame.len = static_cast<__u8>(packet.len);
         frame.can_id = use_extended ? (id | CAN_EFF_FLAG) : (id & CAN_SFF_MASK);
         frame.flags = CANFD_FDF;
+        auto brs_it = brs_flags_.find(packet.interface);
+        if (brs_it != brs_flags_.end() && cls < TX_CLASS_COUNT && brs_it->second[cls].load(std::memory_order_relaxed)) {
+            frame.flags |= CANFD_BRS;   // 数据段切换到 data bitrate
+        }
         std::memcpy(frame.data, packet.data.data(), packet.len);
-        return ::send(sock, &frame, sizeof(frame), 0) == sizeof(frame);
+        expected = sizeof(frame);
+        written = ::send(sock, &frame, sizeof(frame), MSG_DONTWAIT);
     } else {
         if (packet.len > CAN_MAX_DLEN) {
-            throw std::runtime_error("Standard CAN message too large (" + std::to_string(packet.len) + " > 8 bytes)");
+            return TxStatus::INVALID_FRAME;
         }
         struct can_frame frame {};
         frame.can_id = use_extended ? (id | CAN_EFF_FLAG) : (id & CAN_SFF_MASK);
         frame.can_dlc = static_cast<__u8>(packet.len);
         std::memcpy(frame.data, packet.data.data(), packet.len);
-        return ::send(sock, &frame, sizeof(frame), 0) == sizeof(frame);
+        expected = sizeof(frame);
+        written = ::send(sock, &frame, sizeof(frame), MSG_DONTWAIT);
+    }
+
+    if (written == static_cast<ssize_t>(expected)) {
+        // 发送前队列为空时，发送后的队列长度即单帧占用，用于把字节数换算成帧数
+        if (tx && queued_bytes == 0 && tx->skb_bytes.load(std::memory_order_relaxed) == 0) {
+            const int after = socket_outq(sock);
+            if (after > 0) tx->skb_bytes.store(static_cast<size_t>(after), std::memory_order_relaxed);
+        }
+        return TxStatus::OK;
     }
+    if (written < 0) {
+        switch (errno) {
+            case ENOBUFS:
+            case EAGAIN:
+            case EINTR:
+                return TxStatus::BACKPRESSURE;   // 发送队列满，控制器来不及发出
+            case EINVAL:
+            case EMSGSIZE:
+                return TxStatus::INVALID_FRAME;
+            default:
+                return TxStatus::DEVICE_ERROR;   // ENETDOWN、ENXIO、ENODEV 等
+        }
+    }
+    return TxStatus::DEVICE_ERROR;
 }
 
 // bool CanFdBus::receive(const std::string& interface, uint32_t& id, std::vector<uint8_t>& data) {
@@ -210,9 +513,10 @@ bool CanFdBus::receive(bus::GenericBusPacket& packet) {
     int sock = *(it->second);
     const bool use_canfd = canfd_flags_.count(packet.interface) ? canfd_flags_.at(packet.interface) : true;
 
+    timespec kernel_ts{};
     if (use_canfd) {
         struct canfd_frame frame {};
-        ssize_t recv_size = ::recv(sock, &frame, sizeof(frame), 0);
+        ssize_t recv_size = recv_with_timestamp(sock, &frame, sizeof(frame), kernel_ts);
         if (recv_size < 0) {
             // 在非阻塞模式下，EAGAIN 或 EWOULDBLOCK 表示没有数据，是正常情况
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
@@ -230,7 +534,7 @@ bool CanFdBus::receive(bus::GenericBusPacket& packet) {
         std::memcpy(packet.data.data(), frame.data, frame.len);
     } else {
         struct can_frame frame {};
-        ssize_t recv_size = ::recv(sock, &frame, sizeof(frame), 0);
+        ssize_t recv_size = recv_with_timestamp(sock, &frame, sizeof(frame), kernel_ts);
         if (recv_size < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
                 return false;
@@ -246,6 +550,7 @@ bool CanFdBus::receive(bus::GenericBusPacket& packet) {
         packet.protocol_type = bus::BusProtocolType::CAN; // **设置协议类型**
         std::memcpy(packet.data.data(), frame.data, frame.can_dlc);
     }
+    packet.timestamp = to_steady_time(kernel_ts);
 
     return true;
 }
@@ -279,6 +584,17 @@ void CanFdBus::set_fd_mode(const std::string& interface, bool use_fd) {
 void CanFdBus::async_receive(const std::function<void(const bus::GenericBusPacket&)>& callback) {
     receive_callback_ = callback;
     running_ = true;
+    if (runtime_) {
+        for (const auto& interface : interface_names_) {
+            auto it = interface_sockets_.find(interface);
+            if (it == interface_sockets_.end() || !it->second) continue;
+            int fd = *it->second;
+            if (runtime_->add_reader(fd, [this, interface] { drain_socket(interface); })) {
+                runtime_fds_.push_back(fd);
+            }
+        }
+        return;
+    }
     // 为每个接口启动一个线程，用于接收数据
     for (const auto& interface : interface_names_) {
         receive_threads_.emplace_back(&CanFdBus::receive_loop, this, interface);
@@ -300,5 +616,18 @@ void CanFdBus::receive_loop(const std::string& interface) {
     }
 }
 
+void CanFdBus::drain_socket(const std::string& interface) {
+    // 每次最多读一批，剩余帧由电平触发的下一轮事件继续处理，避免单个接口独占 I/O 线程
+    constexpr int MAX_FRAMES_PER_WAKE = 64;
+    for (int i = 0; i < MAX_FRAMES_PER_WAKE && running_; ++i) {
+        bus::GenericBusPacket packet;
+        packet.interface = interface;
+        if (!receive(packet)) break;
+        if (receive_callback_) {
+            receive_callback_(packet);
+        }
+    }
+}
+
 }   // namespace bus
 }    // namespace hardware_driver
@@ -0,0 +1,156 @@
+#include "device_clock_aligner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace hardware_driver {
+namespace bus {
+
+DeviceClockAligner::DeviceClockAligner(const Config& config)
+    : config_(config)
+{
+    if (config_.counter_bits == 0 || config_.counter_bits > 32) {
+        config_.counter_bits = 32;
+    }
+    if (config_.tick_period_ns <= 0.0) {
+        config_.tick_period_ns = 1000.0;
+    }
+    if (config_.max_blocks < 2) {
+        config_.max_blocks = 2;
+    }
+}
+
+void DeviceClockAligner::reset() {
+    initialized_ = false;
+    blocks_.clear();
+    current_block_valid_ = false;
+    skew_ = 0.0;
+    offset_s_ = 0.0;
+}
+
+void DeviceClockAligner::initialize(uint64_t raw_ticks, Clock::time_point host_receive) {
+    reset();
+    initialized_ = true;
+    last_raw_ = raw_ticks;
+    unwrapped_ticks_ = raw_ticks;
+    first_ticks_ = raw_ticks;
+    host_origin_ = host_receive;
+    current_block_start_s_ = 0.0;
+}
+
+std::chrono::nanoseconds DeviceClockAligner::offset() const {
+    if (!initialized_) return std::chrono::nanoseconds(0);
+    // 设备计数为 0 时对应的主机时间相对 host_origin_ 的偏移
+    const double first_device_s = static_cast<double>(first_ticks_) * config_.tick_period_ns * 1e-9;
+    const double offset_s = offset_s_ - first_device_s * (1.0 + skew_);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        (host_origin_ + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(offset_s)))
+            .time_since_epoch());
+}
+
+DeviceClockAligner::Clock::time_point DeviceClockAligner::align(uint32_t device_ticks,
+                                                                Clock::time_point host_receive) {
+    const uint64_t mask = config_.counter_bits >= 32
+        ? 0xFFFFFFFFull : ((1ull << config_.counter_bits) - 1);
+    const uint64_t raw = static_cast<uint64_t>(device_ticks) & mask;
+
+    if (!initialized_) {
+        initialize(raw, host_receive);
+    } else {
+        // 计数器回绕展开：按模差值前进，USB 批量导致的轻微乱序（半周期内）视为回退
+        const uint64_t forward = (raw - last_raw_) & mask;
+        if (forward <= mask / 2) {
+            unwrapped_ticks_ += forward;
+        } else {
+            const uint64_t backward = (last_raw_ - raw) & mask;
+            unwrapped_ticks_ = unwrapped_ticks_ >= backward ? unwrapped_ticks_ - backward : 0;
+        }
+        last_raw_ = raw;
+    }
+
+    double device_s = static_cast<double>(static_cast<int64_t>(unwrapped_ticks_ - first_ticks_))
+                      * config_.tick_period_ns * 1e-9;
+    double host_s = std::chrono::duration<double>(host_receive - host_origin_).count();
+    double residual = host_s - device_s;
+
+    // 残差与当前模型差距过大：设备复位或计数器异常，重新建立对齐
+    if (sample_count_ > 0) {
+        const double predicted = offset_s_ + skew_ * device_s;
+        const double threshold = std::chrono::duration<double>(config_.reset_threshold).count();
+        if (std::fabs(residual - predicted) > threshold) {
+            initialize(raw, host_receive);
+            ++reset_count_;
+            device_s = 0.0;
+            host_s = 0.0;
+            residual = 0.0;
+        }
+    }
+    ++sample_count_;
+
+    // 维护当前块的最小残差（延迟最小的样本）
+    const double block_s = std::chrono::duration<double>(config_.block_duration).count();
+    if (current_block_valid_ && device_s - current_block_start_s_ >= block_s) {
+        blocks_.push_back(current_block_);
+        while (blocks_.size() > config_.max_blocks) {
+            blocks_.pop_front();
+        }
+        current_block_valid_ = false;
+        current_block_start_s_ = device_s;
+        refit();
+    }
+    if (!current_block_valid_ || residual < current_block_.residual_s) {
+        current_block_ = BlockMin{device_s, residual};
+        current_block_valid_ = true;
+    }
+
+    // 当前样本低于模型说明偏移估计偏大，立即下调
+    if (blocks_.empty()) {
+        offset_s_ = current_block_.residual_s - skew_ * current_block_.device_s;
+    } else {
+        offset_s_ = std::min(offset_s_, residual - skew_ * device_s);
+    }
+
+    double aligned_s = device_s + offset_s_ + skew_ * device_s;
+    aligned_s = std::min(aligned_s, host_s);
+
+    return host_origin_ + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(aligned_s));
+}
+
+void DeviceClockAligner::refit() {
+    // 对下包络点做最小二乘拟合得到漂移
+    const size_t n = blocks_.size();
+    if (n >= 2) {
+        double mean_d = 0.0, mean_r = 0.0;
+        for (const auto& b : blocks_) {
+            mean_d += b.device_s;
+            mean_r += b.residual_s;
+        }
+        mean_d /= n;
+        mean_r /= n;
+
+        double sxx = 0.0, sxy = 0.0;
+        for (const auto& b : blocks_) {
+            const double dx = b.device_s - mean_d;
+            sxx += dx * dx;
+            sxy += dx * (b.residual_s - mean_r);
+        }
+        if (sxx > 0.0) {
+            skew_ = sxy / sxx;
+        }
+    }
+
+    // 直线下移到所有下包络点之下，保证对齐结果不晚于实际到达
+    double offset = std::numeric_limits<double>::infinity();
+    for (const auto& b : blocks_) {
+        offset = std::min(offset, b.residual_s - skew_ * b.device_s);
+    }
+    if (current_block_valid_) {
+        offset = std::min(offset, current_block_.residual_s - skew_ * current_block_.device_s);
+    }
+    if (std::isfinite(offset)) {
+        offset_s_ = offset;
+    }
+}
+
+}   // namespace bus
+}   // namespace hardware_driver
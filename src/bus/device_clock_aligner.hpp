@@ -0,0 +1,80 @@
+#ifndef __DEVICE_CLOCK_ALIGNER_HPP__
+#define __DEVICE_CLOCK_ALIGNER_HPP__
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+namespace hardware_driver {
+namespace bus {
+
+/**
+ * @brief 设备时间戳到主机 CLOCK_MONOTONIC 的在线对齐
+ *
+ * USB 适配器为每帧打上自己的计数器时间戳，而主机侧的到达时间叠加了 USB 批量传输
+ * 和调度带来的可变延迟。主机到达时间 h 与设备时间 d 满足 h = d + offset + skew*d + delay，
+ * 其中 delay >= 0。对齐器按设备时间分块，取每块中 (h - d) 的最小值（延迟最小的样本），
+ * 对这些下包络点做最小二乘拟合估计漂移，再把直线下移到所有下包络点之下得到偏移。
+ */
+class DeviceClockAligner {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        double tick_period_ns = 1000.0;                          ///< 设备计数器一个 tick 的时长（默认 1us）
+        unsigned counter_bits = 32;                              ///< 计数器位宽，用于回绕展开
+        std::chrono::milliseconds block_duration{100};           ///< 下包络分块时长（设备时间）
+        size_t max_blocks = 64;                                  ///< 参与拟合的最近块数
+        std::chrono::milliseconds reset_threshold{500};          ///< 残差跳变超过该值视为设备复位
+    };
+
+    DeviceClockAligner() : DeviceClockAligner(Config{}) {}
+    explicit DeviceClockAligner(const Config& config);
+
+    /**
+     * @brief 输入一帧的设备时间戳和主机到达时间，返回对齐到主机时钟的时间戳
+     * @note 返回值不会晚于 host_receive
+     */
+    Clock::time_point align(uint32_t device_ticks, Clock::time_point host_receive);
+
+    void reset();
+
+    // 诊断信息
+    double drift_ppm() const { return skew_ * 1e6; }
+    std::chrono::nanoseconds offset() const;            ///< 当前估计的设备零点对应的主机时间偏移
+    uint64_t sample_count() const { return sample_count_; }
+    uint64_t reset_count() const { return reset_count_; }
+
+private:
+    struct BlockMin {
+        double device_s;     // 相对首样本的设备时间
+        double residual_s;   // 主机时间 - 设备时间
+    };
+
+    Config config_;
+
+    bool initialized_ = false;
+    uint64_t last_raw_ = 0;
+    uint64_t unwrapped_ticks_ = 0;
+    uint64_t first_ticks_ = 0;
+    Clock::time_point host_origin_;
+
+    std::deque<BlockMin> blocks_;
+    BlockMin current_block_{0.0, 0.0};
+    double current_block_start_s_ = 0.0;
+    bool current_block_valid_ = false;
+
+    double skew_ = 0.0;       // 主机相对设备的频率偏差
+    double offset_s_ = 0.0;   // 下包络直线截距
+
+    uint64_t sample_count_ = 0;
+    uint64_t reset_count_ = 0;
+
+    void initialize(uint64_t raw_ticks, Clock::time_point host_receive);
+    void refit();
+};
+
+}   // namespace bus
+}   // namespace hardware_driver
+
+#endif   // __DEVICE_CLOCK_ALIGNER_HPP__
@@ -69,6 +69,10 @@ void Usb2CanfdBus::init() {
             }
 
             usb_devices_[interface] = usb_dev;
+            {
+                std::lock_guard<std::mutex> lock(aligner_mutex_);
+                clock_aligners_[interface] = std::make_unique<DeviceClockAligner>(aligner_config_);
+            }
             std::cout << "[Usb2CanfdBus] Initialized interface: " << interface << " with device: " << it->second << std::endl;
         } catch (const std::exception& e) {
             std::cerr << "[Usb2CanfdBus] Exception initializing interface " << interface << ": " << e.what() << std::endl;
@@ -123,11 +127,22 @@ void Usb2CanfdBus::async_receive(const std::function<void(const GenericBusPacket
         auto it = usb_devices_.find(interface);
         if (it != usb_devices_.end()) {
             it->second->setFrameCallback([this, interface](can_value_type& value) {
+                // 尽早记录主机到达时间，作为对齐器的上界
+                auto host_receive = std::chrono::steady_clock::now();
+                auto timestamp = host_receive;
+                {
+                    std::lock_guard<std::mutex> lock(aligner_mutex_);
+                    auto aligner = clock_aligners_.find(interface);
+                    if (aligner != clock_aligners_.end()) {
+                        timestamp = aligner->second->align(value.head.time_stamp, host_receive);
+                    }
+                }
+
                 canfd_frame frame{};
                 frame.can_id = value.head.id;
                 frame.len = 8;
                 std::memcpy(frame.data, value.data, 8);
-                this->on_frame_received(interface, frame);
+                this->on_frame_received(interface, frame, timestamp);
             });
             receive_threads_.emplace_back(&Usb2CanfdBus::receive_loop, this, interface);
         }
@@ -171,7 +186,25 @@ void Usb2CanfdBus::receive_loop(const std::string& interface) {
     }
 }
 
-void Usb2CanfdBus::on_frame_received(const std::string& interface, const canfd_frame& frame) {
+void Usb2CanfdBus::setClockAlignerConfig(const DeviceClockAligner::Config& config) {
+    std::lock_guard<std::mutex> lock(aligner_mutex_);
+    aligner_config_ = config;
+    for (auto& pair : clock_aligners_) {
+        pair.second = std::make_unique<DeviceClockAligner>(aligner_config_);
+    }
+}
+
+double Usb2CanfdBus::getClockDriftPpm(const std::string& interface) const {
+    std::lock_guard<std::mutex> lock(aligner_mutex_);
+    auto it = clock_aligners_.find(interface);
+    if (it == clock_aligners_.end()) {
+        return 0.0;
+    }
+    return it->second->drift_ppm();
+}
+
+void Usb2CanfdBus::on_frame_received(const std::string& interface, const canfd_frame& frame,
+                                     std::chrono::steady_clock::time_point timestamp) {
     if (!receive_callback_) {
         return;
     }
@@ -181,6 +214,7 @@ void Usb2CanfdBus::on_frame_received(const std::string& interface, const canfd_f
     packet.id = frame.can_id;
     packet.len = frame.len;
     packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.timestamp = timestamp;
     std::memcpy(packet.data.data(), frame.data, frame.len);
 
     receive_callback_(packet);
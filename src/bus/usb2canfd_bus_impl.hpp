@@ -13,7 +13,9 @@
 #include <cstring>
 #include <iostream>
 #include <chrono>
+#include <mutex>
 #include "hardware_driver/bus/bus_interface.hpp"
+#include "device_clock_aligner.hpp"
 
 class usb_class;
 
@@ -40,9 +42,14 @@ public:
     std::string getDeviceSerialNumber(const std::string& interface) const;
     bool isDeviceReady(const std::string& interface) const;
 
+    // 设备时间戳对齐
+    void setClockAlignerConfig(const DeviceClockAligner::Config& config);
+    double getClockDriftPpm(const std::string& interface) const;
+
 private:
     void receive_loop(const std::string& interface);
-    void on_frame_received(const std::string& interface, const canfd_frame& frame);
+    void on_frame_received(const std::string& interface, const canfd_frame& frame,
+                           std::chrono::steady_clock::time_point timestamp);
 
 private:
     std::unordered_map<std::string, std::shared_ptr<usb_class>> usb_devices_;
@@ -54,6 +61,11 @@ private:
     std::function<void(const GenericBusPacket&)> receive_callback_;
     std::vector<std::thread> receive_threads_;
     std::atomic<bool> running_{false};
+
+    // 每个设备独立的时钟对齐器，回调在 usb_class 接收线程中执行
+    std::unordered_map<std::string, std::unique_ptr<DeviceClockAligner>> clock_aligners_;
+    DeviceClockAligner::Config aligner_config_;
+    mutable std::mutex aligner_mutex_;
 };
 
 }   // namespace bus
@@ -0,0 +1,127 @@
+#include "hardware_driver/driver/command_transaction.hpp"
+#include "protocol/motor_protocol.hpp"
+
+namespace hardware_driver {
+namespace motor_driver {
+
+namespace {
+
+bus::GenericBusPacket make_packet(const std::string& interface, uint32_t id) {
+    bus::GenericBusPacket packet{};
+    packet.interface = interface;
+    packet.id = id;
+    return packet;
+}
+
+}  // namespace
+
+void CommandTransaction::push(bus::GenericBusPacket&& packet, EntryKind kind, uint32_t motor_id, uint8_t mode) {
+    Entry entry;
+    entry.packet = std::move(packet);
+    entry.kind = kind;
+    entry.motor_id = motor_id;
+    entry.mode = mode;
+    entries_.push_back(std::move(entry));
+}
+
+CommandTransaction& CommandTransaction::enable_motor(const std::string& interface, uint32_t motor_id, uint8_t mode) {
+    auto packet = make_packet(interface, motor_id);
+    if (motor_protocol::pack_enable_command(packet.data, packet.len, mode)) {
+        push(std::move(packet), EntryKind::ENABLE, motor_id, mode);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::disable_motor(const std::string& interface, uint32_t motor_id, uint8_t mode) {
+    auto packet = make_packet(interface, motor_id);
+    if (motor_protocol::pack_disable_command(packet.data, packet.len, mode)) {
+        push(std::move(packet), EntryKind::DISABLE, motor_id, mode);
+    }
+    return *this;
+}
+
+// 控制命令的 kp/kd 换算与 MotorDriverImpl 对应接口保持一致
+CommandTransaction& CommandTransaction::send_position_cmd(const std::string& interface, uint32_t motor_id,
+    float position, float kp, float kd) {
+    auto packet = make_packet(interface, motor_id);
+    if (motor_protocol::pack_control_command(packet.data, packet.len, position, 0.0f, 0.0f, (uint8_t)(1000 * kp), (uint8_t)(1000 * kd))) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::send_velocity_cmd(const std::string& interface, uint32_t motor_id,
+    float velocity, float kp, float kd) {
+    auto packet = make_packet(interface, motor_id);
+    if (motor_protocol::pack_control_command(packet.data, packet.len, 0.0f, velocity, 0.0f, (uint8_t)(1000 * kp), (uint8_t)(1000 * kd))) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::send_effort_cmd(const std::string& interface, uint32_t motor_id,
+    float effort, float kp, float kd) {
+    auto packet = make_packet(interface, motor_id);
+    if (motor_protocol::pack_control_command(packet.data, packet.len, 0.0f, 0.0f, effort, kp, kd)) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::send_mit_cmd(const std::string& interface, uint32_t motor_id,
+    float position, float velocity, float effort, float kp, float kd) {
+    auto packet = make_packet(interface, motor_id);
+    if (motor_protocol::pack_control_command(packet.data, packet.len, position, velocity, effort, kp, kd)) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::motor_parameter_read(const std::string& interface, uint32_t motor_id, uint16_t address) {
+    auto packet = make_packet(interface, motor_id + 0x600);
+    if (motor_protocol::pack_param_read(packet.data, packet.len, address)) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::motor_parameter_write(const std::string& interface, uint32_t motor_id, uint16_t address, int32_t value) {
+    auto packet = make_packet(interface, motor_id + 0x600);
+    if (motor_protocol::pack_param_write(packet.data, packet.len, address, value)) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::motor_parameter_write(const std::string& interface, uint32_t motor_id, uint16_t address, float value) {
+    auto packet = make_packet(interface, motor_id + 0x600);
+    if (motor_protocol::pack_param_write(packet.data, packet.len, address, value)) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::motor_function_operation(const std::string& interface, uint32_t motor_id, uint8_t operation) {
+    auto packet = make_packet(interface, motor_id + 0x400);
+    if (motor_protocol::pack_function_operation(packet.data, packet.len, operation)) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::request_feedback(const std::string& interface, uint32_t motor_id) {
+    auto packet = make_packet(interface, motor_id + 0x200);
+    if (motor_protocol::pack_motor_feedback_request(packet.data, packet.len)) {
+        push(std::move(packet), EntryKind::COMMAND, motor_id, 0);
+    }
+    return *this;
+}
+
+CommandTransaction& CommandTransaction::append(const bus::GenericBusPacket& packet) {
+    auto copy = packet;
+    push(std::move(copy), EntryKind::COMMAND, packet.id, 0);
+    return *this;
+}
+
+}  // namespace motor_driver
+}  // namespace hardware_driver
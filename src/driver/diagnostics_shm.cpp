@@ -0,0 +1,257 @@
+#include "hardware_driver/driver/diagnostics_shm.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hardware_driver {
+namespace diagnostics {
+
+std::string default_shm_name(int pid) {
+    return SHM_PREFIX + std::to_string(pid);
+}
+
+namespace {
+
+int64_t to_ns(std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+}   // namespace
+
+void encode_frame(const motor_driver::DriverDiagnostics& diagnostics, int pid,
+                  std::chrono::milliseconds period, uint64_t sample_count, ShmFrame& frame) {
+    std::memset(&frame, 0, sizeof(frame));
+    frame.pid = pid;
+    frame.period_ms = static_cast<uint32_t>(period.count());
+    frame.sample_count = sample_count;
+    frame.sampled_ns = to_ns(diagnostics.sampled_at);
+    frame.high_freq_mode = diagnostics.high_freq_mode;
+    frame.feedback_paused = diagnostics.feedback_paused;
+    frame.airtime_pacing = diagnostics.airtime_pacing;
+    frame.receive_mode = static_cast<uint8_t>(diagnostics.receive_mode);
+    frame.control_queue_depth = diagnostics.control_queue_depth;
+    frame.receive_queue_depth = diagnostics.receive_queue_depth;
+    frame.event_backlog = diagnostics.event_backlog;
+    frame.control_deadline_misses = diagnostics.control_deadline_misses;
+    frame.events_published = diagnostics.events_published;
+    frame.event_lag_last_ns = diagnostics.event_lag_last.count();
+    frame.event_lag_max_ns = diagnostics.event_lag_max.count();
+
+    const size_t interface_count = std::min(diagnostics.interfaces.size(), MAX_INTERFACES);
+    for (size_t i = 0; i < interface_count; ++i) {
+        const auto& source = diagnostics.interfaces[i];
+        auto& target = frame.interfaces[i];
+        std::strncpy(target.name, source.interface.c_str(), NAME_LEN - 1);
+        target.tx_sent = source.tx.sent;
+        target.tx_backpressure = source.tx.backpressure;
+        target.tx_retried = source.tx.retried;
+        target.tx_dropped = source.tx.dropped;
+        target.tx_hard_errors = source.tx.hard_errors;
+        target.feedback_frames = source.feedback_frames;
+        target.hook_overruns = source.hook_overruns;
+    }
+    frame.interface_count = static_cast<uint32_t>(interface_count);
+
+    size_t motor_count = 0;
+    for (const auto& source : diagnostics.motors) {
+        size_t index = 0;
+        while (index < interface_count && diagnostics.interfaces[index].interface != source.interface) ++index;
+        if (index == interface_count || motor_count == MAX_MOTORS) {
+            ++frame.motors_truncated;
+            continue;
+        }
+        auto& target = frame.motors[motor_count++];
+        target.interface_index = static_cast<uint16_t>(index);
+        target.enabled = source.enabled;
+        target.motor_mode = source.motor_mode;
+        target.motor_id = source.motor_id;
+        target.feedback_count = source.feedback_count;
+        target.error_code = source.error_code;
+        target.last_feedback_ns = source.feedback_count > 0 ? to_ns(source.last_feedback) : 0;
+        target.position = source.position;
+        target.velocity = source.velocity;
+        target.effort = source.effort;
+    }
+    frame.motor_count = static_cast<uint32_t>(motor_count);
+}
+
+// ========== DiagnosticsExporter ==========
+
+DiagnosticsExporter::DiagnosticsExporter(std::string shm_name, SampleFunction sample,
+                                         std::chrono::milliseconds period)
+    : shm_name_(std::move(shm_name)), sample_(std::move(sample)),
+      period_(std::max(period, std::chrono::milliseconds(1))) {}
+
+DiagnosticsExporter::~DiagnosticsExporter() {
+    stop();
+}
+
+bool DiagnosticsExporter::start() {
+    if (segment_) return true;
+
+    const int fd = shm_open(shm_name_.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "[DiagnosticsExporter] shm_open " << shm_name_ << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, sizeof(ShmSegment)) != 0) {
+        std::cerr << "[DiagnosticsExporter] ftruncate " << shm_name_ << " failed: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(shm_name_.c_str());
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "[DiagnosticsExporter] mmap " << shm_name_ << " failed: " << std::strerror(errno) << std::endl;
+        shm_unlink(shm_name_.c_str());
+        return false;
+    }
+
+    // 先写好头部再置魔数，读者看到魔数时布局已完整
+    segment_ = new (memory) ShmSegment();
+    segment_->version = SHM_VERSION;
+    segment_->frame_size = sizeof(ShmFrame);
+    segment_->seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    segment_->magic = SHM_MAGIC;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = true;
+    }
+    thread_ = std::thread(&DiagnosticsExporter::run, this);
+    return true;
+}
+
+void DiagnosticsExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (segment_) {
+        munmap(segment_, sizeof(ShmSegment));
+        shm_unlink(shm_name_.c_str());
+        segment_ = nullptr;
+    }
+}
+
+void DiagnosticsExporter::run() {
+    // 诊断只在空闲时运行，不抢占控制和接收线程；采样函数不得获取驱动热路径上的锁，
+    // 否则持锁时被长时间挂起会阻塞控制循环（优先级反转）
+    sched_param param{};
+    param.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+
+    motor_driver::DriverDiagnostics diagnostics;
+    auto next = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        lock.unlock();
+        try {
+            sample_(diagnostics);
+            publish(diagnostics);
+        } catch (const std::exception& e) {
+            std::cerr << "[DiagnosticsExporter] sample failed: " << e.what() << std::endl;
+        }
+        lock.lock();
+
+        next += period_;
+        const auto now = std::chrono::steady_clock::now();
+        if (next < now) next = now;   // 长时间没有调度到时不补采
+        cv_.wait_until(lock, next, [this] { return !running_; });
+    }
+}
+
+void DiagnosticsExporter::publish(const motor_driver::DriverDiagnostics& diagnostics) {
+    encode_frame(diagnostics, static_cast<int>(getpid()), period_, ++sample_count_, staging_);
+
+    const uint32_t seq = segment_->seq.load(std::memory_order_relaxed);
+    segment_->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&segment_->frame, &staging_, sizeof(staging_));
+    segment_->seq.store(seq + 2, std::memory_order_release);
+}
+
+// ========== DiagnosticsReader ==========
+
+DiagnosticsReader::~DiagnosticsReader() {
+    close();
+}
+
+bool DiagnosticsReader::open(const std::string& shm_name) {
+    close();
+    const int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ShmSegment)) {
+        ::close(fd);
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(ShmSegment), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) return false;
+
+    const auto* segment = static_cast<const ShmSegment*>(memory);
+    if (segment->magic != SHM_MAGIC || segment->version != SHM_VERSION || segment->frame_size != sizeof(ShmFrame)) {
+        munmap(memory, sizeof(ShmSegment));
+        return false;
+    }
+    segment_ = segment;
+    return true;
+}
+
+void DiagnosticsReader::close() {
+    if (segment_) {
+        munmap(const_cast<ShmSegment*>(segment_), sizeof(ShmSegment));
+        segment_ = nullptr;
+    }
+}
+
+bool DiagnosticsReader::read(ShmFrame& frame) const {
+    if (!segment_) return false;
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        const uint32_t before = segment_->seq.load(std::memory_order_acquire);
+        if (before & 1u) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::memcpy(&frame, &segment_->frame, sizeof(frame));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (segment_->seq.load(std::memory_order_relaxed) != before) continue;
+        return before != 0;
+    }
+    return false;
+}
+
+std::vector<std::string> DiagnosticsReader::list_segments() {
+    std::vector<std::string> names;
+    const std::string prefix = std::string(SHM_PREFIX).substr(1);   // /dev/shm 下的文件名不带前导斜杠
+    DIR* dir = opendir("/dev/shm");
+    if (!dir) return names;
+    while (dirent* entry = readdir(dir)) {
+        const std::string file = entry->d_name;
+        if (file.rfind(prefix, 0) == 0) names.push_back("/" + file);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+}   // namespace diagnostics
+}   // namespace hardware_driver
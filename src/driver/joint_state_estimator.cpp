@@ -0,0 +1,116 @@
+#include "hardware_driver/driver/joint_state_estimator.hpp"
+#include <algorithm>
+
+namespace hardware_driver {
+namespace motor_driver {
+
+JointStateEstimator::JointStateEstimator(size_t joint_count, const JointEstimatorConfig& config)
+    : config_(config)
+{
+    resize(joint_count);
+}
+
+void JointStateEstimator::resize(size_t joint_count) {
+    position_.assign(joint_count, 0.0);
+    velocity_.assign(joint_count, 0.0);
+    acceleration_.assign(joint_count, 0.0);
+    stamp_.assign(joint_count, Clock::time_point{});
+    valid_.assign(joint_count, 0);
+}
+
+void JointStateEstimator::reset() {
+    resize(position_.size());
+}
+
+double JointStateEstimator::clamp_horizon(double dt) const {
+    return std::clamp(dt, 0.0, config_.max_prediction_horizon);
+}
+
+void JointStateEstimator::update(size_t joint, Clock::time_point stamp,
+                                 double measured_position, double measured_velocity) {
+    if (joint >= position_.size()) return;
+
+    const double dt = std::chrono::duration<double>(stamp - stamp_[joint]).count();
+
+    // 乱序或重复的旧测量直接丢弃
+    if (valid_[joint] && dt <= 0.0) {
+        return;
+    }
+
+    // 首次测量或长时间中断后直接以测量值初始化
+    if (!valid_[joint] || dt > config_.max_update_interval) {
+        position_[joint] = measured_position;
+        velocity_[joint] = config_.velocity_gain > 0.0 ? measured_velocity : 0.0;
+        acceleration_[joint] = 0.0;
+        stamp_[joint] = stamp;
+        valid_[joint] = 1;
+        return;
+    }
+
+    // 预测
+    const double x_pred = position_[joint] + velocity_[joint] * dt + 0.5 * acceleration_[joint] * dt * dt;
+    const double v_pred = velocity_[joint] + acceleration_[joint] * dt;
+    const double a_pred = acceleration_[joint];
+
+    // 位置残差修正
+    const double residual = measured_position - x_pred;
+    double x = x_pred + config_.alpha * residual;
+    double v = v_pred + (config_.beta / dt) * residual;
+    double a = a_pred + (2.0 * config_.gamma / (dt * dt)) * residual;
+
+    // 融合电机上报的速度
+    const double v_residual = measured_velocity - v;
+    v += config_.velocity_gain * v_residual;
+
+    position_[joint] = x;
+    velocity_[joint] = v;
+    acceleration_[joint] = a;
+    stamp_[joint] = stamp;
+}
+
+JointStateEstimate JointStateEstimator::get(size_t joint) const {
+    JointStateEstimate estimate;
+    if (joint >= position_.size()) return estimate;
+    estimate.position = position_[joint];
+    estimate.velocity = velocity_[joint];
+    estimate.acceleration = acceleration_[joint];
+    estimate.stamp = stamp_[joint];
+    estimate.valid = valid_[joint] != 0;
+    return estimate;
+}
+
+JointStateEstimate JointStateEstimator::predict(size_t joint, Clock::time_point t) const {
+    JointStateEstimate estimate = get(joint);
+    if (!estimate.valid) return estimate;
+
+    const double dt = std::chrono::duration<double>(t - estimate.stamp).count();
+    const double dt_acc = clamp_horizon(dt);
+    const double dt_vel = std::max(dt, 0.0);
+
+    // 外推窗口内使用二阶模型，超出部分按匀速外推
+    estimate.position += estimate.velocity * dt_vel + 0.5 * estimate.acceleration * dt_acc * dt_acc
+                       + estimate.acceleration * dt_acc * (dt_vel - dt_acc);
+    estimate.velocity += estimate.acceleration * dt_acc;
+    return estimate;
+}
+
+size_t JointStateEstimator::predict(Clock::time_point t, double* positions, double* velocities, size_t count) const {
+    const size_t n = std::min(count, position_.size());
+    const double horizon = config_.max_prediction_horizon;
+
+    for (size_t i = 0; i < n; ++i) {
+        const double dt = std::chrono::duration<double>(t - stamp_[i]).count();
+        const double dt_vel = dt > 0.0 ? dt : 0.0;
+        const double dt_acc = dt_vel < horizon ? dt_vel : horizon;
+        const double valid = valid_[i] ? 1.0 : 0.0;
+        positions[i] = position_[i] + valid * (velocity_[i] * dt_vel
+                     + acceleration_[i] * dt_acc * (0.5 * dt_acc + (dt_vel - dt_acc)));
+        if (velocities) {
+            velocities[i] = velocity_[i] + valid * acceleration_[i] * dt_acc;
+        }
+    }
+    return n;
+}
+
+}   // namespace motor_driver
+}   // namespace hardware_driver
@@ -0,0 +1,70 @@
+#include "hardware_driver/driver/motor_config_snapshot.hpp"
+#include <algorithm>
+
+namespace hardware_driver {
+namespace motor_driver {
+
+namespace {
+// 直接索引表覆盖标准帧ID范围，超出的电机ID退回线性查找
+constexpr uint32_t MAX_INDEXED_MOTOR_ID = 0x7FF;
+}
+
+int InterfaceMotorTable::joint_index(uint32_t motor_id) const {
+    if (motor_id < joint_index_by_id.size()) {
+        return joint_index_by_id[motor_id];
+    }
+    if (motor_id <= MAX_INDEXED_MOTOR_ID) {
+        return -1;
+    }
+    auto it = std::find(motor_ids.begin(), motor_ids.end(), motor_id);
+    return it != motor_ids.end() ? static_cast<int>(it - motor_ids.begin()) : -1;
+}
+
+MotorConfigSnapshot::MotorConfigSnapshot(const ConfigMap& config)
+    : config_(config)
+{
+    interfaces_.reserve(config_.size());
+    for (const auto& [interface, motor_ids] : config_) {
+        InterfaceMotorTable table;
+        table.interface = interface;
+        table.motor_ids = motor_ids;
+
+        uint32_t max_id = 0;
+        for (uint32_t motor_id : motor_ids) {
+            if (motor_id <= MAX_INDEXED_MOTOR_ID) max_id = std::max(max_id, motor_id);
+        }
+        table.joint_index_by_id.assign(motor_ids.empty() ? 0 : max_id + 1, -1);
+        for (size_t i = 0; i < motor_ids.size(); ++i) {
+            if (motor_ids[i] <= MAX_INDEXED_MOTOR_ID && table.joint_index_by_id[motor_ids[i]] < 0) {
+                table.joint_index_by_id[motor_ids[i]] = static_cast<int16_t>(i);
+            }
+        }
+        interfaces_.push_back(std::move(table));
+    }
+}
+
+const InterfaceMotorTable* MotorConfigSnapshot::find(const std::string& interface) const {
+    // 接口数量很少，顺序比较比哈希更快
+    for (const auto& table : interfaces_) {
+        if (table.interface == interface) return &table;
+    }
+    return nullptr;
+}
+
+MotorConfigPublisher::MotorConfigPublisher(const MotorConfigSnapshot::ConfigMap& initial) {
+    retained_.push_back(std::make_unique<const MotorConfigSnapshot>(initial));
+    current_.store(retained_.back().get(), std::memory_order_release);
+}
+
+bool MotorConfigPublisher::publish(const MotorConfigSnapshot::ConfigMap& config) {
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    if (current_.load(std::memory_order_relaxed)->config() == config) {
+        return false;
+    }
+    retained_.push_back(std::make_unique<const MotorConfigSnapshot>(config));
+    current_.store(retained_.back().get(), std::memory_order_release);
+    return true;
+}
+
+}  // namespace motor_driver
+}  // namespace hardware_driver
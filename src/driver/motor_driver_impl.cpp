@@ -2,14 +2,17 @@
 #include "bus/canfd_bus_impl.hpp"
 #include <thread>
 #include <algorithm>
+#include <unistd.h>
 
 namespace hardware_driver {
 namespace motor_driver {
 
 // #define PRINT_DEBUG 
 
-MotorDriverImpl::MotorDriverImpl(std::shared_ptr<bus::BusInterface> bus)
-    : bus_(std::move(bus))
+MotorDriverImpl::MotorDriverImpl(std::shared_ptr<bus::BusInterface> bus,
+                                 std::shared_ptr<runtime::Runtime> runtime)
+    : bus_(std::move(bus)),
+      runtime_(std::move(runtime))
 {
     // 设置CAN FD和扩展帧
     auto canfd_bus = std::dynamic_pointer_cast<bus::CanFdBus>(bus_);
@@ -21,11 +24,21 @@ MotorDriverImpl::MotorDriverImpl(std::shared_ptr<bus::BusInterface> bus)
             canfd_bus->set_fd_mode(interface, use_canfd_);
         }
     }
+    // 预先登记接口序号，使批量记录的序号与接口列表顺序一致
+    for (const auto& interface : bus_->get_interface_names()) {
+        intern_interface(interface);
+    }
+
     // 初始化控制时间
     last_control_time_ = std::chrono::steady_clock::now();
 
     // 注册异步接收回调 - 只负责入队，不阻塞接收线程
     bus_->async_receive([this](const bus::GenericBusPacket& packet) {
+        // 直通模式：在接收线程上直接解码，不经过队列
+        if (receive_mode_.load(std::memory_order_relaxed) == ReceiveMode::RUN_TO_COMPLETION) {
+            handle_bus_packet(packet);
+            return;
+        }
         {
             std::lock_guard<std::mutex> lock(receive_mutex_);
             
@@ -37,10 +50,19 @@ MotorDriverImpl::MotorDriverImpl(std::shared_ptr<bus::BusInterface> bus)
             }
             
             receive_queue_.push(packet);
+            receive_queue_depth_.store(receive_queue_.size(), std::memory_order_relaxed);
+            wake_data_processing();
         }
-        receive_cv_.notify_one();
     });
 
+    if (runtime_) {
+        // 共享运行时：不创建线程，反馈请求挂到运行时定时器上
+        feedback_timer_id_ = runtime_->add_timer(std::chrono::steady_clock::now(), [this] {
+            return feedback_request_tick(std::chrono::steady_clock::now());
+        });
+        return;
+    }
+
     // 启动三线程架构
     data_processing_thread_ = std::thread(&MotorDriverImpl::data_processing_worker, this);
     feedback_request_thread_ = std::thread(&MotorDriverImpl::feedback_request_worker, this);
@@ -48,8 +70,26 @@ MotorDriverImpl::MotorDriverImpl(std::shared_ptr<bus::BusInterface> bus)
 }
 
 MotorDriverImpl::~MotorDriverImpl() {
+    // 先停止诊断导出，导出线程会读取驱动状态
+    stop_diagnostics_export();
+
     // 停止三线程
     running_ = false;
+
+    if (runtime_) {
+        // 撤下定时器并等待已投递的解码任务结束，之后运行时不再回调本对象
+        runtime_->cancel_timer(feedback_timer_id_);
+        runtime::Runtime::TimerId control_timer = 0;
+        {
+            std::lock_guard<std::mutex> lock(control_mutex_);
+            control_timer = control_timer_id_;
+        }
+        if (control_timer != 0) {
+            runtime_->cancel_timer(control_timer);
+        }
+        std::unique_lock<std::mutex> lock(receive_mutex_);
+        receive_cv_.wait(lock, [this] { return !drain_scheduled_; });
+    }
     
     // 唤醒所有等待的线程以便它们能够退出
     control_cv_.notify_all();
@@ -78,10 +118,48 @@ void MotorDriverImpl::register_button_packet_callback(ButtonPacketCallback callb
     button_packet_callback_ = std::move(callback);
 }
 
+void MotorDriverImpl::register_batch_feedback_callback(BatchFeedbackCallback callback) {
+    batch_feedback_callback_ = std::move(callback);
+}
+
+void MotorDriverImpl::set_receive_mode(ReceiveMode mode) {
+    receive_mode_.store(mode, std::memory_order_relaxed);
+}
+
+ReceiveMode MotorDriverImpl::get_receive_mode() const {
+    return receive_mode_.load(std::memory_order_relaxed);
+}
+
+const std::string& MotorDriverImpl::get_interface_name(uint16_t index) const {
+    static const std::string empty;
+    std::shared_lock<std::shared_mutex> lock(interface_names_mutex_);
+    return index < interface_names_.size() ? interface_names_[index] : empty;
+}
+
+uint16_t MotorDriverImpl::intern_interface(const std::string& interface) {
+    {
+        std::shared_lock<std::shared_mutex> lock(interface_names_mutex_);
+        for (size_t i = 0; i < interface_names_.size(); ++i) {
+            if (interface_names_[i] == interface) return static_cast<uint16_t>(i);
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(interface_names_mutex_);
+    for (size_t i = 0; i < interface_names_.size(); ++i) {
+        if (interface_names_[i] == interface) return static_cast<uint16_t>(i);
+    }
+    interface_names_.push_back(interface);
+    return static_cast<uint16_t>(interface_names_.size() - 1);
+}
+
 void MotorDriverImpl::set_motor_config(const std::map<std::string, std::vector<uint32_t>>& config) {
-    interface_motor_config_ = config;
+    // 新快照整体替换，反馈请求等读端下次读取即生效，不会看到半更新的配置
+    motor_config_.publish(config);
+    {
+        std::lock_guard<std::mutex> lock(estimator_mutex_);
+        rebuild_estimators();
+    }
     std::cout << "电机配置已设置，开始监控反馈：" << std::endl;
-    for (const auto& [interface, motor_ids] : interface_motor_config_) {
+    for (const auto& [interface, motor_ids] : config) {
         std::cout << "  " << interface << ": [";
         for (size_t i = 0; i < motor_ids.size(); ++i) {
             std::cout << motor_ids[i];
@@ -92,20 +170,642 @@ void MotorDriverImpl::set_motor_config(const std::map<std::string, std::vector<u
 }
 
 void MotorDriverImpl::pause_feedback_request() {
-    // 保存当前配置并清空，停止反馈请求
-    saved_motor_config_ = interface_motor_config_;
-    interface_motor_config_.clear();
+    // 只置暂停标记，配置保持不变
     feedback_request_paused_.store(true, std::memory_order_release);
     std::cout << "[Feedback] Paused feedback request" << std::endl;
 }
 
 void MotorDriverImpl::resume_feedback_request() {
-    // 恢复之前保存的配置
-    interface_motor_config_ = saved_motor_config_;
     feedback_request_paused_.store(false, std::memory_order_release);
     std::cout << "[Feedback] Resumed feedback request" << std::endl;
 }
 
+// ========== 关节状态估计 ==========
+void MotorDriverImpl::enable_state_estimation(const JointEstimatorConfig& config) {
+    std::lock_guard<std::mutex> lock(estimator_mutex_);
+    estimator_config_ = config;
+    rebuild_estimators();
+    estimation_enabled_.store(true, std::memory_order_release);
+}
+
+void MotorDriverImpl::disable_state_estimation() {
+    estimation_enabled_.store(false, std::memory_order_release);
+}
+
+void MotorDriverImpl::rebuild_estimators() {
+    estimators_.clear();
+    for (const auto& table : motor_config_.current().interfaces()) {
+        auto& slot = estimators_[table.interface];
+        slot.table = &table;
+        slot.estimator = JointStateEstimator(table.motor_ids.size(), estimator_config_);
+    }
+}
+
+void MotorDriverImpl::update_estimator(const std::string& interface, uint32_t motor_id,
+                                       std::chrono::steady_clock::time_point stamp, const Motor_Status& status) {
+    std::lock_guard<std::mutex> lock(estimator_mutex_);
+    auto it = estimators_.find(interface);
+    if (it == estimators_.end()) return;
+
+    const int index = it->second.table->joint_index(motor_id);
+    if (index < 0) return;
+
+    it->second.estimator.update(static_cast<size_t>(index), stamp, status.position, status.velocity);
+}
+
+// ========== 实时控制钩子 ==========
+bool MotorDriverImpl::set_control_hook(const std::string& interface, ControlHook hook, const ControlHookConfig& config) {
+    const InterfaceMotorTable* table = motor_config_.current().find(interface);
+    if (!hook || !table || table->motor_ids.empty()) {
+        std::cerr << "Control hook: interface " << interface << " is not configured" << std::endl;
+        return false;
+    }
+    if (table->motor_ids.size() > MAX_HOOK_JOINTS) {
+        std::cerr << "Control hook: at most " << MAX_HOOK_JOINTS << " motors per interface" << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(control_hook_mutex_);
+    auto& slot = control_hooks_[interface];
+    slot = ControlHookSlot{};
+    slot.hook = std::move(hook);
+    slot.config = config;
+    slot.table = table;
+    slot.published = diagnostic_counters(interface);
+    slot.published->hook_overruns.store(0, std::memory_order_relaxed);
+    control_hooks_active_.store(true, std::memory_order_release);
+    return true;
+}
+
+void MotorDriverImpl::clear_control_hook(const std::string& interface) {
+    std::lock_guard<std::mutex> lock(control_hook_mutex_);
+    auto it = control_hooks_.find(interface);
+    if (it != control_hooks_.end()) {
+        it->second.published->hook_overruns.store(0, std::memory_order_relaxed);
+        control_hooks_.erase(it);
+    }
+    control_hooks_active_.store(!control_hooks_.empty(), std::memory_order_release);
+}
+
+bool MotorDriverImpl::get_control_hook_stats(const std::string& interface, ControlHookStats& stats) const {
+    std::lock_guard<std::mutex> lock(control_hook_mutex_);
+    auto it = control_hooks_.find(interface);
+    if (it == control_hooks_.end()) return false;
+    stats = it->second.stats;
+    return true;
+}
+
+void MotorDriverImpl::run_control_hook(const std::string& interface, const MotorStatusRecord& record) {
+    std::lock_guard<std::mutex> lock(control_hook_mutex_);
+    auto it = control_hooks_.find(interface);
+    if (it == control_hooks_.end()) return;
+    auto& slot = it->second;
+
+    const auto& ids = slot.table->motor_ids;
+    const int joint = slot.table->joint_index(record.motor_id);
+    if (joint < 0) return;
+    const size_t index = static_cast<size_t>(joint);
+    const uint32_t bit = 1u << index;
+    const uint32_t full_mask = (1u << ids.size()) - 1;
+
+    // 同一电机在周期内再次上报：上一周期不完整，以本帧开始新周期
+    if (slot.received_mask & bit) {
+        slot.stats.incomplete_cycles++;
+        slot.received_mask = 0;
+    }
+    slot.state[index] = record;
+    slot.received_mask |= bit;
+    if (slot.received_mask != full_mask) return;
+    slot.received_mask = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    bool send = false;
+    try {
+        send = slot.hook(MotorStatusSpan(slot.state.data(), ids.size()),
+                         JointCommandSpan(slot.command.data(), ids.size()));
+    } catch (const std::exception& e) {
+        std::cerr << "Control hook error on " << interface << ": " << e.what() << std::endl;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    auto& stats = slot.stats;
+    stats.cycles++;
+    stats.last_exec = elapsed;
+    stats.total_exec += elapsed;
+    stats.max_exec = std::max(stats.max_exec, elapsed);
+    if (elapsed > slot.config.deadline) {
+        stats.overruns++;
+        slot.published->hook_overruns.store(stats.overruns, std::memory_order_relaxed);
+    }
+    if (!send) {
+        stats.skipped++;
+        return;
+    }
+
+    // 按 send_mit_cmd_all 的格式编码，未配置的槽位增益为 0
+    std::array<float, 6> positions = {}, velocities = {}, efforts = {}, kps = {}, kds = {};
+    for (size_t i = 0; i < ids.size(); ++i) {
+        positions[i] = slot.command[i].position;
+        velocities[i] = slot.command[i].velocity;
+        efforts[i] = slot.command[i].effort;
+        kps[i] = slot.command[i].kp;
+        kds[i] = slot.command[i].kd;
+    }
+    bus::GenericBusPacket packet;
+    packet.interface = interface;
+    packet.id = 0x000;
+    if (!motor_protocol::pack_control_all_command(packet.data, packet.len, positions, velocities, efforts, kps, kds)) {
+        return;
+    }
+    try {
+        if (send_frame(packet) == bus::TxStatus::OK) {
+            stats.commands_sent++;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error sending control hook command: " << e.what() << std::endl;
+    }
+    last_control_time_ = std::chrono::steady_clock::now();
+    high_freq_mode_.store(true, std::memory_order_relaxed);
+}
+
+bool MotorDriverImpl::get_estimated_state(const std::string& interface, uint32_t motor_id, JointStateEstimate& estimate) const {
+    if (!estimation_enabled_.load(std::memory_order_acquire)) return false;
+
+    std::lock_guard<std::mutex> lock(estimator_mutex_);
+    auto it = estimators_.find(interface);
+    if (it == estimators_.end()) return false;
+
+    const int index = it->second.table->joint_index(motor_id);
+    if (index < 0) return false;
+
+    estimate = it->second.estimator.get(static_cast<size_t>(index));
+    return estimate.valid;
+}
+
+bool MotorDriverImpl::predict_joint_states(const std::string& interface, std::chrono::steady_clock::time_point t,
+                                           std::array<double, 6>& positions, std::array<double, 6>& velocities) const {
+    if (!estimation_enabled_.load(std::memory_order_acquire)) return false;
+
+    std::lock_guard<std::mutex> lock(estimator_mutex_);
+    auto it = estimators_.find(interface);
+    if (it == estimators_.end()) return false;
+
+    positions.fill(0.0);
+    velocities.fill(0.0);
+    it->second.estimator.predict(t, positions.data(), velocities.data(), positions.size());
+    return true;
+}
+
+// ========== 命令门控 ==========
+void MotorDriverImpl::set_command_gate_config(const CommandGateConfig& config) {
+    std::lock_guard<std::mutex> lock(gate_mutex_);
+    gate_config_ = config;
+}
+
+CommandGateConfig MotorDriverImpl::get_command_gate_config() const {
+    std::lock_guard<std::mutex> lock(gate_mutex_);
+    return gate_config_;
+}
+
+CommandGateStats MotorDriverImpl::get_command_gate_stats() const {
+    std::lock_guard<std::mutex> lock(gate_mutex_);
+    return gate_stats_;
+}
+
+void MotorDriverImpl::reset_command_gate_stats() {
+    std::lock_guard<std::mutex> lock(gate_mutex_);
+    gate_stats_ = CommandGateStats{};
+}
+
+bool MotorDriverImpl::get_motor_runtime_state(const std::string& interface, uint32_t motor_id, MotorRuntimeState& state) const {
+    std::lock_guard<std::mutex> lock(gate_mutex_);
+    auto it = gate_entries_.find(Motor_Key{interface, motor_id});
+    if (it == gate_entries_.end() || !it->second.state.reported) return false;
+    state = it->second.state;
+    return true;
+}
+
+BringUpReport MotorDriverImpl::bring_up_motors(const BringUpConfig& config) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    const auto deadline = start + config.timeout;
+
+    BringUpReport report;
+    for (const auto& table : get_motor_config().interfaces()) {
+        auto overrides = config.motor_modes.find(table.interface);
+        for (uint32_t motor_id : table.motor_ids) {
+            MotorBringUpResult result;
+            result.interface = table.interface;
+            result.motor_id = motor_id;
+            result.mode = config.mode;
+            if (overrides != config.motor_modes.end()) {
+                auto mode = overrides->second.find(motor_id);
+                if (mode != overrides->second.end()) result.mode = mode->second;
+            }
+            report.motors.push_back(std::move(result));
+        }
+    }
+    if (report.motors.empty()) return report;
+
+    const size_t count = report.motors.size();
+    std::vector<Clock::time_point> sent_at(count);
+    std::vector<bool> confirmed(count, false);
+    std::vector<bool> answered(count, false);       // 命令发出后收到过反馈
+    size_t remaining = count;
+
+    // 按接口组成事务：清错、使能（带模式）、请求反馈
+    auto send_round = [&]() {
+        std::map<std::string, CommandTransaction> transactions;
+        const auto now = Clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            if (confirmed[i]) continue;
+            auto& motor = report.motors[i];
+            auto& transaction = transactions[motor.interface];
+            if (config.clear_errors) {
+                transaction.motor_function_operation(motor.interface, motor.motor_id,
+                    static_cast<uint8_t>(motor_protocol::MotorFunc::CLEAR_ERROR_CODE));
+            }
+            transaction.enable_motor(motor.interface, motor.motor_id, motor.mode);
+            transaction.request_feedback(motor.interface, motor.motor_id);
+            sent_at[i] = now;
+            ++motor.attempts;
+        }
+        for (const auto& [interface, transaction] : transactions) {
+            submit_transaction(transaction, CommandPriority::HIGH);
+        }
+    };
+
+    send_round();
+    auto next_retry = Clock::now() + config.retry_interval;
+
+    std::unique_lock<std::mutex> lock(gate_mutex_);
+    gate_waiters_.fetch_add(1, std::memory_order_relaxed);
+    while (true) {
+        for (size_t i = 0; i < count; ++i) {
+            if (confirmed[i]) continue;
+            auto& motor = report.motors[i];
+            auto it = gate_entries_.find(Motor_Key{motor.interface, motor.motor_id});
+            if (it == gate_entries_.end() || !it->second.state.reported) continue;
+            const MotorRuntimeState& state = it->second.state;
+            if (state.last_feedback < sent_at[i]) continue;
+
+            answered[i] = true;
+            motor.state = state;
+            if (state.enabled && state.motor_mode == motor.mode && state.error_code == 0) {
+                confirmed[i] = true;
+                motor.outcome = BringUpOutcome::CONFIRMED;
+                motor.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(state.last_feedback - start);
+                --remaining;
+            }
+        }
+
+        const auto now = Clock::now();
+        if (remaining == 0 || now >= deadline) break;
+        if (now >= next_retry) {
+            // 事务提交会获取 gate_mutex_（记录期望模式），重发前先释放
+            lock.unlock();
+            send_round();
+            lock.lock();
+            next_retry = Clock::now() + config.retry_interval;
+            continue;
+        }
+        gate_cv_.wait_until(lock, std::min(deadline, next_retry));
+    }
+    gate_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    lock.unlock();
+
+    report.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+    for (size_t i = 0; i < count; ++i) {
+        if (confirmed[i]) continue;
+        auto& motor = report.motors[i];
+        motor.elapsed = report.elapsed;
+        if (!answered[i]) {
+            motor.outcome = BringUpOutcome::NO_FEEDBACK;
+        } else if (motor.state.error_code != 0) {
+            motor.outcome = BringUpOutcome::FAULT;
+        } else {
+            motor.outcome = BringUpOutcome::NOT_ENABLED;
+        }
+        std::cerr << "[BringUp] " << motor.interface << " motor " << motor.motor_id << " not confirmed after "
+                  << motor.attempts << " attempts (enabled=" << motor.state.enabled
+                  << " mode=" << static_cast<int>(motor.state.motor_mode)
+                  << " error=0x" << std::hex << motor.state.error_code << std::dec << ")" << std::endl;
+    }
+    return report;
+}
+
+bool MotorDriverImpl::get_motor_status(const std::string& interface, uint32_t motor_id, Motor_Status& status) const {
+    std::shared_lock<std::shared_mutex> lock(status_map_mutex_);
+    auto it = status_map_.find(Motor_Key{interface, motor_id});
+    if (it == status_map_.end()) return false;
+    status = it->second;
+    return true;
+}
+
+void MotorDriverImpl::sample_diagnostics(DriverDiagnostics& diagnostics) {
+    diagnostics.sampled_at = std::chrono::steady_clock::now();
+    diagnostics.high_freq_mode = high_freq_mode_.load(std::memory_order_relaxed);
+    diagnostics.feedback_paused = feedback_request_paused_.load(std::memory_order_relaxed);
+    diagnostics.airtime_pacing = airtime_pacing_.load(std::memory_order_relaxed);
+    diagnostics.receive_mode = receive_mode_.load(std::memory_order_relaxed);
+    diagnostics.control_deadline_misses = control_deadline_misses_.load(std::memory_order_relaxed);
+    diagnostics.event_lag_last = std::chrono::nanoseconds(event_lag_last_ns_.load(std::memory_order_relaxed));
+    diagnostics.event_lag_max = std::chrono::nanoseconds(event_lag_max_ns_.exchange(0, std::memory_order_relaxed));
+    diagnostics.control_queue_depth = control_queue_depth_.load(std::memory_order_relaxed);
+    diagnostics.receive_queue_depth = receive_queue_depth_.load(std::memory_order_relaxed);
+    diagnostics.event_backlog = event_backlog_depth_.load(std::memory_order_relaxed);
+    const auto event_bus = std::atomic_load(&diagnostics_event_bus_);
+    diagnostics.events_published = event_bus ? event_bus->events_published() : 0;
+
+    // 接口与电机按配置顺序列出，未配置但有发送记录的接口排在后面
+    diagnostics.interfaces.clear();
+    diagnostics.motors.clear();
+    const auto& config = motor_config_.current();
+    for (const auto& table : config.interfaces()) {
+        InterfaceDiagnostics entry;
+        entry.interface = table.interface;
+        diagnostics.interfaces.push_back(std::move(entry));
+        for (uint32_t motor_id : table.motor_ids) {
+            MotorDiagnostics motor;
+            motor.interface = table.interface;
+            motor.motor_id = motor_id;
+            diagnostics.motors.push_back(std::move(motor));
+        }
+    }
+    auto find_interface = [&diagnostics](const std::string& interface) -> InterfaceDiagnostics& {
+        for (auto& entry : diagnostics.interfaces) {
+            if (entry.interface == interface) return entry;
+        }
+        diagnostics.interfaces.push_back(InterfaceDiagnostics{});
+        diagnostics.interfaces.back().interface = interface;
+        return diagnostics.interfaces.back();
+    };
+
+    const auto directory = std::atomic_load(&diagnostics_directory_);
+    if (!directory) return;
+    for (const auto& [interface, counters] : directory->interfaces) {
+        auto& entry = find_interface(interface);
+        entry.tx = counters->load_tx();
+        entry.hook_overruns = counters->hook_overruns.load(std::memory_order_relaxed);
+    }
+    for (auto& motor : diagnostics.motors) {
+        auto it = directory->slots.find(Motor_Key{motor.interface, motor.motor_id});
+        MotorFeedbackSlot::Snapshot snapshot;
+        if (it == directory->slots.end() || !it->second->read(snapshot)) continue;
+        motor.feedback_count = snapshot.updates;
+        motor.last_feedback = snapshot.stamp;
+        motor.position = snapshot.position;
+        motor.velocity = snapshot.velocity;
+        motor.effort = snapshot.effort;
+        motor.error_code = snapshot.error_code;
+        motor.enabled = snapshot.enabled;
+        motor.motor_mode = snapshot.motor_mode;
+        find_interface(motor.interface).feedback_frames += snapshot.updates;
+    }
+}
+
+std::shared_ptr<InterfaceDiagnosticCounters> MotorDriverImpl::diagnostic_counters(const std::string& interface) {
+    std::lock_guard<std::mutex> lock(diagnostics_directory_mutex_);
+    auto current = std::atomic_load(&diagnostics_directory_);
+    if (current) {
+        for (const auto& [name, counters] : current->interfaces) {
+            if (name == interface) return counters;
+        }
+    }
+    auto directory = current ? std::make_shared<DiagnosticsDirectory>(*current) : std::make_shared<DiagnosticsDirectory>();
+    auto counters = std::make_shared<InterfaceDiagnosticCounters>();
+    directory->interfaces.emplace_back(interface, counters);
+    std::atomic_store(&diagnostics_directory_, std::shared_ptr<const DiagnosticsDirectory>(std::move(directory)));
+    return counters;
+}
+
+void MotorDriverImpl::register_diagnostic_slot(const Motor_Key& key, const MotorFeedbackSlot* slot) {
+    std::lock_guard<std::mutex> lock(diagnostics_directory_mutex_);
+    auto current = std::atomic_load(&diagnostics_directory_);
+    auto directory = current ? std::make_shared<DiagnosticsDirectory>(*current) : std::make_shared<DiagnosticsDirectory>();
+    directory->slots[key] = slot;
+    std::atomic_store(&diagnostics_directory_, std::shared_ptr<const DiagnosticsDirectory>(std::move(directory)));
+}
+
+bool MotorDriverImpl::start_diagnostics_export(const std::string& shm_name, std::chrono::milliseconds period) {
+    std::lock_guard<std::mutex> lock(diagnostics_mutex_);
+    if (diagnostics_exporter_) return true;
+
+    const std::string name = shm_name.empty() ? diagnostics::default_shm_name(static_cast<int>(getpid())) : shm_name;
+    auto exporter = std::make_unique<diagnostics::DiagnosticsExporter>(
+        name, [this](DriverDiagnostics& diagnostics) { sample_diagnostics(diagnostics); }, period);
+    if (!exporter->start()) {
+        return false;
+    }
+    diagnostics_exporter_ = std::move(exporter);
+    std::cout << "[MotorDriverImpl] Diagnostics exported to " << name << std::endl;
+    return true;
+}
+
+void MotorDriverImpl::stop_diagnostics_export() {
+    std::unique_ptr<diagnostics::DiagnosticsExporter> exporter;
+    {
+        std::lock_guard<std::mutex> lock(diagnostics_mutex_);
+        exporter = std::move(diagnostics_exporter_);
+    }
+    // 在锁外停止，导出线程可能正在采样
+    exporter.reset();
+}
+
+const MotorFeedbackSlot* MotorDriverImpl::get_feedback_slot(const std::string& interface, uint32_t motor_id) {
+    std::unique_lock<std::shared_mutex> lock(status_map_mutex_);
+    Motor_Key key{interface, motor_id};
+    auto& slot = feedback_slots_[key];
+    if (!slot) {
+        slot = std::make_unique<MotorFeedbackSlot>();
+        register_diagnostic_slot(key, slot.get());
+    }
+    return slot.get();
+}
+
+void MotorDriverImpl::mark_mode_requested(const std::string& interface, const std::vector<uint32_t>& motor_ids,
+                                          uint8_t mode, bool enable) {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(gate_mutex_);
+    for (uint32_t motor_id : motor_ids) {
+        auto& entry = gate_entries_[Motor_Key{interface, motor_id}];
+        entry.expected_mode = mode;
+        entry.mode_known = true;
+        entry.enable_requested = enable ? now : std::chrono::steady_clock::time_point{};
+        if (!enable && entry.has_deferred) {
+            // 主动失能后，暂存的控制命令不应再发出
+            entry.has_deferred = false;
+            ++gate_stats_.deferred_dropped;
+        }
+    }
+}
+
+bool MotorDriverImpl::is_enable_pending(const GateEntry& entry, std::chrono::steady_clock::time_point now) const {
+    return entry.enable_requested.time_since_epoch().count() != 0 &&
+           now - entry.enable_requested < gate_config_.enable_pending;
+}
+
+MotorDriverImpl::GateDecision MotorDriverImpl::evaluate_gate(const GateEntry& entry,
+                                                             std::chrono::steady_clock::time_point now) const {
+    if (gate_config_.policy == CommandGatePolicy::PASS_THROUGH) {
+        return GateDecision::SEND;
+    }
+
+    const bool enable_pending = is_enable_pending(entry, now);
+
+    // 从未收到反馈或反馈已过期：状态未知，放行
+    if (!entry.state.reported || now - entry.state.last_feedback > gate_config_.state_timeout) {
+        return GateDecision::SEND;
+    }
+
+    if (entry.state.error_code != 0) {
+        return GateDecision::REJECT_FAULT;
+    }
+
+    const bool defer_allowed = enable_pending || gate_config_.policy != CommandGatePolicy::REJECT;
+    if (!entry.state.enabled) {
+        return defer_allowed ? GateDecision::DEFER : GateDecision::REJECT_DISABLED;
+    }
+    if (entry.mode_known && entry.state.motor_mode != entry.expected_mode) {
+        return defer_allowed ? GateDecision::DEFER : GateDecision::REJECT_MODE;
+    }
+    return GateDecision::SEND;
+}
+
+bool MotorDriverImpl::gate_control_command(const bus::GenericBusPacket& packet) {
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::pair<uint32_t, uint8_t>> to_enable;   // 需要自动使能的电机及模式
+    bool send = false;
+
+    {
+        std::lock_guard<std::mutex> lock(gate_mutex_);
+        if (gate_config_.policy == CommandGatePolicy::PASS_THROUGH) {
+            ++gate_stats_.accepted;
+            return true;
+        }
+
+        GateDecision decision = GateDecision::SEND;
+        if (packet.id == 0x00) {
+            // 广播帧：只要接口上有一个电机能执行就发送；全部无法执行时取第一个原因
+            bool any_known = false;
+            bool any_send = false;
+            bool any_defer = false;
+            GateDecision first_reject = GateDecision::SEND;
+            for (const auto& [key, entry] : gate_entries_) {
+                if (key.interface != packet.interface || key.motor_id == 0x00) continue;
+                any_known = true;
+                auto d = evaluate_gate(entry, now);
+                if (d == GateDecision::SEND) {
+                    any_send = true;
+                    break;
+                }
+                if (d == GateDecision::DEFER) {
+                    any_defer = true;
+                } else if (first_reject == GateDecision::SEND) {
+                    first_reject = d;
+                }
+                if (gate_config_.policy == CommandGatePolicy::AUTO_ENABLE && d == GateDecision::DEFER &&
+                    entry.mode_known && !is_enable_pending(entry, now)) {
+                    to_enable.emplace_back(key.motor_id, entry.expected_mode);
+                }
+            }
+            if (any_known && !any_send) {
+                decision = any_defer ? GateDecision::DEFER : first_reject;
+            }
+            if (any_send) to_enable.clear();
+        } else {
+            auto& entry = gate_entries_[Motor_Key{packet.interface, packet.id}];
+            decision = evaluate_gate(entry, now);
+            if (decision == GateDecision::DEFER && gate_config_.policy == CommandGatePolicy::AUTO_ENABLE &&
+                !is_enable_pending(entry, now)) {
+                to_enable.emplace_back(packet.id, entry.mode_known ? entry.expected_mode : entry.state.motor_mode);
+            }
+        }
+
+        switch (decision) {
+            case GateDecision::SEND:
+                ++gate_stats_.accepted;
+                send = true;
+                break;
+            case GateDecision::DEFER: {
+                // 每个电机只保留最新的一条，旧的控制目标已无意义
+                auto& slot = gate_entries_[Motor_Key{packet.interface, packet.id}];
+                if (slot.has_deferred) {
+                    ++gate_stats_.deferred_dropped;
+                }
+                slot.deferred = packet;
+                slot.deferred_at = now;
+                slot.has_deferred = true;
+                ++gate_stats_.deferred;
+                break;
+            }
+            case GateDecision::REJECT_DISABLED:
+                ++gate_stats_.rejected_disabled;
+                break;
+            case GateDecision::REJECT_FAULT:
+                ++gate_stats_.rejected_fault;
+                break;
+            case GateDecision::REJECT_MODE:
+                ++gate_stats_.rejected_mode;
+                break;
+        }
+        gate_stats_.auto_enabled += to_enable.size();
+    }
+
+    // 自动使能在锁外发送，enable_motor 会重新进入门控记录使能请求
+    for (const auto& [motor_id, mode] : to_enable) {
+        enable_motor(packet.interface, motor_id, mode);
+    }
+    return send;
+}
+
+void MotorDriverImpl::update_gate_state(const Motor_Key& key, const Motor_Status& status,
+                                        std::chrono::steady_clock::time_point stamp) {
+    std::vector<bus::GenericBusPacket> ready;
+    {
+        std::lock_guard<std::mutex> lock(gate_mutex_);
+        auto& entry = gate_entries_[key];
+        entry.state.reported = true;
+        entry.state.enabled = status.enable_flag != 0;
+        entry.state.motor_mode = status.motor_mode;
+        entry.state.error_code = status.error_code;
+        entry.state.last_feedback = stamp;
+        if (gate_waiters_.load(std::memory_order_relaxed) > 0) {
+            gate_cv_.notify_all();
+        }
+
+        // 使能已确认
+        if (entry.state.enabled && (!entry.mode_known || entry.state.motor_mode == entry.expected_mode)) {
+            entry.enable_requested = std::chrono::steady_clock::time_point{};
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (evaluate_gate(entry, now) != GateDecision::SEND) return;
+
+        // 电机就绪：发出该电机及本接口广播帧的暂存命令
+        auto flush = [&](GateEntry& slot) {
+            if (!slot.has_deferred) return;
+            slot.has_deferred = false;
+            if (now - slot.deferred_at > gate_config_.deferred_ttl) {
+                ++gate_stats_.deferred_dropped;
+                return;
+            }
+            ready.push_back(slot.deferred);
+            ++gate_stats_.deferred_sent;
+        };
+        flush(entry);
+        auto broadcast = gate_entries_.find(Motor_Key{key.interface, 0x00});
+        if (broadcast != gate_entries_.end()) {
+            flush(broadcast->second);
+        }
+    }
+
+    // 在数据处理线程中调用，队列满时不阻塞
+    for (const auto& packet : ready) {
+        send_control_command_timeout(packet, std::chrono::milliseconds(0));
+    }
+}
+
 bool MotorDriverImpl::send_control_command_timeout(const bus::GenericBusPacket& packet, std::chrono::milliseconds timeout) {
     // 有界队列：带超时的安全版本，避免程序永久阻塞
     {
@@ -123,10 +823,11 @@ bool MotorDriverImpl::send_control_command_timeout(const bus::GenericBusPacket&
         
         // 使用默认优先级
         control_priority_queue_.emplace(packet, CommandPriority::LOW);
+        control_queue_depth_.store(control_priority_queue_.size(), std::memory_order_relaxed);
     }
     
     // 唤醒控制线程
-    control_cv_.notify_one();
+    wake_control();
     return true;
 }
 
@@ -159,10 +860,51 @@ void MotorDriverImpl::send_control_command(const bus::GenericBusPacket& packet,
         
         // 创建优先级命令并加入队列
         control_priority_queue_.emplace(packet, priority);
+        control_queue_depth_.store(control_priority_queue_.size(), std::memory_order_relaxed);
     }
     
     // 唤醒控制线程
-    control_cv_.notify_one();
+    wake_control();
+}
+
+std::future<CommandTransactionResult> MotorDriverImpl::submit_transaction(const CommandTransaction& transaction,
+                                                                         CommandPriority priority) {
+    if (transaction.empty()) {
+        std::promise<CommandTransactionResult> ready;
+        ready.set_value(CommandTransactionResult{});
+        return ready.get_future();
+    }
+
+    auto pending = std::make_shared<PendingTransaction>();
+    pending->packets.reserve(transaction.size());
+    for (const auto& entry : transaction.entries()) {
+        pending->packets.push_back(entry.packet);
+        pending->packets.back().tx_class = tx_class_for(priority);
+    }
+    auto future = pending->promise.get_future();
+
+    // 使能/失能命令的模式记录与单条接口一致，在入队前更新
+    for (const auto& entry : transaction.entries()) {
+        if (entry.kind == CommandTransaction::EntryKind::COMMAND) continue;
+        {
+            std::lock_guard<std::mutex> lock(motor_modes_mutex_);
+            motor_modes_[Motor_Key{entry.packet.interface, entry.motor_id}] = entry.mode;
+        }
+        mark_mode_requested(entry.packet.interface, {entry.motor_id}, entry.mode,
+                            entry.kind == CommandTransaction::EntryKind::ENABLE);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(control_mutex_);
+        control_cv_.wait(lock, [this] {
+            return control_priority_queue_.size() < MAX_QUEUE_SIZE;
+        });
+        control_priority_queue_.emplace(std::move(pending), priority);
+        control_queue_depth_.store(control_priority_queue_.size(), std::memory_order_relaxed);
+    }
+
+    wake_control();
+    return future;
 }
 
 void MotorDriverImpl::send_emergency_stop(const std::string& interface, uint32_t motor_id) {
@@ -197,6 +939,7 @@ void MotorDriverImpl::disable_motor(const std::string interface, const uint32_t
         Motor_Key key{interface, motor_id};
         motor_modes_[key] = mode;
     }
+    mark_mode_requested(interface, {motor_id}, mode, false);
 }
 
 void MotorDriverImpl::disable_all_motors(const std::string interface, std::vector<uint32_t> motor_ids, uint8_t mode) {
@@ -233,6 +976,7 @@ void MotorDriverImpl::disable_all_motors(const std::string interface, std::vecto
         // 失能命令使用高优先级
         send_control_command(packet, CommandPriority::HIGH);
     }
+    mark_mode_requested(interface, motor_ids, mode, false);
 }
 
 void MotorDriverImpl::enable_motor(const std::string interface, const uint32_t motor_id, uint8_t mode) {
@@ -251,6 +995,7 @@ void MotorDriverImpl::enable_motor(const std::string interface, const uint32_t m
         Motor_Key key{interface, motor_id};
         motor_modes_[key] = mode;
     }
+    mark_mode_requested(interface, {motor_id}, mode, true);
 }
 
 void MotorDriverImpl::enable_all_motors(const std::string interface, std::vector<uint32_t> motor_ids, uint8_t mode) {
@@ -288,6 +1033,7 @@ void MotorDriverImpl::enable_all_motors(const std::string interface, std::vector
         // 使能命令使用高优先级
         send_control_command(packet, CommandPriority::HIGH);
     }
+    mark_mode_requested(interface, motor_ids, mode, true);
 }
     
 void MotorDriverImpl::send_position_cmd(const std::string interface, const uint32_t motor_id, 
@@ -299,7 +1045,9 @@ void MotorDriverImpl::send_position_cmd(const std::string interface, const uint3
 
     // 位置命令：只控制位置，速度和力矩设为0
     if (motor_protocol::pack_control_command(packet.data, packet.len, position, 0.0f, 0.0f, (uint8_t)(1000 * kp), (uint8_t)(1000 * kd))) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -312,7 +1060,9 @@ void MotorDriverImpl::send_velocity_cmd(const std::string interface, const uint3
 
     // 速度命令：只控制速度，位置和力矩设为0
     if (motor_protocol::pack_control_command(packet.data, packet.len, 0.0f, velocity, 0.0f, (uint8_t)(1000 * kp), (uint8_t)(1000 * kd))) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -325,7 +1075,9 @@ void MotorDriverImpl::send_effort_cmd(const std::string interface, const uint32_
 
     // 力矩命令：只控制力矩，位置和速度设为0
     if (motor_protocol::pack_control_command(packet.data, packet.len, 0.0f, 0.0f, effort, kp, kd)) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -339,7 +1091,9 @@ void MotorDriverImpl::send_mit_cmd(const std::string interface, const uint32_t m
 
     // MIT模式命令
     if (motor_protocol::pack_control_command(packet.data, packet.len, position, velocity, effort, kp, kd)) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -376,7 +1130,9 @@ void MotorDriverImpl::send_control_cmd(const std::string interface,
 
     // 同时控制多个电机
     if (motor_protocol::pack_control_all_command(packet.data, packet.len, pos_arr, vel_arr, eff_arr, kps_arr, kds_arr)) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -424,6 +1180,7 @@ void MotorDriverImpl::motor_function_operation(const std::string interface, cons
 void MotorDriverImpl::control_worker() {
     // 设置控制线程的CPU亲和性
     set_thread_cpu_affinity(timing_config_.control_cpu_core);
+    auto next_send_time = std::chrono::steady_clock::now();
     
     while (running_) {
         std::unique_lock<std::mutex> lock(control_mutex_);
@@ -435,16 +1192,20 @@ void MotorDriverImpl::control_worker() {
         
         if (!running_) break;
         
-        // 批量处理控制命令，保证200us间隔
-        auto next_send_time = std::chrono::steady_clock::now();
+        // 批量处理控制命令，保证200us间隔；空口节拍下上一批最后一帧的空口时间同样要让出
+        const auto batch_start = std::chrono::steady_clock::now();
+        if (!airtime_pacing_.load(std::memory_order_relaxed) || next_send_time < batch_start) {
+            next_send_time = batch_start;
+        }
         
         while (!control_priority_queue_.empty()) {
             // 每次都取最高优先级的命令（确保抢占式调度）
             auto priority_cmd = control_priority_queue_.top();
             control_priority_queue_.pop();
-            auto packet = priority_cmd.packet;
+            control_queue_depth_.store(control_priority_queue_.size(), std::memory_order_relaxed);
             
             lock.unlock();  // 释放锁进行发送
+            bool requeue = false;
             
             try {
                 // 混合时序控制：粗粒度sleep + 精确忙等待
@@ -461,17 +1222,29 @@ void MotorDriverImpl::control_worker() {
                     while (std::chrono::steady_clock::now() < next_send_time) {
                         std::this_thread::yield();  // 让出时间片但保持活跃
                     }
+                } else if (now - next_send_time > timing_config_.control_interval) {
+                    control_deadline_misses_.fetch_add(1, std::memory_order_relaxed);
                 }
                 
-                // 发送控制命令
-                bus_->send(packet);
+                // 发送控制命令（事务在此连续发出全部数据帧）
+                requeue = transmit_command(priority_cmd);
                 
                 // 更新控制时间，切换到高频模式
                 last_control_time_ = std::chrono::steady_clock::now();
                 high_freq_mode_.store(true, std::memory_order_relaxed);
                 
-                // 计算下次发送时间，使用配置的控制间隔
-                next_send_time += timing_config_.control_interval;
+                if (requeue) {
+                    // 发送队列满：退避后重试，期间更高优先级的命令可以先发
+                    next_send_time = last_control_time_ + tx_backoff();
+                } else {
+                    // 计算下次发送时间：配置的控制间隔按累计时刻推进；空口节拍从实际发送时刻起算，
+                    // 停顿之后不会以快于总线空口时间的速度连续补发
+                    if (airtime_pacing_.load(std::memory_order_relaxed)) {
+                        next_send_time = last_control_time_ + pacing_interval(priority_cmd);
+                    } else {
+                        next_send_time += pacing_interval(priority_cmd);
+                    }
+                }
                 
             } catch (const std::exception& e) {
                 std::cerr << "Error sending control command: " << e.what() << std::endl;
@@ -480,6 +1253,10 @@ void MotorDriverImpl::control_worker() {
             }
             
             lock.lock();  // 重新获取锁检查队列
+            if (requeue) {
+                control_priority_queue_.push(std::move(priority_cmd));   // 保留原时间戳，同优先级中仍排在最前
+                control_queue_depth_.store(control_priority_queue_.size(), std::memory_order_relaxed);
+            }
             
             // 处理完当前批次后，通知等待的生产者线程（用于有界队列的背压控制）
             control_cv_.notify_all();
@@ -488,38 +1265,14 @@ void MotorDriverImpl::control_worker() {
 }
 
 void MotorDriverImpl::feedback_request_worker() {
-    // 使用配置的时序参数
-    const auto& high_freq_interval = timing_config_.high_freq_feedback;
-    const auto& low_freq_interval = timing_config_.low_freq_feedback;
-    const auto& mode_timeout = timing_config_.mode_timeout;
-    
     auto next_request_time = std::chrono::steady_clock::now();
     
     while (running_) {
         auto now = std::chrono::steady_clock::now();
         
-        // 检查频率模式切换
-        if (high_freq_mode_.load(std::memory_order_relaxed) && 
-           (now - last_control_time_) > mode_timeout) {
-            high_freq_mode_.store(false, std::memory_order_relaxed);
-        }
-        
         // 定时发送反馈请求
         if (now >= next_request_time) {
-            auto interval = high_freq_mode_.load(std::memory_order_relaxed) ? 
-                           high_freq_interval : low_freq_interval;
-            
-            try {
-                for (const auto& [interface, motor_ids] : interface_motor_config_) {
-                    (void) motor_ids;  // 避免未使用变量警告
-                    auto feedback_packet = create_feedback_request_all(interface);
-                    bus_->send(feedback_packet);
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error sending feedback request: " << e.what() << std::endl;
-            }
-            
-            next_request_time = now + interval;
+            next_request_time = feedback_request_tick(now);
         }
         
         // 短暂休眠，避免过度占用CPU
@@ -527,19 +1280,322 @@ void MotorDriverImpl::feedback_request_worker() {
     }
 }
 
+std::chrono::steady_clock::time_point MotorDriverImpl::feedback_request_tick(std::chrono::steady_clock::time_point now) {
+    if (!running_) return {};
+
+    // 检查频率模式切换
+    if (high_freq_mode_.load(std::memory_order_relaxed) && 
+       (now - last_control_time_) > timing_config_.mode_timeout) {
+        high_freq_mode_.store(false, std::memory_order_relaxed);
+    }
+
+    auto interval = high_freq_mode_.load(std::memory_order_relaxed) ? 
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(timing_config_.high_freq_feedback) :
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(timing_config_.low_freq_feedback);
+    
+    if (feedback_request_paused_.load(std::memory_order_acquire)) {
+        return now + interval;
+    }
+
+    try {
+        for (const auto& table : motor_config_.current().interfaces()) {
+            auto feedback_packet = create_feedback_request_all(table.interface);
+            send_frame(feedback_packet);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error sending feedback request: " << e.what() << std::endl;
+    }
+    
+    return now + interval;
+}
+
+void MotorDriverImpl::wake_control() {
+    if (!runtime_) {
+        control_cv_.notify_one();
+        return;
+    }
+    // 运行时模式：发送定时器未激活时启动，保持与控制线程相同的发送间隔
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    if (!running_ || control_timer_id_ != 0 || control_priority_queue_.empty()) return;
+    next_control_send_ = std::max(std::chrono::steady_clock::now(), next_control_send_);
+    control_timer_id_ = runtime_->add_timer(next_control_send_, [this] { return control_tick(); });
+}
+
+std::chrono::steady_clock::time_point MotorDriverImpl::control_tick() {
+    std::unique_lock<std::mutex> lock(control_mutex_);
+    if (!running_ || control_priority_queue_.empty()) {
+        control_timer_id_ = 0;
+        return {};
+    }
+    auto command = control_priority_queue_.top();
+    control_priority_queue_.pop();
+    control_queue_depth_.store(control_priority_queue_.size(), std::memory_order_relaxed);
+    if (std::chrono::steady_clock::now() - next_control_send_ > timing_config_.control_interval) {
+        control_deadline_misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+    lock.unlock();
+    control_cv_.notify_all();   // 有界队列的背压控制
+
+    bool requeue = false;
+    try {
+        requeue = transmit_command(command);
+    } catch (const std::exception& e) {
+        std::cerr << "Error sending control command: " << e.what() << std::endl;
+    }
+    auto now = std::chrono::steady_clock::now();
+    last_control_time_ = now;
+    high_freq_mode_.store(true, std::memory_order_relaxed);
+    const auto backoff = requeue ? tx_backoff() : std::chrono::microseconds(0);
+
+    lock.lock();
+    if (requeue) {
+        control_priority_queue_.push(std::move(command));
+        control_queue_depth_.store(control_priority_queue_.size(), std::memory_order_relaxed);
+        next_control_send_ = now + backoff;
+    } else {
+        next_control_send_ = now + pacing_interval(command);
+    }
+    if (control_priority_queue_.empty()) {
+        control_timer_id_ = 0;
+        return {};
+    }
+    return next_control_send_;
+}
+
+bool MotorDriverImpl::transmit_command(PriorityCommand& command) {
+    if (command.transaction) {
+        transmit_transaction(command);
+        return false;
+    }
+
+    const auto status = send_frame(command.packet, command.attempts > 0);
+    if (status != bus::TxStatus::BACKPRESSURE) {
+        return false;
+    }
+    const bool retry = can_retry(command.priority, command.timestamp, command.attempts);
+    {
+        std::lock_guard<std::mutex> lock(tx_mutex_);
+        auto& entry = tx_stats_entry(command.packet.interface);
+        if (retry) {
+            ++entry.stats.retried;
+        } else {
+            ++entry.stats.dropped;
+        }
+        entry.published->publish(entry.stats);
+    }
+    if (retry) ++command.attempts;
+    return retry;
+}
+
+void MotorDriverImpl::transmit_transaction(PriorityCommand& command) {
+    // 事务内的数据帧背靠背发出，背压时原地退避重试以保持连续；单帧失败不中断后续帧
+    CommandTransactionResult result;
+    for (const auto& packet : command.transaction->packets) {
+        uint32_t attempts = 0;
+        while (true) {
+            const auto status = send_frame(packet, attempts > 0);
+            if (status == bus::TxStatus::OK) {
+                ++result.sent;
+                break;
+            }
+            const bool retry = status == bus::TxStatus::BACKPRESSURE &&
+                               can_retry(command.priority, command.timestamp, attempts);
+            {
+                std::lock_guard<std::mutex> lock(tx_mutex_);
+                auto& entry = tx_stats_entry(packet.interface);
+                if (retry) {
+                    ++entry.stats.retried;
+                } else if (status == bus::TxStatus::BACKPRESSURE) {
+                    ++entry.stats.dropped;
+                }
+                entry.published->publish(entry.stats);
+            }
+            if (!retry) {
+                ++result.failed;
+                break;
+            }
+            ++attempts;
+            std::this_thread::sleep_for(tx_backoff());
+        }
+    }
+    command.transaction->promise.set_value(result);
+}
+
+// ========== 发送错误处理 ==========
+
+bus::TxStatus MotorDriverImpl::send_frame(const bus::GenericBusPacket& packet, bool is_retry) {
+    bus::TxStatus status = bus::TxStatus::DEVICE_ERROR;
+    try {
+        status = bus_->try_send(packet);
+    } catch (const std::exception& e) {
+        std::cerr << "Error sending frame on " << packet.interface << ": " << e.what() << std::endl;
+    }
+
+    TxErrorCallback callback;
+    TxStats snapshot;
+    bool escalate = false;
+    {
+        std::lock_guard<std::mutex> lock(tx_mutex_);
+        auto& entry = tx_stats_entry(packet.interface);
+        auto& stats = entry.stats;
+        switch (status) {
+            case bus::TxStatus::OK:
+                ++stats.sent;
+                if (is_retry) ++stats.retry_succeeded;
+                stats.consecutive_hard_errors = 0;
+                break;
+            case bus::TxStatus::BACKPRESSURE:
+                ++stats.backpressure;
+                stats.last_error = status;
+                break;
+            default:
+                ++stats.hard_errors;
+                stats.last_error = status;
+                // 每轮连续硬错误只上报一次，避免逐帧刷屏
+                if (++stats.consecutive_hard_errors == tx_retry_config_.escalate_after) {
+                    ++stats.escalations;
+                    escalate = true;
+                    snapshot = stats;
+                    callback = tx_error_callback_;
+                }
+                break;
+        }
+        entry.published->publish(stats);
+    }
+
+    if (escalate) {
+        std::cerr << "[TX] " << packet.interface << ": " << snapshot.consecutive_hard_errors
+                  << " consecutive send failures (" << bus::to_string(status) << ")" << std::endl;
+        if (callback) {
+            callback(packet.interface, status, snapshot);
+        }
+        emit_bus_tx_error_event(packet.interface, status, snapshot.consecutive_hard_errors);
+    }
+    return status;
+}
+
+bool MotorDriverImpl::can_retry(CommandPriority priority, std::chrono::steady_clock::time_point enqueued,
+                                uint32_t attempts) const {
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    if (attempts >= tx_retry_config_.max_retries) return false;
+    const auto ttl = tx_retry_config_.ttl[static_cast<size_t>(priority)];
+    return std::chrono::steady_clock::now() - enqueued < ttl;
+}
+
+std::chrono::microseconds MotorDriverImpl::tx_backoff() const {
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    return tx_retry_config_.backoff;
+}
+
+std::chrono::nanoseconds MotorDriverImpl::pacing_interval(const PriorityCommand& command) const {
+    std::chrono::nanoseconds airtime(0);
+    if (command.transaction) {
+        for (const auto& packet : command.transaction->packets) {
+            airtime += bus_->frame_airtime(packet);
+        }
+    } else {
+        airtime = bus_->frame_airtime(command.packet);
+    }
+    if (airtime.count() == 0) {
+        return timing_config_.control_interval;
+    }
+    if (airtime_pacing_.load(std::memory_order_relaxed)) {
+        return airtime + timing_config_.airtime_guard;
+    }
+    return std::max<std::chrono::nanoseconds>(timing_config_.control_interval, airtime);
+}
+
+void MotorDriverImpl::set_tx_retry_config(const TxRetryConfig& config) {
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    tx_retry_config_ = config;
+}
+
+TxRetryConfig MotorDriverImpl::get_tx_retry_config() const {
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    return tx_retry_config_;
+}
+
+std::map<std::string, TxStats> MotorDriverImpl::get_tx_stats() const {
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    std::map<std::string, TxStats> result;
+    for (const auto& [interface, entry] : tx_stats_) {
+        result[interface] = entry.stats;
+    }
+    return result;
+}
+
+MotorDriverImpl::TxStatsEntry& MotorDriverImpl::tx_stats_entry(const std::string& interface) {
+    auto& entry = tx_stats_[interface];
+    if (!entry.published) entry.published = diagnostic_counters(interface);
+    return entry;
+}
+
+void MotorDriverImpl::register_tx_error_callback(TxErrorCallback callback) {
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    tx_error_callback_ = std::move(callback);
+}
+
 void MotorDriverImpl::data_processing_worker() {
     while (running_) {
-        bus::GenericBusPacket packet;
         {
             std::unique_lock<std::mutex> lock(receive_mutex_);
             receive_cv_.wait(lock, [this] { 
-                return !running_ || !receive_queue_.empty(); 
+                return !running_ || !receive_queue_.empty() || !pending_status_events_.empty();
             });
             if (!running_) break;
-            packet = std::move(receive_queue_.front());
-            receive_queue_.pop();
+            // 一次取走当前积压的全部数据包，接收线程继续向空队列写入
+            std::swap(receive_burst_, receive_queue_);
+            std::swap(status_event_burst_, pending_status_events_);
+            receive_queue_depth_.store(receive_queue_.size(), std::memory_order_relaxed);
+            event_backlog_depth_.store(pending_status_events_.size(), std::memory_order_relaxed);
+        }
+        process_receive_burst();
+    }
+}
+
+void MotorDriverImpl::drain_receive_queue() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(receive_mutex_);
+            if (!running_ || (receive_queue_.empty() && pending_status_events_.empty())) {
+                drain_scheduled_ = false;
+                receive_cv_.notify_all();   // 析构函数等待此标志
+                return;
+            }
+            std::swap(receive_burst_, receive_queue_);
+            std::swap(status_event_burst_, pending_status_events_);
+            receive_queue_depth_.store(receive_queue_.size(), std::memory_order_relaxed);
+            event_backlog_depth_.store(pending_status_events_.size(), std::memory_order_relaxed);
         }
-        handle_bus_packet(packet);  // 处理单个数据包
+        process_receive_burst();
+    }
+}
+
+void MotorDriverImpl::wake_data_processing() {
+    if (!runtime_) {
+        receive_cv_.notify_one();
+        return;
+    }
+    // 同一时刻只投递一个解码任务，保证按到达顺序串行处理
+    if (running_ && !drain_scheduled_) {
+        drain_scheduled_ = true;
+        runtime_->post([this] { drain_receive_queue(); });
+    }
+}
+
+void MotorDriverImpl::process_receive_burst() {
+    if (!receive_burst_.empty()) {
+        std::lock_guard<std::mutex> decode_lock(decode_mutex_);
+        while (!receive_burst_.empty()) {
+            process_bus_packet(receive_burst_.front());
+            receive_burst_.pop();
+        }
+        dispatch_status_batch();  // 整个突发的状态只分发一次
+    }
+    // 直通模式转交过来的事件
+    if (!status_event_burst_.empty()) {
+        publish_status_events(MotorStatusSpan(status_event_burst_.data(), status_event_burst_.size()));
+        status_event_burst_.clear();
     }
 }
 
@@ -553,6 +1609,12 @@ bus::GenericBusPacket MotorDriverImpl::create_feedback_request_all(const std::st
 }
 
 void MotorDriverImpl::handle_bus_packet(const bus::GenericBusPacket& packet) {
+    std::lock_guard<std::mutex> decode_lock(decode_mutex_);
+    process_bus_packet(packet);
+    dispatch_status_batch();
+}
+
+void MotorDriverImpl::process_bus_packet(const bus::GenericBusPacket& packet) {
     // 检查是否是按键数据包 (CAN ID 0x8F)
     constexpr uint32_t BUTTON_RX_CAN_ID = 0x8F;
     if (packet.id == BUTTON_RX_CAN_ID && button_packet_callback_) {
@@ -576,8 +1638,12 @@ void MotorDriverImpl::handle_bus_packet(const bus::GenericBusPacket& packet) {
     auto feedback_opt = motor_protocol::parse_feedback(packet);
     if (!feedback_opt) return;
 
+    // 没有接收时间戳的总线（如测试桩）以处理时刻为准
+    const auto stamp = packet.timestamp.time_since_epoch().count() != 0 ?
+                       packet.timestamp : std::chrono::steady_clock::now();
+
     // 使用std::visit处理不同类型的反馈
-    std::visit([this](auto&& feedback) {
+    std::visit([this, stamp](auto&& feedback) {
         using T = std::decay_t<decltype(feedback)>;
         
         if constexpr (std::is_same_v<T, motor_protocol::MotorStatusFeedback>) {
@@ -588,18 +1654,35 @@ void MotorDriverImpl::handle_bus_packet(const bus::GenericBusPacket& packet) {
             {
                 std::unique_lock<std::shared_mutex> lock(status_map_mutex_);
                 status_map_[key] = feedback.status;  // 线程安全更新状态
+                auto& slot = feedback_slots_[key];
+                if (!slot) {
+                    slot = std::make_unique<MotorFeedbackSlot>();
+                    register_diagnostic_slot(key, slot.get());
+                }
+                slot->publish(feedback.status, stamp);
             }
 
-            // 立即调用回调函数（向后兼容）
-            if (feedback_callback_) {
-                feedback_callback_(feedback.interface, feedback.motor_id, feedback.status);
+            // 跟踪电机实际状态，并在就绪时发出暂存命令
+            update_gate_state(key, feedback.status, stamp);
+
+            // 更新关节状态估计
+            if (estimation_enabled_.load(std::memory_order_acquire)) {
+                update_estimator(feedback.interface, feedback.motor_id, stamp, feedback.status);
             }
 
-            // 通知所有观察者
-            notify_motor_status_observers(feedback.interface, feedback.motor_id, feedback.status);
+            MotorStatusRecord record;
+            record.interface_index = intern_interface(feedback.interface);
+            record.motor_id = feedback.motor_id;
+            record.stamp = stamp;
+            record.status = feedback.status;
 
-            // 发布事件总线事件
-            emit_motor_status_event(feedback.interface, feedback.motor_id, feedback.status);
+            // 周期反馈齐全时在本线程直接运行控制钩子并发送命令
+            if (control_hooks_active_.load(std::memory_order_acquire)) {
+                run_control_hook(feedback.interface, record);
+            }
+
+            // 回调、观察者和事件在突发结束时统一分发
+            status_batch_.push_back(record);
 
 #ifdef PRINT_DEBUG
             std::cout << "Interface: " << feedback.interface << " Motor ID: "
@@ -730,14 +1813,110 @@ void MotorDriverImpl::remove_iap_observer(std::shared_ptr<IAPStatusObserver> obs
         iap_observers_.end());
 }
 
-void MotorDriverImpl::notify_motor_status_observers(const std::string& interface, uint32_t motor_id, const Motor_Status& status) {
+void MotorDriverImpl::dispatch_status_batch() {
+    if (status_batch_.empty()) return;
+    MotorStatusSpan records(status_batch_.data(), status_batch_.size());
+
+    // 批量路径
+    if (batch_feedback_callback_) {
+        batch_feedback_callback_(records);
+    }
+    notify_batch_observers(records);
+
+    // 单电机适配：逐条展开给旧接口
+    if (feedback_callback_) {
+        for (const auto& record : records) {
+            feedback_callback_(get_interface_name(record.interface_index), record.motor_id, record.status);
+        }
+    }
+    notify_motor_status_observers(records);
+
+    // 事件总线发布涉及分配，直通模式下交给数据处理线程
+    if (receive_mode_.load(std::memory_order_relaxed) == ReceiveMode::RUN_TO_COMPLETION) {
+        defer_status_events(records);
+    } else {
+        publish_status_events(records);
+    }
+
+    status_batch_.clear();  // 保留容量，稳态下不再分配
+}
+
+void MotorDriverImpl::defer_status_events(MotorStatusSpan records) {
+    {
+        std::lock_guard<std::mutex> lock(event_bus_mutex_);
+        if (!event_bus_) return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(receive_mutex_);
+        if (pending_status_events_.size() + records.size() > MAX_EVENT_BACKLOG) {
+            // 事件消费跟不上时丢弃积压的旧事件，状态存储与回调不受影响
+            pending_status_events_.clear();
+            std::cerr << "Warning: Status event backlog overflow, dropping pending events" << std::endl;
+        }
+        pending_status_events_.insert(pending_status_events_.end(), records.begin(), records.end());
+        event_backlog_depth_.store(pending_status_events_.size(), std::memory_order_relaxed);
+        wake_data_processing();
+    }
+}
+
+void MotorDriverImpl::publish_status_events(MotorStatusSpan records) {
+    emit_motor_status_records_event(records);
+    for (const auto& record : records) {
+        emit_motor_status_event(get_interface_name(record.interface_index), record.motor_id, record.status);
+    }
+    if (records.empty()) return;
+
+    // 事件时延：发布完成时距突发中最早一条反馈的接收时刻
+    const int64_t lag_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - records[0].stamp).count();
+    event_lag_last_ns_.store(lag_ns, std::memory_order_relaxed);
+    int64_t max = event_lag_max_ns_.load(std::memory_order_relaxed);
+    while (lag_ns > max && !event_lag_max_ns_.compare_exchange_weak(max, lag_ns, std::memory_order_relaxed)) {}
+}
+
+void MotorDriverImpl::add_batch_observer(std::shared_ptr<MotorStatusBatchObserver> observer) {
+    std::lock_guard<std::mutex> lock(batch_observers_mutex_);
+    batch_observers_.push_back(std::weak_ptr<MotorStatusBatchObserver>(observer));
+}
+
+void MotorDriverImpl::remove_batch_observer(std::shared_ptr<MotorStatusBatchObserver> observer) {
+    std::lock_guard<std::mutex> lock(batch_observers_mutex_);
+    batch_observers_.erase(
+        std::remove_if(batch_observers_.begin(), batch_observers_.end(),
+            [&observer](const std::weak_ptr<MotorStatusBatchObserver>& weak_obs) {
+                return weak_obs.lock() == observer;
+            }),
+        batch_observers_.end());
+}
+
+void MotorDriverImpl::notify_batch_observers(MotorStatusSpan records) {
+    std::lock_guard<std::mutex> lock(batch_observers_mutex_);
+
+    for (auto it = batch_observers_.begin(); it != batch_observers_.end(); ) {
+        if (auto observer = it->lock()) {
+            try {
+                observer->on_motor_status_batch(records);
+            } catch (const std::exception& e) {
+                std::cerr << "Observer error in motor status batch: " << e.what() << std::endl;
+            }
+            ++it;
+        } else {
+            it = batch_observers_.erase(it);
+        }
+    }
+}
+
+void MotorDriverImpl::notify_motor_status_observers(MotorStatusSpan records) {
     std::lock_guard<std::mutex> lock(observers_mutex_);
 
     // 使用迭代器遍历，自动清理失效的观察者
     for (auto it = observers_.begin(); it != observers_.end(); ) {
         if (auto observer = it->lock()) {
             try {
-                observer->on_motor_status_update(interface, motor_id, status);
+                for (const auto& record : records) {
+                    observer->on_motor_status_update(get_interface_name(record.interface_index),
+                                                     record.motor_id, record.status);
+                }
                 ++it;
             } catch (const std::exception& e) {
                 std::cerr << "Observer error in motor status update: " << e.what() << std::endl;
@@ -815,6 +1994,7 @@ void MotorDriverImpl::notify_iap_observers(const std::string& interface, uint32_
 // ========== 事件总线集成实现 ==========
 void MotorDriverImpl::set_event_bus(std::shared_ptr<event::EventBus> event_bus) {
     std::lock_guard<std::mutex> lock(event_bus_mutex_);
+    std::atomic_store(&diagnostics_event_bus_, event_bus);
     event_bus_ = std::move(event_bus);
 }
 
@@ -843,6 +2023,28 @@ void MotorDriverImpl::emit_motor_status_event(const std::string& interface, uint
     // }
 }
 
+void MotorDriverImpl::emit_motor_status_records_event(MotorStatusSpan records) {
+    std::shared_ptr<event::EventBus> event_bus;
+    {
+        std::lock_guard<std::mutex> lock(event_bus_mutex_);
+        event_bus = event_bus_;
+    }
+    // 没有订阅者时不复制记录
+    if (!event_bus || !event_bus->has_subscribers<event::MotorStatusRecordsEvent>()) return;
+
+    std::vector<std::string> interface_names;
+    {
+        std::shared_lock<std::shared_mutex> lock(interface_names_mutex_);
+        interface_names.assign(interface_names_.begin(), interface_names_.end());
+    }
+    try {
+        event_bus->publish(std::make_shared<event::MotorStatusRecordsEvent>(
+            std::vector<MotorStatusRecord>(records.begin(), records.end()), std::move(interface_names)));
+    } catch (const std::exception& e) {
+        std::cerr << "Error emitting motor status records event: " << e.what() << std::endl;
+    }
+}
+
 void MotorDriverImpl::emit_motor_batch_status_event(const std::string& interface, const std::map<uint32_t, Motor_Status>& status_all) {
     std::shared_ptr<event::EventBus> event_bus;
     {
@@ -860,6 +2062,22 @@ void MotorDriverImpl::emit_motor_batch_status_event(const std::string& interface
     }
 }
 
+void MotorDriverImpl::emit_bus_tx_error_event(const std::string& interface, bus::TxStatus status, uint32_t consecutive_errors) {
+    std::shared_ptr<event::EventBus> event_bus;
+    {
+        std::lock_guard<std::mutex> lock(event_bus_mutex_);
+        event_bus = event_bus_;
+    }
+
+    if (event_bus) {
+        try {
+            event_bus->emit<event::BusTxErrorEvent>(interface, status, consecutive_errors);
+        } catch (const std::exception& e) {
+            std::cerr << "Error emitting bus tx error event: " << e.what() << std::endl;
+        }
+    }
+}
+
 void MotorDriverImpl::emit_motor_function_result_event(const std::string& interface, uint32_t motor_id, uint8_t op_code, bool success) {
     std::shared_ptr<event::EventBus> event_bus;
     {
@@ -1025,7 +2243,9 @@ void MotorDriverImpl::send_position_cmd_all(const std::string interface,
     std::array<float, 6> efforts = {};
 
     if (motor_protocol::pack_control_all_command(packet.data, packet.len, positions, velocities, efforts, kps, kds)) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -1042,7 +2262,9 @@ void MotorDriverImpl::send_velocity_cmd_all(const std::string interface,
     std::array<float, 6> efforts = {};
 
     if (motor_protocol::pack_control_all_command(packet.data, packet.len, positions, velocities, efforts, kps, kds)) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -1059,7 +2281,9 @@ void MotorDriverImpl::send_effort_cmd_all(const std::string interface,
     std::array<float, 6> velocities = {};
 
     if (motor_protocol::pack_control_all_command(packet.data, packet.len, positions, velocities, efforts, kps, kds)) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -1074,7 +2298,9 @@ void MotorDriverImpl::send_mit_cmd_all(const std::string interface,
     packet.id = 0x000;  // 批量控制使用广播ID
 
     if (motor_protocol::pack_control_all_command(packet.data, packet.len, positions, velocities, efforts, kps, kds)) {
-        send_control_command(packet);
+        if (gate_control_command(packet)) {
+            send_control_command(packet);
+        }
     }
 }
 
@@ -2,11 +2,17 @@
 #define __MOTOR_DRIVER_IMPL_HPP__
 
 #include "hardware_driver/driver/motor_driver_interface.hpp"
+#include "hardware_driver/driver/joint_state_estimator.hpp"
+#include "hardware_driver/driver/command_transaction.hpp"
+#include "hardware_driver/driver/motor_config_snapshot.hpp"
+#include "hardware_driver/driver/diagnostics_shm.hpp"
+#include "driver/motor_feedback_slot.hpp"
 #include "protocol/motor_protocol.hpp"
 #include "protocol/iap_protocol.hpp"
 #include "hardware_driver/bus/bus_interface.hpp"
 #include "hardware_driver/event/event_bus.hpp"
 #include "hardware_driver/event/motor_events.hpp"
+#include "hardware_driver/runtime/runtime.hpp"
 #include <iostream>
 #include <memory>
 #include <unordered_map>
@@ -23,6 +29,8 @@
 #include <memory>
 #include <map>
 #include <array>
+#include <deque>
+#include <future>
 
 // MotorKey 结构体和哈希
 struct Motor_Key {
@@ -55,14 +63,81 @@ enum class CommandPriority : uint8_t {
     EMERGENCY = 3   // 紧急优先级：紧急停止、故障清除
 };
 
+// 诊断采样读取的接口计数：热路径在已持有的锁内以 relaxed 原子量同步一份
+struct InterfaceDiagnosticCounters {
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> backpressure{0};
+    std::atomic<uint64_t> retried{0};
+    std::atomic<uint64_t> retry_succeeded{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> hard_errors{0};
+    std::atomic<uint64_t> escalations{0};
+    std::atomic<uint32_t> consecutive_hard_errors{0};
+    std::atomic<bus::TxStatus> last_error{bus::TxStatus::OK};
+    std::atomic<uint64_t> hook_overruns{0};
+
+    void publish(const TxStats& stats) {
+        sent.store(stats.sent, std::memory_order_relaxed);
+        backpressure.store(stats.backpressure, std::memory_order_relaxed);
+        retried.store(stats.retried, std::memory_order_relaxed);
+        retry_succeeded.store(stats.retry_succeeded, std::memory_order_relaxed);
+        dropped.store(stats.dropped, std::memory_order_relaxed);
+        hard_errors.store(stats.hard_errors, std::memory_order_relaxed);
+        escalations.store(stats.escalations, std::memory_order_relaxed);
+        consecutive_hard_errors.store(stats.consecutive_hard_errors, std::memory_order_relaxed);
+        last_error.store(stats.last_error, std::memory_order_relaxed);
+    }
+
+    TxStats load_tx() const {
+        TxStats stats;
+        stats.sent = sent.load(std::memory_order_relaxed);
+        stats.backpressure = backpressure.load(std::memory_order_relaxed);
+        stats.retried = retried.load(std::memory_order_relaxed);
+        stats.retry_succeeded = retry_succeeded.load(std::memory_order_relaxed);
+        stats.dropped = dropped.load(std::memory_order_relaxed);
+        stats.hard_errors = hard_errors.load(std::memory_order_relaxed);
+        stats.escalations = escalations.load(std::memory_order_relaxed);
+        stats.consecutive_hard_errors = consecutive_hard_errors.load(std::memory_order_relaxed);
+        stats.last_error = last_error.load(std::memory_order_relaxed);
+        return stats;
+    }
+};
+
+// 诊断采样遍历的接口计数与反馈快照，只在新增接口或电机时复制后整体替换
+struct DiagnosticsDirectory {
+    std::vector<std::pair<std::string, std::shared_ptr<InterfaceDiagnosticCounters>>> interfaces;
+    std::unordered_map<Motor_Key, const MotorFeedbackSlot*> slots;     // 反馈槽位只增不删，指针在驱动生命周期内有效
+};
+
+// 命令优先级对应的内核发送类别：使能/失能和紧急停止走最高频带，不受在途帧数限制
+inline bus::TxClass tx_class_for(CommandPriority priority) {
+    switch (priority) {
+        case CommandPriority::LOW: return bus::TxClass::BULK;
+        case CommandPriority::NORMAL: return bus::TxClass::NORMAL;
+        default: return bus::TxClass::URGENT;
+    }
+}
+
+// 已提交的命令事务：整体占用队列中的一个位置，发送完成后兑现 promise
+struct PendingTransaction {
+    std::vector<bus::GenericBusPacket> packets;
+    std::promise<CommandTransactionResult> promise;
+};
+
 // 带优先级的控制命令包装
 struct PriorityCommand {
     bus::GenericBusPacket packet;
     CommandPriority priority;
     std::chrono::steady_clock::time_point timestamp;
+    std::shared_ptr<PendingTransaction> transaction;   // 非空时发送事务中的全部数据帧，忽略 packet
+    uint32_t attempts{0};                              // 因发送队列满已重试的次数
     
     PriorityCommand(const bus::GenericBusPacket& pkt, CommandPriority prio = CommandPriority::NORMAL) 
-        : packet(pkt), priority(prio), timestamp(std::chrono::steady_clock::now()) {}
+        : packet(pkt), priority(prio), timestamp(std::chrono::steady_clock::now()) {
+        packet.tx_class = tx_class_for(prio);
+    }
+    PriorityCommand(std::shared_ptr<PendingTransaction> txn, CommandPriority prio)
+        : packet{}, priority(prio), timestamp(std::chrono::steady_clock::now()), transaction(std::move(txn)) {}
 };
 
 // 优先级比较器：优先级高的先执行，同优先级按时间排序
@@ -82,25 +157,36 @@ struct TimingConfig {
     std::chrono::milliseconds low_freq_feedback{50};     // 低频反馈间隔 (20Hz)
     std::chrono::milliseconds mode_timeout{100};         // 高频模式超时
     int control_cpu_core{4};                           // 控制线程CPU绑定 (-1表示不绑定)(2~5 P核心可以获得最佳实时性能)
+    std::chrono::microseconds airtime_guard{20};       // 按空口时间节拍时，每条命令额外预留的间隔
 };
 
 class MotorDriverImpl : public MotorDriverInterface {
 public:
     // 队列大小限制
     static constexpr size_t MAX_QUEUE_SIZE = 128;
+    // 直通模式下待异步发布的状态事件上限（按记录计）
+    static constexpr size_t MAX_EVENT_BACKLOG = 1024;
     
     // 回调函数类型定义
     using FeedbackCallback = std::function<void(const std::string& interface,
                                                uint32_t motor_id,
                                                const Motor_Status& status)>;
 
+    // 批量状态回调类型：一次接收突发内解码出的全部状态
+    using BatchFeedbackCallback = std::function<void(MotorStatusSpan records)>;
+
     // 按键数据包回调类型 (用于转发按键CAN数据包)
     using ButtonPacketCallback = std::function<void(const std::string& interface,
                                                     uint32_t can_id,
                                                     const uint8_t* data,
                                                     size_t len)>;
 
-    explicit MotorDriverImpl(std::shared_ptr<bus::BusInterface> bus);
+    /**
+     * @param runtime 共享运行时；为空时驱动自建三个工作线程，
+     *                否则反馈请求与控制命令由运行时定时器发出、接收数据在运行时处理线程解码，驱动不创建线程
+     */
+    explicit MotorDriverImpl(std::shared_ptr<bus::BusInterface> bus,
+                             std::shared_ptr<runtime::Runtime> runtime = nullptr);
     
     // 事件总线集成
     void set_event_bus(std::shared_ptr<event::EventBus> event_bus);
@@ -155,6 +241,7 @@ public:
     // 新增公共接口
     void register_feedback_callback(FeedbackCallback callback);
     void register_button_packet_callback(ButtonPacketCallback callback);  // 注册按键数据包回调
+    void register_batch_feedback_callback(BatchFeedbackCallback callback);  // 注册批量状态回调
     void send_control_command(const bus::GenericBusPacket& packet);
     void send_control_command(const bus::GenericBusPacket& packet, CommandPriority priority);
     bool send_control_command_timeout(const bus::GenericBusPacket& packet, std::chrono::milliseconds timeout = std::chrono::milliseconds(10));
@@ -162,24 +249,127 @@ public:
     // 便捷的紧急停止接口
     void send_emergency_stop(const std::string& interface, uint32_t motor_id);
 
-    // 设置要监控的电机配置（用于反馈请求）
+    /**
+     * @brief 整体提交命令事务：一次入队、一次唤醒，事务内命令按顺序连续发送，不与其他命令交错
+     * @param priority 事务整体的优先级，默认与使能命令相同
+     * @return 全部命令发送完成后就绪；空事务立即就绪。驱动析构时未发出的事务抛出 broken_promise
+     *
+     * 事务只占用一个发送间隔；队列满时与 send_control_command 一样阻塞等待。
+     */
+    std::future<CommandTransactionResult> submit_transaction(const CommandTransaction& transaction,
+                                                             CommandPriority priority = CommandPriority::HIGH);
+
+    // 发送失败处理：背压重试策略、按接口的发送统计、连续硬错误上报
+    void set_tx_retry_config(const TxRetryConfig& config);
+    TxRetryConfig get_tx_retry_config() const;
+    std::map<std::string, TxStats> get_tx_stats() const;
+    void register_tx_error_callback(TxErrorCallback callback);
+
+    /**
+     * @brief 按总线估算的空口时间节拍控制命令
+     * 关闭（默认）时发送间隔为 max(control_interval, 空口时间)；开启后为 空口时间 + airtime_guard，
+     * 开启 BRS 后短帧可以远快于固定间隔下发。总线无法估算空口时间时仍使用 control_interval。
+     */
+    void set_airtime_pacing(bool enable) { airtime_pacing_.store(enable, std::memory_order_relaxed); }
+    bool get_airtime_pacing() const { return airtime_pacing_.load(std::memory_order_relaxed); }
+
+    // 设置要监控的电机配置（用于反馈请求），可在运行中替换，原子发布新快照
     void set_motor_config(const std::map<std::string, std::vector<uint32_t>>& config);
+    // 当前配置快照，返回的引用在驱动生命周期内有效
+    const MotorConfigSnapshot& get_motor_config() const { return motor_config_.current(); }
 
-    // 反馈请求控制接口
+    // 反馈请求控制接口（只暂停发送，不改动配置）
     void pause_feedback_request();
     void resume_feedback_request();
 
+    // 关节状态估计接口（基于带时间戳的反馈做延迟补偿，默认关闭）
+    void enable_state_estimation(const JointEstimatorConfig& config = JointEstimatorConfig{});
+    void disable_state_estimation();
+    bool get_estimated_state(const std::string& interface, uint32_t motor_id, JointStateEstimate& estimate) const;
+
+    /**
+     * @brief 设置接口的实时控制钩子（见 ControlHook）
+     * @note 使用调用时 set_motor_config 中该接口的电机列表（最多 6 个）；接口未配置时返回 false
+     */
+    bool set_control_hook(const std::string& interface, ControlHook hook, const ControlHookConfig& config = ControlHookConfig{});
+    void clear_control_hook(const std::string& interface);
+    bool get_control_hook_stats(const std::string& interface, ControlHookStats& stats) const;
+    /**
+     * @brief 把接口上所有电机的状态外推到时刻 t（通常是下一次命令发送时刻）
+     * @note 数组下标与 set_motor_config 中该接口的电机顺序一致
+     * @return 接口未配置或估计未开启时返回 false
+     */
+    bool predict_joint_states(const std::string& interface, std::chrono::steady_clock::time_point t,
+                              std::array<double, 6>& positions, std::array<double, 6>& velocities) const;
+
+    // 命令门控：按电机上报的使能/模式/故障状态在入队前校验控制命令
+    void set_command_gate_config(const CommandGateConfig& config);
+    CommandGateConfig get_command_gate_config() const;
+    CommandGateStats get_command_gate_stats() const;
+    void reset_command_gate_stats();
+    bool get_motor_runtime_state(const std::string& interface, uint32_t motor_id, MotorRuntimeState& state) const;
+
+    /**
+     * @brief 确认式上电：对配置中所有接口的所有电机清错、设置模式并使能，等待状态反馈确认
+     * @return 每个电机的结果与确认耗时；全部确认或 config.timeout 到期时返回
+     * @note 每个接口的命令作为一个事务提交，所有接口先全部发出再统一等待；
+     *       只有命令发出之后收到的反馈才计入确认，未确认的电机每 retry_interval 重发一次
+     */
+    BringUpReport bring_up_motors(const BringUpConfig& config = BringUpConfig{});
+
+    // 读取电机最近一次上报的状态，未收到过反馈时返回 false
+    bool get_motor_status(const std::string& interface, uint32_t motor_id, Motor_Status& status) const;
+    /**
+     * @brief 获取电机的无锁反馈快照，供控制循环每周期读取
+     * @note 槽位在首次请求或首次反馈时创建，之后地址不变，可在循环外取一次后反复读取
+     */
+    const MotorFeedbackSlot* get_feedback_slot(const std::string& interface, uint32_t motor_id);
+
     // 观察者模式接口
     void add_observer(std::shared_ptr<MotorStatusObserver> observer);
     void add_iap_observer(std::shared_ptr<IAPStatusObserver> observer);
     void remove_observer(std::shared_ptr<MotorStatusObserver> observer);
     void remove_iap_observer(std::shared_ptr<IAPStatusObserver> observer);
+    void add_batch_observer(std::shared_ptr<MotorStatusBatchObserver> observer);
+    void remove_batch_observer(std::shared_ptr<MotorStatusBatchObserver> observer);
+
+    /**
+     * @brief 由 MotorStatusRecord::interface_index 查接口名
+     * @note 序号在驱动生命周期内不变，返回的引用一直有效；未知序号返回空字符串
+     */
+    const std::string& get_interface_name(uint16_t index) const;
+
+    /**
+     * @brief 设置接收处理模式，可在运行中切换
+     * @note RUN_TO_COMPLETION 下反馈回调、观察者在总线接收线程上执行，应保持轻量；
+     *       事件总线事件转交数据处理线程发布，不阻塞接收
+     */
+    void set_receive_mode(ReceiveMode mode);
+    ReceiveMode get_receive_mode() const;
+
+    /**
+     * @brief 采集诊断快照：队列深度、各接口收发计数、各电机反馈时刻、控制超时与事件时延
+     * @note 只读取热路径同步的原子计数、无锁反馈快照和诊断目录，不获取控制、接收、发送等热路径上的锁；
+     *       event_lag_max 为上次采样以来的最大值，采样后清零
+     */
+    void sample_diagnostics(DriverDiagnostics& diagnostics);
+
+    /**
+     * @brief 把诊断快照按周期导出到 POSIX 共享内存，供 hwdriver-top 查看
+     * @param shm_name 共享内存名，为空时使用 /hwdriver.<pid>
+     * @return 共享内存创建失败时返回 false；已在导出时返回 true
+     */
+    bool start_diagnostics_export(const std::string& shm_name = "",
+                                  std::chrono::milliseconds period = std::chrono::milliseconds(100));
+    void stop_diagnostics_export();
 
 private:
     std::shared_ptr<bus::BusInterface> bus_;
     // 简化的状态存储 - 使用线程安全哈希表，只保存最新状态
     std::unordered_map<Motor_Key, Motor_Status> status_map_;
     mutable std::shared_mutex status_map_mutex_;  // 读写锁，支持多读者单写者
+    // 无锁反馈快照，与 status_map_ 同时更新；槽位只增不删，由 status_map_mutex_ 保护映射本身
+    std::unordered_map<Motor_Key, std::unique_ptr<MotorFeedbackSlot>> feedback_slots_;
     FeedbackCallback feedback_callback_;
     ButtonPacketCallback button_packet_callback_;  // 按键数据包回调
 
@@ -199,6 +389,14 @@ private:
     std::mutex observers_mutex_;  // 保护观察者列表
     std::mutex iap_observers_mutex_;  // 保护观察者列表
 
+    // 批量状态分发
+    BatchFeedbackCallback batch_feedback_callback_;
+    std::vector<std::weak_ptr<MotorStatusBatchObserver>> batch_observers_;
+    std::mutex batch_observers_mutex_;
+    std::vector<MotorStatusRecord> status_batch_;          // 本次突发的状态记录，由 decode_mutex_ 保护
+    std::deque<std::string> interface_names_;              // 接口序号表，只增不删（deque 保证元素引用稳定）
+    mutable std::shared_mutex interface_names_mutex_;
+
     // 控制命令优先级队列和同步
     std::priority_queue<PriorityCommand, std::vector<PriorityCommand>, PriorityComparator> control_priority_queue_;
     std::mutex control_mutex_;
@@ -210,32 +408,144 @@ private:
     
     // 接收数据队列和同步
     std::queue<bus::GenericBusPacket> receive_queue_;
+    std::queue<bus::GenericBusPacket> receive_burst_;      // 数据处理线程一次取出的数据包，与 receive_queue_ 交换
+    std::atomic<ReceiveMode> receive_mode_{ReceiveMode::QUEUED};
+    std::mutex decode_mutex_;                              // 串行化解码与状态分发（两种模式及多个接收线程共用）
+    std::vector<MotorStatusRecord> pending_status_events_; // 直通模式下待发布的状态事件，由 receive_mutex_ 保护
+    std::vector<MotorStatusRecord> status_event_burst_;    // 数据处理线程一次取出的待发布事件
     std::mutex receive_mutex_;
     std::condition_variable receive_cv_;
 
     // 频率控制
     std::atomic<bool> high_freq_mode_{false};
     std::chrono::steady_clock::time_point last_control_time_;
-    std::map<std::string, std::vector<uint32_t>> interface_motor_config_;
-    std::map<std::string, std::vector<uint32_t>> saved_motor_config_;  // 保存暂停前的配置
+    MotorConfigPublisher motor_config_;                 // 电机配置快照，热路径无锁读取
     std::atomic<bool> feedback_request_paused_{false};  // 反馈请求暂停标记
 
     // 时序参数
     TimingConfig timing_config_;
 
+    // 关节状态估计：每个接口一个估计器，关节下标与配置快照中的电机顺序一致
+    struct EstimatorSlot {
+        const InterfaceMotorTable* table{nullptr};   // 指向重建时的配置快照
+        JointStateEstimator estimator;
+    };
+    std::unordered_map<std::string, EstimatorSlot> estimators_;
+    JointEstimatorConfig estimator_config_;
+    std::atomic<bool> estimation_enabled_{false};
+    mutable std::mutex estimator_mutex_;
+    void rebuild_estimators();   // 调用方需持有 estimator_mutex_
+    void update_estimator(const std::string& interface, uint32_t motor_id,
+                          std::chrono::steady_clock::time_point stamp, const Motor_Status& status);
+
+    // 实时控制钩子：每个接口一个，状态/命令缓冲预先分配，周期内不分配内存
+    static constexpr size_t MAX_HOOK_JOINTS = 6;
+    struct ControlHookSlot {
+        ControlHook hook;
+        ControlHookConfig config;
+        const InterfaceMotorTable* table{nullptr};   // 设置钩子时的配置快照
+        std::array<MotorStatusRecord, MAX_HOOK_JOINTS> state{};
+        std::array<JointCommand, MAX_HOOK_JOINTS> command{};
+        uint32_t received_mask{0};
+        ControlHookStats stats;
+        std::shared_ptr<InterfaceDiagnosticCounters> published;   // 诊断采样读取的超时计数
+    };
+    std::unordered_map<std::string, ControlHookSlot> control_hooks_;
+    std::atomic<bool> control_hooks_active_{false};
+    mutable std::mutex control_hook_mutex_;
+    void run_control_hook(const std::string& interface, const MotorStatusRecord& record);
+
+    // 命令门控：跟踪上报状态、待确认的使能请求和暂存命令
+    struct GateEntry {
+        MotorRuntimeState state;
+        std::chrono::steady_clock::time_point enable_requested;   // 最近一次使能请求时刻
+        uint8_t expected_mode{0};                                 // 最近一次请求的模式
+        bool mode_known{false};
+        bool has_deferred{false};
+        bus::GenericBusPacket deferred;
+        std::chrono::steady_clock::time_point deferred_at;
+    };
+    enum class GateDecision : uint8_t { SEND, DEFER, REJECT_DISABLED, REJECT_FAULT, REJECT_MODE };
+    std::unordered_map<Motor_Key, GateEntry> gate_entries_;
+    CommandGateConfig gate_config_;
+    CommandGateStats gate_stats_;
+    mutable std::mutex gate_mutex_;
+    std::condition_variable gate_cv_;           // 上报状态更新时通知 bring_up_motors
+    std::atomic<int> gate_waiters_{0};
+    bool gate_control_command(const bus::GenericBusPacket& packet);   // 返回 true 表示立即入队
+    GateDecision evaluate_gate(const GateEntry& entry, std::chrono::steady_clock::time_point now) const;   // 调用方需持有 gate_mutex_
+    bool is_enable_pending(const GateEntry& entry, std::chrono::steady_clock::time_point now) const;
+    void mark_mode_requested(const std::string& interface, const std::vector<uint32_t>& motor_ids, uint8_t mode, bool enable);
+    void update_gate_state(const Motor_Key& key, const Motor_Status& status, std::chrono::steady_clock::time_point stamp);
+
     // 三线程架构
     std::thread feedback_request_thread_;   // 反馈线程：发送请求
     std::thread data_processing_thread_;   // 数据处理线程：处理接收队列
     std::thread control_thread_;    // 控制线程：专门发送控制命令
     std::atomic<bool> running_{true};
 
+    // 共享运行时模式
+    std::shared_ptr<runtime::Runtime> runtime_;
+    runtime::Runtime::TimerId feedback_timer_id_{0};
+    runtime::Runtime::TimerId control_timer_id_{0};            // 由 control_mutex_ 保护，0 表示发送定时器未激活
+    std::chrono::steady_clock::time_point next_control_send_;  // 由 control_mutex_ 保护
+    bool drain_scheduled_{false};                              // 由 receive_mutex_ 保护，已投递解码任务
+
     // 三线程工作函数
     void feedback_request_worker();        // 反馈请求线程：定时发送反馈请求
     void data_processing_worker();         // 数据处理线程：阻塞处理接收队列  
     void control_worker();                 // 控制线程：发送控制命令
+
+    // 线程与运行时两种模式共用的处理单元
+    std::chrono::steady_clock::time_point feedback_request_tick(std::chrono::steady_clock::time_point now);  // 返回下次请求时刻
+    void process_receive_burst();          // 解码 receive_burst_ 并发布 status_event_burst_
+    void drain_receive_queue();            // 运行时任务：处理完积压的接收数据后退出
+    void wake_data_processing();           // 调用方需持有 receive_mutex_
+    void wake_control();                   // 新命令入队后唤醒控制线程或启动发送定时器
+    std::chrono::steady_clock::time_point control_tick();   // 运行时定时器：发送一条控制命令
+    bool transmit_command(PriorityCommand& command);  // 发送单条命令或整个事务，占用一个发送间隔；返回 true 表示需重新入队
+    void transmit_transaction(PriorityCommand& command);
+
+    // 发送错误处理：所有发送都经过 send_frame 统计，控制命令背压时按优先级和有效期重试
+    bus::TxStatus send_frame(const bus::GenericBusPacket& packet, bool is_retry = false);
+    bool can_retry(CommandPriority priority, std::chrono::steady_clock::time_point enqueued, uint32_t attempts) const;
+    std::chrono::microseconds tx_backoff() const;
+    std::chrono::nanoseconds pacing_interval(const PriorityCommand& command) const;
+    std::atomic<bool> airtime_pacing_{false};
+    TxRetryConfig tx_retry_config_;
+    struct TxStatsEntry {
+        TxStats stats;
+        std::shared_ptr<InterfaceDiagnosticCounters> published;  // 每次更新后同步，供诊断采样读取
+    };
+    TxStatsEntry& tx_stats_entry(const std::string& interface);   // 调用方需持有 tx_mutex_
+    std::unordered_map<std::string, TxStatsEntry> tx_stats_;
+    TxErrorCallback tx_error_callback_;
+    mutable std::mutex tx_mutex_;
+
+    // 诊断：控制超时计数、事件发布时延，以及可选的共享内存导出线程
+    std::atomic<uint64_t> control_deadline_misses_{0};
+    std::atomic<int64_t> event_lag_last_ns_{0};
+    std::atomic<int64_t> event_lag_max_ns_{0};
+    std::unique_ptr<diagnostics::DiagnosticsExporter> diagnostics_exporter_;
+    std::mutex diagnostics_mutex_;
+    // 诊断采样不获取热路径上的锁：队列深度由入队/出队方在已持有的锁内同步，
+    // 接口计数与反馈快照通过只在新增接口/电机时整体替换的目录查找（std::atomic_load/atomic_store）
+    std::atomic<size_t> control_queue_depth_{0};
+    std::atomic<size_t> receive_queue_depth_{0};
+    std::atomic<size_t> event_backlog_depth_{0};
+    std::shared_ptr<const DiagnosticsDirectory> diagnostics_directory_;
+    std::mutex diagnostics_directory_mutex_;     // 只串行化目录替换，不与其他锁嵌套获取
+    std::shared_ptr<event::EventBus> diagnostics_event_bus_;   // 与 event_bus_ 同步设置，采样时 atomic_load
+    std::shared_ptr<InterfaceDiagnosticCounters> diagnostic_counters(const std::string& interface);
+    void register_diagnostic_slot(const Motor_Key& key, const MotorFeedbackSlot* slot);
     
     // 数据处理函数  
-    void handle_bus_packet(const bus::GenericBusPacket& packet);  // 处理单个数据包
+    void handle_bus_packet(const bus::GenericBusPacket& packet);  // 处理单个数据包并立即分发状态
+    void process_bus_packet(const bus::GenericBusPacket& packet);  // 解码数据包，状态记录追加到 status_batch_
+    void dispatch_status_batch();                                  // 分发并清空 status_batch_
+    void defer_status_events(MotorStatusSpan records);             // 交给数据处理线程发布事件
+    void publish_status_events(MotorStatusSpan records);           // 发布批量及单电机状态事件
+    uint16_t intern_interface(const std::string& interface);
     // 请求反馈数据
     bus::GenericBusPacket create_feedback_request_all(const std::string& interface);
     
@@ -247,7 +557,8 @@ private:
     void cleanup_cpu_binding();
     
     // 通知观察者的私有方法
-    void notify_motor_status_observers(const std::string& interface, uint32_t motor_id, const Motor_Status& status);
+    void notify_motor_status_observers(MotorStatusSpan records);
+    void notify_batch_observers(MotorStatusSpan records);
     void notify_function_result_observers(const std::string& interface, uint32_t motor_id, uint8_t op_code, bool success);
     void notify_parameter_result_observers(const std::string& interface, uint32_t motor_id, uint16_t address, uint8_t data_type, const std::any& data);
     void notify_iap_observers(const std::string& interface, uint32_t motor_id, IAPStatus msg);
@@ -262,6 +573,8 @@ private:
     // 事件发布方法
     void emit_motor_status_event(const std::string& interface, uint32_t motor_id, const Motor_Status& status);
     void emit_motor_batch_status_event(const std::string& interface, const std::map<uint32_t, Motor_Status>& status_all);
+    void emit_motor_status_records_event(MotorStatusSpan records);
+    void emit_bus_tx_error_event(const std::string& interface, bus::TxStatus status, uint32_t consecutive_errors);
     void emit_motor_function_result_event(const std::string& interface, uint32_t motor_id, uint8_t op_code, bool success);
     void emit_motor_parameter_result_event(const std::string& interface, uint32_t motor_id, uint16_t address, uint8_t data_type, const std::any& data);
 
@@ -0,0 +1,80 @@
+#ifndef __MOTOR_FEEDBACK_SLOT_HPP__
+#define __MOTOR_FEEDBACK_SLOT_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "hardware_driver/driver/motor_driver_interface.hpp"
+
+namespace hardware_driver {
+namespace motor_driver {
+
+/**
+ * @brief 单个电机最新反馈的无锁快照（seqlock）
+ *
+ * 只有数据处理线程写入；控制循环等读者不加锁读取，读到写入中途的数据时重试。
+ * 字段都是 relaxed 原子量，一致性由序号保证。
+ */
+class MotorFeedbackSlot {
+public:
+    struct Snapshot {
+        float position{0.0f};
+        float velocity{0.0f};
+        float effort{0.0f};
+        uint32_t error_code{0};
+        bool enabled{false};
+        uint8_t motor_mode{0};
+        std::chrono::steady_clock::time_point stamp;
+        uint32_t updates{0};        // 累计写入次数，可用于判断是否有新反馈
+    };
+
+    void publish(const Motor_Status& status, std::chrono::steady_clock::time_point stamp) {
+        const uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        position_.store(status.position, std::memory_order_relaxed);
+        velocity_.store(status.velocity, std::memory_order_relaxed);
+        effort_.store(status.effort, std::memory_order_relaxed);
+        error_code_.store(status.error_code, std::memory_order_relaxed);
+        enabled_.store(status.enable_flag != 0, std::memory_order_relaxed);
+        motor_mode_.store(status.motor_mode, std::memory_order_relaxed);
+        stamp_ns_.store(stamp.time_since_epoch().count(), std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // 从未写入或连续多次读到写入中途时返回 false
+    bool read(Snapshot& out) const {
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            const uint32_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1u) continue;
+            out.position = position_.load(std::memory_order_relaxed);
+            out.velocity = velocity_.load(std::memory_order_relaxed);
+            out.effort = effort_.load(std::memory_order_relaxed);
+            out.error_code = error_code_.load(std::memory_order_relaxed);
+            out.enabled = enabled_.load(std::memory_order_relaxed);
+            out.motor_mode = motor_mode_.load(std::memory_order_relaxed);
+            const int64_t stamp_ns = stamp_ns_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) != before) continue;
+            out.stamp = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(stamp_ns));
+            out.updates = before / 2;
+            return before != 0;
+        }
+        return false;
+    }
+
+private:
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<float> position_{0.0f};
+    std::atomic<float> velocity_{0.0f};
+    std::atomic<float> effort_{0.0f};
+    std::atomic<uint32_t> error_code_{0};
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint8_t> motor_mode_{0};
+    std::atomic<int64_t> stamp_ns_{0};
+};
+
+}   // namespace motor_driver
+}   // namespace hardware_driver
+
+#endif // __MOTOR_FEEDBACK_SLOT_HPP__
@@ -0,0 +1,63 @@
+#include "hardware_driver/interface/joint_buffers.hpp"
+#include "hardware_driver/driver/motor_driver_interface.hpp"
+#include "driver/motor_feedback_slot.hpp"
+#include <algorithm>
+
+namespace hardware_driver {
+
+JointBuffers::JointBuffers(std::shared_ptr<motor_driver::MotorDriverInterface> motor_driver,
+                           std::string interface, std::vector<uint32_t> motor_ids,
+                           const std::vector<const motor_driver::MotorFeedbackSlot*>& slots)
+    : motor_driver_(std::move(motor_driver)),
+      interface_(std::move(interface)),
+      motor_ids_(std::move(motor_ids)),
+      joint_count_(std::min(motor_ids_.size(), kMaxJoints)) {
+    for (size_t i = 0; i < joint_count_ && i < slots.size(); ++i) {
+        slots_[i] = slots[i];
+    }
+    // 与 send_mit_cmd_all 的默认增益一致
+    kp_.fill(0.05);
+    kd_.fill(0.005);
+}
+
+size_t JointBuffers::read() {
+    size_t fresh = 0;
+    motor_driver::MotorFeedbackSlot::Snapshot snapshot;
+    for (size_t i = 0; i < joint_count_; ++i) {
+        if (!slots_[i] || !slots_[i]->read(snapshot)) {
+            continue;
+        }
+        const int64_t stamp_ns = snapshot.stamp.time_since_epoch().count();
+        if (stamp_ns == stamp_ns_[i]) {
+            continue;   // 自上次 read() 以来没有新反馈
+        }
+        position_[i] = snapshot.position;
+        velocity_[i] = snapshot.velocity;
+        effort_[i] = snapshot.effort;
+        error_code_[i] = snapshot.error_code;
+        stamp_ns_[i] = stamp_ns;
+        ++fresh;
+    }
+    return fresh;
+}
+
+void JointBuffers::write() {
+    if (!motor_driver_) {
+        return;
+    }
+    std::array<float, kMaxJoints> positions = {};
+    std::array<float, kMaxJoints> velocities = {};
+    std::array<float, kMaxJoints> efforts = {};
+    std::array<float, kMaxJoints> kps = {};
+    std::array<float, kMaxJoints> kds = {};
+    for (size_t i = 0; i < joint_count_; ++i) {
+        positions[i] = static_cast<float>(command_position_[i]);
+        velocities[i] = static_cast<float>(command_velocity_[i]);
+        efforts[i] = static_cast<float>(command_effort_[i]);
+        kps[i] = static_cast<float>(kp_[i]);
+        kds[i] = static_cast<float>(kd_[i]);
+    }
+    motor_driver_->send_mit_cmd_all(interface_, positions, velocities, efforts, kps, kds);
+}
+
+}   // namespace hardware_driver
@@ -4,8 +4,10 @@
 #include "driver/gripper_driver_impl.hpp"
 #include "driver/button_driver_impl.hpp"
 #include "bus/canfd_bus_impl.hpp"
+#include "interface/tracking_monitor.hpp"
 // #include "bus/usb2canfd_bus_impl.hpp"
 #include <chrono>
+#include <cmath>
 #include <thread>
 #include <cstring>
 #include <iostream>
@@ -21,7 +23,7 @@ RobotHardware::RobotHardware(
     const std::map<std::string, std::vector<uint32_t>>& interface_motor_config,
     MotorStatusCallback callback)
     : motor_driver_(std::move(motor_driver)),
-      interface_motor_config_(interface_motor_config),
+      motor_config_(interface_motor_config),
       status_callback_(callback),
       batch_status_callback_(nullptr),
       event_bus_(nullptr),
@@ -40,7 +42,7 @@ RobotHardware::RobotHardware(
         }
         
         // 设置电机配置，启动反馈请求
-        motor_driver_impl->set_motor_config(interface_motor_config_);
+        motor_driver_impl->set_motor_config(interface_motor_config);
     }
 }
 
@@ -50,7 +52,7 @@ RobotHardware::RobotHardware(
     const std::map<std::string, std::vector<uint32_t>>& interface_motor_config,
     MotorBatchStatusCallback batch_callback)
     : motor_driver_(std::move(motor_driver)),
-      interface_motor_config_(interface_motor_config),
+      motor_config_(interface_motor_config),
       status_callback_(nullptr),
       batch_status_callback_(batch_callback),
       event_bus_(nullptr),
@@ -72,7 +74,7 @@ RobotHardware::RobotHardware(
         );
         
         // 设置电机配置，启动反馈请求
-        motor_driver_impl->set_motor_config(interface_motor_config_);
+        motor_driver_impl->set_motor_config(interface_motor_config);
     }
 }
 
@@ -82,7 +84,7 @@ RobotHardware::RobotHardware(
     const std::map<std::string, std::vector<uint32_t>>& interface_motor_config,
     std::shared_ptr<hardware_driver::motor_driver::MotorStatusObserver> observer)
     : motor_driver_(std::move(motor_driver)),
-      interface_motor_config_(interface_motor_config),
+      motor_config_(interface_motor_config),
       status_callback_(nullptr),
       batch_status_callback_(nullptr),
       event_bus_(nullptr),
@@ -99,7 +101,7 @@ RobotHardware::RobotHardware(
         motor_driver_impl->add_observer(current_observer_);
 
         // 设置电机配置，启动反馈请求
-        motor_driver_impl->set_motor_config(interface_motor_config_);
+        motor_driver_impl->set_motor_config(interface_motor_config);
 
         std::cout << "RobotHardware initialized with Observer - status updates will be handled by observer" << std::endl;
     }
@@ -111,7 +113,7 @@ RobotHardware::RobotHardware(
     const std::map<std::string, std::vector<uint32_t>>& interface_motor_config,
     std::shared_ptr<hardware_driver::motor_driver::IAPStatusObserver> iap_observer)
     : motor_driver_(std::move(motor_driver)),
-      interface_motor_config_(interface_motor_config),
+      motor_config_(interface_motor_config),
       status_callback_(nullptr),
       batch_status_callback_(nullptr),
       event_bus_(nullptr),
@@ -129,7 +131,7 @@ RobotHardware::RobotHardware(
         motor_driver_impl->add_iap_observer(current_iap_observer_);
 
         // 设置电机配置，启动反馈请求
-        motor_driver_impl->set_motor_config(interface_motor_config_);
+        motor_driver_impl->set_motor_config(interface_motor_config);
 
         std::cout << "RobotHardware initialized with IAPStatusObserver - IAP updates will be handled by observer" << std::endl;
     }
@@ -142,7 +144,7 @@ RobotHardware::RobotHardware(
     std::shared_ptr<hardware_driver::event::EventBus> event_bus,
     std::shared_ptr<hardware_driver::motor_driver::MotorEventHandler> event_handler)
     : motor_driver_(std::move(motor_driver)),
-      interface_motor_config_(interface_motor_config),
+      motor_config_(interface_motor_config),
       status_callback_(nullptr),
       batch_status_callback_(nullptr),
       event_bus_(std::move(event_bus)),
@@ -225,13 +227,35 @@ RobotHardware::RobotHardware(
         );
         
         // 设置电机配置，启动反馈请求
-        motor_driver_impl->set_motor_config(interface_motor_config_);
+        motor_driver_impl->set_motor_config(interface_motor_config);
         
         std::cout << "RobotHardware initialized with EventBus and EventHandler" << std::endl;
     }
 }
 
-RobotHardware::~RobotHardware() = default;
+void RobotHardware::set_motor_config(const std::map<std::string, std::vector<uint32_t>>& interface_motor_config) {
+    motor_config_.publish(interface_motor_config);
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->set_motor_config(interface_motor_config);
+    }
+}
+
+RobotHardware::~RobotHardware() {
+    // 停止轨迹队列执行线程
+    std::lock_guard<std::mutex> lock(trajectory_queues_mutex_);
+    for (auto& [interface, queue] : trajectory_queues_) {
+        {
+            std::lock_guard<std::mutex> queue_lock(queue->mutex);
+            queue->stop = true;
+        }
+        queue->cv.notify_all();
+        if (queue->worker.joinable()) {
+            queue->worker.join();
+        }
+    }
+    trajectory_queues_.clear();
+}
 
 // 内部状态聚合方法实现
 void RobotHardware::handle_motor_status_with_aggregation(const std::string& interface, uint32_t motor_id, 
@@ -249,9 +273,9 @@ void RobotHardware::handle_motor_status_with_aggregation(const std::string& inte
         status_cache_[interface][motor_id] = status;
         
         // 检查是否收集齐该总线上的所有电机数据
-        auto config_it = interface_motor_config_.find(interface);
-        if (config_it != interface_motor_config_.end()) {
-            const auto& expected_motors = config_it->second;
+        const auto* motor_table = motor_config_.current().find(interface);
+        if (motor_table) {
+            const auto& expected_motors = motor_table->motor_ids;
             auto& interface_cache = status_cache_[interface];
             
             // 检查是否所有期望的电机都有数据
@@ -319,13 +343,13 @@ bool RobotHardware::send_realtime_velocity_command(const std::string& interface,
                                                   const std::array<double, 6>& kps,
                                                   const std::array<double, 6>& kds) {
 
-    auto config_it = interface_motor_config_.find(interface);
-    if (config_it == interface_motor_config_.end()) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
         return false;
     }
 
     try {
-        const auto& motor_ids = config_it->second;
+        const auto& motor_ids = motor_table->motor_ids;
 
         // 验证电机数量不超过 6
         if (motor_ids.size() > 6) {
@@ -356,13 +380,13 @@ bool RobotHardware::send_realtime_position_command(const std::string& interface,
                                                   const std::array<double, 6>& kps,
                                                   const std::array<double, 6>& kds) {
 
-    auto config_it = interface_motor_config_.find(interface);
-    if (config_it == interface_motor_config_.end()) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
         return false;
     }
 
     try {
-        const auto& motor_ids = config_it->second;
+        const auto& motor_ids = motor_table->motor_ids;
 
         // 验证电机数量不超过 6
         if (motor_ids.size() > 6) {
@@ -393,13 +417,13 @@ bool RobotHardware::send_realtime_effort_command(const std::string& interface,
                                                 const std::array<double, 6>& kps,
                                                 const std::array<double, 6>& kds) {
 
-    auto config_it = interface_motor_config_.find(interface);
-    if (config_it == interface_motor_config_.end()) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
         return false;
     }
 
     try {
-        const auto& motor_ids = config_it->second;
+        const auto& motor_ids = motor_table->motor_ids;
 
         // 验证电机数量不超过 6
         if (motor_ids.size() > 6) {
@@ -432,13 +456,13 @@ bool RobotHardware::send_realtime_mit_command(const std::string& interface,
                                               const std::array<double, 6>& kps,
                                               const std::array<double, 6>& kds) {
 
-    auto config_it = interface_motor_config_.find(interface);
-    if (config_it == interface_motor_config_.end()) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
         return false;
     }
 
     try {
-        const auto& motor_ids = config_it->second;
+        const auto& motor_ids = motor_table->motor_ids;
 
         // 验证电机数量不超过 6
         if (motor_ids.size() > 6) {
@@ -470,17 +494,21 @@ bool RobotHardware::send_realtime_mit_command(const std::string& interface,
 
 //  轨迹执行接口 
 bool RobotHardware::execute_trajectory(const std::string& interface, const Trajectory& trajectory) {
-    auto config_it = interface_motor_config_.find(interface);
-    if (config_it == interface_motor_config_.end()) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
         return false;
     }
     
     if (trajectory.points.empty()) {
         return false;
     }
+
+    if (!check_trajectory_before_execution(interface, trajectory)) {
+        return false;
+    }
     
     try {
-        const auto& motor_ids = config_it->second;
+        const auto& motor_ids = motor_table->motor_ids;
         auto start_time = std::chrono::steady_clock::now();
         size_t total_points = trajectory.points.size();
         
@@ -652,6 +680,485 @@ void RobotHardware::resume_status_monitoring() {
     }
 }
 
+// ========== 关节状态估计接口 ==========
+void RobotHardware::enable_state_estimation(const hardware_driver::motor_driver::JointEstimatorConfig& config) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->enable_state_estimation(config);
+    }
+}
+
+void RobotHardware::disable_state_estimation() {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->disable_state_estimation();
+    }
+}
+
+bool RobotHardware::get_estimated_joint_state(const std::string& interface, uint32_t motor_id,
+                                              hardware_driver::motor_driver::JointStateEstimate& estimate) const {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        return false;
+    }
+    return motor_driver_impl->get_estimated_state(interface, motor_id, estimate);
+}
+
+bool RobotHardware::predict_joint_states(const std::string& interface,
+                                         std::chrono::steady_clock::time_point t,
+                                         std::array<double, 6>& positions,
+                                         std::array<double, 6>& velocities) const {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        return false;
+    }
+    return motor_driver_impl->predict_joint_states(interface, t, positions, velocities);
+}
+
+// ========== 轨迹校验 ==========
+
+void RobotHardware::set_trajectory_validation(const std::string& interface,
+                                              const hardware_driver::trajectory::TrajectoryValidationLimits& limits) {
+    std::lock_guard<std::mutex> lock(trajectory_validation_mutex_);
+    trajectory_validation_limits_[interface] = limits;
+}
+
+void RobotHardware::disable_trajectory_validation(const std::string& interface) {
+    std::lock_guard<std::mutex> lock(trajectory_validation_mutex_);
+    trajectory_validation_limits_.erase(interface);
+}
+
+bool RobotHardware::validate_trajectory(const std::string& interface, const Trajectory& trajectory,
+                                        hardware_driver::trajectory::TrajectoryValidationResult& result) const {
+    return validate_trajectory(interface, trajectory, result, true);
+}
+
+bool RobotHardware::validate_trajectory(const std::string& interface, const Trajectory& trajectory,
+                                        hardware_driver::trajectory::TrajectoryValidationResult& result,
+                                        bool check_start_distance) const {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
+        return false;
+    }
+    const auto& motor_ids = motor_table->motor_ids;
+
+    hardware_driver::trajectory::TrajectoryValidationLimits limits;
+    {
+        std::lock_guard<std::mutex> lock(trajectory_validation_mutex_);
+        auto it = trajectory_validation_limits_.find(interface);
+        if (it != trajectory_validation_limits_.end()) {
+            limits = it->second;
+        }
+    }
+    if (!check_start_distance) {
+        limits.max_start_distance = 0.0;
+    }
+
+    // 起点距离相对电机最近上报的位置；任一电机没有反馈时跳过该项
+    std::vector<double> current_positions;
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (limits.max_start_distance > 0.0 && motor_driver_impl) {
+        for (uint32_t motor_id : motor_ids) {
+            hardware_driver::motor_driver::Motor_Status status;
+            if (!motor_driver_impl->get_motor_status(interface, motor_id, status)) {
+                current_positions.clear();
+                break;
+            }
+            current_positions.push_back(status.position);
+        }
+    }
+
+    hardware_driver::trajectory::TrajectoryValidator validator(limits);
+    result = validator.validate(trajectory, motor_ids.size(),
+                                current_positions.empty() ? nullptr : &current_positions);
+    return result.valid;
+}
+
+hardware_driver::trajectory::TrajectoryValidationResult RobotHardware::get_last_trajectory_validation(
+    const std::string& interface) const {
+    std::lock_guard<std::mutex> lock(trajectory_validation_mutex_);
+    auto it = last_trajectory_validation_.find(interface);
+    if (it == last_trajectory_validation_.end()) {
+        return hardware_driver::trajectory::TrajectoryValidationResult{};
+    }
+    return it->second;
+}
+
+bool RobotHardware::check_trajectory_before_execution(const std::string& interface, const Trajectory& trajectory,
+                                                      bool check_start_distance) {
+    {
+        std::lock_guard<std::mutex> lock(trajectory_validation_mutex_);
+        if (trajectory_validation_limits_.find(interface) == trajectory_validation_limits_.end()) {
+            return true;
+        }
+    }
+
+    hardware_driver::trajectory::TrajectoryValidationResult result;
+    bool valid = validate_trajectory(interface, trajectory, result, check_start_distance);
+    if (!valid) {
+        std::cerr << "[RobotHardware] Trajectory rejected on " << interface << ": " << result.summary() << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(trajectory_validation_mutex_);
+    last_trajectory_validation_[interface] = std::move(result);
+    return valid;
+}
+
+// ========== 轨迹队列实现 ==========
+
+void RobotHardware::set_trajectory_blend_config(const hardware_driver::trajectory::TrajectoryBlendConfig& config) {
+    std::lock_guard<std::mutex> lock(trajectory_queues_mutex_);
+    trajectory_blend_config_ = config;
+}
+
+RobotHardware::TrajectoryQueue* RobotHardware::get_trajectory_queue(const std::string& interface, bool create) {
+    std::lock_guard<std::mutex> lock(trajectory_queues_mutex_);
+    auto it = trajectory_queues_.find(interface);
+    if (it != trajectory_queues_.end()) {
+        return it->second.get();
+    }
+    if (!create) {
+        return nullptr;
+    }
+
+    auto queue = std::make_unique<TrajectoryQueue>();
+    auto* raw = queue.get();
+    raw->worker = std::thread(&RobotHardware::trajectory_queue_worker, this, raw, interface);
+    trajectory_queues_[interface] = std::move(queue);
+    return raw;
+}
+
+bool RobotHardware::enqueue_trajectory(const std::string& interface, const Trajectory& trajectory) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
+        return false;
+    }
+    if (trajectory.points.empty()) {
+        return false;
+    }
+
+    // 所有点的关节数必须一致
+    const size_t dof = trajectory.points.front().positions.size();
+    if (dof == 0) {
+        return false;
+    }
+    for (const auto& point : trajectory.points) {
+        if (point.positions.size() != dof) {
+            std::cerr << "[TrajectoryQueue] Inconsistent joint count in trajectory" << std::endl;
+            return false;
+        }
+    }
+
+    // 接在正在执行的轨迹之后时，起点应与队尾衔接而不是当前位置，不做起点距离检查
+    bool continuing = false;
+    if (auto* existing = get_trajectory_queue(interface, false)) {
+        std::lock_guard<std::mutex> lock(existing->mutex);
+        continuing = existing->active;
+    }
+    if (!check_trajectory_before_execution(interface, trajectory, !continuing)) {
+        return false;
+    }
+
+    hardware_driver::trajectory::TrajectoryBlendConfig blend_config;
+    {
+        std::lock_guard<std::mutex> lock(trajectory_queues_mutex_);
+        blend_config = trajectory_blend_config_;
+    }
+
+    auto* queue = get_trajectory_queue(interface, true);
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        auto now = std::chrono::steady_clock::now();
+
+        if (!queue->active || queue->stream.points.empty()) {
+            queue->stream = trajectory;
+            queue->start_time = now;
+            queue->next_index = 0;
+            queue->active = true;
+        } else {
+            if (queue->stream.points.front().positions.size() != dof) {
+                std::cerr << "[TrajectoryQueue] Joint count differs from queued trajectory" << std::endl;
+                return false;
+            }
+
+            // 丢弃已发送的点，保留两个用于衔接处的差分
+            if (queue->next_index > 2) {
+                size_t drop = queue->next_index - 2;
+                queue->stream.points.erase(queue->stream.points.begin(), queue->stream.points.begin() + drop);
+                queue->next_index -= drop;
+            }
+
+            double elapsed = std::chrono::duration<double>(now - queue->start_time).count();
+            queue->stream = hardware_driver::trajectory::blend_trajectories(
+                queue->stream, trajectory, blend_config, elapsed + blend_config.min_lead_time);
+        }
+    }
+    queue->cv.notify_all();
+    return true;
+}
+
+double RobotHardware::get_trajectory_queue_remaining_time(const std::string& interface) const {
+    TrajectoryQueue* queue = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(trajectory_queues_mutex_);
+        auto it = trajectory_queues_.find(interface);
+        if (it == trajectory_queues_.end()) {
+            return 0.0;
+        }
+        queue = it->second.get();
+    }
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->active || queue->stream.points.empty()) {
+        return 0.0;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - queue->start_time).count();
+    return std::max(0.0, queue->stream.points.back().time_from_start - elapsed);
+}
+
+bool RobotHardware::wait_for_trajectory_queue(const std::string& interface, int timeout_ms) {
+    auto* queue = get_trajectory_queue(interface, false);
+    if (!queue) {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    auto idle = [queue]() { return !queue->active || queue->stop; };
+    if (timeout_ms == 0) {
+        queue->cv.wait(lock, idle);
+        return true;
+    }
+    return queue->cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), idle);
+}
+
+void RobotHardware::clear_trajectory_queue(const std::string& interface) {
+    auto* queue = get_trajectory_queue(interface, false);
+    if (!queue) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->stream.points.clear();
+        queue->next_index = 0;
+        queue->active = false;
+    }
+    queue->cv.notify_all();
+}
+
+void RobotHardware::trajectory_queue_worker(TrajectoryQueue* queue, std::string interface) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    const size_t motor_count = motor_table ? motor_table->motor_ids.size() : 0;
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    while (!queue->stop) {
+        if (!queue->active || queue->next_index >= queue->stream.points.size()) {
+            if (queue->active) {
+                queue->active = false;
+                queue->cv.notify_all();
+            }
+            queue->cv.wait(lock, [queue]() {
+                return queue->stop || (queue->active && queue->next_index < queue->stream.points.size());
+            });
+            continue;
+        }
+
+        // 等待到点的发送时刻；期间入队会修改执行流，被唤醒后重新取点
+        const auto& point = queue->stream.points[queue->next_index];
+        auto target_time = queue->start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(point.time_from_start));
+        if (std::chrono::steady_clock::now() < target_time) {
+            queue->cv.wait_until(lock, target_time);
+            continue;
+        }
+
+        std::array<float, 6> positions = {};
+        std::array<float, 6> velocities = {};
+        std::array<float, 6> efforts = {};
+        for (size_t i = 0; i < std::min(motor_count, positions.size()) && i < point.positions.size(); ++i) {
+            positions[i] = static_cast<float>(point.positions[i]);
+        }
+        ++queue->next_index;
+
+        lock.unlock();
+        motor_driver_->send_mit_cmd_all(interface, positions, velocities, efforts);
+        lock.lock();
+    }
+}
+
+// ========== 批量读写缓冲 ==========
+
+std::shared_ptr<hardware_driver::JointBuffers> RobotHardware::create_joint_buffers(const std::string& interface) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
+        return nullptr;
+    }
+
+    // 非 MotorDriverImpl 的驱动没有反馈槽位，read() 不更新状态，write() 仍可用
+    std::vector<const hardware_driver::motor_driver::MotorFeedbackSlot*> slots;
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        for (uint32_t motor_id : motor_table->motor_ids) {
+            slots.push_back(motor_driver_impl->get_feedback_slot(interface, motor_id));
+        }
+    }
+    return std::make_shared<hardware_driver::JointBuffers>(motor_driver_, interface, motor_table->motor_ids, slots);
+}
+
+// ========== 批量状态观察者 ==========
+
+bool RobotHardware::add_status_batch_observer(
+    std::shared_ptr<hardware_driver::motor_driver::MotorStatusBatchObserver> observer) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl || !observer) {
+        return false;
+    }
+    motor_driver_impl->add_batch_observer(observer);
+    return true;
+}
+
+void RobotHardware::remove_status_batch_observer(
+    std::shared_ptr<hardware_driver::motor_driver::MotorStatusBatchObserver> observer) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->remove_batch_observer(observer);
+    }
+}
+
+std::string RobotHardware::get_interface_name(uint16_t interface_index) const {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    return motor_driver_impl ? motor_driver_impl->get_interface_name(interface_index) : std::string();
+}
+
+void RobotHardware::set_receive_mode(hardware_driver::motor_driver::ReceiveMode mode) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->set_receive_mode(mode);
+    }
+}
+
+// ========== 实时控制钩子 ==========
+
+bool RobotHardware::set_control_hook(const std::string& interface, hardware_driver::motor_driver::ControlHook hook,
+                                     const hardware_driver::motor_driver::ControlHookConfig& config) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        std::cerr << "Control hook requires MotorDriverImpl" << std::endl;
+        return false;
+    }
+    return motor_driver_impl->set_control_hook(interface, std::move(hook), config);
+}
+
+void RobotHardware::clear_control_hook(const std::string& interface) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->clear_control_hook(interface);
+    }
+}
+
+bool RobotHardware::get_control_hook_stats(const std::string& interface,
+                                           hardware_driver::motor_driver::ControlHookStats& stats) const {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    return motor_driver_impl && motor_driver_impl->get_control_hook_stats(interface, stats);
+}
+
+// ========== 命令事务 ==========
+
+std::future<hardware_driver::motor_driver::CommandTransactionResult> RobotHardware::submit_command_transaction(
+    const hardware_driver::motor_driver::CommandTransaction& transaction) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        std::cerr << "Command transaction requires MotorDriverImpl" << std::endl;
+        std::promise<hardware_driver::motor_driver::CommandTransactionResult> rejected;
+        hardware_driver::motor_driver::CommandTransactionResult result;
+        result.failed = transaction.size();
+        rejected.set_value(result);
+        return rejected.get_future();
+    }
+    return motor_driver_impl->submit_transaction(transaction);
+}
+
+// ========== 命令门控 ==========
+
+void RobotHardware::set_command_gate_config(const hardware_driver::motor_driver::CommandGateConfig& config) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->set_command_gate_config(config);
+    }
+}
+
+hardware_driver::motor_driver::CommandGateStats RobotHardware::get_command_gate_stats() const {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        return {};
+    }
+    return motor_driver_impl->get_command_gate_stats();
+}
+
+// ========== 发送错误处理 ==========
+
+void RobotHardware::set_tx_retry_config(const hardware_driver::motor_driver::TxRetryConfig& config) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->set_tx_retry_config(config);
+    }
+}
+
+void RobotHardware::set_airtime_pacing(bool enable) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->set_airtime_pacing(enable);
+    }
+}
+
+bool RobotHardware::start_diagnostics_export(const std::string& shm_name) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        std::cerr << "[RobotHardware] Diagnostics export requires MotorDriverImpl" << std::endl;
+        return false;
+    }
+    return motor_driver_impl->start_diagnostics_export(shm_name);
+}
+
+void RobotHardware::stop_diagnostics_export() {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->stop_diagnostics_export();
+    }
+}
+
+std::map<std::string, hardware_driver::motor_driver::TxStats> RobotHardware::get_tx_stats() const {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        return {};
+    }
+    return motor_driver_impl->get_tx_stats();
+}
+
+void RobotHardware::register_tx_error_callback(hardware_driver::motor_driver::TxErrorCallback callback) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (motor_driver_impl) {
+        motor_driver_impl->register_tx_error_callback(std::move(callback));
+    }
+}
+
+bool RobotHardware::get_motor_runtime_state(const std::string& interface, uint32_t motor_id,
+                                            hardware_driver::motor_driver::MotorRuntimeState& state) const {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        return false;
+    }
+    return motor_driver_impl->get_motor_runtime_state(interface, motor_id, state);
+}
+
+hardware_driver::motor_driver::BringUpReport RobotHardware::bring_up_motors(
+    const hardware_driver::motor_driver::BringUpConfig& config) {
+    auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+    if (!motor_driver_impl) {
+        return {};
+    }
+    return motor_driver_impl->bring_up_motors(config);
+}
+
 // ========== 异步轨迹执行实现（新的简化版本） ==========
 
 std::string RobotHardware::execute_trajectory_async(
@@ -660,8 +1167,8 @@ std::string RobotHardware::execute_trajectory_async(
     bool show_progress) {
 
     // 检查接口是否存在
-    auto config_it = interface_motor_config_.find(interface);
-    if (config_it == interface_motor_config_.end()) {
+    const auto* motor_table = motor_config_.current().find(interface);
+    if (!motor_table) {
         return "";
     }
 
@@ -669,6 +1176,10 @@ std::string RobotHardware::execute_trajectory_async(
         return "";
     }
 
+    if (!check_trajectory_before_execution(interface, trajectory)) {
+        return "";
+    }
+
     // 检查该接口是否已有执行中的轨迹（包括IDLE、RUNNING、PAUSED状态）
     // {
     //     std::shared_lock<std::shared_mutex> lock(trajectory_tasks_mutex_);
@@ -747,6 +1258,7 @@ bool RobotHardware::resume_trajectory(const std::string& execution_id) {
             task->should_pause = false;
             task->pause_elapsed += std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::steady_clock::now() - task->pause_start_time);
+            task->pause_start_time = std::chrono::steady_clock::time_point();
             task->state = TrajectoryExecutionState::RUNNING;
         }
         task->state_cv.notify_one();
@@ -948,8 +1460,8 @@ size_t RobotHardware::get_active_trajectory_count() const {
 // 私有执行线程函数
 void RobotHardware::trajectory_execution_worker(std::shared_ptr<TrajectoryExecutionTask> task) {
     try {
-        auto config_it = interface_motor_config_.find(task->interface);
-        if (config_it == interface_motor_config_.end()) {
+        const auto* motor_table = motor_config_.current().find(task->interface);
+        if (!motor_table) {
             std::unique_lock<std::mutex> state_lock(task->state_mutex);
             task->state = TrajectoryExecutionState::ERROR;
             task->error_message = "Interface not found";
@@ -958,9 +1470,31 @@ void RobotHardware::trajectory_execution_worker(std::shared_ptr<TrajectoryExecut
             return;
         }
 
-        const auto& motor_ids = config_it->second;
+        const auto& motor_ids = motor_table->motor_ids;
         size_t total_points = task->trajectory.points.size();
 
+        // 跟踪误差监控：循环外取好各电机的无锁反馈槽位，循环内只做读取和比较
+        hardware_driver::trajectory::TrackingMonitorConfig tracking_config;
+        {
+            std::lock_guard<std::mutex> lock(tracking_monitor_mutex_);
+            tracking_config = tracking_monitor_config_;
+        }
+        std::unique_ptr<hardware_driver::trajectory::TrackingMonitor> monitor;
+        auto motor_driver_impl = std::dynamic_pointer_cast<hardware_driver::motor_driver::MotorDriverImpl>(motor_driver_);
+        if (tracking_config.enabled && motor_driver_impl) {
+            std::vector<const hardware_driver::motor_driver::MotorFeedbackSlot*> slots;
+            for (uint32_t motor_id : motor_ids) {
+                slots.push_back(motor_driver_impl->get_feedback_slot(task->interface, motor_id));
+            }
+            monitor = std::make_unique<hardware_driver::trajectory::TrackingMonitor>(tracking_config, slots);
+        }
+        auto store_tracking_report = [&task, &monitor]() {
+            if (monitor) {
+                task->tracking_report = monitor->report();
+                task->tracking_report_ready = true;
+            }
+        };
+
         // 更新状态为RUNNING
         {
             std::unique_lock<std::mutex> state_lock(task->state_mutex);
@@ -988,6 +1522,7 @@ void RobotHardware::trajectory_execution_worker(std::shared_ptr<TrajectoryExecut
 
                 if (task->should_stop) {
                     task->state = TrajectoryExecutionState::CANCELLED;
+                    store_tracking_report();
                     state_lock.unlock();
 
                     if (tty && tty != stderr) {
@@ -1037,6 +1572,51 @@ void RobotHardware::trajectory_execution_worker(std::shared_ptr<TrajectoryExecut
                 task->current_point_index = point_idx + 1;
             }
 
+            // 跟踪误差检查
+            if (monitor && monitor->update(point_idx, positions, std::chrono::steady_clock::now())) {
+                auto report = monitor->report();
+                std::cerr << "[RobotHardware] Tracking error on " << task->interface << " joint "
+                          << report.trip_joint_index << " at point " << point_idx << ": "
+                          << report.trip_error << std::endl;
+
+                if (tracking_config.action != hardware_driver::trajectory::TrackingErrorAction::REPORT_ONLY) {
+                    size_t last_sent = stop_trajectory_smoothly(task, *monitor, tracking_config.stop_time,
+                                                                point_idx, motor_ids.size());
+
+                    if (tracking_config.action == hardware_driver::trajectory::TrackingErrorAction::ABORT) {
+                        {
+                            std::unique_lock<std::mutex> state_lock(task->state_mutex);
+                            task->state = TrajectoryExecutionState::ERROR;
+                            task->error_message = "Tracking error exceeded on joint " +
+                                                  std::to_string(report.trip_joint_index) +
+                                                  " at point " + std::to_string(point_idx);
+                            store_tracking_report();
+                        }
+                        if (tty && tty != stderr) {
+                            fclose(tty);
+                        }
+                        task->state_cv.notify_all();
+                        return;
+                    }
+
+                    // HOLD：停在 last_sent 处并暂停，恢复后从下一个点继续，时间基准按停下时刻平移
+                    {
+                        std::unique_lock<std::mutex> state_lock(task->state_mutex);
+                        const auto now = std::chrono::steady_clock::now();
+                        task->pause_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            now - task->start_time -
+                            std::chrono::duration<double>(task->trajectory.points[last_sent].time_from_start));
+                        task->pause_start_time = now;
+                        task->should_pause = true;
+                        task->state = TrajectoryExecutionState::PAUSED;
+                    }
+                    task->state_cv.notify_all();
+                    monitor->rearm();
+                    point_idx = last_sent;
+                    continue;
+                }
+            }
+
             // 显示进度条（仅当 show_progress 为 true 时）
             if (task->show_progress && tty) {
                 auto now = std::chrono::steady_clock::now();
@@ -1052,6 +1632,7 @@ void RobotHardware::trajectory_execution_worker(std::shared_ptr<TrajectoryExecut
             std::unique_lock<std::mutex> state_lock(task->state_mutex);
             task->state = TrajectoryExecutionState::COMPLETED;
             task->current_point_index = total_points;
+            store_tracking_report();
         }
 
         // 显示最终进度
@@ -1129,6 +1710,77 @@ std::chrono::milliseconds RobotHardware::get_trajectory_total_time(const Traject
     );
 }
 
+void RobotHardware::set_tracking_monitor_config(const hardware_driver::trajectory::TrackingMonitorConfig& config) {
+    std::lock_guard<std::mutex> lock(tracking_monitor_mutex_);
+    tracking_monitor_config_ = config;
+}
+
+bool RobotHardware::get_tracking_report(const std::string& execution_id,
+                                        hardware_driver::trajectory::TrackingReport& report) {
+    std::shared_lock<std::shared_mutex> lock(trajectory_tasks_mutex_);
+
+    auto it = trajectory_execution_tasks_.find(execution_id);
+    if (it == trajectory_execution_tasks_.end()) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> state_lock(it->second->state_mutex);
+    if (!it->second->tracking_report_ready) {
+        return false;
+    }
+    report = it->second->tracking_report;
+    return true;
+}
+
+size_t RobotHardware::stop_trajectory_smoothly(const std::shared_ptr<TrajectoryExecutionTask>& task,
+                                               const hardware_driver::trajectory::TrackingMonitor& monitor,
+                                               double stop_time, size_t from_index, size_t motor_count) {
+    const auto& points = task->trajectory.points;
+    const double tau0 = points[from_index].time_from_start;
+    const auto wall0 = std::chrono::steady_clock::now();
+
+    // 超限关节停在触发时的实际位置，不再继续顶着阻挡
+    std::array<bool, 6> hold = {};
+    std::array<float, 6> hold_position = {};
+    for (size_t i = 0; i < std::min<size_t>(motor_count, 6); ++i) {
+        hold[i] = monitor.joint_exceeded(i) && monitor.latest_position(i, hold_position[i]);
+    }
+
+    auto send_point = [&](size_t index) {
+        std::array<float, 6> positions = {};
+        std::array<float, 6> velocities = {};
+        std::array<float, 6> efforts = {};
+        for (size_t i = 0; i < std::min<size_t>(motor_count, 6); ++i) {
+            positions[i] = hold[i] ? hold_position[i]
+                                   : (i < points[index].positions.size() ? static_cast<float>(points[index].positions[i]) : 0.0f);
+        }
+        motor_driver_->send_mit_cmd_all(task->interface, positions, velocities, efforts);
+    };
+
+    // 执行速度从 1 线性降到 0：轨迹时间走过 d 时实际用时 x 满足 d = x - x^2 / (2T)，最多再走 T/2
+    size_t last_sent = from_index;
+    for (size_t k = from_index + 1; k < points.size() && stop_time > 0.0 && !task->should_stop; ++k) {
+        const double d = points[k].time_from_start - tau0;
+        if (2.0 * d > stop_time) {
+            break;
+        }
+        const double x = stop_time * (1.0 - std::sqrt(1.0 - 2.0 * d / stop_time));
+        std::this_thread::sleep_until(wall0 + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(x)));
+
+        send_point(k);
+        last_sent = k;
+        std::unique_lock<std::mutex> state_lock(task->state_mutex);
+        task->current_point_index = k + 1;
+    }
+
+    // 没有可用于减速的后续点时，至少把超限关节停住
+    if (last_sent == from_index) {
+        send_point(from_index);
+    }
+    return last_sent;
+}
+
 void RobotHardware::cleanup_completed_trajectory_tasks() {
     std::unique_lock<std::shared_mutex> lock(trajectory_tasks_mutex_);
 
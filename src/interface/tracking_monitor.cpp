@@ -0,0 +1,108 @@
+#include "interface/tracking_monitor.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace hardware_driver {
+namespace trajectory {
+
+TrackingMonitor::TrackingMonitor(const TrackingMonitorConfig& config,
+                                 const std::vector<const hardware_driver::motor_driver::MotorFeedbackSlot*>& slots)
+    : config_(config),
+      joint_count_(std::min(slots.size(), kMaxJoints)),
+      history_(config.setpoint_delay_cycles + 1) {
+    for (size_t j = 0; j < joint_count_; ++j) {
+        slots_[j] = slots[j];
+        threshold_[j] = j < config_.max_error.size() ? config_.max_error[j] : config_.default_max_error;
+    }
+}
+
+bool TrackingMonitor::update(size_t point_index, const std::array<float, kMaxJoints>& setpoint,
+                             std::chrono::steady_clock::time_point now) {
+    history_[history_head_] = setpoint;
+    history_head_ = (history_head_ + 1) % history_.size();
+    history_size_ = std::min(history_size_ + 1, history_.size());
+
+    // 延迟周期数的设定值还没攒够时不比较
+    if (history_size_ < history_.size()) {
+        return false;
+    }
+    // 环形缓冲已满时，head 指向最早的设定值
+    const auto& reference = history_[history_head_];
+
+    bool compared = false;
+    bool newly_tripped = false;
+    for (size_t j = 0; j < joint_count_; ++j) {
+        exceeded_[j] = false;
+        hardware_driver::motor_driver::MotorFeedbackSlot::Snapshot snapshot;
+        if (!slots_[j] || !slots_[j]->read(snapshot) || now - snapshot.stamp > config_.feedback_timeout) {
+            consecutive_[j] = 0;
+            continue;
+        }
+        compared = true;
+
+        const double error = std::fabs(static_cast<double>(reference[j]) - static_cast<double>(snapshot.position));
+        max_error_[j] = std::max(max_error_[j], error);
+        sum_sq_[j] += error * error;
+        ++joint_samples_[j];
+
+        if (error > threshold_[j]) {
+            exceeded_[j] = true;
+            if (++consecutive_[j] >= std::max<size_t>(1, config_.trip_cycles) && !tripped_) {
+                tripped_ = true;
+                ever_tripped_ = true;
+                newly_tripped = true;
+                trip_point_index_ = point_index;
+                trip_joint_index_ = j;
+                trip_error_ = error;
+            }
+        } else {
+            consecutive_[j] = 0;
+        }
+    }
+
+    if (compared) {
+        ++samples_;
+    } else {
+        ++stale_samples_;
+    }
+    return newly_tripped;
+}
+
+bool TrackingMonitor::latest_position(size_t joint, float& position) const {
+    if (joint >= joint_count_ || !slots_[joint]) {
+        return false;
+    }
+    hardware_driver::motor_driver::MotorFeedbackSlot::Snapshot snapshot;
+    if (!slots_[joint]->read(snapshot)) {
+        return false;
+    }
+    position = snapshot.position;
+    return true;
+}
+
+void TrackingMonitor::rearm() {
+    tripped_ = false;
+    consecutive_.fill(0);
+    exceeded_.fill(false);
+}
+
+TrackingReport TrackingMonitor::report() const {
+    TrackingReport report;
+    report.max_error.assign(max_error_.begin(), max_error_.begin() + joint_count_);
+    report.rms_error.resize(joint_count_, 0.0);
+    for (size_t j = 0; j < joint_count_; ++j) {
+        if (joint_samples_[j] > 0) {
+            report.rms_error[j] = std::sqrt(sum_sq_[j] / static_cast<double>(joint_samples_[j]));
+        }
+    }
+    report.samples = samples_;
+    report.stale_samples = stale_samples_;
+    report.tripped = ever_tripped_;
+    report.trip_point_index = trip_point_index_;
+    report.trip_joint_index = trip_joint_index_;
+    report.trip_error = trip_error_;
+    return report;
+}
+
+}   // namespace trajectory
+}   // namespace hardware_driver
@@ -0,0 +1,78 @@
+#ifndef __TRACKING_MONITOR_HPP__
+#define __TRACKING_MONITOR_HPP__
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "hardware_driver/interface/trajectory_tracking.hpp"
+#include "driver/motor_feedback_slot.hpp"
+
+namespace hardware_driver {
+namespace trajectory {
+
+/**
+ * @brief 轨迹执行循环内的跟踪误差监控
+ *
+ * 每周期把发送的设定值与各电机无锁反馈快照比较，累计最大误差和平方和，
+ * 并按连续超限周期数判断是否触发。不分配内存、不加锁，适合在控制循环中调用。
+ */
+class TrackingMonitor {
+public:
+    static constexpr size_t kMaxJoints = 6;
+
+    // slots 下标与设定值数组下标一致；元素可为空（该关节不监控）
+    TrackingMonitor(const TrackingMonitorConfig& config,
+                    const std::vector<const hardware_driver::motor_driver::MotorFeedbackSlot*>& slots);
+
+    /**
+     * @brief 记录本周期发送的设定值并与最新反馈比较
+     * @return 本次调用首次触发超限时返回 true
+     */
+    bool update(size_t point_index, const std::array<float, kMaxJoints>& setpoint,
+                std::chrono::steady_clock::time_point now);
+
+    bool tripped() const { return tripped_; }
+
+    // 关节在最近一次比较中是否超限
+    bool joint_exceeded(size_t joint) const { return joint < joint_count_ && exceeded_[joint]; }
+
+    // 关节最近一次反馈的位置
+    bool latest_position(size_t joint, float& position) const;
+
+    // 清除触发状态（HOLD 后继续执行时调用），统计数据保留
+    void rearm();
+
+    // 生成报告（计算 RMS）
+    TrackingReport report() const;
+
+private:
+    TrackingMonitorConfig config_;
+    size_t joint_count_{0};
+    std::array<const hardware_driver::motor_driver::MotorFeedbackSlot*, kMaxJoints> slots_{};
+    std::array<double, kMaxJoints> threshold_{};
+
+    // 延迟比较用的设定值环形缓冲
+    std::vector<std::array<float, kMaxJoints>> history_;
+    size_t history_head_{0};
+    size_t history_size_{0};
+
+    std::array<size_t, kMaxJoints> consecutive_{};
+    std::array<bool, kMaxJoints> exceeded_{};
+    std::array<double, kMaxJoints> max_error_{};
+    std::array<double, kMaxJoints> sum_sq_{};
+    std::array<size_t, kMaxJoints> joint_samples_{};
+    size_t samples_{0};
+    size_t stale_samples_{0};
+
+    bool tripped_{false};
+    bool ever_tripped_{false};
+    size_t trip_point_index_{0};
+    size_t trip_joint_index_{0};
+    double trip_error_{0.0};
+};
+
+}   // namespace trajectory
+}   // namespace hardware_driver
+
+#endif // __TRACKING_MONITOR_HPP__
@@ -0,0 +1,182 @@
+#include "hardware_driver/interface/trajectory_blending.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace hardware_driver {
+namespace trajectory {
+
+namespace {
+
+// 轨迹点速度：优先使用点内数据，缺失时用相邻点差分
+double point_velocity(const std::vector<TrajectoryPoint>& points, size_t i, size_t j) {
+    const auto& p = points[i];
+    if (p.velocities.size() > j) return p.velocities[j];
+    if (points.size() < 2) return 0.0;
+    const size_t a = i > 0 ? i - 1 : 0;
+    const size_t b = i + 1 < points.size() ? i + 1 : i;
+    const double dt = points[b].time_from_start - points[a].time_from_start;
+    return dt > 0.0 ? (points[b].positions[j] - points[a].positions[j]) / dt : 0.0;
+}
+
+double point_acceleration(const std::vector<TrajectoryPoint>& points, size_t i, size_t j) {
+    const auto& p = points[i];
+    if (p.accelerations.size() > j) return p.accelerations[j];
+    if (points.size() < 2) return 0.0;
+    const size_t a = i > 0 ? i - 1 : 0;
+    const size_t b = i + 1 < points.size() ? i + 1 : i;
+    const double dt = points[b].time_from_start - points[a].time_from_start;
+    return dt > 0.0 ? (point_velocity(points, b, j) - point_velocity(points, a, j)) / dt : 0.0;
+}
+
+// 五次 Hermite 曲线：两端位置、速度、加速度给定
+struct QuinticSegment {
+    double c[6];
+
+    QuinticSegment(double p0, double v0, double a0, double p1, double v1, double a1, double T) {
+        const double T2 = T * T, T3 = T2 * T, T4 = T3 * T, T5 = T4 * T;
+        const double dp = p1 - p0;
+        c[0] = p0;
+        c[1] = v0;
+        c[2] = 0.5 * a0;
+        c[3] = (20.0 * dp - (8.0 * v1 + 12.0 * v0) * T - (3.0 * a0 - a1) * T2) / (2.0 * T3);
+        c[4] = (-30.0 * dp + (14.0 * v1 + 16.0 * v0) * T + (3.0 * a0 - 2.0 * a1) * T2) / (2.0 * T4);
+        c[5] = (12.0 * dp - 6.0 * (v1 + v0) * T - (a0 - a1) * T2) / (2.0 * T5);
+    }
+
+    void evaluate(double t, double& p, double& v, double& a) const {
+        p = c[0] + t * (c[1] + t * (c[2] + t * (c[3] + t * (c[4] + t * c[5]))));
+        v = c[1] + t * (2.0 * c[2] + t * (3.0 * c[3] + t * (4.0 * c[4] + t * 5.0 * c[5])));
+        a = 2.0 * c[2] + t * (6.0 * c[3] + t * (12.0 * c[4] + t * 20.0 * c[5]));
+    }
+};
+
+void append_shifted(Trajectory& result, const Trajectory& source, double from_time, double shift) {
+    const double last = result.points.empty() ? -1e300 : result.points.back().time_from_start;
+    for (const auto& point : source.points) {
+        if (point.time_from_start < from_time) continue;
+        const double t = point.time_from_start + shift;
+        if (t <= last) continue;
+        result.points.push_back(point);
+        result.points.back().time_from_start = t;
+    }
+}
+
+}   // namespace
+
+void sample_trajectory(const Trajectory& trajectory, double t,
+                       std::vector<double>& position, std::vector<double>& velocity, std::vector<double>& acceleration) {
+    const auto& points = trajectory.points;
+    if (points.empty()) {
+        position.clear();
+        velocity.clear();
+        acceleration.clear();
+        return;
+    }
+
+    const size_t dof = points.front().positions.size();
+    position.assign(dof, 0.0);
+    velocity.assign(dof, 0.0);
+    acceleration.assign(dof, 0.0);
+
+    // 超出时间范围时保持端点位置
+    if (t <= points.front().time_from_start || points.size() == 1) {
+        position = points.front().positions;
+        return;
+    }
+    if (t >= points.back().time_from_start) {
+        position = points.back().positions;
+        return;
+    }
+
+    auto it = std::upper_bound(points.begin(), points.end(), t,
+                               [](double value, const TrajectoryPoint& p) { return value < p.time_from_start; });
+    const size_t k1 = static_cast<size_t>(it - points.begin());
+    const size_t k0 = k1 - 1;
+    const double t0 = points[k0].time_from_start;
+    const double t1 = points[k1].time_from_start;
+    const double f = t1 > t0 ? (t - t0) / (t1 - t0) : 0.0;
+
+    for (size_t j = 0; j < dof; ++j) {
+        const double p0 = points[k0].positions[j];
+        const double p1 = j < points[k1].positions.size() ? points[k1].positions[j] : p0;
+        position[j] = p0 + f * (p1 - p0);
+        const double v0 = point_velocity(points, k0, j);
+        const double v1 = point_velocity(points, k1, j);
+        velocity[j] = v0 + f * (v1 - v0);
+        const double a0 = point_acceleration(points, k0, j);
+        const double a1 = point_acceleration(points, k1, j);
+        acceleration[j] = a0 + f * (a1 - a0);
+    }
+}
+
+Trajectory blend_trajectories(const Trajectory& first, const Trajectory& second,
+                              const TrajectoryBlendConfig& config, double earliest_blend_start) {
+    if (first.points.empty()) return second;
+    if (second.points.empty()) return first;
+
+    Trajectory result;
+    result.joint_names = first.joint_names.empty() ? second.joint_names : first.joint_names;
+
+    const size_t dof = first.points.front().positions.size();
+    if (second.points.front().positions.size() != dof) {
+        std::cerr << "[TrajectoryBlend] Joint count mismatch: " << dof << " vs "
+                  << second.points.front().positions.size() << std::endl;
+        return first;
+    }
+
+    const double first_start = first.points.front().time_from_start;
+    const double first_end = first.points.back().time_from_start;
+    const double second_start = second.points.front().time_from_start;
+    const double second_duration = second.points.back().time_from_start - second_start;
+
+    double window = std::min({config.blend_window, second_duration, first_end - first_start});
+    double blend_start = std::max(first_end - window, earliest_blend_start);
+    window = first_end - blend_start;
+
+    // 窗口不足：不重叠，second 在 first 结束（或最早允许时刻）之后接上
+    if (window <= 0.0 || config.sample_period <= 0.0) {
+        const double join = std::max(first_end, earliest_blend_start);
+        result.points = first.points;
+        append_shifted(result, second, second_start, join - second_start);
+        return result;
+    }
+
+    // first 在衔接起点之前的部分
+    for (const auto& point : first.points) {
+        if (point.time_from_start >= blend_start) break;
+        result.points.push_back(point);
+    }
+
+    // 衔接段：从 first 在 blend_start 的状态过渡到 second 在 second_start + window 的状态
+    std::vector<double> p0, v0, a0, p1, v1, a1;
+    sample_trajectory(first, blend_start, p0, v0, a0);
+    sample_trajectory(second, second_start + window, p1, v1, a1);
+
+    std::vector<QuinticSegment> segments;
+    segments.reserve(dof);
+    for (size_t j = 0; j < dof; ++j) {
+        segments.emplace_back(p0[j], v0[j], a0[j], p1[j], v1[j], a1[j], window);
+    }
+
+    const size_t samples = std::max<size_t>(1, static_cast<size_t>(std::ceil(window / config.sample_period)));
+    for (size_t k = 0; k <= samples; ++k) {
+        const double tau = window * static_cast<double>(k) / static_cast<double>(samples);
+        TrajectoryPoint point;
+        point.time_from_start = blend_start + tau;
+        point.positions.resize(dof);
+        point.velocities.resize(dof);
+        point.accelerations.resize(dof);
+        for (size_t j = 0; j < dof; ++j) {
+            segments[j].evaluate(tau, point.positions[j], point.velocities[j], point.accelerations[j]);
+        }
+        result.points.push_back(std::move(point));
+    }
+
+    // second 在衔接窗口之后的部分，时间平移到 first 的时间基准
+    append_shifted(result, second, second_start + window, blend_start - second_start);
+    return result;
+}
+
+}   // namespace trajectory
+}   // namespace hardware_driver
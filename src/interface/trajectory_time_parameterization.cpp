@@ -0,0 +1,432 @@
+#include "hardware_driver/interface/trajectory_time_parameterization.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace hardware_driver {
+namespace trajectory {
+
+namespace {
+
+constexpr double kEpsilon = 1e-12;
+constexpr double kDuplicateDistance = 1e-9;   // 距离小于该值的相邻路径点视为重复
+constexpr double kMaxSdotSquared = 1e12;      // 无约束时 sdot^2 的数值上界
+constexpr size_t kMinPathSamples = 64;        // 路径点过少时细分到该数量，避免静止到静止只有一步
+constexpr int kBisectionIterations = 40;
+
+}   // namespace
+
+TrajectoryTimeParameterizer::TrajectoryTimeParameterizer(const JointLimits& limits,
+                                                         const TimeParameterizationOptions& options)
+    : limits_(limits), options_(options)
+{
+}
+
+bool TrajectoryTimeParameterizer::validate(const std::vector<std::vector<double>>& path, std::string& error) const {
+    if (path.empty()) {
+        error = "路径为空";
+        return false;
+    }
+
+    const size_t dof = limits_.max_velocity.size();
+    if (dof == 0 || limits_.max_acceleration.size() != dof ||
+        (!limits_.max_jerk.empty() && limits_.max_jerk.size() != dof)) {
+        error = "关节限制维度不一致";
+        return false;
+    }
+    for (size_t j = 0; j < dof; ++j) {
+        if (!(limits_.max_velocity[j] > 0.0) || !(limits_.max_acceleration[j] > 0.0)) {
+            error = "关节 " + std::to_string(j) + " 的速度/加速度限制必须为正";
+            return false;
+        }
+    }
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (path[i].size() != dof) {
+            error = "路径点 " + std::to_string(i) + " 的关节数为 " + std::to_string(path[i].size()) +
+                    "，期望 " + std::to_string(dof);
+            return false;
+        }
+        for (double v : path[i]) {
+            if (!std::isfinite(v)) {
+                error = "路径点 " + std::to_string(i) + " 含有非有限值";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void TrajectoryTimeParameterizer::build_path(const std::vector<std::vector<double>>& path) {
+    dof_ = limits_.max_velocity.size();
+    const size_t dof = dof_;
+
+    // 去除重复点
+    q_.clear();
+    q_.reserve(path.size() * dof);
+    q_.insert(q_.end(), path[0].begin(), path[0].end());
+    double total_length = 0.0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        const double* prev = &q_[q_.size() - dof];
+        double d2 = 0.0;
+        for (size_t j = 0; j < dof; ++j) {
+            const double d = path[i][j] - prev[j];
+            d2 += d * d;
+        }
+        if (d2 > kDuplicateDistance * kDuplicateDistance) {
+            q_.insert(q_.end(), path[i].begin(), path[i].end());
+            total_length += std::sqrt(d2);
+        }
+    }
+    count_ = q_.size() / dof;
+
+    // 稀疏路径按弦长细分，保证离散化足够细
+    if (count_ >= 2 && count_ < kMinPathSamples) {
+        const double max_step = total_length / static_cast<double>(kMinPathSamples);
+        std::vector<double> dense;
+        dense.reserve(kMinPathSamples * 2 * dof);
+        for (size_t i = 0; i + 1 < count_; ++i) {
+            const double* a = &q_[i * dof];
+            const double* b = &q_[(i + 1) * dof];
+            double d2 = 0.0;
+            for (size_t j = 0; j < dof; ++j) d2 += (b[j] - a[j]) * (b[j] - a[j]);
+            const size_t pieces = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(d2) / max_step)));
+            for (size_t k = 0; k < pieces; ++k) {
+                const double f = static_cast<double>(k) / static_cast<double>(pieces);
+                for (size_t j = 0; j < dof; ++j) dense.push_back(a[j] + f * (b[j] - a[j]));
+            }
+        }
+        dense.insert(dense.end(), q_.end() - dof, q_.end());
+        q_.swap(dense);
+        count_ = q_.size() / dof;
+    }
+
+    const size_t n = count_;
+    ds_.assign(n > 1 ? n - 1 : 0, 0.0);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        const double* a = &q_[i * dof];
+        const double* b = &q_[(i + 1) * dof];
+        double d2 = 0.0;
+        for (size_t j = 0; j < dof; ++j) d2 += (b[j] - a[j]) * (b[j] - a[j]);
+        ds_[i] = std::sqrt(d2);
+    }
+
+    // 路径导数：非均匀网格上的中心差分，端点单侧差分
+    dq_.assign(n * dof, 0.0);
+    ddq_.assign(n * dof, 0.0);
+    if (n >= 2) {
+        for (size_t j = 0; j < dof; ++j) {
+            dq_[j] = (q_[dof + j] - q_[j]) / ds_[0];
+            dq_[(n - 1) * dof + j] = (q_[(n - 1) * dof + j] - q_[(n - 2) * dof + j]) / ds_[n - 2];
+        }
+    }
+    for (size_t i = 1; i + 1 < n; ++i) {
+        const double h0 = ds_[i - 1];
+        const double h1 = ds_[i];
+        const double inv_sum = 1.0 / (h0 + h1);
+        const double* qm = &q_[(i - 1) * dof];
+        const double* qc = &q_[i * dof];
+        const double* qp = &q_[(i + 1) * dof];
+        double* dq = &dq_[i * dof];
+        double* ddq = &ddq_[i * dof];
+        for (size_t j = 0; j < dof; ++j) {
+            const double s0 = (qc[j] - qm[j]) / h0;
+            const double s1 = (qp[j] - qc[j]) / h1;
+            dq[j] = (s0 * h1 + s1 * h0) * inv_sum;
+            ddq[j] = 2.0 * (s1 - s0) * inv_sum;
+        }
+    }
+    if (n >= 3) {
+        for (size_t j = 0; j < dof; ++j) {
+            ddq_[j] = ddq_[dof + j];
+            ddq_[(n - 1) * dof + j] = ddq_[(n - 2) * dof + j];
+        }
+    }
+
+    acc_scale_.assign(n, 1.0);
+}
+
+void TrajectoryTimeParameterizer::compute_velocity_caps() {
+    const size_t dof = dof_;
+    x_cap_.assign(count_, kMaxSdotSquared);
+    for (size_t i = 0; i < count_; ++i) {
+        const double* dq = &dq_[i * dof];
+        const double* ddq = &ddq_[i * dof];
+        double cap = kMaxSdotSquared;
+        for (size_t j = 0; j < dof; ++j) {
+            const double v = limits_.max_velocity[j];
+            const double d = std::fabs(dq[j]);
+            if (d > kEpsilon) {
+                cap = std::min(cap, (v * v) / (d * d));
+            } else if (std::fabs(ddq[j]) > kEpsilon) {
+                // 该关节在此处路径速度为零，只剩曲率项 ddq * sdot^2 受加速度约束
+                cap = std::min(cap, limits_.max_acceleration[j] * acc_scale_[i] / std::fabs(ddq[j]));
+            }
+        }
+        x_cap_[i] = cap;
+    }
+}
+
+void TrajectoryTimeParameterizer::acceleration_bounds(size_t i, double x, double& u_lo, double& u_hi) const {
+    // 关节加速度 = ddq * sdot^2 + dq * sddot，逐关节求 sddot 的可行区间并取交集
+    const size_t dof = dof_;
+    const double* dq = &dq_[i * dof];
+    const double* ddq = &ddq_[i * dof];
+    const double scale = acc_scale_[i];
+    double lo = -std::numeric_limits<double>::infinity();
+    double hi = std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < dof; ++j) {
+        const double b = dq[j];
+        if (std::fabs(b) <= kEpsilon) continue;
+        const double a_max = limits_.max_acceleration[j] * scale;
+        const double c = ddq[j] * x;
+        double l = (-a_max - c) / b;
+        double h = (a_max - c) / b;
+        if (b < 0.0) std::swap(l, h);
+        lo = std::max(lo, l);
+        hi = std::min(hi, h);
+    }
+    u_lo = lo;
+    u_hi = hi;
+}
+
+bool TrajectoryTimeParameterizer::solve_profile(std::string& error) {
+    const size_t n = count_;
+    compute_velocity_caps();
+
+    // 反向遍历：x_max_[i] 为能在之后所有约束内减速到终点静止的最大 sdot^2
+    x_max_.assign(n, 0.0);
+    x_max_[n - 1] = 0.0;
+    for (size_t k = n - 1; k-- > 0;) {
+        const double h = ds_[k];
+        const double next = x_max_[k + 1];
+        auto feasible = [&](double x) {
+            double lo, hi;
+            acceleration_bounds(k, x, lo, hi);
+            lo = std::max(lo, -x / (2.0 * h));
+            hi = std::min(hi, (next - x) / (2.0 * h));
+            return lo <= hi + 1e-9 * (1.0 + std::fabs(hi));
+        };
+
+        double upper = x_cap_[k];
+        if (feasible(upper)) {
+            x_max_[k] = upper;
+            continue;
+        }
+        double lower = 0.0;
+        if (!feasible(lower)) {
+            error = "路径在第 " + std::to_string(k) + " 点不可行";
+            return false;
+        }
+        for (int it = 0; it < kBisectionIterations; ++it) {
+            const double mid = 0.5 * (lower + upper);
+            if (feasible(mid)) {
+                lower = mid;
+            } else {
+                upper = mid;
+            }
+        }
+        x_max_[k] = lower;
+    }
+
+    // 正向遍历：从静止出发，每段取不超过可控集的最大加速度
+    x_.assign(n, 0.0);
+    u_.assign(n, 0.0);
+    t_.assign(n, 0.0);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        const double h = ds_[i];
+        double lo, hi;
+        acceleration_bounds(i, x_[i], lo, hi);
+        double u = std::min(hi, (x_max_[i + 1] - x_[i]) / (2.0 * h));
+        double x_next = std::clamp(x_[i] + 2.0 * h * u, 0.0, x_max_[i + 1]);
+        u = (x_next - x_[i]) / (2.0 * h);
+        x_[i + 1] = x_next;
+        u_[i] = u;
+
+        const double denom = std::sqrt(x_[i]) + std::sqrt(x_next);
+        if (denom <= kEpsilon) {
+            error = "路径在第 " + std::to_string(i) + " 段无法前进";
+            return false;
+        }
+        t_[i + 1] = t_[i] + 2.0 * h / denom;
+    }
+    if (n >= 2) {
+        // 终点沿用最后一段的 sddot，但需落在终点处的加速度可行区间内
+        double lo, hi;
+        acceleration_bounds(n - 1, x_[n - 1], lo, hi);
+        u_[n - 1] = std::clamp(u_[n - 2], std::min(lo, 0.0), std::max(hi, 0.0));
+    }
+    return true;
+}
+
+bool TrajectoryTimeParameterizer::enforce_jerk() {
+    if (limits_.max_jerk.empty()) return true;
+
+    const size_t n = count_;
+    const size_t dof = dof_;
+    const double factor = options_.jerk_tightening_factor;
+    bool satisfied = true;
+
+    auto joint_acc = [&](size_t i, size_t j) {
+        return ddq_[i * dof + j] * x_[i] + dq_[i * dof + j] * u_[i];
+    };
+
+    for (size_t i = 0; i + 1 < n; ++i) {
+        const double dt = t_[i + 1] - t_[i];
+        if (dt <= 0.0) continue;
+        bool violated = false;
+        for (size_t j = 0; j < dof; ++j) {
+            const double j_max = limits_.max_jerk[j];
+            if (j_max <= 0.0) continue;
+            double jerk = (joint_acc(i + 1, j) - joint_acc(i, j)) / dt;
+            // 起点和终点相对静止状态的加速度跳变
+            if (i == 0) jerk = std::max(std::fabs(jerk), std::fabs(joint_acc(0, j)) / dt);
+            if (i + 2 == n) jerk = std::max(std::fabs(jerk), std::fabs(joint_acc(n - 1, j)) / dt);
+            if (std::fabs(jerk) > j_max * (1.0 + 1e-6)) {
+                violated = true;
+                break;
+            }
+        }
+        if (violated) {
+            acc_scale_[i] *= factor;
+            acc_scale_[i + 1] *= factor;
+            satisfied = false;
+        }
+    }
+    return satisfied;
+}
+
+void TrajectoryTimeParameterizer::write_trajectory(Trajectory& trajectory) const {
+    const size_t dof = dof_;
+    trajectory.points.resize(count_);
+    for (size_t i = 0; i < count_; ++i) {
+        auto& point = trajectory.points[i];
+        const double sdot = std::sqrt(x_[i]);
+        point.time_from_start = t_[i];
+        point.positions.assign(q_.begin() + i * dof, q_.begin() + (i + 1) * dof);
+        point.velocities.resize(dof);
+        point.accelerations.resize(dof);
+        for (size_t j = 0; j < dof; ++j) {
+            point.velocities[j] = dq_[i * dof + j] * sdot;
+            point.accelerations[j] = ddq_[i * dof + j] * x_[i] + dq_[i * dof + j] * u_[i];
+        }
+    }
+    if (count_ > 0) {
+        std::fill(trajectory.points.back().velocities.begin(), trajectory.points.back().velocities.end(), 0.0);
+    }
+}
+
+void TrajectoryTimeParameterizer::resample_trajectory(Trajectory& trajectory) const {
+    const size_t dof = dof_;
+    const double period = options_.resample_period;
+    const double duration = t_[count_ - 1];
+    const size_t samples = static_cast<size_t>(std::floor(duration / period)) + 1;
+
+    trajectory.points.clear();
+    trajectory.points.reserve(samples + 1);
+
+    size_t seg = 0;
+    for (size_t k = 0; k < samples; ++k) {
+        const double t = std::min(k * period, duration);
+        while (seg + 2 < count_ && t_[seg + 1] <= t) ++seg;
+
+        // 段内 sddot 恒定，s 为时间的二次函数；关节量在路径点之间线性插值
+        const double tau = t - t_[seg];
+        const double sdot0 = std::sqrt(x_[seg]);
+        const double u = u_[seg];
+        const double h = ds_[seg];
+        const double s_local = std::clamp(sdot0 * tau + 0.5 * u * tau * tau, 0.0, h);
+        const double f = h > 0.0 ? s_local / h : 0.0;
+        const double sdot = std::max(0.0, sdot0 + u * tau);
+
+        TrajectoryPoint point;
+        point.time_from_start = t;
+        point.positions.resize(dof);
+        point.velocities.resize(dof);
+        point.accelerations.resize(dof);
+        for (size_t j = 0; j < dof; ++j) {
+            const size_t a = seg * dof + j;
+            const size_t b = (seg + 1) * dof + j;
+            const double dq = dq_[a] + f * (dq_[b] - dq_[a]);
+            const double ddq = ddq_[a] + f * (ddq_[b] - ddq_[a]);
+            point.positions[j] = q_[a] + f * (q_[b] - q_[a]);
+            point.velocities[j] = dq * sdot;
+            point.accelerations[j] = ddq * sdot * sdot + dq * u;
+        }
+        trajectory.points.push_back(std::move(point));
+    }
+
+    // 保证终点精确落在路径末端
+    if (trajectory.points.back().time_from_start < duration) {
+        TrajectoryPoint last;
+        last.time_from_start = duration;
+        last.positions.assign(q_.end() - dof, q_.end());
+        last.velocities.assign(dof, 0.0);
+        last.accelerations.assign(dof, 0.0);
+        trajectory.points.push_back(std::move(last));
+    } else {
+        trajectory.points.back().positions.assign(q_.end() - dof, q_.end());
+        std::fill(trajectory.points.back().velocities.begin(), trajectory.points.back().velocities.end(), 0.0);
+    }
+}
+
+TimeParameterizationResult TrajectoryTimeParameterizer::compute(const std::vector<std::vector<double>>& path,
+                                                                Trajectory& trajectory) {
+    TimeParameterizationResult result;
+    if (!validate(path, result.error_message)) {
+        std::cerr << "[TimeParameterization] " << result.error_message << std::endl;
+        return result;
+    }
+
+    build_path(path);
+
+    // 只有一个有效点：原地静止
+    if (count_ < 2) {
+        x_.assign(count_, 0.0);
+        u_.assign(count_, 0.0);
+        t_.assign(count_, 0.0);
+        write_trajectory(trajectory);
+        result.success = true;
+        return result;
+    }
+
+    bool jerk_ok = false;
+    for (size_t iteration = 0;; ++iteration) {
+        if (!solve_profile(result.error_message)) {
+            std::cerr << "[TimeParameterization] " << result.error_message << std::endl;
+            return result;
+        }
+        jerk_ok = enforce_jerk();
+        if (jerk_ok || iteration >= options_.max_jerk_iterations) {
+            result.jerk_iterations = iteration;
+            break;
+        }
+    }
+    result.jerk_satisfied = jerk_ok;
+    if (!jerk_ok) {
+        std::cerr << "[TimeParameterization] Warning: jerk limits not met after "
+                  << result.jerk_iterations << " iterations" << std::endl;
+    }
+
+    if (options_.resample_period > 0.0) {
+        resample_trajectory(trajectory);
+    } else {
+        write_trajectory(trajectory);
+    }
+
+    result.success = true;
+    result.duration = t_[count_ - 1];
+    return result;
+}
+
+TimeParameterizationResult TrajectoryTimeParameterizer::retime(Trajectory& trajectory) {
+    std::vector<std::vector<double>> path;
+    path.reserve(trajectory.points.size());
+    for (const auto& point : trajectory.points) {
+        path.push_back(point.positions);
+    }
+    return compute(path, trajectory);
+}
+
+}   // namespace trajectory
+}   // namespace hardware_driver
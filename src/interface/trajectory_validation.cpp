@@ -0,0 +1,267 @@
+#include "hardware_driver/interface/trajectory_validation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <thread>
+
+namespace hardware_driver {
+namespace trajectory {
+
+const char* to_string(TrajectoryViolation violation) {
+    switch (violation) {
+        case TrajectoryViolation::NONE: return "NONE";
+        case TrajectoryViolation::EMPTY: return "EMPTY";
+        case TrajectoryViolation::DIMENSION_MISMATCH: return "DIMENSION_MISMATCH";
+        case TrajectoryViolation::NON_FINITE: return "NON_FINITE";
+        case TrajectoryViolation::NON_MONOTONIC_TIME: return "NON_MONOTONIC_TIME";
+        case TrajectoryViolation::POSITION_LIMIT: return "POSITION_LIMIT";
+        case TrajectoryViolation::VELOCITY_LIMIT: return "VELOCITY_LIMIT";
+        case TrajectoryViolation::ACCELERATION_LIMIT: return "ACCELERATION_LIMIT";
+        case TrajectoryViolation::START_DISTANCE: return "START_DISTANCE";
+    }
+    return "UNKNOWN";
+}
+
+std::string TrajectoryValidationResult::summary() const {
+    if (valid) {
+        return "valid";
+    }
+    std::ostringstream oss;
+    oss << issue_count << " issue(s)";
+    if (!issues.empty()) {
+        const auto& first = issues.front();
+        oss << "; first: " << to_string(first.violation)
+            << " at point " << first.point_index << " joint " << first.joint_index
+            << " (value " << first.value << ", limit " << first.limit << ")";
+    }
+    return oss.str();
+}
+
+TrajectoryValidator::TrajectoryValidator(const TrajectoryValidationLimits& limits,
+                                         const TrajectoryValidationOptions& options)
+    : limits_(limits), options_(options) {}
+
+void TrajectoryValidator::add_issue(IssueList& list, TrajectoryViolation violation, size_t point, size_t joint,
+                                    double value, double limit) const {
+    ++list.count;
+    if (list.issues.size() < options_.max_issues) {
+        list.issues.push_back(TrajectoryIssue{violation, point, joint, value, limit});
+    }
+}
+
+size_t TrajectoryValidator::chunk_count() const {
+    if (count_ < options_.parallel_min_points || options_.parallel_min_points == 0) {
+        return 1;
+    }
+    size_t threads = options_.max_threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // 每块至少 1024 个点，避免线程开销超过校验本身
+    return std::max<size_t>(1, std::min(threads, count_ / 1024));
+}
+
+template <typename Check>
+void TrajectoryValidator::run_chunks(size_t chunks, std::vector<IssueList>& lists, Check check) {
+    lists.assign(chunks, IssueList{});
+    const size_t per_chunk = (count_ + chunks - 1) / chunks;
+    auto range = [&](size_t c, size_t& begin, size_t& end) {
+        begin = std::min(count_, c * per_chunk);
+        end = std::min(count_, begin + per_chunk);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(chunks > 0 ? chunks - 1 : 0);
+    for (size_t c = 1; c < chunks; ++c) {
+        size_t begin, end;
+        range(c, begin, end);
+        workers.emplace_back([&check, &lists, c, begin, end]() { check(begin, end, lists[c]); });
+    }
+    size_t begin, end;
+    range(0, begin, end);
+    check(begin, end, lists[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void TrajectoryValidator::collect(std::vector<IssueList>& lists, TrajectoryValidationResult& result) const {
+    for (auto& list : lists) {
+        result.issue_count += list.count;
+        result.issues.insert(result.issues.end(), list.issues.begin(), list.issues.end());
+    }
+    std::stable_sort(result.issues.begin(), result.issues.end(),
+                     [](const TrajectoryIssue& a, const TrajectoryIssue& b) {
+                         return a.point_index != b.point_index ? a.point_index < b.point_index
+                                                               : a.joint_index < b.joint_index;
+                     });
+    if (result.issues.size() > options_.max_issues) {
+        result.issues.resize(options_.max_issues);
+    }
+}
+
+void TrajectoryValidator::check_structure(const Trajectory& trajectory, size_t begin, size_t end, IssueList& list) {
+    const auto& points = trajectory.points;
+    for (size_t i = begin; i < end; ++i) {
+        const auto& point = points[i];
+        const double t = point.time_from_start;
+        t_[i] = t;
+
+        if (point.positions.size() != dof_ ||
+            (!point.velocities.empty() && point.velocities.size() != dof_) ||
+            (!point.accelerations.empty() && point.accelerations.size() != dof_)) {
+            add_issue(list, TrajectoryViolation::DIMENSION_MISMATCH, i, 0,
+                      static_cast<double>(point.positions.size()), static_cast<double>(dof_));
+            continue;
+        }
+
+        if (!std::isfinite(t)) {
+            add_issue(list, TrajectoryViolation::NON_FINITE, i, 0, t, 0.0);
+        } else if (i == 0 ? t < 0.0 : !(t > points[i - 1].time_from_start)) {
+            add_issue(list, TrajectoryViolation::NON_MONOTONIC_TIME, i, 0, t,
+                      i == 0 ? 0.0 : points[i - 1].time_from_start);
+        }
+
+        for (size_t j = 0; j < dof_; ++j) {
+            const double q = point.positions[j];
+            if (!std::isfinite(q)) {
+                add_issue(list, TrajectoryViolation::NON_FINITE, i, j, q, 0.0);
+            }
+            q_[j * count_ + i] = q;
+        }
+
+        if (i + 1 < count_) {
+            inv_dt_[i] = 1.0 / (points[i + 1].time_from_start - t);
+        }
+    }
+}
+
+void TrajectoryValidator::check_limits(size_t begin, size_t end, IssueList& list) const {
+    const double* t = t_.data();
+    const double* inv_dt = inv_dt_.data();
+    const double scale = 1.0 + limits_.tolerance;
+
+    for (size_t j = 0; j < dof_; ++j) {
+        const double* q = q_.data() + j * count_;
+
+        // 位置：先求块内最值，越界时再逐点定位
+        if (j < limits_.min_position.size() || j < limits_.max_position.size()) {
+            const double lo_limit = j < limits_.min_position.size() ? limits_.min_position[j] : -HUGE_VAL;
+            const double hi_limit = j < limits_.max_position.size() ? limits_.max_position[j] : HUGE_VAL;
+            double lo = HUGE_VAL, hi = -HUGE_VAL;
+            for (size_t i = begin; i < end; ++i) {
+                lo = q[i] < lo ? q[i] : lo;
+                hi = q[i] > hi ? q[i] : hi;
+            }
+            if (lo < lo_limit || hi > hi_limit) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (q[i] < lo_limit) add_issue(list, TrajectoryViolation::POSITION_LIMIT, i, j, q[i], lo_limit);
+                    else if (q[i] > hi_limit) add_issue(list, TrajectoryViolation::POSITION_LIMIT, i, j, q[i], hi_limit);
+                }
+            }
+        }
+
+        // 速度：段 i 为点 i 到 i+1，归属点 i+1
+        const size_t seg_end = std::min(end, count_ - 1);
+        if (j < limits_.max_velocity.size() && begin < seg_end) {
+            const double limit = limits_.max_velocity[j] * scale;
+            double peak = 0.0;
+            for (size_t i = begin; i < seg_end; ++i) {
+                const double v = std::fabs((q[i + 1] - q[i]) * inv_dt[i]);
+                peak = v > peak ? v : peak;
+            }
+            if (peak > limit) {
+                for (size_t i = begin; i < seg_end; ++i) {
+                    const double v = (q[i + 1] - q[i]) * inv_dt[i];
+                    if (std::fabs(v) > limit) {
+                        add_issue(list, TrajectoryViolation::VELOCITY_LIMIT, i + 1, j, v, limits_.max_velocity[j]);
+                    }
+                }
+            }
+        }
+
+        // 加速度：点 i 两侧段速度之差除以两段中点的时间间隔
+        const size_t acc_begin = std::max<size_t>(begin, 1);
+        if (j < limits_.max_acceleration.size() && acc_begin < seg_end) {
+            const double limit = limits_.max_acceleration[j] * scale;
+            double peak = 0.0;
+            for (size_t i = acc_begin; i < seg_end; ++i) {
+                const double v0 = (q[i] - q[i - 1]) * inv_dt[i - 1];
+                const double v1 = (q[i + 1] - q[i]) * inv_dt[i];
+                const double a = std::fabs((v1 - v0) * 2.0 / (t[i + 1] - t[i - 1]));
+                peak = a > peak ? a : peak;
+            }
+            if (peak > limit) {
+                for (size_t i = acc_begin; i < seg_end; ++i) {
+                    const double v0 = (q[i] - q[i - 1]) * inv_dt[i - 1];
+                    const double v1 = (q[i + 1] - q[i]) * inv_dt[i];
+                    const double a = (v1 - v0) * 2.0 / (t[i + 1] - t[i - 1]);
+                    if (std::fabs(a) > limit) {
+                        add_issue(list, TrajectoryViolation::ACCELERATION_LIMIT, i, j, a, limits_.max_acceleration[j]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TrajectoryValidationResult TrajectoryValidator::validate(const Trajectory& trajectory, size_t expected_dof,
+                                                         const std::vector<double>* current_positions) {
+    const auto start = std::chrono::steady_clock::now();
+    TrajectoryValidationResult result;
+    auto finish = [&]() {
+        result.valid = result.issue_count == 0;
+        result.elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    };
+
+    if (trajectory.points.empty()) {
+        result.issue_count = 1;
+        result.issues.push_back(TrajectoryIssue{TrajectoryViolation::EMPTY, 0, 0, 0.0, 0.0});
+        return finish();
+    }
+
+    count_ = trajectory.points.size();
+    dof_ = expected_dof > 0 ? expected_dof : trajectory.points.front().positions.size();
+    if (dof_ == 0) {
+        result.issue_count = 1;
+        result.issues.push_back(TrajectoryIssue{TrajectoryViolation::DIMENSION_MISMATCH, 0, 0, 0.0, 0.0});
+        return finish();
+    }
+    t_.resize(count_);
+    inv_dt_.resize(count_);
+    q_.resize(count_ * dof_);
+
+    const size_t chunks = chunk_count();
+    result.threads_used = chunks;
+    std::vector<IssueList> lists;
+
+    // 结构问题会让差分失去意义，先单独检查
+    run_chunks(chunks, lists, [this, &trajectory](size_t begin, size_t end, IssueList& list) {
+        check_structure(trajectory, begin, end, list);
+    });
+    collect(lists, result);
+    if (result.issue_count > 0) {
+        return finish();
+    }
+
+    run_chunks(chunks, lists, [this](size_t begin, size_t end, IssueList& list) {
+        check_limits(begin, end, list);
+    });
+
+    if (limits_.max_start_distance > 0.0 && current_positions && current_positions->size() >= dof_) {
+        result.start_checked = true;
+        for (size_t j = 0; j < dof_; ++j) {
+            const double distance = std::fabs(q_[j * count_] - (*current_positions)[j]);
+            if (!(distance <= limits_.max_start_distance)) {
+                add_issue(lists[0], TrajectoryViolation::START_DISTANCE, 0, j, distance, limits_.max_start_distance);
+            }
+        }
+    }
+    collect(lists, result);
+    return finish();
+}
+
+}   // namespace trajectory
+}   // namespace hardware_driver
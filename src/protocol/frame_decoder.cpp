@@ -0,0 +1,609 @@
+/*********************************************************************
+ * @file        frame_decoder.cpp
+ * @brief       总线帧分类、解码与流量统计实现
+ *********************************************************************/
+
+#include "frame_decoder.hpp"
+#include "motor_protocol.hpp"
+#include "iap_protocol.hpp"
+#include "gripper_omnipicker_protocol.hpp"
+#include "driver/button_driver_impl.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <variant>
+
+namespace hardware_driver {
+namespace frame_decoder {
+
+namespace {
+
+constexpr const char* FRAME_CLASS_NAMES[FRAME_CLASS_COUNT] = {
+    "control", "control_all", "enable", "enable_all", "feedback_req", "function", "param",
+    "control_reply", "status", "func_result", "param_result", "iap_req", "iap_status",
+    "gripper", "button", "unknown"
+};
+
+constexpr size_t BATCH_MOTORS = 6;          // 批量控制/使能帧中的电机数，槽位 i 对应电机 i + 1
+
+// 请求 → 应答配对的槽位
+constexpr int SLOT_STATUS = 0;
+constexpr int SLOT_CONTROL = 1;
+constexpr int SLOT_FUNCTION = 2;
+constexpr int SLOT_PARAMETER = 3;
+
+int request_slot(FrameClass frame_class) {
+    switch (frame_class) {
+        case FrameClass::FEEDBACK_REQUEST: return SLOT_STATUS;
+        case FrameClass::CONTROL:
+        case FrameClass::CONTROL_ALL:      return SLOT_CONTROL;
+        case FrameClass::FUNCTION:         return SLOT_FUNCTION;
+        case FrameClass::PARAMETER:        return SLOT_PARAMETER;
+        default:                           return -1;
+    }
+}
+
+int reply_slot(FrameClass frame_class) {
+    switch (frame_class) {
+        case FrameClass::STATUS:           return SLOT_STATUS;
+        case FrameClass::CONTROL_REPLY:    return SLOT_CONTROL;
+        case FrameClass::FUNCTION_RESULT:  return SLOT_FUNCTION;
+        case FrameClass::PARAMETER_RESULT: return SLOT_PARAMETER;
+        default:                           return -1;
+    }
+}
+
+bool from_device(FrameClass frame_class) {
+    switch (frame_class) {
+        case FrameClass::CONTROL_REPLY:
+        case FrameClass::STATUS:
+        case FrameClass::FUNCTION_RESULT:
+        case FrameClass::PARAMETER_RESULT:
+        case FrameClass::IAP_STATUS:       return true;
+        default:                           return false;
+    }
+}
+
+float be_float(const uint8_t* in) {
+    uint32_t raw = (static_cast<uint32_t>(in[0]) << 24) | (static_cast<uint32_t>(in[1]) << 16) |
+                   (static_cast<uint32_t>(in[2]) << 8) | static_cast<uint32_t>(in[3]);
+    float value;
+    std::memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+int16_t be_int16(const uint8_t* in) {
+    return static_cast<int16_t>((static_cast<uint16_t>(in[0]) << 8) | in[1]);
+}
+
+uint16_t be_uint16(const uint8_t* in) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(in[0]) << 8) | in[1]);
+}
+
+const char* function_name(uint8_t op) {
+    using motor_protocol::MotorFunc;
+    switch (static_cast<MotorFunc>(op)) {
+        case MotorFunc::PARAM_RESET:               return "param_reset";
+        case MotorFunc::PARAM_SAVE_TO_FLASH:       return "save_flash";
+        case MotorFunc::CLEAR_ERROR_CODE:          return "clear_error";
+        case MotorFunc::MOTOR_ZERO_POS_SET:        return "set_zero";
+        case MotorFunc::MOTOR_FIND_ZERO_POS:       return "find_zero";
+        case MotorFunc::MOTOR_IAP_UPDATE:          return "iap_update";
+        case MotorFunc::MOTOR_HALL_CALIBRATION:    return "hall_calib";
+        case MotorFunc::MOTOR_CURRENT_CALIBRATION: return "current_calib";
+        case MotorFunc::MOTOR_ENCODER_CALIBRATION: return "encoder_calib";
+        case MotorFunc::MOTOR_SOFTWARE_RESET:      return "soft_reset";
+    }
+    return "op?";
+}
+
+void append_hex(std::ostringstream& out, const uint8_t* data, size_t len) {
+    char buf[4];
+    for (size_t i = 0; i < len; ++i) {
+        std::snprintf(buf, sizeof(buf), "%02X", data[i]);
+        out << buf;
+    }
+}
+
+bool is_printable(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        if (!std::isprint(data[i])) return false;
+    }
+    return true;
+}
+
+void describe_parameter_value(std::ostringstream& out, uint8_t type, const uint8_t* value) {
+    if (type == 0x01) {
+        out << " int=" << static_cast<int32_t>((static_cast<uint32_t>(value[0]) << 24) |
+                                                (static_cast<uint32_t>(value[1]) << 16) |
+                                                (static_cast<uint32_t>(value[2]) << 8) | value[3]);
+    } else if (type == 0x02) {
+        out << " float=" << be_float(value);
+    }
+}
+
+void describe_gripper(std::ostringstream& out, const bus::GenericBusPacket& packet) {
+    using namespace gripper_protocol;
+    const uint8_t* d = packet.data.data();
+    const size_t len = packet.len;
+    if (packet.id == CANFD_2_RS485_ID) {
+        // 1 字节为转换器唤醒，否则是 RS485 透传帧 55 AA <n> <data> <checksum> EB AA
+        if (len == 1) {
+            out << "rs485 wakeup mode=" << static_cast<int>(d[0]);
+        } else if (len >= 3 && d[0] == 0x55 && d[1] == 0xAA) {
+            const size_t n = std::min<size_t>(d[2], len >= 6 ? len - 6 : 0);
+            out << "rs485 tx n=" << static_cast<int>(d[2]) << " data=";
+            append_hex(out, d + 3, n);
+        } else {
+            out << "rs485 tx ";
+            append_hex(out, d, len);
+        }
+    } else if (packet.id == RS485_2_CANFD_ID) {
+        out << "rs485 rx ";
+        append_hex(out, d, len);
+    } else if (packet.id == SEND_GRIPPER_ID) {
+        if (len >= 7 && d[0] == 0x01) {
+            out << "omnipicker cmd pos=" << static_cast<int>(d[2]) << " speed=" << static_cast<int>(d[3])
+                << " force=" << static_cast<int>(d[4]) << " acc=" << static_cast<int>(d[5])
+                << " dec=" << static_cast<int>(d[6]);
+        } else if (len >= 8 && d[0] == 0x02 && d[1] == 0x01) {
+            out << "pgc cmd vel=" << be_uint16(d + 2) << " effort=" << be_uint16(d + 4)
+                << " pos=" << be_uint16(d + 6) * 0.1 << "mm";
+        } else if (len >= 2 && d[0] == 0x02 && d[1] == 0x02) {
+            out << "pgc query";
+        } else {
+            out << "gripper cmd ";
+            append_hex(out, d, len);
+        }
+    } else {    // RECV_GRIPPER_ID
+        if (len >= 6 && d[0] == 0x01) {
+            out << "omnipicker status=" << static_cast<int>(d[1]) << " action=" << static_cast<int>(d[2])
+                << " pos=" << static_cast<int>(d[3]) << " speed=" << static_cast<int>(d[4])
+                << " force=" << static_cast<int>(d[5]);
+            if (d[1] != static_cast<uint8_t>(OmniPickerStatus::NORMAL)) out << " FAULT";
+            if (d[2] == static_cast<uint8_t>(OmniPickerActionStatus::GRIPPER_JAM)) out << " JAM";
+            if (d[2] == static_cast<uint8_t>(OmniPickerActionStatus::OBJ_FALL)) out << " OBJ_FALL";
+        } else if (len >= 2 && d[0] == 0x02) {
+            out << "pgc status=" << static_cast<int>(d[1]);
+            if (d[1] == static_cast<uint8_t>(PGCGripperStatus::GRIPPER_STOP_SOMETHING)) out << " holding";
+            if (d[1] == static_cast<uint8_t>(PGCGripperStatus::GRIPPER_STOP_OBJ_FALL)) out << " OBJ_FALL";
+        } else {
+            out << "gripper feedback ";
+            append_hex(out, d, len);
+        }
+    }
+}
+
+void describe_button(std::ostringstream& out, const bus::GenericBusPacket& packet) {
+    using namespace button_driver;
+    const uint8_t* d = packet.data.data();
+    if (packet.len >= 4) {
+        if (packet.id == BUTTON_RX_CAN_ID) {
+            for (size_t i = 0; i < PROTOCOL_COUNT; ++i) {
+                if (std::memcmp(d, PROTOCOL_TABLE[i].code, 4) == 0) {
+                    out << "button " << PROTOCOL_TABLE[i].code << " status="
+                        << static_cast<int>(PROTOCOL_TABLE[i].status);
+                    return;
+                }
+            }
+        } else if (std::memcmp(d, REPLAY_COMPLETE_CODE, 4) == 0) {
+            out << "button FXJS replay complete";
+            return;
+        }
+    }
+    out << (packet.id == BUTTON_RX_CAN_ID ? "button rx " : "button tx ");
+    if (is_printable(d, packet.len)) {
+        out << '"' << std::string(reinterpret_cast<const char*>(d), packet.len) << '"';
+    } else {
+        append_hex(out, d, packet.len);
+    }
+}
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+}   // namespace
+
+const char* frame_class_name(FrameClass frame_class) {
+    const size_t index = static_cast<size_t>(frame_class);
+    return index < FRAME_CLASS_COUNT ? FRAME_CLASS_NAMES[index] : "unknown";
+}
+
+bool parse_frame_class(const std::string& name, FrameClass& frame_class) {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (size_t i = 0; i < FRAME_CLASS_COUNT; ++i) {
+        if (lower == FRAME_CLASS_NAMES[i]) {
+            frame_class = static_cast<FrameClass>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+FrameInfo classify(const bus::GenericBusPacket& packet) {
+    FrameInfo info;
+    const uint32_t id = packet.id;
+    const uint8_t* d = packet.data.data();
+
+    // 夹爪与按键使用固定的低位 ID，先于单电机帧判断
+    if (id == gripper_protocol::CANFD_2_RS485_ID || id == gripper_protocol::SEND_GRIPPER_ID) {
+        info.frame_class = FrameClass::GRIPPER;
+        return info;
+    }
+    if (id == gripper_protocol::RS485_2_CANFD_ID || id == gripper_protocol::RECV_GRIPPER_ID) {
+        info.frame_class = FrameClass::GRIPPER;
+        info.from_device = true;
+        return info;
+    }
+    if (id == button_driver::BUTTON_RX_CAN_ID || id == button_driver::BUTTON_TX_CAN_ID) {
+        info.frame_class = FrameClass::BUTTON;
+        info.from_device = (id == button_driver::BUTTON_RX_CAN_ID);
+        return info;
+    }
+
+    if (id == 0x000) {
+        if (packet.len >= 2) {
+            switch (d[1]) {
+                case 0x00: info.frame_class = FrameClass::FEEDBACK_REQUEST; break;
+                case 0x02: info.frame_class = FrameClass::ENABLE_ALL; break;
+                case 0x03: info.frame_class = FrameClass::CONTROL_ALL; break;
+                default: break;
+            }
+        }
+        return info;
+    }
+
+    const uint32_t base = id & 0xFFFFFF00;
+    const uint32_t motor_id = id & 0xFF;
+    info.motor_id = motor_id;
+    switch (base) {
+        case 0x000:
+            if (packet.len >= 1 && d[0] == 0x0E) {
+                info.frame_class = FrameClass::CONTROL;
+            } else if (packet.len >= 2 && d[0] == 0x02) {
+                info.frame_class = FrameClass::ENABLE;
+            }
+            break;
+        case 0x100: info.frame_class = FrameClass::CONTROL_REPLY; info.from_device = true; break;
+        case 0x200: info.frame_class = FrameClass::FEEDBACK_REQUEST; break;
+        case 0x300: info.frame_class = FrameClass::STATUS; info.from_device = true; break;
+        case 0x400: info.frame_class = FrameClass::FUNCTION; break;
+        case 0x500: info.frame_class = FrameClass::FUNCTION_RESULT; info.from_device = true; break;
+        case 0x600: info.frame_class = FrameClass::PARAMETER; break;
+        case 0x700: info.frame_class = FrameClass::PARAMETER_RESULT; info.from_device = true; break;
+        case 0x1400: info.frame_class = FrameClass::IAP_REQUEST; break;
+        case 0xFF00: info.frame_class = FrameClass::IAP_STATUS; info.from_device = true; break;
+        default: break;
+    }
+    if (info.frame_class == FrameClass::UNKNOWN) {
+        info.motor_id = 0;
+    }
+    return info;
+}
+
+std::string describe(const bus::GenericBusPacket& packet, const FrameInfo& info) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    const uint8_t* d = packet.data.data();
+    const size_t len = packet.len;
+
+    switch (info.frame_class) {
+        case FrameClass::CONTROL:
+            if (len < 15) break;
+            out << "pos=" << be_float(d + 1) << " vel=" << be_float(d + 5) << " eff=" << be_float(d + 9)
+                << " kp=" << d[13] / 1000.0 << " kd=" << d[14] / 1000.0;
+            return out.str();
+
+        case FrameClass::CONTROL_ALL: {
+            const size_t motors = std::min(BATCH_MOTORS, len >= 2 ? (len - 2) / 8 : 0);
+            for (size_t i = 0; i < motors; ++i) {
+                const uint8_t* m = d + 2 + i * 8;
+                if (i) out << " | ";
+                out << "m" << i + 1 << " pos=" << be_int16(m) / 100.0 << " vel=" << be_int16(m + 2) / 100.0
+                    << " eff=" << be_int16(m + 4) / 10.0 << " kp=" << m[6] / 1000.0 << " kd=" << m[7] / 1000.0;
+            }
+            return out.str();
+        }
+
+        case FrameClass::ENABLE:
+            out << (d[1] ? "enable" : "disable");
+            if (len >= 3) out << " mode=" << static_cast<int>(d[2]);
+            return out.str();
+
+        case FrameClass::ENABLE_ALL: {
+            const size_t motors = std::min(BATCH_MOTORS, len >= 2 ? len - 2 : 0);
+            for (size_t i = 0; i < motors; ++i) {
+                if (i) out << ' ';
+                out << "m" << i + 1 << "=" << ((d[2 + i] >> 4) ? "on" : "off") << "/" << (d[2 + i] & 0x0F);
+            }
+            return out.str();
+        }
+
+        case FrameClass::FEEDBACK_REQUEST:
+            out << (info.motor_id ? "request feedback" : "request feedback (all)");
+            return out.str();
+
+        case FrameClass::FUNCTION:
+            if (len < 2) break;
+            out << function_name(d[1]) << " (0x" << std::hex << std::setw(2) << std::setfill('0')
+                << static_cast<int>(d[1]) << ")";
+            return out.str();
+
+        case FrameClass::PARAMETER:
+            if (len < 4) break;
+            out << (d[1] == 0x01 ? "read" : "write") << " addr=0x" << std::hex << std::setw(4)
+                << std::setfill('0') << be_uint16(d + 2) << std::dec << std::setfill(' ');
+            if (d[1] == 0x02 && len >= 9) describe_parameter_value(out, d[4], d + 5);
+            return out.str();
+
+        case FrameClass::CONTROL_REPLY:
+            out << "control reply ";
+            append_hex(out, d, len);
+            return out.str();
+
+        case FrameClass::STATUS:
+        case FrameClass::FUNCTION_RESULT:
+        case FrameClass::PARAMETER_RESULT: {
+            if (info.frame_class == FrameClass::STATUS && len < 24) {
+                out << "truncated status len=" << len;
+                return out.str();
+            }
+            // 电机反馈只走 CAN FD，经典 CAN 日志里的帧也按 CAN FD 布局解析
+            auto feedback = motor_protocol::parse_canfd_feedback(packet);
+            if (!feedback) break;
+            if (auto* status = std::get_if<motor_protocol::MotorStatusFeedback>(&*feedback)) {
+                const auto& s = status->status;
+                out << (s.enable_flag ? "on" : "off") << " mode=" << static_cast<int>(s.motor_mode)
+                    << " pos=" << s.position << " vel=" << s.velocity << " eff=" << s.effort
+                    << " volt=" << s.voltage << " temp=" << s.temperature;
+                if (s.limit_flag) out << " limit=" << static_cast<int>(s.limit_flag);
+                if (s.error_code) out << " err=0x" << std::hex << s.error_code << std::dec;
+            } else if (auto* func = std::get_if<motor_protocol::FuncResultFeedback>(&*feedback)) {
+                out << function_name(func->op_code) << (func->success ? " ok" : " FAILED");
+            } else if (auto* param = std::get_if<motor_protocol::ParamResultFeedback>(&*feedback)) {
+                out << (param->rw_method == 0x01 ? "read" : "write") << " addr=0x" << std::hex << std::setw(4)
+                    << std::setfill('0') << param->addr << std::dec << std::setfill(' ');
+                if (len >= 9) describe_parameter_value(out, param->data_type, d + 5);
+            }
+            return out.str();
+        }
+
+        case FrameClass::IAP_REQUEST:
+            if (len == 2 && d[0] == 0x01 && d[1] == static_cast<uint8_t>(motor_protocol::MotorFunc::MOTOR_IAP_UPDATE)) {
+                out << "enter iap";
+            } else if (len == 3 && std::memcmp(d, "key", 3) == 0) {
+                out << "key";
+            } else {
+                out << "firmware " << len << " bytes";
+            }
+            return out.str();
+
+        case FrameClass::IAP_STATUS: {
+            if (len < 4) break;
+            auto feedback = iap_protocol::parse_iap_feedback(packet);
+            if (!feedback) break;
+            out << iap_protocol::iap_status_to_string(feedback->status_msg);
+            return out.str();
+        }
+
+        case FrameClass::GRIPPER:
+            describe_gripper(out, packet);
+            return out.str();
+
+        case FrameClass::BUTTON:
+            describe_button(out, packet);
+            return out.str();
+
+        default:
+            break;
+    }
+
+    // 无法按协议解码时输出原始字节
+    out.str("");
+    append_hex(out, d, len);
+    return out.str();
+}
+
+bool parse_candump_line(const std::string& line, bus::GenericBusPacket& packet, int64_t& timestamp_ns) {
+    // (sec.usec) iface id#data 或 id##flags data
+    const size_t open = line.find('(');
+    const size_t close = line.find(')', open);
+    if (open == std::string::npos || close == std::string::npos) return false;
+
+    const std::string stamp = line.substr(open + 1, close - open - 1);
+    const size_t dot = stamp.find('.');
+    if (dot == std::string::npos) return false;
+    try {
+        const int64_t sec = std::stoll(stamp.substr(0, dot));
+        std::string frac = stamp.substr(dot + 1);
+        frac.resize(9, '0');
+        timestamp_ns = sec * 1000000000LL + std::stoll(frac);
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    std::istringstream rest(line.substr(close + 1));
+    std::string iface, frame;
+    if (!(rest >> iface >> frame)) return false;
+
+    const size_t hash = frame.find('#');
+    if (hash == std::string::npos || hash == 0) return false;
+    uint32_t id = 0;
+    for (size_t i = 0; i < hash; ++i) {
+        const int v = hex_value(frame[i]);
+        if (v < 0) return false;
+        id = (id << 4) | static_cast<uint32_t>(v);
+    }
+
+    size_t pos = hash + 1;
+    bool fd = false;
+    if (pos < frame.size() && frame[pos] == '#') {
+        fd = true;
+        pos += 2;   // 跳过 FD 标志位（BRS/ESI）
+        if (pos > frame.size()) return false;
+    } else if (pos < frame.size() && (frame[pos] == 'R' || frame[pos] == 'r')) {
+        pos = frame.size();     // 远程帧没有数据
+    }
+
+    size_t len = 0;
+    while (pos < frame.size()) {
+        if (frame[pos] == '.') {    // candump 允许用 '.' 分隔字节
+            ++pos;
+            continue;
+        }
+        if (pos + 1 >= frame.size() || len >= bus::MAX_BUS_DATA_SIZE) return false;
+        const int hi = hex_value(frame[pos]);
+        const int lo = hex_value(frame[pos + 1]);
+        if (hi < 0 || lo < 0) return false;
+        packet.data[len++] = static_cast<uint8_t>((hi << 4) | lo);
+        pos += 2;
+    }
+    std::fill(packet.data.begin() + len, packet.data.end(), 0);
+
+    packet.interface = iface;
+    packet.id = id;
+    packet.len = len;
+    packet.protocol_type = fd ? bus::BusProtocolType::CAN_FD : bus::BusProtocolType::CAN;
+    return true;
+}
+
+void RunningStats::add(double value) {
+    ++count;
+    if (count == 1) {
+        min = max = value;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    const double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+}
+
+double RunningStats::stddev() const {
+    return count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : 0.0;
+}
+
+void TrafficAnalyzer::add(const bus::GenericBusPacket& packet, const FrameInfo& info, int64_t timestamp_ns) {
+    ++frame_count_;
+    ++totals_[static_cast<size_t>(info.frame_class)];
+    if (first_ns_ == 0) first_ns_ = timestamp_ns;
+    last_ns_ = std::max(last_ns_, timestamp_ns);
+
+    const int req_slot = request_slot(info.frame_class);
+    if (req_slot >= 0) {
+        if (info.motor_id == 0) {
+            interfaces_[packet.interface].broadcast[req_slot] = timestamp_ns;
+        } else {
+            pending_[{packet.interface, info.motor_id}].unicast[req_slot] = timestamp_ns;
+        }
+    }
+
+    // 批量控制/使能帧按槽位计入各电机
+    if (info.frame_class == FrameClass::CONTROL_ALL || info.frame_class == FrameClass::ENABLE_ALL) {
+        for (uint32_t motor = 1; motor <= BATCH_MOTORS; ++motor) {
+            ++motors_[{packet.interface, motor}].frames[static_cast<size_t>(info.frame_class)];
+        }
+        return;
+    }
+    if (info.motor_id == 0) return;
+
+    const MotorKey key{packet.interface, info.motor_id};
+    MotorTraffic& traffic = motors_[key];
+    ++traffic.frames[static_cast<size_t>(info.frame_class)];
+
+    if (info.frame_class == FrameClass::STATUS) {
+        if (traffic.last_status_ns != 0) {
+            traffic.status_interval_us.add((timestamp_ns - traffic.last_status_ns) / 1000.0);
+        } else {
+            traffic.first_status_ns = timestamp_ns;
+        }
+        traffic.last_status_ns = timestamp_ns;
+    }
+
+    const int rep_slot = reply_slot(info.frame_class);
+    if (rep_slot < 0) return;
+
+    MotorPending& pending = pending_[key];
+    int64_t request_ns = pending.unicast[rep_slot];
+    auto iface = interfaces_.find(packet.interface);
+    if (iface != interfaces_.end()) {
+        request_ns = std::max(request_ns, iface->second.broadcast[rep_slot]);
+    }
+    // 只与尚未配对的最近一次请求配对
+    if (request_ns == 0 || request_ns == pending.matched[rep_slot] || request_ns > timestamp_ns) return;
+    pending.matched[rep_slot] = request_ns;
+
+    const double latency_us = (timestamp_ns - request_ns) / 1000.0;
+    switch (rep_slot) {
+        case SLOT_STATUS:    traffic.status_latency_us.add(latency_us); break;
+        case SLOT_CONTROL:   traffic.control_latency_us.add(latency_us); break;
+        case SLOT_FUNCTION:  traffic.function_latency_us.add(latency_us); break;
+        case SLOT_PARAMETER: traffic.parameter_latency_us.add(latency_us); break;
+        default: break;
+    }
+}
+
+void TrafficAnalyzer::report(std::ostream& out, const std::set<uint32_t>& motor_filter) const {
+    const double seconds = last_ns_ > first_ns_ ? (last_ns_ - first_ns_) / 1e9 : 0.0;
+    out << std::fixed << std::setprecision(3);
+    out << "frames=" << frame_count_ << " duration=" << seconds << "s";
+    out << std::setprecision(1);
+    if (seconds > 0.0) out << " rate=" << frame_count_ / seconds << "/s";
+    out << "\n";
+    for (size_t i = 0; i < FRAME_CLASS_COUNT; ++i) {
+        if (totals_[i] == 0) continue;
+        out << "  " << std::left << std::setw(14) << FRAME_CLASS_NAMES[i] << std::right << std::setw(10)
+            << totals_[i] << "\n";
+    }
+
+    auto latency = [&out](const RunningStats& stats) {
+        if (stats.count == 0) {
+            out << std::setw(17) << "-";
+        } else {
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(0) << stats.mean << "/" << stats.max;
+            out << std::setw(17) << cell.str();
+        }
+    };
+
+    out << std::left << std::setw(8) << "IFACE" << std::right << std::setw(5) << "ID"
+        << std::setw(10) << "STATUS/s" << std::setw(10) << "TX/s"
+        << std::setw(11) << "GAP(us)" << std::setw(11) << "JITTER" << std::setw(11) << "GAPMAX"
+        << std::setw(17) << "REQ>ST avg/max" << std::setw(17) << "CTRL>RPL" << std::setw(17) << "PARAM>RES"
+        << "\n";
+    for (const auto& [key, traffic] : motors_) {
+        if (!motor_filter.empty() && motor_filter.find(key.second) == motor_filter.end()) continue;
+        uint64_t tx_frames = 0;
+        for (size_t i = 0; i < FRAME_CLASS_COUNT; ++i) {
+            if (!from_device(static_cast<FrameClass>(i))) tx_frames += traffic.frames[i];
+        }
+        const uint64_t status = traffic.frames[static_cast<size_t>(FrameClass::STATUS)];
+        out << std::left << std::setw(8) << key.first << std::right << std::setw(5) << key.second
+            << std::setw(10) << (seconds > 0.0 ? status / seconds : 0.0)
+            << std::setw(10) << (seconds > 0.0 ? tx_frames / seconds : 0.0);
+        if (traffic.status_interval_us.count > 0) {
+            out << std::setw(11) << traffic.status_interval_us.mean << std::setw(11)
+                << traffic.status_interval_us.stddev() << std::setw(11) << traffic.status_interval_us.max;
+        } else {
+            out << std::setw(11) << "-" << std::setw(11) << "-" << std::setw(11) << "-";
+        }
+        latency(traffic.status_latency_us);
+        latency(traffic.control_latency_us);
+        latency(traffic.parameter_latency_us);
+        out << "\n";
+    }
+}
+
+}   // namespace frame_decoder
+}   // namespace hardware_driver
@@ -0,0 +1,135 @@
+/*********************************************************************
+ * @file        frame_decoder.hpp
+ * @brief       总线帧分类与解码，供抓包工具和测试使用
+ *
+ * 按帧 ID 和数据把总线上的每一帧归类（电机控制、批量控制、反馈请求、状态反馈、参数读写、IAP、夹爪、按键），
+ * 并转成可读文本。电机反馈与 IAP 状态使用 motor_protocol / iap_protocol 的解析函数，主机发出的命令按对应
+ * pack_* 函数的布局反向解析。分类只看 ID 和少量字节，不分配内存，可在满载总线上逐帧调用。
+ *********************************************************************/
+
+#ifndef __HARDWARE_DRIVER_FRAME_DECODER_HPP__
+#define __HARDWARE_DRIVER_FRAME_DECODER_HPP__
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+#include "hardware_driver/bus/bus_interface.hpp"
+
+namespace hardware_driver {
+namespace frame_decoder {
+
+enum class FrameClass : uint8_t {
+    CONTROL = 0,            // 单电机 MIT 控制（ID = 电机号）
+    CONTROL_ALL,            // 批量控制（ID 0，data[1] = 0x03）
+    ENABLE,                 // 单电机使能/失能
+    ENABLE_ALL,             // 批量使能/失能（ID 0，data[1] = 0x02）
+    FEEDBACK_REQUEST,       // 反馈请求（ID 0 广播或 0x200 + 电机号）
+    FUNCTION,               // 功能操作（0x400 + 电机号）
+    PARAMETER,              // 参数读写（0x600 + 电机号）
+    CONTROL_REPLY,          // 控制应答（0x100 + 电机号）
+    STATUS,                 // 状态反馈（0x300 + 电机号）
+    FUNCTION_RESULT,        // 功能操作结果（0x500 + 电机号）
+    PARAMETER_RESULT,       // 参数读写结果（0x700 + 电机号）
+    IAP_REQUEST,            // IAP 请求、key 和固件数据（0x1400 + 电机号）
+    IAP_STATUS,             // IAP ASCII 状态码（0xFF00 + 电机号）
+    GRIPPER,                // 夹爪与 CANFD-RS485 转换器（0x3F/0x4F/0x5F/0x6F）
+    BUTTON,                 // 按键事件与 LED 控制（0x8F/0x7F）
+    UNKNOWN,
+    COUNT
+};
+
+constexpr size_t FRAME_CLASS_COUNT = static_cast<size_t>(FrameClass::COUNT);
+
+const char* frame_class_name(FrameClass frame_class);
+// 按名称（不区分大小写，如 "status"、"param_result"）查找帧类别
+bool parse_frame_class(const std::string& name, FrameClass& frame_class);
+
+struct FrameInfo {
+    FrameClass frame_class{FrameClass::UNKNOWN};
+    bool from_device{false};        // true：设备发往主机
+    uint32_t motor_id{0};           // 0 表示广播或与电机无关
+};
+
+// 只看 ID 和前两个字节，不分配内存
+FrameInfo classify(const bus::GenericBusPacket& packet);
+
+// 帧内容的可读描述（不含时间戳、接口和 ID）
+std::string describe(const bus::GenericBusPacket& packet, const FrameInfo& info);
+
+/**
+ * @brief 解析 candump -l 日志行："(1700000000.123456) can0 123#11223344" 或 "... can0 123##1112233"
+ * @param timestamp_ns 日志中的时间戳（纳秒）
+ * @return 行格式不符时返回 false
+ */
+bool parse_candump_line(const std::string& line, bus::GenericBusPacket& packet, int64_t& timestamp_ns);
+
+// 增量统计：均值、标准差、最小/最大值
+struct RunningStats {
+    uint64_t count{0};
+    double mean{0.0};
+    double m2{0.0};
+    double min{0.0};
+    double max{0.0};
+
+    void add(double value);
+    double stddev() const;
+};
+
+// 单个电机的流量统计，时间单位为微秒
+struct MotorTraffic {
+    std::array<uint64_t, FRAME_CLASS_COUNT> frames{};
+    RunningStats status_interval_us;            // 状态反馈到达间隔，标准差即抖动
+    RunningStats status_latency_us;             // 反馈请求 → 状态反馈
+    RunningStats control_latency_us;            // 控制命令 → 控制应答
+    RunningStats function_latency_us;           // 功能操作 → 结果
+    RunningStats parameter_latency_us;          // 参数读写 → 结果
+    int64_t first_status_ns{0};
+    int64_t last_status_ns{0};
+};
+
+/**
+ * @brief 按接口和电机统计帧速率、应答时延和到达间隔抖动
+ * 请求与应答按电机配对：广播请求对接口上每个电机都有效，每个请求只与其后第一个应答配对
+ */
+class TrafficAnalyzer {
+public:
+    using MotorKey = std::pair<std::string, uint32_t>;
+
+    void add(const bus::GenericBusPacket& packet, const FrameInfo& info, int64_t timestamp_ns);
+
+    const std::map<MotorKey, MotorTraffic>& motors() const { return motors_; }
+    const std::array<uint64_t, FRAME_CLASS_COUNT>& totals() const { return totals_; }
+    uint64_t frame_count() const { return frame_count_; }
+    int64_t first_ns() const { return first_ns_; }
+    int64_t last_ns() const { return last_ns_; }
+
+    // 打印统计表；motor_filter 非空时只列出其中的电机
+    void report(std::ostream& out, const std::set<uint32_t>& motor_filter = {}) const;
+
+private:
+    // 请求时刻：按接口的广播请求，以及按电机的单播请求
+    struct PendingRequests {
+        std::array<int64_t, 4> broadcast{};     // 下标见 request_slot()
+    };
+    struct MotorPending {
+        std::array<int64_t, 4> unicast{};
+        std::array<int64_t, 4> matched{};       // 已配对过的请求时刻，避免一个请求配对多个应答
+    };
+
+    std::map<std::string, PendingRequests> interfaces_;
+    std::map<MotorKey, MotorPending> pending_;
+    std::map<MotorKey, MotorTraffic> motors_;
+    std::array<uint64_t, FRAME_CLASS_COUNT> totals_{};
+    uint64_t frame_count_{0};
+    int64_t first_ns_{0};
+    int64_t last_ns_{0};
+};
+
+}   // namespace frame_decoder
+}   // namespace hardware_driver
+
+#endif    // __HARDWARE_DRIVER_FRAME_DECODER_HPP__
@@ -0,0 +1,264 @@
+#include "hardware_driver/runtime/runtime.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace hardware_driver {
+namespace runtime {
+
+Runtime::Runtime(RuntimeConfig config)
+    : config_(std::move(config))
+{
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wakeup_fd_ < 0) {
+        std::cerr << "[Runtime] Failed to create epoll/eventfd: " << std::strerror(errno) << std::endl;
+    } else {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = wakeup_fd_;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event);
+    }
+
+    const size_t worker_count = config_.worker_threads > 0 ? config_.worker_threads : 1;
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&Runtime::worker_loop, this, i);
+    }
+    timer_thread_ = std::thread(&Runtime::timer_loop, this);
+    io_thread_ = std::thread(&Runtime::io_loop, this);
+}
+
+Runtime::~Runtime() {
+    running_ = false;
+
+    tasks_cv_.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        timer_cv_.notify_all();
+    }
+    if (wakeup_fd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = ::write(wakeup_fd_, &one, sizeof(one));
+        (void)written;
+    }
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    if (timer_thread_.joinable()) timer_thread_.join();
+    if (io_thread_.joinable()) io_thread_.join();
+
+    if (wakeup_fd_ >= 0) ::close(wakeup_fd_);
+    if (epoll_fd_ >= 0) ::close(epoll_fd_);
+}
+
+void Runtime::pin_current_thread(int cpu) {
+    if (cpu < 0) return;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    int result = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (result != 0) {
+        std::cerr << "[Runtime] Failed to bind thread to CPU core " << cpu
+                  << ": " << std::strerror(result) << std::endl;
+    }
+}
+
+// ========== 处理线程池 ==========
+
+void Runtime::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    tasks_cv_.notify_one();
+}
+
+void Runtime::worker_loop(size_t index) {
+    pin_current_thread(index < config_.worker_cpus.size() ? config_.worker_cpus[index] : -1);
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(tasks_mutex_);
+            tasks_cv_.wait(lock, [this] { return !running_ || !tasks_.empty(); });
+            if (!running_) break;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "[Runtime] Task error: " << e.what() << std::endl;
+        }
+    }
+}
+
+// ========== 定时器 ==========
+
+Runtime::TimerId Runtime::add_timer(Clock::time_point first, TimerCallback callback) {
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    TimerId id = next_timer_id_++;
+    timers_[id] = TimerEntry{std::make_shared<TimerCallback>(std::move(callback)), first};
+    timer_queue_.emplace(first, id);
+    timer_cv_.notify_one();
+    return id;
+}
+
+void Runtime::cancel_timer(TimerId id) {
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+    auto it = timers_.find(id);
+    if (it != timers_.end()) {
+        auto range = timer_queue_.equal_range(it->second.due);
+        for (auto q = range.first; q != range.second; ++q) {
+            if (q->second == id) {
+                timer_queue_.erase(q);
+                break;
+            }
+        }
+        timers_.erase(it);
+    }
+    // 回调正在执行时等待其结束；在定时器线程内取消自身则直接返回
+    if (std::this_thread::get_id() != timer_thread_id_) {
+        timer_done_cv_.wait(lock, [this, id] { return running_timer_ != id; });
+    }
+}
+
+void Runtime::timer_loop() {
+    pin_current_thread(config_.timer_cpu);
+
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+    timer_thread_id_ = std::this_thread::get_id();   // 先于任何定时器回调记录，cancel_timer 持同一把锁读取
+    while (running_) {
+        if (timer_queue_.empty()) {
+            timer_cv_.wait(lock);
+            continue;
+        }
+
+        const auto due = timer_queue_.begin()->first;
+        const auto now = Clock::now();
+        if (due > now) {
+            // 混合时序：粗粒度等待 + 到期前忙等待
+            if (due - now > config_.timer_spin) {
+                timer_cv_.wait_until(lock, due - config_.timer_spin);
+            } else {
+                lock.unlock();
+                while (Clock::now() < due) {
+                    std::this_thread::yield();
+                }
+                lock.lock();
+            }
+            continue;
+        }
+
+        const TimerId id = timer_queue_.begin()->second;
+        timer_queue_.erase(timer_queue_.begin());
+        auto entry = timers_.find(id);
+        if (entry == timers_.end()) continue;
+        auto callback = entry->second.callback;
+        running_timer_ = id;
+        lock.unlock();
+
+        Clock::time_point next{};
+        try {
+            next = (*callback)();
+        } catch (const std::exception& e) {
+            std::cerr << "[Runtime] Timer error: " << e.what() << std::endl;
+        }
+
+        lock.lock();
+        running_timer_ = 0;
+        entry = timers_.find(id);   // 回调期间可能已被取消
+        if (entry != timers_.end()) {
+            if (next == Clock::time_point{}) {
+                timers_.erase(entry);
+            } else {
+                entry->second.due = next;
+                timer_queue_.emplace(next, id);
+            }
+        }
+        timer_done_cv_.notify_all();
+    }
+}
+
+// ========== I/O ==========
+
+bool Runtime::add_reader(int fd, std::function<void()> on_readable) {
+    if (epoll_fd_ < 0 || fd < 0) return false;
+
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        std::cerr << "[Runtime] Failed to watch fd " << fd << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    readers_[fd] = std::make_shared<std::function<void()>>(std::move(on_readable));
+    return true;
+}
+
+void Runtime::remove_reader(int fd) {
+    std::unique_lock<std::mutex> lock(io_mutex_);
+    if (readers_.erase(fd) > 0) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    if (std::this_thread::get_id() != io_thread_id_) {
+        io_done_cv_.wait(lock, [this, fd] { return running_reader_ != fd; });
+    }
+}
+
+void Runtime::io_loop() {
+    pin_current_thread(config_.io_cpu);
+
+    constexpr int MAX_EVENTS = 16;
+    epoll_event events[MAX_EVENTS];
+    {
+        // 先于任何可读回调记录，remove_reader 持同一把锁读取
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        io_thread_id_ = std::this_thread::get_id();
+    }
+    while (running_ && epoll_fd_ >= 0) {
+        int count = epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[Runtime] epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        for (int i = 0; i < count && running_; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wakeup_fd_) {
+                uint64_t value = 0;
+                ssize_t bytes = ::read(wakeup_fd_, &value, sizeof(value));
+                (void)bytes;
+                continue;
+            }
+
+            std::shared_ptr<std::function<void()>> reader;
+            {
+                std::lock_guard<std::mutex> lock(io_mutex_);
+                auto it = readers_.find(fd);
+                if (it == readers_.end()) continue;   // 本轮事件返回前已被移除
+                reader = it->second;
+                running_reader_ = fd;
+            }
+            try {
+                (*reader)();
+            } catch (const std::exception& e) {
+                std::cerr << "[Runtime] Reader error on fd " << fd << ": " << e.what() << std::endl;
+            }
+            {
+                std::lock_guard<std::mutex> lock(io_mutex_);
+                running_reader_ = -1;
+            }
+            io_done_cv_.notify_all();
+        }
+    }
+}
+
+}   // namespace runtime
+}   // namespace hardware_driver
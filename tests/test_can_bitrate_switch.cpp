@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "bus/canfd_bus_impl.hpp"
+#include "driver/motor_driver_impl.hpp"
+#include "hardware_driver/bus/can_airtime.hpp"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace hardware_driver;
+using namespace hardware_driver::motor_driver;
+using namespace hardware_driver::bus;
+
+// CAN FD 数据段波特率切换（BRS）：空口时间模型和 BRS 标志的确定性检查，
+// 实际发送间隔和帧率的测量见 benchmarks/benchmark_can_bitrate_switch.cpp
+namespace {
+
+constexpr uint32_t kNominalBitrate = 1000000;
+constexpr uint32_t kDataBitrate = 5000000;
+constexpr size_t kBatchFrameLength = 50;     // 6 电机批量控制帧
+constexpr size_t kControlFrameLength = 15;   // 单电机控制帧
+
+int64_t airtime_ns(size_t len, bool fd, bool brs, bool extended, uint32_t data_bitrate = kDataBitrate) {
+    return can_frame_airtime(len, fd, brs, extended, kNominalBitrate, data_bitrate).count();
+}
+
+// 记录控制帧发送顺序的仿真总线，空口时间按模型估算
+class AirtimeBus : public BusInterface {
+public:
+    explicit AirtimeBus(bool brs) : brs_(brs) {}
+
+    void init() override {}
+    bool send(const GenericBusPacket& packet) override {
+        if (packet.id == 1 && packet.len == kControlFrameLength) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            packets_.push_back(packet);
+        }
+        return true;
+    }
+    bool receive(GenericBusPacket& /*packet*/) override { return false; }
+    void async_receive(const std::function<void(const GenericBusPacket&)>& /*callback*/) override {}
+    std::vector<std::string> get_interface_names() const override { return {"can0"}; }
+
+    std::chrono::nanoseconds frame_airtime(const GenericBusPacket& packet) const override {
+        return can_frame_airtime(packet.len, true, brs_, true, kNominalBitrate, kDataBitrate);
+    }
+
+    std::vector<GenericBusPacket> packets() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return packets_;
+    }
+
+private:
+    bool brs_;
+    mutable std::mutex mutex_;
+    std::vector<GenericBusPacket> packets_;
+};
+
+}   // namespace
+
+// 按位手工计算的帧长度
+TEST(CanAirtimeTest, MatchesHandComputedFrames) {
+    // 标准帧 CAN FD，8 字节，BRS：
+    //   仲裁段 17 位 + 填充 (17-1)/4 = 4 位 + CRC 定界/ACK/EOF/帧间隔 13 位 = 34 位 @ 1 Mbit/s = 34000 ns
+    //   数据段 ESI/DLC 5 位 + 数据 64 位 = 69 位，填充后 86.25 位；CRC17 + 填充计数 4 位 = 21 位，固定填充后 26.25 位
+    //   共 112.5 位 @ 5 Mbit/s = 22500 ns
+    EXPECT_NEAR(airtime_ns(8, true, true, false), 56500, 1);
+
+    // 扩展帧 CAN FD，8 字节，无 BRS：仲裁段 36 + 8.75 + 13 = 57.75 位，数据段 112.5 位，共 170.25 位 @ 1 Mbit/s
+    EXPECT_NEAR(airtime_ns(8, true, false, true), 170250, 1);
+
+    // 扩展帧 CAN FD，15 字节补齐到 16 字节，BRS：数据段 (5 + 128) * 1.25 + 26.25 = 192.5 位 @ 5 Mbit/s = 38500 ns
+    EXPECT_NEAR(airtime_ns(kControlFrameLength, true, true, true), 57750 + 38500, 1);
+
+    // 经典 CAN 标准帧，8 字节：34 + 64 = 98 位，填充 (98-1)/4 = 24.25 位，加 13 位 = 135.25 位
+    EXPECT_NEAR(airtime_ns(8, false, false, false), 135250, 1);
+}
+
+TEST(CanAirtimeTest, BitRateSwitchShortensDataPhase) {
+    for (size_t len : {kControlFrameLength, kBatchFrameLength}) {
+        EXPECT_LT(airtime_ns(len, true, true, true), airtime_ns(len, true, false, true));
+    }
+    // 未开启 BRS 或没有数据段波特率时按仲裁段波特率计算
+    EXPECT_EQ(airtime_ns(kBatchFrameLength, true, false, true, 0), airtime_ns(kBatchFrameLength, true, false, true));
+    EXPECT_EQ(airtime_ns(kBatchFrameLength, true, true, true, 0), airtime_ns(kBatchFrameLength, true, false, true));
+    // 经典 CAN 忽略 BRS
+    EXPECT_EQ(airtime_ns(8, false, true, true), airtime_ns(8, false, false, true));
+}
+
+// 按空口时间节拍发送时命令不丢失、不乱序
+TEST(CanBitrateSwitchTest, AirtimePacingSendsEveryCommandInOrder) {
+    constexpr int kCommands = 50;
+    for (bool brs : {false, true}) {
+        auto bus = std::make_shared<AirtimeBus>(brs);
+        auto driver = std::make_shared<MotorDriverImpl>(bus);
+        driver->set_airtime_pacing(true);
+
+        for (int i = 0; i < kCommands; ++i) {
+            driver->send_velocity_cmd("can0", 1, 0.01f * (i + 1), 0.05f, 0.005f);
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (bus->packets().size() < static_cast<size_t>(kCommands) &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        const auto packets = bus->packets();
+        ASSERT_EQ(packets.size(), static_cast<size_t>(kCommands)) << "brs=" << brs;
+        for (size_t i = 1; i < packets.size(); ++i) {
+            EXPECT_NE(packets[i].data, packets[i - 1].data);
+        }
+    }
+}
+
+TEST(CanBitrateSwitchTest, VcanFallsBackWithoutDataBitrate) {
+    if (if_nametoindex("vcan0") == 0) {
+        GTEST_SKIP() << "vcan0 not available";
+    }
+    CanFdBus bus({"vcan0"}, kNominalBitrate, kDataBitrate);
+
+    // vcan 没有位定时，启动检查后关闭 BRS，按配置的仲裁段波特率估算空口时间
+    CanFdBus::BitTiming timing;
+    ASSERT_TRUE(bus.get_bit_timing("vcan0", timing));
+    EXPECT_EQ(timing.data_bitrate, 0u);
+    for (size_t cls = 0; cls < TX_CLASS_COUNT; ++cls) {
+        EXPECT_FALSE(bus.get_bit_rate_switch("vcan0", static_cast<TxClass>(cls)));
+    }
+    EXPECT_FALSE(bus.set_bit_rate_switch("vcan0", true));
+    EXPECT_FALSE(bus.get_bit_rate_switch("vcan0", TxClass::URGENT));
+
+    GenericBusPacket packet;
+    packet.interface = "vcan0";
+    packet.id = 1;
+    packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.len = kBatchFrameLength;
+    packet.data.fill(0);
+    EXPECT_EQ(bus.frame_airtime(packet).count(), airtime_ns(kBatchFrameLength, true, false, true, 0));
+    EXPECT_EQ(bus.try_send(packet), TxStatus::OK);
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include "bus/can_udp_bus_impl.hpp"
+#include "driver/motor_driver_impl.hpp"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <linux/can.h>
+#include <memory>
+#include <mutex>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace hardware_driver;
+using namespace hardware_driver::bus;
+using namespace hardware_driver::motor_driver;
+
+namespace {
+
+// 绑定到随机端口后立即释放，取一个当前空闲的本地端口
+uint16_t free_udp_port() {
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    socklen_t len = sizeof(addr);
+    getsockname(sock, reinterpret_cast<sockaddr*>(&addr), &len);
+    close(sock);
+    return ntohs(addr.sin_port);
+}
+
+// 收集接收到的帧
+struct Collector {
+    std::mutex mutex;
+    std::vector<GenericBusPacket> packets;
+
+    void operator()(const GenericBusPacket& packet) {
+        std::lock_guard<std::mutex> lock(mutex);
+        packets.push_back(packet);
+    }
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return packets.size();
+    }
+    bool wait_for(size_t count, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (size() < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return size() >= count;
+    }
+};
+
+GenericBusPacket make_packet(uint32_t id, size_t len, uint8_t seed, TxClass tx_class = TxClass::BULK) {
+    GenericBusPacket packet;
+    packet.interface = "can0";
+    packet.id = id;
+    packet.len = len;
+    packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.tx_class = tx_class;
+    for (size_t i = 0; i < len; ++i) packet.data[i] = static_cast<uint8_t>(seed + i);
+    return packet;
+}
+
+class CanUdpBusTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const uint16_t port_a = free_udp_port();
+        const uint16_t port_b = free_udp_port();
+        bus_a_ = std::make_unique<CanUdpBus>(std::vector<CanUdpEndpoint>{{"can0", "127.0.0.1", port_b, port_a}});
+        bus_b_ = std::make_unique<CanUdpBus>(std::vector<CanUdpEndpoint>{{"can0", "127.0.0.1", port_a, port_b}});
+        if (bus_a_->get_local_port("can0") == 0 || bus_b_->get_local_port("can0") == 0) {
+            GTEST_SKIP() << "UDP loopback not available";
+        }
+        bus_b_->async_receive(std::ref(received_));
+    }
+
+    std::unique_ptr<CanUdpBus> bus_a_;
+    std::unique_ptr<CanUdpBus> bus_b_;
+    Collector received_;
+};
+
+}   // namespace
+
+// 批次内的帧按顺序到达，内容、ID 和协议类型保持不变
+TEST_F(CanUdpBusTest, BatchesFramesWithinLatencyBudget) {
+    bus_a_->set_batch_latency(std::chrono::microseconds(2000));
+    constexpr int kFrames = 20;
+    for (int i = 0; i < kFrames; ++i) {
+        ASSERT_TRUE(bus_a_->send(make_packet(0x100 + i, 15, static_cast<uint8_t>(i))));
+    }
+    ASSERT_TRUE(received_.wait_for(kFrames));
+
+    for (int i = 0; i < kFrames; ++i) {
+        const auto& packet = received_.packets[i];
+        EXPECT_EQ(packet.interface, "can0");
+        EXPECT_EQ(packet.id, 0x100u + i);
+        EXPECT_EQ(packet.len, 15u);
+        EXPECT_EQ(packet.protocol_type, BusProtocolType::CAN_FD);
+        EXPECT_EQ(packet.data[0], static_cast<uint8_t>(i));
+    }
+
+    // I/O 线程在 sendto 之后才累加发送统计，flush 持有同一把锁，返回时统计已更新
+    bus_a_->flush();
+    CanUdpLinkStats tx_stats;
+    ASSERT_TRUE(bus_a_->get_link_stats("can0", tx_stats));
+    EXPECT_EQ(tx_stats.tx_frames, static_cast<uint64_t>(kFrames));
+    EXPECT_LT(tx_stats.tx_datagrams, static_cast<uint64_t>(kFrames));   // 多帧合并为少量数据报
+
+    CanUdpLinkStats rx_stats;
+    ASSERT_TRUE(bus_b_->get_link_stats("can0", rx_stats));
+    EXPECT_EQ(rx_stats.rx_frames, static_cast<uint64_t>(kFrames));
+    EXPECT_EQ(rx_stats.rx_lost, 0u);
+}
+
+// 紧急帧不等待批次截止时间
+TEST_F(CanUdpBusTest, UrgentFrameFlushesImmediately) {
+    bus_a_->set_batch_latency(std::chrono::microseconds(500000));
+    ASSERT_TRUE(bus_a_->send(make_packet(0x01, 8, 1)));
+    ASSERT_TRUE(bus_a_->send(make_packet(0x02, 8, 2, TxClass::URGENT)));
+    ASSERT_TRUE(received_.wait_for(2, std::chrono::milliseconds(100)));
+    EXPECT_EQ(received_.packets[0].id, 0x01u);
+    EXPECT_EQ(received_.packets[1].id, 0x02u);
+}
+
+// 按 cannelloni 序号检测丢包，探测包测量 RTT
+TEST_F(CanUdpBusTest, DetectsSequenceGapsAndMeasuresRtt) {
+    // 手工构造 cannelloni 数据报：序号 0 后直接发送序号 3
+    int raw = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in target{};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(bus_b_->get_local_port("can0"));
+    inet_pton(AF_INET, "127.0.0.1", &target.sin_addr);
+    auto send_datagram = [&](uint8_t seq, uint32_t can_id) {
+        const uint32_t id_be = htonl(can_id | CAN_EFF_FLAG);
+        uint8_t datagram[5 + 4 + 1 + 2] = {2, 0, seq, 0, 1};
+        std::memcpy(datagram + 5, &id_be, 4);
+        datagram[9] = 2;   // 经典 CAN，2 字节
+        datagram[10] = 0xAA;
+        datagram[11] = 0x55;
+        sendto(raw, datagram, sizeof(datagram), 0, reinterpret_cast<sockaddr*>(&target), sizeof(target));
+    };
+    send_datagram(0, 0x11);
+    send_datagram(3, 0x12);
+    ASSERT_TRUE(received_.wait_for(2));
+    close(raw);
+
+    EXPECT_EQ(received_.packets[1].id, 0x12u);
+    EXPECT_EQ(received_.packets[1].protocol_type, BusProtocolType::CAN);
+    EXPECT_EQ(received_.packets[1].len, 2u);
+    EXPECT_EQ(received_.packets[1].data[1], 0x55);
+
+    CanUdpLinkStats stats;
+    ASSERT_TRUE(bus_b_->get_link_stats("can0", stats));
+    EXPECT_EQ(stats.rx_lost, 2u);
+
+    // 两端都是 CanUdpBus 时探测包会被回送
+    bus_a_->set_probe_interval(std::chrono::milliseconds(5));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    do {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        bus_a_->get_link_stats("can0", stats);
+    } while (stats.probes_answered == 0 && std::chrono::steady_clock::now() < deadline);
+    EXPECT_GT(stats.probes_answered, 0u);
+    EXPECT_GT(stats.rtt_last.count(), 0);
+    EXPECT_LE(stats.rtt_min, stats.rtt_max);
+}
+
+// FD 帧的 BRS 标志按发送类别设置，默认不带
+TEST_F(CanUdpBusTest, BitRateSwitchFollowsTxClass) {
+    int raw = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(raw, reinterpret_cast<sockaddr*>(&local), sizeof(local)), 0);
+    socklen_t local_len = sizeof(local);
+    getsockname(raw, reinterpret_cast<sockaddr*>(&local), &local_len);
+    timeval timeout{1, 0};
+    setsockopt(raw, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    CanUdpBus bus({{"can0", "127.0.0.1", ntohs(local.sin_port), 0}});
+    EXPECT_FALSE(bus.get_bit_rate_switch("can0", TxClass::BULK));
+    bus.set_bit_rate_switch("can0", TxClass::URGENT, true);
+    EXPECT_TRUE(bus.get_bit_rate_switch("can0", TxClass::URGENT));
+
+    // 紧急帧触发发送，两帧在同一个数据报中
+    bus.set_batch_latency(std::chrono::microseconds(500000));
+    ASSERT_TRUE(bus.send(make_packet(0x01, 8, 1)));
+    ASSERT_TRUE(bus.send(make_packet(0x02, 8, 2, TxClass::URGENT)));
+
+    uint8_t datagram[256];
+    const ssize_t size = recv(raw, datagram, sizeof(datagram), 0);
+    close(raw);
+    ASSERT_EQ(size, 5 + 2 * (4 + 2 + 8));
+    // 帧格式：ID(4) + 长度|FD 标志(1) + CAN FD 标志(1) + 数据
+    EXPECT_EQ(datagram[5 + 4] & 0x0F, 8);
+    EXPECT_EQ(datagram[5 + 5], 0);
+    EXPECT_EQ(datagram[5 + 14 + 5], CANFD_BRS);
+}
+
+// 现有电机驱动不做修改即可使用 UDP 总线
+TEST_F(CanUdpBusTest, MotorDriverRunsOverTunnel) {
+    auto bus = std::shared_ptr<CanUdpBus>(std::move(bus_a_));
+    auto driver = std::make_shared<MotorDriverImpl>(bus);
+    driver->enable_motor("can0", 1, 4);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    bool enable_seen = false;
+    while (!enable_seen && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(received_.mutex);
+        for (const auto& packet : received_.packets) {
+            enable_seen = enable_seen || packet.id == 1u;
+        }
+    }
+    EXPECT_TRUE(enable_seen);
+}
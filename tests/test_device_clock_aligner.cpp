@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "bus/device_clock_aligner.hpp"
+#include <cmath>
+#include <random>
+
+using namespace hardware_driver::bus;
+using Clock = DeviceClockAligner::Clock;
+
+namespace {
+
+// 模拟设备：计数器 1us/tick，带频率漂移，主机到达时间叠加 USB 批量延迟
+struct SimulatedDevice {
+    double drift_ppm;
+    uint32_t start_ticks;
+    Clock::time_point host_origin;
+
+    // 第 t 秒（真实时间）发出的帧的设备计数
+    uint32_t ticks_at(double t) const {
+        double ticks = t * 1e6 / (1.0 + drift_ppm * 1e-6);
+        return static_cast<uint32_t>(start_ticks + static_cast<uint64_t>(std::llround(ticks)));
+    }
+
+    Clock::time_point host_at(double t) const {
+        return host_origin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(t));
+    }
+};
+
+double error_us(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(a - b).count();
+}
+
+}   // namespace
+
+TEST(DeviceClockAlignerTest, ResultNeverLaterThanHostArrival) {
+    DeviceClockAligner aligner;
+    auto now = Clock::now();
+    auto aligned = aligner.align(1000, now);
+    EXPECT_LE(aligned, now);
+    aligned = aligner.align(2000, now + std::chrono::microseconds(900));
+    EXPECT_LE(aligned, now + std::chrono::microseconds(900));
+}
+
+TEST(DeviceClockAlignerTest, RemovesUsbBatchingJitterAndDrift) {
+    SimulatedDevice device{80.0, 123456, Clock::now()};
+    DeviceClockAligner aligner;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> jitter(0.0, 800e-6);
+    const double frame_period = 500e-6;
+
+    double max_error = 0.0;
+    for (int k = 0; k < 40000; ++k) {   // 20s
+        double t = k * frame_period;
+        // USB 1ms 批量：到达时间量化到下一个 1ms 边界，再叠加调度延迟
+        double arrival = std::ceil(t / 1e-3) * 1e-3 + 100e-6 + jitter(rng);
+        auto aligned = aligner.align(device.ticks_at(t), device.host_at(arrival));
+        if (t > 5.0) {
+            max_error = std::max(max_error, std::fabs(error_us(aligned, device.host_at(t))));
+        }
+    }
+
+    // 到达时间抖动接近 2ms，对齐后误差应只剩最小延迟量级
+    EXPECT_LT(max_error, 250.0);
+    EXPECT_NEAR(aligner.drift_ppm(), 80.0, 10.0);
+}
+
+TEST(DeviceClockAlignerTest, HandlesCounterWraparound) {
+    SimulatedDevice device{0.0, 0xFFFFFFFFu - 2000000u, Clock::now()};
+    DeviceClockAligner aligner;
+
+    Clock::time_point last{};
+    for (int k = 0; k < 8000; ++k) {   // 跨越回绕点
+        double t = k * 500e-6;
+        auto aligned = aligner.align(device.ticks_at(t), device.host_at(t + 200e-6));
+        EXPECT_GE(aligned, last);
+        last = aligned;
+    }
+    EXPECT_EQ(aligner.reset_count(), 0u);
+    EXPECT_NEAR(error_us(last, device.host_at(7999 * 500e-6)), 200.0, 5.0);
+}
+
+TEST(DeviceClockAlignerTest, DeviceResetRestartsAlignment) {
+    SimulatedDevice device{0.0, 5000000, Clock::now()};
+    DeviceClockAligner aligner;
+
+    for (int k = 0; k < 100; ++k) {
+        aligner.align(device.ticks_at(k * 1e-3), device.host_at(k * 1e-3));
+    }
+    // 设备重新上电，计数器归零
+    auto aligned = aligner.align(10, device.host_at(0.2));
+    EXPECT_EQ(aligner.reset_count(), 1u);
+    EXPECT_NEAR(error_us(aligned, device.host_at(0.2)), 0.0, 1.0);
+}
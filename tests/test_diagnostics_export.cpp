@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "driver/motor_driver_impl.hpp"
+#include "hardware_driver/driver/diagnostics_shm.hpp"
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+
+using namespace hardware_driver;
+using namespace hardware_driver::motor_driver;
+using namespace hardware_driver::bus;
+using namespace hardware_driver::diagnostics;
+
+namespace {
+
+class LoopbackBus : public BusInterface {
+public:
+    void init() override {}
+    bool send(const GenericBusPacket& /*packet*/) override { return true; }
+    bool receive(GenericBusPacket& /*packet*/) override { return false; }
+    void async_receive(const std::function<void(const GenericBusPacket&)>& callback) override {
+        callback_ = callback;
+    }
+    std::vector<std::string> get_interface_names() const override { return {"can0"}; }
+
+    void inject(const GenericBusPacket& packet) { callback_(packet); }
+
+private:
+    std::function<void(const GenericBusPacket&)> callback_;
+};
+
+GenericBusPacket make_status_packet(uint32_t motor_id) {
+    GenericBusPacket packet;
+    packet.interface = "can0";
+    packet.id = 0x300 | motor_id;
+    packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.len = 24;
+    packet.data.fill(0);
+    packet.data[1] = 1;
+    packet.data[2] = 5;
+    return packet;
+}
+
+// 等待导出线程写出满足条件的一帧
+template <typename Predicate>
+bool wait_for_frame(const DiagnosticsReader& reader, ShmFrame& frame, Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (reader.read(frame) && predicate(frame)) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+}   // namespace
+
+// 快照包含配置的接口和电机、反馈计数和发送统计
+TEST(DiagnosticsExportTest, SampleReflectsDriverState) {
+    auto bus = std::make_shared<LoopbackBus>();
+    auto driver = std::make_shared<MotorDriverImpl>(bus);
+    driver->set_motor_config({{"can0", {1, 2}}});
+
+    for (int i = 0; i < 5; ++i) bus->inject(make_status_packet(1));
+    driver->send_velocity_cmd("can0", 2, 0.5f);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    DriverDiagnostics diagnostics;
+    driver->sample_diagnostics(diagnostics);
+    ASSERT_EQ(diagnostics.interfaces.size(), 1u);
+    EXPECT_EQ(diagnostics.interfaces[0].interface, "can0");
+    EXPECT_GT(diagnostics.interfaces[0].tx.sent, 0u);
+    EXPECT_EQ(diagnostics.interfaces[0].feedback_frames, 5u);
+    EXPECT_TRUE(diagnostics.high_freq_mode);
+
+    ASSERT_EQ(diagnostics.motors.size(), 2u);
+    EXPECT_EQ(diagnostics.motors[0].motor_id, 1u);
+    EXPECT_EQ(diagnostics.motors[0].feedback_count, 5u);
+    EXPECT_TRUE(diagnostics.motors[0].enabled);
+    EXPECT_EQ(diagnostics.motors[0].motor_mode, 5);
+    EXPECT_EQ(diagnostics.motors[1].feedback_count, 0u);
+    EXPECT_EQ(diagnostics.control_queue_depth, 0u);
+}
+
+// 其他进程通过共享内存读到同样的数据，停止导出后共享内存被删除
+TEST(DiagnosticsExportTest, ExportsToSharedMemory) {
+    const std::string name = "/hwdriver.test." + std::to_string(getpid());
+    auto bus = std::make_shared<LoopbackBus>();
+    auto driver = std::make_shared<MotorDriverImpl>(bus);
+    driver->set_motor_config({{"can0", {1, 2, 3}}});
+    if (!driver->start_diagnostics_export(name, std::chrono::milliseconds(10))) {
+        GTEST_SKIP() << "POSIX shared memory not available";
+    }
+
+    DiagnosticsReader reader;
+    ASSERT_TRUE(reader.open(name));
+    bus->inject(make_status_packet(3));
+
+    ShmFrame frame;
+    ASSERT_TRUE(wait_for_frame(reader, frame, [](const ShmFrame& f) {
+        return f.motor_count == 3 && f.motors[2].feedback_count == 1;
+    }));
+    EXPECT_EQ(frame.pid, getpid());
+    EXPECT_EQ(frame.period_ms, 10u);
+    ASSERT_EQ(frame.interface_count, 1u);
+    EXPECT_STREQ(frame.interfaces[0].name, "can0");
+    EXPECT_EQ(frame.motors[2].motor_id, 3u);
+    EXPECT_NE(frame.motors[2].last_feedback_ns, 0);
+    EXPECT_EQ(frame.motors[0].last_feedback_ns, 0);
+
+    // 采样持续推进
+    const uint64_t first_sample = frame.sample_count;
+    ASSERT_TRUE(wait_for_frame(reader, frame, [first_sample](const ShmFrame& f) {
+        return f.sample_count > first_sample;
+    }));
+
+    driver->stop_diagnostics_export();
+    DiagnosticsReader after_stop;
+    EXPECT_FALSE(after_stop.open(name));
+}
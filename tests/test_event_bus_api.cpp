@@ -346,3 +346,69 @@ TEST_F(EventBusApiTest, PositionModeControlSequence) {
     std::cout << "Position mode control sequence: " << counter_->motor_status_count.load()
               << " status events published" << std::endl;
 }
+
+// 测试13：过滤订阅按接口、电机和事件种类投递，只调用感兴趣的处理器
+TEST_F(EventBusApiTest, FilteredSubscriptionsRouteByInterfaceMotorAndKind) {
+    // 每个订阅者只关注 can0 上的一个电机，共 100 个（超过一个 64 位字）
+    constexpr int kSubscribers = 100;
+    std::vector<int> received(kSubscribers, 0);
+    std::vector<std::shared_ptr<EventHandler>> handlers;
+    for (int i = 0; i < kSubscribers; ++i) {
+        handlers.push_back(event_bus_->subscribe_filtered<MotorStatusEvent>(
+            SubscriptionFilter().on_interface("can0").on_motor(i + 1),
+            [&received, i](const std::shared_ptr<MotorStatusEvent>& event) {
+                EXPECT_EQ(event->get_motor_id(), static_cast<uint32_t>(i + 1));
+                received[i]++;
+            }));
+    }
+
+    // can1 全部电机的状态与批量事件，用基类处理器同时订阅两种
+    int can1_events = 0;
+    auto can1_handler = event_bus_->subscribe_filtered<Event>(
+        SubscriptionFilter().on_interface("can1").of_kinds(
+            event_kind_bit(EventKind::MOTOR_STATUS) | event_kind_bit(EventKind::MOTOR_BATCH_STATUS)),
+        [&can1_events](const std::shared_ptr<Event>& event) {
+            EXPECT_EQ(*event->get_source_interface(), "can1");
+            can1_events++;
+        });
+
+    // 不限接口的功能结果订阅
+    int function_results = 0;
+    auto function_handler = event_bus_->subscribe_filtered<MotorFunctionResultEvent>(
+        SubscriptionFilter(), [&function_results](const std::shared_ptr<MotorFunctionResultEvent>&) {
+            function_results++;
+        });
+    EXPECT_EQ(event_bus_->get_statistics().total_filtered_handlers, static_cast<size_t>(kSubscribers + 2));
+
+    Motor_Status status = create_test_status(10.0f);
+    event_bus_->emit<MotorStatusEvent>("can0", 70, status);
+    event_bus_->emit<MotorStatusEvent>("can0", 3, status);
+    event_bus_->emit<MotorStatusEvent>("can0", 300, status);    // 超出电机掩码范围，无人关注
+    event_bus_->emit<MotorStatusEvent>("can1", 70, status);
+    event_bus_->emit<MotorStatusEvent>("can2", 1, status);
+    event_bus_->emit<MotorBatchStatusEvent>("can1", std::map<uint32_t, Motor_Status>{{1, status}});
+    event_bus_->emit<MotorFunctionResultEvent>("can0", 5, 0x03, true);
+    event_bus_->emit<MotorFunctionResultEvent>("can3", 1, 0x03, true);
+
+    for (int i = 0; i < kSubscribers; ++i) {
+        EXPECT_EQ(received[i], (i + 1 == 70 || i + 1 == 3) ? 1 : 0) << "subscriber " << i;
+    }
+    EXPECT_EQ(can1_events, 2);
+    EXPECT_EQ(function_results, 2);
+
+    // 普通订阅不受影响，仍收到全部电机状态事件
+    EXPECT_EQ(counter_->motor_status_count.load(), 5);
+    EXPECT_TRUE(event_bus_->has_subscribers<MotorBatchStatusEvent>());
+
+    // 取消订阅与处理器释放后不再投递
+    event_bus_->unsubscribe_filtered(can1_handler);
+    handlers[69].reset();
+    event_bus_->cleanup_handlers();
+    event_bus_->emit<MotorStatusEvent>("can1", 70, status);
+    event_bus_->emit<MotorStatusEvent>("can0", 70, status);
+    event_bus_->emit<MotorStatusEvent>("can0", 3, status);
+    EXPECT_EQ(can1_events, 2);
+    EXPECT_EQ(received[69], 1);
+    EXPECT_EQ(received[2], 2);
+    EXPECT_EQ(event_bus_->get_statistics().total_filtered_handlers, static_cast<size_t>(kSubscribers));
+}
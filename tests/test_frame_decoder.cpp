@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "protocol/frame_decoder.hpp"
+#include "protocol/motor_protocol.hpp"
+#include <cstring>
+
+using namespace hardware_driver;
+using namespace hardware_driver::bus;
+using namespace hardware_driver::frame_decoder;
+
+namespace {
+
+GenericBusPacket make_packet(uint32_t id, std::initializer_list<uint8_t> bytes) {
+    GenericBusPacket packet;
+    packet.interface = "can0";
+    packet.id = id;
+    packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.data.fill(0);
+    std::copy(bytes.begin(), bytes.end(), packet.data.begin());
+    packet.len = bytes.size();
+    return packet;
+}
+
+GenericBusPacket make_status_packet(uint32_t motor_id) {
+    GenericBusPacket packet = make_packet(0x300 | motor_id, {});
+    packet.len = 24;
+    packet.data[1] = 1;     // 使能
+    packet.data[2] = 5;     // 模式
+    const float position = 1.5f;
+    uint32_t raw;
+    std::memcpy(&raw, &position, sizeof(raw));
+    packet.data[3] = raw >> 24;
+    packet.data[4] = raw >> 16;
+    packet.data[5] = raw >> 8;
+    packet.data[6] = raw;
+    packet.data[18] = 0x04;     // 错误码 0x4
+    return packet;
+}
+
+constexpr int64_t MS = 1000000;
+
+}   // namespace
+
+// 主机命令按 pack_* 布局解码，批量控制帧拆到各电机
+TEST(FrameDecoderTest, DecodesHostCommands) {
+    GenericBusPacket packet;
+    packet.interface = "can0";
+    packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.id = 0x000;
+    motor_protocol::pack_control_all_command(packet.data, packet.len, {1.0f, -2.5f, 0, 0, 0, 0},
+                                             {0.5f, 0, 0, 0, 0, 0}, {3.0f, 0, 0, 0, 0, 0},
+                                             {0.2f, 0, 0, 0, 0, 0}, {0.05f, 0, 0, 0, 0, 0});
+    FrameInfo info = classify(packet);
+    EXPECT_EQ(info.frame_class, FrameClass::CONTROL_ALL);
+    EXPECT_FALSE(info.from_device);
+    std::string text = describe(packet, info);
+    EXPECT_NE(text.find("m1 pos=1.000 vel=0.500 eff=3.000 kp=0.200 kd=0.050"), std::string::npos) << text;
+    EXPECT_NE(text.find("m2 pos=-2.500"), std::string::npos) << text;
+
+    packet.id = 0x600 | 3;
+    motor_protocol::pack_param_write(packet.data, packet.len, 0x000B, 12.5f);
+    info = classify(packet);
+    EXPECT_EQ(info.frame_class, FrameClass::PARAMETER);
+    EXPECT_EQ(info.motor_id, 3u);
+    EXPECT_EQ(describe(packet, info), "write addr=0x000b float=12.500");
+
+    packet.id = 0x000;
+    motor_protocol::pack_motor_feedback_request_all(packet.data, packet.len);
+    info = classify(packet);
+    EXPECT_EQ(info.frame_class, FrameClass::FEEDBACK_REQUEST);
+    EXPECT_EQ(info.motor_id, 0u);
+}
+
+// 设备反馈、IAP 状态码、夹爪和按键帧
+TEST(FrameDecoderTest, DecodesDeviceFrames) {
+    GenericBusPacket status = make_status_packet(2);
+    FrameInfo info = classify(status);
+    EXPECT_EQ(info.frame_class, FrameClass::STATUS);
+    EXPECT_TRUE(info.from_device);
+    EXPECT_EQ(info.motor_id, 2u);
+    const std::string text = describe(status, info);
+    EXPECT_NE(text.find("on mode=5 pos=1.500"), std::string::npos) << text;
+    EXPECT_NE(text.find("err=0x4"), std::string::npos) << text;
+
+    GenericBusPacket iap = make_packet(0xFF00 | 4, {'B', 'K', '0', '1'});
+    info = classify(iap);
+    EXPECT_EQ(info.frame_class, FrameClass::IAP_STATUS);
+    EXPECT_EQ(info.motor_id, 4u);
+    EXPECT_EQ(describe(iap, info), "BK01");
+
+    GenericBusPacket gripper = make_packet(0x6F, {0x01, 0x00, 0x02, 120, 50, 30});
+    info = classify(gripper);
+    EXPECT_EQ(info.frame_class, FrameClass::GRIPPER);
+    EXPECT_NE(describe(gripper, info).find("pos=120"), std::string::npos);
+    EXPECT_NE(describe(gripper, info).find("JAM"), std::string::npos);
+
+    GenericBusPacket button = make_packet(0x8F, {'G', 'J', 'F', 'X'});
+    info = classify(button);
+    EXPECT_EQ(info.frame_class, FrameClass::BUTTON);
+    EXPECT_NE(describe(button, info).find("GJFX"), std::string::npos);
+
+    GenericBusPacket unknown = make_packet(0x1234, {0xDE, 0xAD});
+    info = classify(unknown);
+    EXPECT_EQ(info.frame_class, FrameClass::UNKNOWN);
+    EXPECT_EQ(describe(unknown, info), "DEAD");
+}
+
+TEST(FrameDecoderTest, ParsesCandumpLines) {
+    GenericBusPacket packet;
+    int64_t timestamp_ns = 0;
+    ASSERT_TRUE(parse_candump_line("(1700000000.123456) can1 305##1020304", packet, timestamp_ns));
+    EXPECT_EQ(timestamp_ns, 1700000000123456000LL);
+    EXPECT_EQ(packet.interface, "can1");
+    EXPECT_EQ(packet.id, 0x305u);
+    EXPECT_EQ(packet.protocol_type, BusProtocolType::CAN_FD);
+    ASSERT_EQ(packet.len, 3u);
+    EXPECT_EQ(packet.data[0], 0x02);
+    EXPECT_EQ(packet.data[2], 0x04);
+
+    ASSERT_TRUE(parse_candump_line("(1.5) can0 07F#46584A53", packet, timestamp_ns));
+    EXPECT_EQ(timestamp_ns, 1500000000LL);
+    EXPECT_EQ(packet.protocol_type, BusProtocolType::CAN);
+    EXPECT_EQ(packet.len, 4u);
+
+    EXPECT_FALSE(parse_candump_line("can0  123   [2]  11 22", packet, timestamp_ns));
+    EXPECT_FALSE(parse_candump_line("(1.0) can0 12G#00", packet, timestamp_ns));
+    EXPECT_FALSE(parse_candump_line("(1.0) can0 123#123", packet, timestamp_ns));
+}
+
+// 广播请求对每个电机只配对一次，状态反馈间隔统计抖动
+TEST(FrameDecoderTest, AnalyzerPairsRepliesAndMeasuresJitter) {
+    TrafficAnalyzer analyzer;
+    auto feed = [&analyzer](const GenericBusPacket& packet, int64_t timestamp_ns) {
+        analyzer.add(packet, classify(packet), timestamp_ns);
+    };
+    const GenericBusPacket request_all = make_packet(0x000, {0x02, 0x00, 0x00});
+    const GenericBusPacket request_one = make_packet(0x200 | 1, {0x00});
+
+    feed(request_all, 10 * MS);
+    feed(make_status_packet(1), 10 * MS + 200000);
+    feed(make_status_packet(2), 10 * MS + 300000);
+    feed(make_status_packet(1), 11 * MS);             // 没有新请求，不计时延
+    feed(request_one, 12 * MS);
+    feed(make_status_packet(1), 12 * MS + 500000);
+
+    const auto& motors = analyzer.motors();
+    const auto& m1 = motors.at({"can0", 1});
+    const auto& m2 = motors.at({"can0", 2});
+    EXPECT_EQ(m1.frames[static_cast<size_t>(FrameClass::STATUS)], 3u);
+    EXPECT_EQ(m1.frames[static_cast<size_t>(FrameClass::FEEDBACK_REQUEST)], 1u);
+    ASSERT_EQ(m1.status_latency_us.count, 2u);
+    EXPECT_DOUBLE_EQ(m1.status_latency_us.min, 200.0);
+    EXPECT_DOUBLE_EQ(m1.status_latency_us.max, 500.0);
+    ASSERT_EQ(m2.status_latency_us.count, 1u);
+    EXPECT_DOUBLE_EQ(m2.status_latency_us.mean, 300.0);
+
+    // 间隔 800us 和 1500us
+    ASSERT_EQ(m1.status_interval_us.count, 2u);
+    EXPECT_DOUBLE_EQ(m1.status_interval_us.mean, 1150.0);
+    EXPECT_NEAR(m1.status_interval_us.stddev(), 494.97, 0.01);
+    EXPECT_EQ(analyzer.frame_count(), 6u);
+    EXPECT_EQ(analyzer.totals()[static_cast<size_t>(FrameClass::STATUS)], 4u);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "hardware_driver/driver/joint_state_estimator.hpp"
+#include <cmath>
+
+using namespace hardware_driver::motor_driver;
+using Clock = std::chrono::steady_clock;
+
+class JointStateEstimatorTest : public ::testing::Test {
+protected:
+    Clock::time_point t0_ = Clock::now();
+
+    Clock::time_point at(double seconds) const {
+        return t0_ + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+};
+
+TEST_F(JointStateEstimatorTest, FirstMeasurementInitializesState) {
+    JointStateEstimator estimator(2);
+    EXPECT_FALSE(estimator.get(0).valid);
+
+    estimator.update(0, at(0.0), 1.5, 0.2);
+    auto estimate = estimator.get(0);
+    EXPECT_TRUE(estimate.valid);
+    EXPECT_DOUBLE_EQ(estimate.position, 1.5);
+    EXPECT_DOUBLE_EQ(estimate.velocity, 0.2);
+    EXPECT_FALSE(estimator.get(1).valid);
+}
+
+TEST_F(JointStateEstimatorTest, TracksConstantVelocityRamp) {
+    JointStateEstimator estimator(1);
+    const double velocity = 2.0;
+    const double dt = 0.005;
+
+    for (int k = 0; k < 400; ++k) {
+        double t = k * dt;
+        estimator.update(0, at(t), velocity * t, velocity);
+    }
+
+    auto estimate = estimator.get(0);
+    EXPECT_NEAR(estimate.position, velocity * 399 * dt, 1e-3);
+    EXPECT_NEAR(estimate.velocity, velocity, 1e-3);
+    EXPECT_NEAR(estimate.acceleration, 0.0, 1e-2);
+}
+
+TEST_F(JointStateEstimatorTest, PredictExtrapolatesToCommandTime) {
+    JointStateEstimator estimator(1);
+    const double velocity = 1.0;
+    const double dt = 0.005;
+    for (int k = 0; k < 200; ++k) {
+        estimator.update(0, at(k * dt), velocity * k * dt, velocity);
+    }
+
+    // 反馈滞后 3ms，外推到发送时刻
+    double last_t = 199 * dt;
+    auto predicted = estimator.predict(0, at(last_t + 0.003));
+    EXPECT_NEAR(predicted.position, velocity * (last_t + 0.003), 1e-3);
+
+    double positions[1];
+    double velocities[1];
+    EXPECT_EQ(estimator.predict(at(last_t + 0.003), positions, velocities, 1), 1u);
+    EXPECT_NEAR(positions[0], predicted.position, 1e-9);
+    EXPECT_NEAR(velocities[0], predicted.velocity, 1e-9);
+}
+
+TEST_F(JointStateEstimatorTest, PredictionHorizonIsBounded) {
+    JointEstimatorConfig config;
+    config.max_prediction_horizon = 0.01;
+    JointStateEstimator estimator(1, config);
+
+    // 构造一个有加速度的状态
+    for (int k = 0; k < 200; ++k) {
+        double t = k * 0.005;
+        estimator.update(0, at(t), 0.5 * 4.0 * t * t, 4.0 * t);
+    }
+    auto state = estimator.get(0);
+    auto far = estimator.predict(0, state.stamp + std::chrono::seconds(1));
+
+    // 超出窗口后速度不再随加速度增长
+    EXPECT_NEAR(far.velocity, state.velocity + state.acceleration * 0.01, 1e-9);
+}
+
+TEST_F(JointStateEstimatorTest, OutOfOrderMeasurementIsIgnored) {
+    JointStateEstimator estimator(1);
+    estimator.update(0, at(0.010), 1.0, 0.0);
+    estimator.update(0, at(0.005), 5.0, 0.0);
+    EXPECT_DOUBLE_EQ(estimator.get(0).position, 1.0);
+}
+
+TEST_F(JointStateEstimatorTest, LongGapReinitializes) {
+    JointStateEstimator estimator(1);
+    estimator.update(0, at(0.0), 0.0, 0.0);
+    estimator.update(0, at(1.0), 3.0, 0.5);
+    auto estimate = estimator.get(0);
+    EXPECT_DOUBLE_EQ(estimate.position, 3.0);
+    EXPECT_DOUBLE_EQ(estimate.velocity, 0.5);
+    EXPECT_DOUBLE_EQ(estimate.acceleration, 0.0);
+}
+
+TEST_F(JointStateEstimatorTest, InvalidJointsPredictLastKnownValue) {
+    JointStateEstimator estimator(3);
+    estimator.update(1, at(0.0), 2.0, 1.0);
+
+    double positions[3] = {-1, -1, -1};
+    EXPECT_EQ(estimator.predict(at(0.005), positions, nullptr, 3), 3u);
+    EXPECT_DOUBLE_EQ(positions[0], 0.0);
+    EXPECT_NEAR(positions[1], 2.005, 1e-9);
+    EXPECT_DOUBLE_EQ(positions[2], 0.0);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "driver/motor_driver_impl.hpp"
+#include "hardware_driver/interface/joint_buffers.hpp"
 #include "bus/canfd_bus_impl.hpp"
 #include "hardware_driver/event/event_bus.hpp"
 #include "hardware_driver/event/motor_events.hpp"
@@ -9,6 +10,10 @@
 #include <atomic>
 #include <mutex>
 #include <map>
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <set>
 
 using namespace hardware_driver;
 using namespace hardware_driver::motor_driver;
@@ -471,3 +476,555 @@ TEST_F(MotorDriverImplTest, FullMotorControlFlow) {
     std::cout << "Full motor control flow: completed with " << (final_count - initial_count)
               << " commands\n";
 }
+
+// ========== 命令门控 ==========
+
+// 构造电机状态反馈帧（0x300 | motor_id）
+static GenericBusPacket make_status_feedback(uint32_t motor_id, uint8_t enable_flag, uint8_t mode, uint32_t error_code = 0) {
+    GenericBusPacket packet;
+    packet.interface = "can0";
+    packet.id = 0x300 | motor_id;
+    packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.len = 24;
+    packet.data.fill(0);
+    packet.data[1] = enable_flag;
+    packet.data[2] = mode;
+    packet.data[15] = static_cast<uint8_t>(error_code >> 24);
+    packet.data[16] = static_cast<uint8_t>(error_code >> 16);
+    packet.data[17] = static_cast<uint8_t>(error_code >> 8);
+    packet.data[18] = static_cast<uint8_t>(error_code);
+    return packet;
+}
+
+// 测试16：未收到反馈的电机状态未知，命令直接放行
+TEST_F(MotorDriverImplTest, CommandGatePassesUnknownState) {
+    motor_driver_->send_position_cmd("can0", 1, 10.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(mock_bus_->get_send_count(), 1);
+    EXPECT_EQ(motor_driver_->get_command_gate_stats().accepted, 1u);
+}
+
+// 测试17：电机上报失能或故障时拒绝控制命令
+TEST_F(MotorDriverImplTest, CommandGateRejectsDisabledAndFaultedMotors) {
+    mock_bus_->simulate_receive(make_status_feedback(1, 0, 5));
+    mock_bus_->simulate_receive(make_status_feedback(2, 1, 5, 0x01));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    MotorRuntimeState state;
+    ASSERT_TRUE(motor_driver_->get_motor_runtime_state("can0", 1, state));
+    EXPECT_FALSE(state.enabled);
+    EXPECT_EQ(state.motor_mode, 5);
+
+    motor_driver_->send_position_cmd("can0", 1, 10.0);
+    motor_driver_->send_position_cmd("can0", 2, 10.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(mock_bus_->get_send_count(), 0);
+    auto stats = motor_driver_->get_command_gate_stats();
+    EXPECT_EQ(stats.rejected_disabled, 1u);
+    EXPECT_EQ(stats.rejected_fault, 1u);
+}
+
+// 测试18：使能请求尚未确认时命令暂存，确认后发出
+TEST_F(MotorDriverImplTest, CommandGateDefersUntilEnableConfirmed) {
+    mock_bus_->simulate_receive(make_status_feedback(1, 0, 4));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    motor_driver_->enable_motor("can0", 1, 5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    int after_enable = mock_bus_->get_send_count();
+
+    motor_driver_->send_position_cmd("can0", 1, 10.0);
+    motor_driver_->send_position_cmd("can0", 1, 20.0);   // 覆盖前一条暂存命令
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(mock_bus_->get_send_count(), after_enable);
+
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(mock_bus_->get_send_count(), after_enable + 1);
+
+    auto stats = motor_driver_->get_command_gate_stats();
+    EXPECT_EQ(stats.deferred, 2u);
+    EXPECT_EQ(stats.deferred_dropped, 1u);
+    EXPECT_EQ(stats.deferred_sent, 1u);
+}
+
+// 测试19：模式不符时拒绝，AUTO_ENABLE 策略下自动按期望模式使能
+TEST_F(MotorDriverImplTest, CommandGateModeMismatchAndAutoEnable) {
+    motor_driver_->disable_motor("can0", 1, 5);   // 记录期望模式
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 4));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    int baseline = mock_bus_->get_send_count();
+
+    motor_driver_->send_position_cmd("can0", 1, 10.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(mock_bus_->get_send_count(), baseline);
+    EXPECT_EQ(motor_driver_->get_command_gate_stats().rejected_mode, 1u);
+
+    CommandGateConfig config;
+    config.policy = CommandGatePolicy::AUTO_ENABLE;
+    motor_driver_->set_command_gate_config(config);
+
+    motor_driver_->send_position_cmd("can0", 1, 20.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(mock_bus_->get_send_count(), baseline + 1);   // 仅发出使能帧
+    EXPECT_EQ(motor_driver_->get_command_gate_stats().auto_enabled, 1u);
+
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(mock_bus_->get_send_count(), baseline + 2);   // 暂存的位置命令
+}
+
+// 测试20：反馈同时写入无锁快照槽位，槽位地址在首次反馈前后保持不变
+TEST_F(MotorDriverImplTest, FeedbackSlotTracksLatestStatus) {
+    const auto* slot = motor_driver_->get_feedback_slot("can0", 1);
+    ASSERT_NE(slot, nullptr);
+    MotorFeedbackSlot::Snapshot snapshot;
+    EXPECT_FALSE(slot->read(snapshot));
+
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5));
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5, 0x02));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(motor_driver_->get_feedback_slot("can0", 1), slot);
+    ASSERT_TRUE(slot->read(snapshot));
+    EXPECT_EQ(snapshot.updates, 2u);
+    EXPECT_EQ(snapshot.error_code, 0x02u);
+    EXPECT_LE(std::chrono::steady_clock::now() - snapshot.stamp, std::chrono::seconds(1));
+}
+
+// 测试21：批量缓冲 read() 从反馈槽位取状态，write() 发出一条批量命令
+TEST_F(MotorDriverImplTest, JointBuffersBatchReadWrite) {
+    std::vector<const MotorFeedbackSlot*> slots = {
+        motor_driver_->get_feedback_slot("can0", 1),
+        motor_driver_->get_feedback_slot("can0", 2)
+    };
+    JointBuffers buffers(motor_driver_, "can0", {1, 2}, slots);
+    EXPECT_EQ(buffers.joint_count(), 2u);
+    EXPECT_EQ(buffers.read(), 0u);
+
+    mock_bus_->simulate_receive(make_status_feedback(2, 1, 5, 0x04));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(buffers.read(), 1u);
+    EXPECT_EQ(buffers.stamp_ns()[0], 0);
+    EXPECT_NE(buffers.stamp_ns()[1], 0);
+    EXPECT_EQ(buffers.error_code()[1], 0x04u);
+
+    // 没有新反馈时不计入，状态保持上一次的值
+    const int64_t first_stamp = buffers.stamp_ns()[1];
+    EXPECT_EQ(buffers.read(), 0u);
+    EXPECT_EQ(buffers.stamp_ns()[1], first_stamp);
+    mock_bus_->simulate_receive(make_status_feedback(2, 1, 5, 0x04));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(buffers.read(), 1u);
+    EXPECT_GT(buffers.stamp_ns()[1], first_stamp);
+
+    // 电机 2 上报了故障码，关闭门控以验证发送路径
+    CommandGateConfig config;
+    config.policy = CommandGatePolicy::PASS_THROUGH;
+    motor_driver_->set_command_gate_config(config);
+
+    int baseline = mock_bus_->get_send_count();
+    buffers.command_position()[0] = 1.5;
+    buffers.command_position()[1] = -0.5;
+    buffers.write();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(mock_bus_->get_send_count(), baseline + 1);
+}
+
+// 测试22：批量观察者按突发接收紧凑记录，单电机回调与事件作为适配层仍逐条收到
+TEST_F(MotorDriverImplTest, StatusBatchDeliveryWithPerMotorAdapters) {
+    class BatchObserver : public MotorStatusBatchObserver {
+    public:
+        void on_motor_status_batch(MotorStatusSpan records) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++batches;
+            received.insert(received.end(), records.begin(), records.end());
+        }
+        std::mutex mutex;
+        int batches = 0;
+        std::vector<MotorStatusRecord> received;
+    };
+    auto batch_observer = std::make_shared<BatchObserver>();
+    motor_driver_->add_batch_observer(batch_observer);
+
+    std::atomic<int> per_motor_calls{0};
+    motor_driver_->register_feedback_callback(
+        [&per_motor_calls](const std::string& interface, uint32_t, const Motor_Status&) {
+            if (interface == "can0") per_motor_calls++;
+        });
+
+    std::atomic<size_t> event_records{0};
+    auto handler = event_bus_->subscribe<MotorStatusRecordsEvent>(
+        [&event_records](const std::shared_ptr<MotorStatusRecordsEvent>& event) {
+            auto records = event->get_records();
+            if (!records.empty() && event->get_interface_name(records[0].interface_index) == "can0") {
+                event_records += records.size();
+            }
+        });
+
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5));
+    mock_bus_->simulate_receive(make_status_feedback(2, 1, 5));
+    mock_bus_->simulate_receive(make_status_feedback(3, 0, 4, 0x08));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::lock_guard<std::mutex> lock(batch_observer->mutex);
+    ASSERT_EQ(batch_observer->received.size(), 3u);
+    EXPECT_GE(batch_observer->batches, 1);
+    EXPECT_LE(batch_observer->batches, 3);
+    for (size_t i = 0; i < 3; ++i) {
+        const auto& record = batch_observer->received[i];
+        EXPECT_EQ(record.motor_id, i + 1);
+        EXPECT_EQ(motor_driver_->get_interface_name(record.interface_index), "can0");
+        EXPECT_NE(record.stamp.time_since_epoch().count(), 0);
+    }
+    EXPECT_EQ(batch_observer->received[2].status.error_code, 0x08u);
+    EXPECT_EQ(per_motor_calls.load(), 3);
+    EXPECT_EQ(event_records.load(), 3u);
+    EXPECT_EQ(motor_driver_->get_interface_name(999), "");
+}
+
+// 测试23：直通模式在接收线程上同步解码，事件总线事件异步发布
+TEST_F(MotorDriverImplTest, RunToCompletionDecodesOnReceiveThread) {
+    motor_driver_->set_receive_mode(ReceiveMode::RUN_TO_COMPLETION);
+    EXPECT_EQ(motor_driver_->get_receive_mode(), ReceiveMode::RUN_TO_COMPLETION);
+
+    std::thread::id callback_thread;
+    motor_driver_->register_feedback_callback(
+        [&callback_thread](const std::string&, uint32_t, const Motor_Status&) {
+            callback_thread = std::this_thread::get_id();
+        });
+    std::atomic<int> events{0};
+    auto handler = event_bus_->subscribe<MotorStatusEvent>(
+        [&events](const std::shared_ptr<MotorStatusEvent>&) { events++; });
+
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5, 0x02));
+
+    // 无需等待：返回时状态已写入
+    Motor_Status status;
+    ASSERT_TRUE(motor_driver_->get_motor_status("can0", 1, status));
+    EXPECT_EQ(status.error_code, 0x02u);
+    EXPECT_EQ(callback_thread, std::this_thread::get_id());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(events.load(), 1);
+
+    // 切回队列模式后由数据处理线程解码
+    motor_driver_->set_receive_mode(ReceiveMode::QUEUED);
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_NE(callback_thread, std::this_thread::get_id());
+    EXPECT_EQ(events.load(), 2);
+}
+
+// 测试24：控制钩子在周期反馈齐全时运行，并在同一周期直接发出批量命令
+TEST_F(MotorDriverImplTest, ControlHookRunsOnCompleteCycle) {
+    EXPECT_FALSE(motor_driver_->set_control_hook("can0", [](MotorStatusSpan, JointCommandSpan) { return true; }));
+    motor_driver_->set_motor_config({{"can0", {1, 2}}});
+
+    std::atomic<int> calls{0};
+    ControlHookConfig config;
+    config.deadline = std::chrono::microseconds(1000);
+    ASSERT_TRUE(motor_driver_->set_control_hook("can0",
+        [&calls](MotorStatusSpan state, JointCommandSpan command) {
+            calls++;
+            for (size_t i = 0; i < state.size(); ++i) {
+                command[i].position = state[i].status.position + 0.5f;
+                command[i].kp = 1.0f;
+            }
+            return state[1].status.error_code == 0;    // 电机 2 故障时不发送
+        }, config));
+
+    auto hook_commands = [this] {
+        int count = 0;
+        for (const auto& packet : mock_bus_->get_sent_packets()) {
+            if (packet.id == 0x000 && packet.len > 3 && packet.data[1] == 0x03) count++;
+        }
+        return count;
+    };
+
+    // 只收到电机 1：周期未完成
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(calls.load(), 0);
+
+    mock_bus_->simulate_receive(make_status_feedback(2, 1, 5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(hook_commands(), 1);
+
+    // 电机 1 连续上报两次：记为不完整周期；电机 2 故障，钩子选择不发送
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5));
+    mock_bus_->simulate_receive(make_status_feedback(1, 1, 5));
+    mock_bus_->simulate_receive(make_status_feedback(2, 1, 5, 0x01));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    ControlHookStats stats;
+    ASSERT_TRUE(motor_driver_->get_control_hook_stats("can0", stats));
+    EXPECT_EQ(stats.cycles, 2u);
+    EXPECT_EQ(stats.commands_sent, 1u);
+    EXPECT_EQ(stats.skipped, 1u);
+    EXPECT_EQ(stats.incomplete_cycles, 1u);
+    EXPECT_GT(stats.max_exec.count(), 0);
+    EXPECT_EQ(hook_commands(), 1);
+
+    motor_driver_->clear_control_hook("can0");
+    EXPECT_FALSE(motor_driver_->get_control_hook_stats("can0", stats));
+}
+
+// 测试25：命令事务整体入队，按顺序连续发送，不与其他线程的命令交错
+TEST_F(MotorDriverImplTest, TransactionSendsContiguouslyAndInOrder) {
+    auto empty = motor_driver_->submit_transaction(CommandTransaction{});
+    EXPECT_EQ(empty.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    EXPECT_EQ(empty.get().sent, 0u);
+
+    CommandTransaction transaction;
+    transaction.enable_motor("can0", 1, 0x04)
+               .motor_parameter_write("can0", 1, 0x0010, 1.5f)
+               .motor_function_operation("can0", 1, 0x01)
+               .send_velocity_cmd("can0", 1, 0.3f, 0.05f, 0.005f)
+               .enable_motor("can0", 2, 0x04);
+    ASSERT_EQ(transaction.size(), 5u);
+    const std::vector<uint32_t> expected_ids = {1, 0x601, 0x401, 1, 2};
+
+    // 另一个线程持续发送电机 3 的单条命令
+    std::atomic<bool> stop{false};
+    std::thread producer([this, &stop] {
+        float velocity = 0.0f;
+        while (!stop) {
+            motor_driver_->send_velocity_cmd("can0", 3, velocity, 0.05f, 0.005f);
+            velocity += 0.01f;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    auto future = motor_driver_->submit_transaction(transaction);
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    auto result = future.get();
+    stop = true;
+    producer.join();
+
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(result.sent, 5u);
+
+    // 只看控制命令，忽略反馈请求线程直接发出的帧
+    std::vector<uint32_t> ids;
+    for (const auto& packet : mock_bus_->get_sent_packets()) {
+        if (packet.id == 1 || packet.id == 2 || packet.id == 3 || packet.id == 0x601 || packet.id == 0x401) {
+            ids.push_back(packet.id);
+        }
+    }
+    auto first = std::find(ids.begin(), ids.end(), 1u);
+    ASSERT_NE(first, ids.end());
+    ASSERT_GE(static_cast<size_t>(std::distance(first, ids.end())), expected_ids.size());
+    EXPECT_TRUE(std::equal(expected_ids.begin(), expected_ids.end(), first));
+    EXPECT_EQ(std::count(ids.begin(), ids.end(), 1u), 2);
+}
+
+// 测试26：电机配置快照预先生成索引表，运行中可原子替换
+TEST_F(MotorDriverImplTest, MotorConfigSnapshotHotSwap) {
+    MotorConfigSnapshot snapshot({{"can0", {3, 1, 2}}, {"can1", {0x7F0, 0x900}}});
+    const auto* can0 = snapshot.find("can0");
+    ASSERT_NE(can0, nullptr);
+    EXPECT_EQ(can0->joint_index(3), 0);
+    EXPECT_EQ(can0->joint_index(2), 2);
+    EXPECT_EQ(can0->joint_index(4), -1);
+    EXPECT_EQ(snapshot.find("can1")->joint_index(0x900), 1);
+    EXPECT_EQ(snapshot.find("can2"), nullptr);
+
+    motor_driver_->set_motor_config({{"can0", {1, 2}}});
+    const auto& first = motor_driver_->get_motor_config();
+
+    // 暂停反馈请求不再清空配置
+    motor_driver_->pause_feedback_request();
+    EXPECT_NE(motor_driver_->get_motor_config().find("can0"), nullptr);
+    motor_driver_->resume_feedback_request();
+
+    // 反馈请求线程运行时反复替换配置
+    for (int i = 0; i < 200; ++i) {
+        if (i % 2 == 0) {
+            motor_driver_->set_motor_config({{"can0", {1, 2, 3}}, {"can1", {1}}});
+        } else {
+            motor_driver_->set_motor_config({{"can0", {1, 2}}});
+        }
+    }
+    const auto& current = motor_driver_->get_motor_config();
+    ASSERT_NE(current.find("can0"), nullptr);
+    EXPECT_EQ(current.find("can0")->motor_ids.size(), 2u);
+    EXPECT_EQ(current.find("can1"), nullptr);
+
+    // 旧快照的引用依然有效
+    EXPECT_EQ(first.find("can0")->joint_index(2), 1);
+}
+
+// 发送队列满/设备故障可控的模拟总线
+class TxFaultBus : public MockBusInterface {
+public:
+    std::atomic<int> backpressure_frames{0};
+    std::atomic<bool> device_down{false};
+
+    TxStatus try_send(const GenericBusPacket& packet) override {
+        if (device_down) return TxStatus::DEVICE_ERROR;
+        if (backpressure_frames > 0) {
+            backpressure_frames--;
+            return TxStatus::BACKPRESSURE;
+        }
+        return send(packet) ? TxStatus::OK : TxStatus::DEVICE_ERROR;
+    }
+};
+
+// 测试27：背压时按有效期退避重试，硬错误按接口统计并上报一次
+TEST(MotorDriverTxErrorTest, BackpressureRetryAndHardErrorEscalation) {
+    auto bus = std::make_shared<TxFaultBus>();
+    auto driver = std::make_shared<MotorDriverImpl>(bus);
+
+    TxRetryConfig config;
+    config.backoff = std::chrono::microseconds(100);
+    config.max_retries = 5;
+    config.escalate_after = 3;
+    config.ttl.fill(std::chrono::seconds(1));   // 有效期放宽，只检查重试次数上限
+    driver->set_tx_retry_config(config);
+
+    // 等待发送线程处理完命令，超时后照常检查
+    auto wait_stats = [&driver](const std::function<bool(const TxStats&)>& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (!done(driver->get_tx_stats()["can0"]) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return driver->get_tx_stats()["can0"];
+    };
+
+    std::atomic<int> escalations{0};
+    driver->register_tx_error_callback([&escalations](const std::string& interface, TxStatus status, const TxStats& stats) {
+        EXPECT_EQ(interface, "can0");
+        EXPECT_EQ(status, TxStatus::DEVICE_ERROR);
+        EXPECT_EQ(stats.consecutive_hard_errors, 3u);
+        escalations++;
+    });
+
+    // 两次背压后重试成功
+    bus->backpressure_frames = 2;
+    driver->send_velocity_cmd("can0", 1, 0.1f, 0.05f, 0.005f);
+    auto stats = wait_stats([](const TxStats& s) { return s.sent + s.dropped >= 1; });
+    EXPECT_EQ(bus->get_send_count(), 1);
+    EXPECT_EQ(stats.backpressure, 2u);
+    EXPECT_EQ(stats.retried, 2u);
+    EXPECT_EQ(stats.retry_succeeded, 1u);
+    EXPECT_EQ(stats.dropped, 0u);
+
+    // 持续背压：重试次数用尽后丢弃并计数
+    bus->backpressure_frames = 100;
+    driver->send_velocity_cmd("can0", 1, 0.2f, 0.05f, 0.005f);
+    stats = wait_stats([](const TxStats& s) { return s.sent + s.dropped >= 2; });
+    EXPECT_EQ(stats.dropped, 1u);
+    EXPECT_EQ(stats.retried, 2u + config.max_retries);
+    EXPECT_EQ(bus->get_send_count(), 1);
+
+    // 设备故障：不重试，连续达到阈值时只上报一次
+    bus->backpressure_frames = 0;
+    bus->device_down = true;
+    for (int i = 0; i < 5; ++i) {
+        driver->send_velocity_cmd("can0", 2, 0.1f * i, 0.05f, 0.005f);
+    }
+    stats = wait_stats([](const TxStats& s) { return s.hard_errors >= 5; });
+    EXPECT_EQ(stats.hard_errors, 5u);
+    EXPECT_EQ(stats.last_error, TxStatus::DEVICE_ERROR);
+    EXPECT_EQ(escalations.load(), 1);
+}
+
+// 测试28：命令按优先级映射到内核发送类别，使能命令走紧急类别
+TEST_F(MotorDriverImplTest, CommandPriorityMapsToTxClass) {
+    motor_driver_->enable_motor("can0", 1, 0x04);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    motor_driver_->send_velocity_cmd("can0", 1, 0.5f, 0.05f, 0.005f);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    std::vector<TxClass> classes;
+    for (const auto& packet : mock_bus_->get_sent_packets()) {
+        if (packet.id == 1) classes.push_back(packet.tx_class);
+    }
+    ASSERT_EQ(classes.size(), 2u);
+    EXPECT_EQ(classes[0], TxClass::URGENT);
+    EXPECT_EQ(classes[1], TxClass::BULK);
+    EXPECT_EQ(tx_class_for(CommandPriority::EMERGENCY), TxClass::URGENT);
+    EXPECT_EQ(tx_class_for(CommandPriority::NORMAL), TxClass::NORMAL);
+}
+
+// 按协议响应清错、使能和反馈请求的模拟关节模组；silent 中的电机不应答
+class SimulatedDeviceBus : public MockBusInterface {
+public:
+    struct Device { bool enabled{false}; uint8_t mode{0}; uint32_t error{0}; };
+
+    std::map<uint32_t, Device> devices;
+    std::set<uint32_t> silent;
+
+    bool send(const GenericBusPacket& packet) override {
+        MockBusInterface::send(packet);
+        const uint32_t motor_id = packet.id & 0xFF;
+        std::optional<GenericBusPacket> reply;
+        {
+            std::lock_guard<std::mutex> lock(devices_mutex_);
+            if (silent.count(motor_id)) return true;
+            Device& device = devices[motor_id];
+            const uint32_t family = packet.id & 0xFF00;
+            if (family == 0x400 && packet.data[0] == 0x01 && packet.data[1] == 0x03) {
+                device.error = 0;
+            } else if (family == 0x000 && packet.data[0] == 0x02) {
+                device.enabled = packet.data[1] != 0;
+                device.mode = packet.data[2];
+            } else if (family == 0x200) {
+                reply = make_status_feedback(motor_id, device.enabled, device.mode, device.error);
+                reply->interface = packet.interface;
+            }
+        }
+        if (reply) simulate_receive(*reply);
+        return true;
+    }
+
+    std::vector<std::string> get_interface_names() const override { return {"can0", "can1"}; }
+
+private:
+    std::mutex devices_mutex_;
+};
+
+// 测试29：并行上电，按反馈确认使能与模式；清错后恢复，不应答的电机超时
+TEST(MotorDriverBringUpTest, ConfirmsEnableFromFeedback) {
+    auto bus = std::make_shared<SimulatedDeviceBus>();
+    bus->devices[2].error = 0x04;       // 上电前带故障，清错后恢复
+    bus->silent.insert(6);
+    auto driver = std::make_shared<MotorDriverImpl>(bus);
+    driver->set_motor_config({{"can0", {1, 2}}, {"can1", {5, 6}}});
+
+    BringUpConfig config;
+    config.motor_modes["can1"][5] = 0x04;
+    config.timeout = std::chrono::milliseconds(300);
+    config.retry_interval = std::chrono::milliseconds(50);
+    BringUpReport report = driver->bring_up_motors(config);
+
+    ASSERT_EQ(report.motors.size(), 4u);
+    EXPECT_FALSE(report.ok());
+    for (const auto& motor : report.motors) {
+        SCOPED_TRACE(motor.interface + " motor " + std::to_string(motor.motor_id));
+        if (motor.motor_id == 6) {
+            EXPECT_EQ(motor.outcome, BringUpOutcome::NO_FEEDBACK);
+            EXPECT_GT(motor.attempts, 1u);
+            continue;
+        }
+        EXPECT_EQ(motor.outcome, BringUpOutcome::CONFIRMED);
+        EXPECT_EQ(motor.attempts, 1u);
+        EXPECT_TRUE(motor.state.enabled);
+        EXPECT_EQ(motor.state.error_code, 0u);
+        EXPECT_EQ(motor.state.motor_mode, motor.motor_id == 5 ? 0x04 : 0x03);
+        EXPECT_LT(motor.elapsed, std::chrono::microseconds(100000));
+    }
+    EXPECT_GE(report.elapsed, std::chrono::microseconds(300000));
+
+    // 全部应答时不等待超时
+    bus->silent.clear();
+    report = driver->bring_up_motors(config);
+    EXPECT_TRUE(report.ok());
+    EXPECT_LT(report.elapsed, std::chrono::microseconds(100000));
+}
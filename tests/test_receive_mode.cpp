@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "driver/motor_driver_impl.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace hardware_driver;
+using namespace hardware_driver::motor_driver;
+using namespace hardware_driver::bus;
+
+// 接收模式：两种模式下反馈都完整送达，直通模式在总线接收线程上执行回调；
+// 两种模式的延迟对比见 benchmarks/benchmark_receive_mode.cpp
+namespace {
+
+class LoopbackBus : public BusInterface {
+public:
+    void init() override {}
+    bool send(const GenericBusPacket& /*packet*/) override { return true; }
+    bool receive(GenericBusPacket& /*packet*/) override { return false; }
+    void async_receive(const std::function<void(const GenericBusPacket&)>& callback) override {
+        callback_ = callback;
+    }
+    std::vector<std::string> get_interface_names() const override { return {"can0"}; }
+
+    void inject(const GenericBusPacket& packet) { callback_(packet); }
+
+private:
+    std::function<void(const GenericBusPacket&)> callback_;
+};
+
+GenericBusPacket make_status_packet(uint32_t motor_id) {
+    GenericBusPacket packet;
+    packet.interface = "can0";
+    packet.id = 0x300 | motor_id;
+    packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.len = 24;
+    packet.data.fill(0);
+    packet.data[1] = 1;
+    packet.data[2] = 5;
+    return packet;
+}
+
+struct Delivery {
+    std::mutex mutex;
+    std::vector<uint32_t> motors;
+    std::vector<std::thread::id> threads;
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return motors.size();
+    }
+};
+
+// 逐帧注入并等待送达，返回送达的帧数
+size_t inject_and_wait(LoopbackBus& bus, Delivery& delivery, int frames) {
+    for (int i = 0; i < frames; ++i) {
+        const size_t expected = static_cast<size_t>(i) + 1;
+        bus.inject(make_status_packet(static_cast<uint32_t>(i % 6) + 1));
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (delivery.size() < expected && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        if (delivery.size() < expected) break;
+    }
+    return delivery.size();
+}
+
+}   // namespace
+
+TEST(ReceiveModeTest, EveryFrameDeliveredInBothModes) {
+    constexpr int kFrames = 200;
+    for (ReceiveMode mode : {ReceiveMode::QUEUED, ReceiveMode::RUN_TO_COMPLETION}) {
+        auto bus = std::make_shared<LoopbackBus>();
+        auto driver = std::make_shared<MotorDriverImpl>(bus);
+        driver->set_receive_mode(mode);
+        EXPECT_EQ(driver->get_receive_mode(), mode);
+
+        Delivery delivery;
+        driver->register_feedback_callback([&](const std::string&, uint32_t motor_id, const Motor_Status& status) {
+            EXPECT_EQ(status.motor_mode, 5);
+            std::lock_guard<std::mutex> lock(delivery.mutex);
+            delivery.motors.push_back(motor_id);
+            delivery.threads.push_back(std::this_thread::get_id());
+        });
+
+        ASSERT_EQ(inject_and_wait(*bus, delivery, kFrames), static_cast<size_t>(kFrames));
+        std::lock_guard<std::mutex> lock(delivery.mutex);
+        for (int i = 0; i < kFrames; ++i) {
+            EXPECT_EQ(delivery.motors[i], static_cast<uint32_t>(i % 6) + 1);
+            // 直通模式在注入（总线接收）线程上回调，排队模式由数据处理线程回调
+            if (mode == ReceiveMode::RUN_TO_COMPLETION) {
+                EXPECT_EQ(delivery.threads[i], std::this_thread::get_id());
+            } else {
+                EXPECT_NE(delivery.threads[i], std::this_thread::get_id());
+            }
+        }
+    }
+}
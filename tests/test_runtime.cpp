@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "hardware_driver/runtime/runtime.hpp"
+#include "driver/motor_driver_impl.hpp"
+#include <sys/eventfd.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace hardware_driver;
+using namespace hardware_driver::bus;
+using namespace hardware_driver::motor_driver;
+using hardware_driver::runtime::Runtime;
+using hardware_driver::runtime::RuntimeConfig;
+
+namespace {
+
+size_t process_thread_count() {
+    size_t count = 0;
+    if (DIR* dir = opendir("/proc/self/task")) {
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') ++count;
+        }
+        closedir(dir);
+    }
+    return count;
+}
+
+class CountingBus : public BusInterface {
+public:
+    void init() override {}
+    bool send(const GenericBusPacket& packet) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (packet.id == 0x00) ++feedback_requests_; else ++commands_;
+        return true;
+    }
+    bool receive(GenericBusPacket& /*packet*/) override { return false; }
+    void async_receive(const std::function<void(const GenericBusPacket&)>& callback) override {
+        callback_ = callback;
+    }
+    std::vector<std::string> get_interface_names() const override { return {"can0"}; }
+
+    void inject(const GenericBusPacket& packet) { callback_(packet); }
+    int feedback_requests() const { std::lock_guard<std::mutex> lock(mutex_); return feedback_requests_; }
+    int commands() const { std::lock_guard<std::mutex> lock(mutex_); return commands_; }
+
+private:
+    mutable std::mutex mutex_;
+    int feedback_requests_ = 0;
+    int commands_ = 0;
+    std::function<void(const GenericBusPacket&)> callback_;
+};
+
+GenericBusPacket make_status_packet(uint32_t motor_id) {
+    GenericBusPacket packet;
+    packet.interface = "can0";
+    packet.id = 0x300 | motor_id;
+    packet.protocol_type = BusProtocolType::CAN_FD;
+    packet.len = 24;
+    packet.data.fill(0);
+    packet.data[1] = 1;
+    packet.data[2] = 5;
+    return packet;
+}
+
+}   // namespace
+
+TEST(RuntimeTest, RunsPostedTasks) {
+    Runtime runtime(RuntimeConfig{2, {}, -1, -1});
+    std::atomic<int> done{0};
+    for (int i = 0; i < 100; ++i) {
+        runtime.post([&done] { done++; });
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (done.load() < 100 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(done.load(), 100);
+    EXPECT_EQ(runtime.thread_count(), 4u);
+}
+
+TEST(RuntimeTest, PeriodicTimerAndCancel) {
+    Runtime runtime;
+    std::atomic<int> ticks{0};
+    auto id = runtime.add_timer(Runtime::Clock::now(), [&ticks] {
+        ticks++;
+        return Runtime::Clock::now() + std::chrono::milliseconds(2);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    runtime.cancel_timer(id);
+    int after_cancel = ticks.load();
+    EXPECT_GE(after_cancel, 5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(ticks.load(), after_cancel);
+
+    // 返回空时刻的一次性定时器
+    std::atomic<int> once{0};
+    runtime.add_timer(Runtime::Clock::now(), [&once] { once++; return Runtime::Clock::time_point{}; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(once.load(), 1);
+}
+
+// 运行时刚创建就在回调内取消自身，不应等待自己结束而死锁
+TEST(RuntimeTest, CancelFromOwnCallbackRightAfterStart) {
+    for (int i = 0; i < 50; ++i) {
+        Runtime runtime;
+        std::atomic<bool> timer_done{false};
+        Runtime::TimerId timer = 0;
+        std::mutex timer_mutex;   // 保证回调读到 add_timer 返回的 id
+        {
+            std::lock_guard<std::mutex> lock(timer_mutex);
+            timer = runtime.add_timer(Runtime::Clock::now(), [&] {
+                std::lock_guard<std::mutex> lock(timer_mutex);
+                runtime.cancel_timer(timer);
+                timer_done = true;
+                return Runtime::Clock::time_point{};
+            });
+        }
+
+        int fd = eventfd(1, EFD_NONBLOCK);
+        ASSERT_GE(fd, 0);
+        std::atomic<bool> reader_done{false};
+        ASSERT_TRUE(runtime.add_reader(fd, [&runtime, fd, &reader_done] {
+            runtime.remove_reader(fd);
+            reader_done = true;
+        }));
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while ((!timer_done.load() || !reader_done.load()) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_TRUE(timer_done.load());
+        EXPECT_TRUE(reader_done.load());
+        ::close(fd);
+    }
+}
+
+TEST(RuntimeTest, ReaderCalledWhenReadable) {
+    Runtime runtime;
+    int fd = eventfd(0, EFD_NONBLOCK);
+    ASSERT_GE(fd, 0);
+    std::atomic<int> reads{0};
+    ASSERT_TRUE(runtime.add_reader(fd, [fd, &reads] {
+        uint64_t value = 0;
+        if (::read(fd, &value, sizeof(value)) == sizeof(value)) reads++;
+    }));
+
+    uint64_t one = 1;
+    ASSERT_EQ(::write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(reads.load(), 1);
+
+    runtime.remove_reader(fd);
+    ASSERT_EQ(::write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(reads.load(), 1);
+    ::close(fd);
+}
+
+// 多个驱动挂到同一运行时，线程数不随实例数增长，收发功能不变
+TEST(RuntimeTest, DriversShareRuntimeThreads) {
+    auto runtime = std::make_shared<Runtime>();
+    const size_t baseline = process_thread_count();
+
+    std::vector<std::shared_ptr<CountingBus>> buses;
+    std::vector<std::shared_ptr<MotorDriverImpl>> drivers;
+    for (int i = 0; i < 4; ++i) {
+        buses.push_back(std::make_shared<CountingBus>());
+        drivers.push_back(std::make_shared<MotorDriverImpl>(buses.back(), runtime));
+        CommandGateConfig config;
+        config.policy = CommandGatePolicy::PASS_THROUGH;
+        drivers.back()->set_command_gate_config(config);
+        drivers.back()->set_motor_config({{"can0", {1}}});
+    }
+    EXPECT_EQ(process_thread_count(), baseline);
+
+    for (size_t i = 0; i < drivers.size(); ++i) {
+        buses[i]->inject(make_status_packet(1));
+        drivers[i]->send_position_cmd("can0", 1, 0.5f * i);
+        drivers[i]->send_position_cmd("can0", 1, 0.5f * i + 0.1f);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    for (size_t i = 0; i < drivers.size(); ++i) {
+        Motor_Status status;
+        EXPECT_TRUE(drivers[i]->get_motor_status("can0", 1, status));
+        EXPECT_EQ(buses[i]->commands(), 2);
+        EXPECT_GE(buses[i]->feedback_requests(), 1);
+    }
+
+    drivers.clear();
+    EXPECT_EQ(process_thread_count(), baseline);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "interface/tracking_monitor.hpp"
+#include <chrono>
+#include <cmath>
+
+using namespace hardware_driver::trajectory;
+using hardware_driver::motor_driver::Motor_Status;
+using hardware_driver::motor_driver::MotorFeedbackSlot;
+
+namespace {
+
+void publish_position(MotorFeedbackSlot& slot, float position, std::chrono::steady_clock::time_point stamp) {
+    Motor_Status status{};
+    status.position = position;
+    slot.publish(status, stamp);
+}
+
+std::array<float, 6> setpoint(float a, float b) {
+    std::array<float, 6> values = {};
+    values[0] = a;
+    values[1] = b;
+    return values;
+}
+
+}   // namespace
+
+TEST(TrackingMonitorTest, AccumulatesMaxAndRmsError) {
+    MotorFeedbackSlot slot0, slot1;
+    TrackingMonitorConfig config;
+    config.enabled = true;
+    config.default_max_error = 1.0;
+    TrackingMonitor monitor(config, {&slot0, &slot1});
+
+    auto now = std::chrono::steady_clock::now();
+    const float errors[] = {0.1f, 0.3f, 0.2f};
+    for (size_t i = 0; i < 3; ++i) {
+        publish_position(slot0, 1.0f - errors[i], now);
+        publish_position(slot1, 2.0f, now);
+        EXPECT_FALSE(monitor.update(i, setpoint(1.0f, 2.0f), now));
+    }
+
+    auto report = monitor.report();
+    ASSERT_EQ(report.max_error.size(), 2u);
+    EXPECT_NEAR(report.max_error[0], 0.3, 1e-6);
+    EXPECT_NEAR(report.rms_error[0], std::sqrt((0.01 + 0.09 + 0.04) / 3.0), 1e-6);
+    EXPECT_NEAR(report.max_error[1], 0.0, 1e-9);
+    EXPECT_EQ(report.samples, 3u);
+    EXPECT_FALSE(report.tripped);
+}
+
+TEST(TrackingMonitorTest, TripsAfterConsecutiveCycles) {
+    MotorFeedbackSlot slot0, slot1;
+    TrackingMonitorConfig config;
+    config.enabled = true;
+    config.max_error = {0.5, 0.05};
+    config.trip_cycles = 3;
+    TrackingMonitor monitor(config, {&slot0, &slot1});
+
+    auto now = std::chrono::steady_clock::now();
+    publish_position(slot0, 0.0f, now);
+    publish_position(slot1, 0.0f, now);
+
+    // 单次超限后恢复：计数清零，不触发
+    EXPECT_FALSE(monitor.update(0, setpoint(0.0f, 0.1f), now));
+    EXPECT_TRUE(monitor.joint_exceeded(1));
+    EXPECT_FALSE(monitor.update(1, setpoint(0.0f, 0.0f), now));
+    EXPECT_FALSE(monitor.joint_exceeded(1));
+
+    // 关节 1 被挡住，设定值继续前进
+    EXPECT_FALSE(monitor.update(2, setpoint(0.1f, 0.1f), now));
+    EXPECT_FALSE(monitor.update(3, setpoint(0.2f, 0.2f), now));
+    EXPECT_TRUE(monitor.update(4, setpoint(0.3f, 0.3f), now));
+    EXPECT_TRUE(monitor.tripped());
+    EXPECT_FALSE(monitor.joint_exceeded(0));
+    EXPECT_TRUE(monitor.joint_exceeded(1));
+    EXPECT_FALSE(monitor.update(5, setpoint(0.4f, 0.4f), now));   // 只报告一次
+
+    auto report = monitor.report();
+    EXPECT_TRUE(report.tripped);
+    EXPECT_EQ(report.trip_point_index, 4u);
+    EXPECT_EQ(report.trip_joint_index, 1u);
+    EXPECT_NEAR(report.trip_error, 0.3, 1e-6);
+
+    monitor.rearm();
+    EXPECT_FALSE(monitor.tripped());
+    EXPECT_TRUE(monitor.report().tripped);
+}
+
+TEST(TrackingMonitorTest, SkipsStaleFeedback) {
+    MotorFeedbackSlot slot0;
+    TrackingMonitorConfig config;
+    config.enabled = true;
+    config.default_max_error = 0.01;
+    config.trip_cycles = 1;
+    config.feedback_timeout = std::chrono::milliseconds(20);
+    TrackingMonitor monitor(config, {&slot0});
+
+    auto now = std::chrono::steady_clock::now();
+    EXPECT_FALSE(monitor.update(0, setpoint(1.0f, 0.0f), now));   // 尚无反馈
+    publish_position(slot0, 0.0f, now - std::chrono::milliseconds(100));
+    EXPECT_FALSE(monitor.update(1, setpoint(1.0f, 0.0f), now));   // 反馈过期
+
+    auto report = monitor.report();
+    EXPECT_EQ(report.samples, 0u);
+    EXPECT_EQ(report.stale_samples, 2u);
+    EXPECT_FALSE(report.tripped);
+}
+
+TEST(TrackingMonitorTest, ComparesAgainstDelayedSetpoint) {
+    MotorFeedbackSlot slot0;
+    TrackingMonitorConfig config;
+    config.enabled = true;
+    config.default_max_error = 0.05;
+    config.trip_cycles = 1;
+    config.setpoint_delay_cycles = 2;
+    TrackingMonitor monitor(config, {&slot0});
+
+    // 反馈滞后设定值两个周期：与延迟后的设定值比较误差为 0
+    auto now = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < 10; ++i) {
+        const float commanded = 0.1f * i;
+        const float measured = i >= 2 ? 0.1f * (i - 2) : 0.0f;
+        publish_position(slot0, measured, now);
+        EXPECT_FALSE(monitor.update(i, setpoint(commanded, 0.0f), now));
+    }
+    auto report = monitor.report();
+    EXPECT_EQ(report.samples, 8u);
+    EXPECT_NEAR(report.max_error[0], 0.0, 1e-6);
+}
+
+TEST(TrackingMonitorTest, UpdateIsCheap) {
+    MotorFeedbackSlot slots[6];
+    std::vector<const MotorFeedbackSlot*> pointers;
+    auto now = std::chrono::steady_clock::now();
+    for (auto& slot : slots) {
+        publish_position(slot, 0.0f, now);
+        pointers.push_back(&slot);
+    }
+    TrackingMonitorConfig config;
+    config.enabled = true;
+    config.feedback_timeout = std::chrono::hours(1);
+    TrackingMonitor monitor(config, pointers);
+
+    const size_t cycles = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cycles; ++i) {
+        monitor.update(i, setpoint(0.01f, 0.01f), now);
+    }
+    auto per_cycle_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / cycles;
+    EXPECT_LT(per_cycle_ns, 5000.0);
+    EXPECT_EQ(monitor.report().samples, cycles);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "hardware_driver/interface/trajectory_blending.hpp"
+#include <cmath>
+
+using namespace hardware_driver::trajectory;
+
+namespace {
+
+// 单关节匀速轨迹：from -> to，时长 duration，按 period 采样
+Trajectory constant_velocity(double from, double to, double duration, double period = 0.01) {
+    Trajectory trajectory;
+    trajectory.joint_names = {"joint1"};
+    const size_t steps = static_cast<size_t>(std::round(duration / period));
+    const double velocity = (to - from) / duration;
+    for (size_t i = 0; i <= steps; ++i) {
+        TrajectoryPoint point;
+        point.time_from_start = duration * i / steps;
+        point.positions = {from + (to - from) * i / steps};
+        point.velocities = {velocity};
+        point.accelerations = {0.0};
+        trajectory.points.push_back(point);
+    }
+    return trajectory;
+}
+
+// 相邻点位置差分不超过 max_step，时间严格递增
+void expect_continuous(const Trajectory& trajectory, double max_step) {
+    const auto& points = trajectory.points;
+    for (size_t i = 1; i < points.size(); ++i) {
+        EXPECT_GT(points[i].time_from_start, points[i - 1].time_from_start);
+        EXPECT_LE(std::fabs(points[i].positions[0] - points[i - 1].positions[0]), max_step);
+    }
+}
+
+}   // namespace
+
+TEST(TrajectoryBlendingTest, SampleInterpolatesBetweenPoints) {
+    auto trajectory = constant_velocity(0.0, 1.0, 1.0);
+    std::vector<double> p, v, a;
+
+    sample_trajectory(trajectory, 0.255, p, v, a);
+    ASSERT_EQ(p.size(), 1u);
+    EXPECT_NEAR(p[0], 0.255, 1e-9);
+    EXPECT_NEAR(v[0], 1.0, 1e-9);
+
+    // 超出范围保持端点且速度为零
+    sample_trajectory(trajectory, 5.0, p, v, a);
+    EXPECT_DOUBLE_EQ(p[0], 1.0);
+    EXPECT_DOUBLE_EQ(v[0], 0.0);
+}
+
+TEST(TrajectoryBlendingTest, BlendOverlapsAndStaysContinuous) {
+    auto first = constant_velocity(0.0, 1.0, 1.0);
+    auto second = constant_velocity(1.0, 2.0, 1.0);
+    TrajectoryBlendConfig config;
+    config.blend_window = 0.2;
+
+    auto result = blend_trajectories(first, second, config);
+    ASSERT_FALSE(result.points.empty());
+
+    // 重叠窗口使总时长缩短 blend_window
+    EXPECT_NEAR(result.points.back().time_from_start, 1.8, 1e-9);
+    EXPECT_NEAR(result.points.back().positions[0], 2.0, 1e-9);
+    expect_continuous(result, 0.02);
+
+    // 衔接段内不停顿，两端速度与原轨迹一致
+    for (const auto& point : result.points) {
+        if (point.time_from_start > 0.8 && point.time_from_start < 1.0) {
+            EXPECT_GT(point.velocities[0], 0.5);
+        }
+    }
+    std::vector<double> p, v, a;
+    sample_trajectory(result, 0.8, p, v, a);
+    EXPECT_NEAR(v[0], 1.0, 1e-6);
+    sample_trajectory(result, 1.0, p, v, a);
+    EXPECT_NEAR(v[0], 1.0, 1e-6);
+}
+
+TEST(TrajectoryBlendingTest, BlendMatchesBoundaryStates) {
+    auto first = constant_velocity(0.0, 1.0, 1.0);
+    auto second = constant_velocity(1.0, 0.0, 1.0);
+    TrajectoryBlendConfig config;
+    config.blend_window = 0.3;
+
+    auto result = blend_trajectories(first, second, config);
+    expect_continuous(result, 0.05);
+
+    std::vector<double> p, v, a;
+    sample_trajectory(result, 0.7, p, v, a);
+    EXPECT_NEAR(p[0], 0.7, 1e-9);
+    sample_trajectory(result, 1.0, p, v, a);
+    EXPECT_NEAR(p[0], 0.7, 1e-9);   // second 在 t=0.3 处的位置
+    EXPECT_NEAR(v[0], -1.0, 1e-6);
+}
+
+TEST(TrajectoryBlendingTest, EarliestBlendStartKeepsSentPoints) {
+    auto first = constant_velocity(0.0, 1.0, 1.0);
+    auto second = constant_velocity(1.0, 2.0, 1.0);
+    TrajectoryBlendConfig config;
+    config.blend_window = 0.5;
+
+    auto result = blend_trajectories(first, second, config, 0.9);
+    for (const auto& point : result.points) {
+        if (point.time_from_start >= 0.9) break;
+        EXPECT_NEAR(point.positions[0], point.time_from_start, 1e-9);
+    }
+    // 窗口被压缩到 0.1 秒
+    EXPECT_NEAR(result.points.back().time_from_start, 1.9, 1e-9);
+    expect_continuous(result, 0.05);
+}
+
+TEST(TrajectoryBlendingTest, ZeroWindowConcatenates) {
+    auto first = constant_velocity(0.0, 1.0, 1.0);
+    auto second = constant_velocity(1.0, 2.0, 1.0);
+    TrajectoryBlendConfig config;
+    config.blend_window = 0.0;
+
+    auto result = blend_trajectories(first, second, config);
+    EXPECT_NEAR(result.points.back().time_from_start, 2.0, 1e-9);
+    EXPECT_EQ(result.points.size(), first.points.size() + second.points.size() - 1);
+    expect_continuous(result, 0.02);
+}
+
+TEST(TrajectoryBlendingTest, JointCountMismatchKeepsFirst) {
+    auto first = constant_velocity(0.0, 1.0, 1.0);
+    Trajectory second;
+    TrajectoryPoint point;
+    point.positions = {0.0, 0.0};
+    second.points.push_back(point);
+
+    auto result = blend_trajectories(first, second, TrajectoryBlendConfig{});
+    EXPECT_EQ(result.points.size(), first.points.size());
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "hardware_driver/interface/trajectory_time_parameterization.hpp"
+#include <chrono>
+#include <cmath>
+
+using namespace hardware_driver::trajectory;
+
+namespace {
+
+JointLimits make_limits(size_t dof, double v, double a, double j = 0.0) {
+    JointLimits limits;
+    limits.max_velocity.assign(dof, v);
+    limits.max_acceleration.assign(dof, a);
+    if (j > 0.0) limits.max_jerk.assign(dof, j);
+    return limits;
+}
+
+std::vector<std::vector<double>> straight_line(double from, double to, size_t samples) {
+    std::vector<std::vector<double>> path;
+    for (size_t i = 0; i < samples; ++i) {
+        path.push_back({from + (to - from) * i / (samples - 1)});
+    }
+    return path;
+}
+
+// 由相邻点的位置差分检查速度/加速度是否超限
+void expect_within_limits(const Trajectory& trajectory, const JointLimits& limits, double tolerance) {
+    const auto& points = trajectory.points;
+    for (size_t i = 1; i < points.size(); ++i) {
+        EXPECT_GT(points[i].time_from_start, points[i - 1].time_from_start);
+        for (size_t j = 0; j < points[i].velocities.size(); ++j) {
+            EXPECT_LE(std::fabs(points[i].velocities[j]), limits.max_velocity[j] * (1.0 + tolerance));
+            EXPECT_LE(std::fabs(points[i].accelerations[j]), limits.max_acceleration[j] * (1.0 + tolerance));
+        }
+    }
+}
+
+}   // namespace
+
+TEST(TrajectoryTimeParameterizationTest, StraightLineMatchesTrapezoidalProfile) {
+    auto limits = make_limits(1, 2.0, 4.0);
+    TrajectoryTimeParameterizer parameterizer(limits);
+    Trajectory trajectory;
+
+    auto result = parameterizer.compute(straight_line(0.0, 3.0, 2000), trajectory);
+    ASSERT_TRUE(result.success);
+
+    // 梯形速度曲线：加速 0.5s、匀速 1.0s、减速 0.5s
+    EXPECT_NEAR(result.duration, 2.0, 0.01);
+    EXPECT_DOUBLE_EQ(trajectory.points.front().time_from_start, 0.0);
+    EXPECT_NEAR(trajectory.points.back().positions[0], 3.0, 1e-12);
+    EXPECT_NEAR(trajectory.points.back().velocities[0], 0.0, 1e-12);
+    expect_within_limits(trajectory, limits, 1e-6);
+}
+
+TEST(TrajectoryTimeParameterizationTest, SlowestJointDominates) {
+    JointLimits limits = make_limits(2, 1.0, 10.0);
+    limits.max_velocity[1] = 0.25;
+    TrajectoryTimeParameterizer parameterizer(limits);
+    Trajectory trajectory;
+
+    std::vector<std::vector<double>> path;
+    for (size_t i = 0; i < 500; ++i) {
+        double s = i / 499.0;
+        path.push_back({s, s});
+    }
+    auto result = parameterizer.compute(path, trajectory);
+    ASSERT_TRUE(result.success);
+    EXPECT_GT(result.duration, 1.0 / 0.25);
+    expect_within_limits(trajectory, limits, 1e-6);
+}
+
+TEST(TrajectoryTimeParameterizationTest, SparsePathIsRefinedAndStopsAtCorner) {
+    auto limits = make_limits(2, 1.0, 2.0);
+    TrajectoryTimeParameterizer parameterizer(limits);
+    Trajectory trajectory;
+
+    auto result = parameterizer.compute({{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}}, trajectory);
+    ASSERT_TRUE(result.success);
+    EXPECT_GT(trajectory.points.size(), 3u);
+    expect_within_limits(trajectory, limits, 1e-6);
+
+    // 直角拐点处的曲率把速度压到远低于巡航速度
+    bool found_corner = false;
+    for (const auto& point : trajectory.points) {
+        if (std::fabs(point.positions[0] - 1.0) < 1e-9 && std::fabs(point.positions[1]) < 1e-9) {
+            found_corner = true;
+            EXPECT_LT(std::hypot(point.velocities[0], point.velocities[1]), 0.3);
+        }
+    }
+    EXPECT_TRUE(found_corner);
+}
+
+TEST(TrajectoryTimeParameterizationTest, JerkLimitSmoothsAcceleration) {
+    auto limits = make_limits(1, 2.0, 4.0);
+    TrajectoryTimeParameterizer unlimited(limits);
+    Trajectory fast;
+    auto fast_result = unlimited.compute(straight_line(0.0, 3.0, 400), fast);
+    ASSERT_TRUE(fast_result.success);
+
+    auto jerk_limits = make_limits(1, 2.0, 4.0, 40.0);
+    TimeParameterizationOptions options;
+    options.max_jerk_iterations = 200;
+    TrajectoryTimeParameterizer limited(jerk_limits, options);
+    Trajectory smooth;
+    auto result = limited.compute(straight_line(0.0, 3.0, 400), smooth);
+    ASSERT_TRUE(result.success);
+    EXPECT_TRUE(result.jerk_satisfied);
+    EXPECT_GT(result.jerk_iterations, 0u);
+    EXPECT_GT(result.duration, fast_result.duration);
+
+    for (size_t i = 1; i < smooth.points.size(); ++i) {
+        double dt = smooth.points[i].time_from_start - smooth.points[i - 1].time_from_start;
+        double jerk = (smooth.points[i].accelerations[0] - smooth.points[i - 1].accelerations[0]) / dt;
+        EXPECT_LE(std::fabs(jerk), 40.0 * (1.0 + 1e-3));
+    }
+}
+
+TEST(TrajectoryTimeParameterizationTest, ResamplesAtFixedPeriod) {
+    auto limits = make_limits(1, 2.0, 4.0);
+    TimeParameterizationOptions options;
+    options.resample_period = 0.005;
+    TrajectoryTimeParameterizer parameterizer(limits, options);
+    Trajectory trajectory;
+
+    auto result = parameterizer.compute(straight_line(0.0, 3.0, 1000), trajectory);
+    ASSERT_TRUE(result.success);
+    for (size_t i = 1; i + 1 < trajectory.points.size(); ++i) {
+        EXPECT_NEAR(trajectory.points[i].time_from_start - trajectory.points[i - 1].time_from_start, 0.005, 1e-9);
+        EXPECT_GE(trajectory.points[i].positions[0], trajectory.points[i - 1].positions[0]);
+    }
+    EXPECT_NEAR(trajectory.points.back().time_from_start, result.duration, 1e-12);
+    EXPECT_DOUBLE_EQ(trajectory.points.back().positions[0], 3.0);
+}
+
+TEST(TrajectoryTimeParameterizationTest, RejectsInconsistentInput) {
+    TrajectoryTimeParameterizer parameterizer(make_limits(2, 1.0, 1.0));
+    Trajectory trajectory;
+    EXPECT_FALSE(parameterizer.compute({}, trajectory).success);
+    EXPECT_FALSE(parameterizer.compute({{0.0, 0.0}, {1.0}}, trajectory).success);
+
+    TrajectoryTimeParameterizer bad_limits(make_limits(2, 0.0, 1.0));
+    EXPECT_FALSE(bad_limits.compute({{0.0, 0.0}, {1.0, 1.0}}, trajectory).success);
+}
+
+TEST(TrajectoryTimeParameterizationTest, LongPathIsFastEnoughForOnlineUse) {
+    const size_t dof = 6;
+    auto limits = make_limits(dof, 3.0, 10.0);
+    TrajectoryTimeParameterizer parameterizer(limits);
+
+    std::vector<std::vector<double>> path;
+    for (size_t i = 0; i < 5000; ++i) {
+        double s = i / 4999.0;
+        std::vector<double> q(dof);
+        for (size_t j = 0; j < dof; ++j) q[j] = std::sin(2.0 * s * (j + 1));
+        path.push_back(q);
+    }
+
+    Trajectory trajectory;
+    auto start = std::chrono::steady_clock::now();
+    auto result = parameterizer.compute(path, trajectory);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(trajectory.points.size(), 5000u);
+    EXPECT_LT(elapsed, 200.0);
+    expect_within_limits(trajectory, limits, 1e-3);
+}
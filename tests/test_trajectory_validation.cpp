@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "hardware_driver/interface/trajectory_validation.hpp"
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+using namespace hardware_driver::trajectory;
+
+namespace {
+
+// 各关节按 sin 曲线运动，幅值 amplitude，角频率 omega
+Trajectory sine_trajectory(size_t dof, size_t count, double period, double amplitude = 1.0, double omega = 1.0) {
+    Trajectory trajectory;
+    for (size_t i = 0; i < count; ++i) {
+        TrajectoryPoint point;
+        point.time_from_start = i * period;
+        for (size_t j = 0; j < dof; ++j) {
+            point.positions.push_back(amplitude * std::sin(omega * point.time_from_start + j));
+        }
+        trajectory.points.push_back(point);
+    }
+    return trajectory;
+}
+
+TrajectoryValidationLimits make_limits(size_t dof, double p, double v, double a) {
+    TrajectoryValidationLimits limits;
+    limits.min_position.assign(dof, -p);
+    limits.max_position.assign(dof, p);
+    limits.max_velocity.assign(dof, v);
+    limits.max_acceleration.assign(dof, a);
+    return limits;
+}
+
+}   // namespace
+
+TEST(TrajectoryValidationTest, AcceptsFeasibleTrajectory) {
+    TrajectoryValidator validator(make_limits(6, 1.1, 1.1, 1.1));
+    auto result = validator.validate(sine_trajectory(6, 1000, 0.01), 6);
+    EXPECT_TRUE(result.valid) << result.summary();
+    EXPECT_EQ(result.issue_count, 0u);
+    EXPECT_EQ(result.summary(), "valid");
+}
+
+TEST(TrajectoryValidationTest, RejectsEmptyAndMissingJoints) {
+    TrajectoryValidator validator;
+    auto empty = validator.validate(Trajectory{}, 6);
+    EXPECT_FALSE(empty.valid);
+    ASSERT_FALSE(empty.issues.empty());
+    EXPECT_EQ(empty.issues[0].violation, TrajectoryViolation::EMPTY);
+
+    // 点的关节数少于电机数：执行时会被补 0，必须拒绝
+    auto trajectory = sine_trajectory(6, 10, 0.01);
+    trajectory.points[4].positions.pop_back();
+    auto result = validator.validate(trajectory, 6);
+    EXPECT_FALSE(result.valid);
+    ASSERT_EQ(result.issues.size(), 1u);
+    EXPECT_EQ(result.issues[0].violation, TrajectoryViolation::DIMENSION_MISMATCH);
+    EXPECT_EQ(result.issues[0].point_index, 4u);
+    EXPECT_EQ(result.issues[0].value, 5.0);
+}
+
+TEST(TrajectoryValidationTest, RejectsNonMonotonicTimeAndNonFinite) {
+    TrajectoryValidator validator;
+    auto trajectory = sine_trajectory(2, 10, 0.01);
+    trajectory.points[3].time_from_start = trajectory.points[2].time_from_start;
+    trajectory.points[7].positions[1] = std::numeric_limits<double>::quiet_NaN();
+
+    auto result = validator.validate(trajectory, 2);
+    EXPECT_FALSE(result.valid);
+    ASSERT_EQ(result.issues.size(), 2u);
+    EXPECT_EQ(result.issues[0].violation, TrajectoryViolation::NON_MONOTONIC_TIME);
+    EXPECT_EQ(result.issues[0].point_index, 3u);
+    EXPECT_EQ(result.issues[1].violation, TrajectoryViolation::NON_FINITE);
+    EXPECT_EQ(result.issues[1].point_index, 7u);
+    EXPECT_EQ(result.issues[1].joint_index, 1u);
+}
+
+TEST(TrajectoryValidationTest, ReportsLimitViolationsPrecisely) {
+    auto trajectory = sine_trajectory(3, 200, 0.01);
+    // 关节 2 在第 100 个点跳变 0.1 rad：位置差分速度 10 rad/s
+    trajectory.points[100].positions[2] += 0.1;
+
+    TrajectoryValidator validator(make_limits(3, 2.0, 2.0, 50.0));
+    auto result = validator.validate(trajectory, 3);
+    EXPECT_FALSE(result.valid);
+
+    bool velocity_found = false, acceleration_found = false;
+    for (const auto& issue : result.issues) {
+        EXPECT_EQ(issue.joint_index, 2u);
+        if (issue.violation == TrajectoryViolation::VELOCITY_LIMIT) {
+            velocity_found = true;
+            EXPECT_TRUE(issue.point_index == 100u || issue.point_index == 101u);
+            EXPECT_NEAR(std::fabs(issue.value), 10.0, 1.1);
+            EXPECT_DOUBLE_EQ(issue.limit, 2.0);
+        }
+        if (issue.violation == TrajectoryViolation::ACCELERATION_LIMIT) {
+            acceleration_found = true;
+            EXPECT_GE(issue.point_index, 99u);
+            EXPECT_LE(issue.point_index, 101u);
+        }
+    }
+    EXPECT_TRUE(velocity_found);
+    EXPECT_TRUE(acceleration_found);
+
+    TrajectoryValidator position_validator(make_limits(3, 0.5, 100.0, 1e6));
+    auto position_result = position_validator.validate(trajectory, 3);
+    EXPECT_FALSE(position_result.valid);
+    EXPECT_EQ(position_result.issues[0].violation, TrajectoryViolation::POSITION_LIMIT);
+    EXPECT_EQ(position_result.issues.size(), 16u);
+    EXPECT_GT(position_result.issue_count, 16u);
+}
+
+TEST(TrajectoryValidationTest, ChecksStartDistance) {
+    auto limits = make_limits(2, 10.0, 10.0, 100.0);
+    limits.max_start_distance = 0.05;
+    TrajectoryValidator validator(limits);
+    auto trajectory = sine_trajectory(2, 50, 0.01);
+
+    std::vector<double> near = {trajectory.points[0].positions[0], trajectory.points[0].positions[1] + 0.01};
+    auto ok = validator.validate(trajectory, 2, &near);
+    EXPECT_TRUE(ok.valid);
+    EXPECT_TRUE(ok.start_checked);
+
+    std::vector<double> far = {trajectory.points[0].positions[0] - 0.3, trajectory.points[0].positions[1]};
+    auto rejected = validator.validate(trajectory, 2, &far);
+    EXPECT_FALSE(rejected.valid);
+    ASSERT_EQ(rejected.issues.size(), 1u);
+    EXPECT_EQ(rejected.issues[0].violation, TrajectoryViolation::START_DISTANCE);
+    EXPECT_NEAR(rejected.issues[0].value, 0.3, 1e-12);
+
+    // 没有当前位置时跳过起点检查
+    auto skipped = validator.validate(trajectory, 2);
+    EXPECT_TRUE(skipped.valid);
+    EXPECT_FALSE(skipped.start_checked);
+}
+
+TEST(TrajectoryValidationTest, ParallelMatchesSerial) {
+    auto trajectory = sine_trajectory(6, 100000, 0.001);
+    trajectory.points[12345].positions[3] += 0.5;
+    trajectory.points[87654].positions[0] -= 0.5;
+    auto limits = make_limits(6, 2.0, 5.0, 1000.0);
+
+    TrajectoryValidationOptions serial_options;
+    serial_options.parallel_min_points = 0;
+    TrajectoryValidator serial(limits, serial_options);
+    auto serial_result = serial.validate(trajectory, 6);
+
+    TrajectoryValidationOptions parallel_options;
+    parallel_options.parallel_min_points = 1000;
+    parallel_options.max_threads = 4;
+    TrajectoryValidator parallel(limits, parallel_options);
+    auto parallel_result = parallel.validate(trajectory, 6);
+
+    EXPECT_EQ(serial_result.threads_used, 1u);
+    EXPECT_EQ(parallel_result.threads_used, 4u);
+    EXPECT_FALSE(parallel_result.valid);
+    EXPECT_EQ(parallel_result.issue_count, serial_result.issue_count);
+    ASSERT_EQ(parallel_result.issues.size(), serial_result.issues.size());
+    for (size_t i = 0; i < serial_result.issues.size(); ++i) {
+        EXPECT_EQ(parallel_result.issues[i].violation, serial_result.issues[i].violation);
+        EXPECT_EQ(parallel_result.issues[i].point_index, serial_result.issues[i].point_index);
+        EXPECT_EQ(parallel_result.issues[i].joint_index, serial_result.issues[i].joint_index);
+    }
+    EXPECT_EQ(parallel_result.issues.front().point_index, 12344u);   // 跳变前一点的加速度已超限
+}
+
+TEST(TrajectoryValidationTest, LargeTrajectoryValidatesQuickly) {
+    auto trajectory = sine_trajectory(6, 100000, 0.001);
+    TrajectoryValidator validator(make_limits(6, 1.1, 1.1, 1.1));
+    validator.validate(trajectory, 6);   // 预热缓冲区
+    auto result = validator.validate(trajectory, 6);
+    EXPECT_TRUE(result.valid) << result.summary();
+    EXPECT_LT(result.elapsed_us, 200000.0);
+    std::cout << "validated " << trajectory.points.size() << " points in " << result.elapsed_us
+              << " us on " << result.threads_used << " thread(s)" << std::endl;
+}
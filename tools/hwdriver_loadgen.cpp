@@ -0,0 +1,265 @@
+/**
+ * @file hwdriver_loadgen.cpp
+ * @brief 总线负载生成工具，用于容量测试
+ *
+ * 在 SocketCAN / vcan 接口上按目标占用率发送接近实际的流量组成（状态反馈、批量控制、参数读写、外部帧），
+ * 可按多个占用率依次运行，每一档结束时报告实际达到的占用率、帧率和发送时刻偏差。与驱动自身的指标
+ * （hwdriver-top、基准测试）结合，可以得到控制时延随总线负载的变化。
+ *
+ * 用法：
+ *   hwdriver-loadgen --interface=can0 --utilization=0.5,0.8,0.95 --step=10
+ *                    [--bitrate=1000000] [--dbitrate=5000000] [--classic] [--no-brs] [--extended]
+ *                    [--mix=status:6,control_all:1,param:0.2,foreign:0.5] [--motors=11,12]
+ *                    [--foreign-ids=0x7A0,0x7A1] [--foreign-len=8] [--report-interval=1]
+ *                    [--realtime=PRIO] [--json]
+ */
+#include "hardware_driver/bus/bus_load_generator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace hardware_driver::bus;
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+void handle_signal(int) { g_stop.store(true); }
+
+struct Options {
+    LoadProfile profile;
+    std::vector<double> utilizations{0.5};
+    double step_s{10.0};
+    double report_interval_s{1.0};
+    int realtime_priority{0};
+    bool json{false};
+};
+
+void print_usage() {
+    std::fprintf(stderr,
+        "用法: hwdriver-loadgen --interface=IFACE [选项]\n"
+        "  --utilization=U[,U...]   目标总线占用率（0.01~1.0），多个值依次运行，默认 0.5\n"
+        "  --step=S                 每档运行秒数，默认 10\n"
+        "  --bitrate=BPS            仲裁段波特率，默认 1000000\n"
+        "  --dbitrate=BPS           数据段波特率，默认 5000000\n"
+        "  --classic                发送经典 CAN 帧（外部帧最多 8 字节，超过 8 字节的类型不可用）\n"
+        "  --no-brs                 按不切换数据段波特率计算空口时间\n"
+        "  --extended               按 29 位扩展帧计算空口时间\n"
+        "  --mix=KIND:W[,...]       帧组成：status control_all control feedback_req param foreign\n"
+        "  --motors=ID[,ID...]      模拟的电机 ID，默认 1-6（与驱动同时运行时应避开驱动配置的电机）\n"
+        "  --foreign-ids=ID[,...]   外部帧 ID，默认 0x7A0\n"
+        "  --foreign-len=N          外部帧长度，默认 8\n"
+        "  --report-interval=S      每 S 秒向 stderr 报告一次，0 表示只在每档结束时报告\n"
+        "  --realtime=PRIO          以 SCHED_FIFO 优先级 PRIO 运行发送线程\n"
+        "  --json                   每档结果以 JSON 行输出到 stdout\n");
+}
+
+std::vector<std::string> split(const std::string& value) {
+    std::vector<std::string> items;
+    std::istringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+std::vector<uint32_t> parse_ids(const std::string& value) {
+    std::vector<uint32_t> ids;
+    for (const auto& item : split(value)) ids.push_back(static_cast<uint32_t>(std::strtoul(item.c_str(), nullptr, 0)));
+    return ids;
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    options.profile.interface.clear();
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        const std::string key = arg.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--interface" || key == "-i") {
+            options.profile.interface = value;
+        } else if (key == "--utilization") {
+            options.utilizations.clear();
+            for (const auto& item : split(value)) options.utilizations.push_back(std::atof(item.c_str()));
+        } else if (key == "--step") {
+            options.step_s = std::atof(value.c_str());
+        } else if (key == "--bitrate") {
+            options.profile.nominal_bitrate = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 0));
+        } else if (key == "--dbitrate") {
+            options.profile.data_bitrate = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 0));
+        } else if (key == "--classic") {
+            options.profile.fd = false;
+        } else if (key == "--no-brs") {
+            options.profile.brs = false;
+        } else if (key == "--extended") {
+            options.profile.extended = true;
+        } else if (key == "--mix") {
+            if (!parse_load_mix(value, options.profile.mix)) {
+                std::fprintf(stderr, "无效的帧组成: %s\n", value.c_str());
+                return false;
+            }
+        } else if (key == "--motors") {
+            options.profile.motor_ids = parse_ids(value);
+        } else if (key == "--foreign-ids") {
+            options.profile.foreign_ids = parse_ids(value);
+        } else if (key == "--foreign-len") {
+            options.profile.foreign_len = std::strtoul(value.c_str(), nullptr, 0);
+        } else if (key == "--report-interval") {
+            options.report_interval_s = std::atof(value.c_str());
+        } else if (key == "--realtime") {
+            options.realtime_priority = std::atoi(value.c_str());
+        } else if (key == "--json") {
+            options.json = true;
+        } else {
+            print_usage();
+            return false;
+        }
+    }
+    if (options.profile.interface.empty() || options.utilizations.empty()) {
+        print_usage();
+        return false;
+    }
+    return true;
+}
+
+int open_send_socket(const std::string& interface, bool fd) {
+    int sock = ::socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (sock < 0) {
+        std::fprintf(stderr, "创建 %s 套接字失败: %s\n", interface.c_str(), std::strerror(errno));
+        return -1;
+    }
+    const int enable = 1;
+    if (fd && setsockopt(sock, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) < 0) {
+        std::fprintf(stderr, "%s 不支持 CAN FD\n", interface.c_str());
+        ::close(sock);
+        return -1;
+    }
+    // 只发送：清空过滤器，不接收任何帧
+    setsockopt(sock, SOL_CAN_RAW, CAN_RAW_FILTER, nullptr, 0);
+
+    struct ifreq ifr {};
+    std::strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    if (ioctl(sock, SIOCGIFINDEX, &ifr) < 0) {
+        std::fprintf(stderr, "接口 %s 不存在: %s\n", interface.c_str(), std::strerror(errno));
+        ::close(sock);
+        return -1;
+    }
+    struct sockaddr_can addr {};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (::bind(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::fprintf(stderr, "绑定 %s 失败: %s\n", interface.c_str(), std::strerror(errno));
+        ::close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+// 发送队列满（ENOBUFS）时不等待，计为发送失败，保持节拍
+bool send_raw(int sock, bool fd, const GenericBusPacket& packet) {
+    struct canfd_frame frame {};
+    frame.can_id = packet.id > CAN_SFF_MASK ? (packet.id | CAN_EFF_FLAG) : packet.id;
+    frame.len = static_cast<uint8_t>(std::min<size_t>(packet.len, fd ? CANFD_MAX_DLEN : CAN_MAX_DLEN));
+    if (fd) frame.flags = CANFD_BRS;
+    std::memcpy(frame.data, packet.data.data(), frame.len);
+    const size_t size = fd ? CANFD_MTU : CAN_MTU;
+    return ::write(sock, &frame, size) == static_cast<ssize_t>(size);
+}
+
+void print_stats(FILE* out, double target, const LoadStats& stats) {
+    std::fprintf(out,
+                 "target=%.1f%% achieved=%.2f%% frames=%llu rate=%.0f/s failures=%llu late_avg=%.1fus "
+                 "late_max=%.1fus resets=%llu\n",
+                 target * 100.0, stats.utilization * 100.0, static_cast<unsigned long long>(stats.frames_sent),
+                 stats.frame_rate, static_cast<unsigned long long>(stats.send_failures),
+                 stats.late_avg.count() / 1e3, stats.late_max.count() / 1e3,
+                 static_cast<unsigned long long>(stats.schedule_resets));
+}
+
+void print_json(const Options& options, double target, double planned_rate, const LoadStats& stats) {
+    std::printf("{\"interface\":\"%s\",\"target_utilization\":%.4f,\"achieved_utilization\":%.4f,"
+                "\"planned_frame_rate\":%.1f,\"frame_rate\":%.1f,\"frames_sent\":%llu,\"send_failures\":%llu,"
+                "\"late_avg_us\":%.2f,\"late_max_us\":%.2f,\"schedule_resets\":%llu,\"elapsed_s\":%.3f}\n",
+                options.profile.interface.c_str(), target, stats.utilization, planned_rate, stats.frame_rate,
+                static_cast<unsigned long long>(stats.frames_sent),
+                static_cast<unsigned long long>(stats.send_failures), stats.late_avg.count() / 1e3,
+                stats.late_max.count() / 1e3, static_cast<unsigned long long>(stats.schedule_resets),
+                stats.elapsed.count() / 1e9);
+    std::fflush(stdout);
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) return 1;
+
+    struct sigaction action {};
+    action.sa_handler = handle_signal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    const bool fd = options.profile.fd;
+    const int sock = open_send_socket(options.profile.interface, fd);
+    if (sock < 0) return 1;
+
+    // 发送线程继承调用线程的调度策略
+    if (options.realtime_priority > 0) {
+        sched_param param{};
+        param.sched_priority = options.realtime_priority;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+            std::fprintf(stderr, "无法设置 SCHED_FIFO（需要 CAP_SYS_NICE），以普通优先级运行\n");
+        }
+    }
+
+    for (double target : options.utilizations) {
+        if (g_stop.load()) break;
+        LoadProfile profile = options.profile;
+        profile.utilization = target;
+        BusLoadGenerator generator(profile, [sock, fd](const GenericBusPacket& packet) {
+            return send_raw(sock, fd, packet);
+        });
+        const double planned_rate = generator.planned_frame_rate();
+        std::fprintf(stderr, "[%s] target %.1f%%, planned %.0f frames/s\n", profile.interface.c_str(),
+                     target * 100.0, planned_rate);
+        if (!generator.start()) break;
+
+        const auto step_end = std::chrono::steady_clock::now() + std::chrono::duration<double>(options.step_s);
+        auto next_report = std::chrono::steady_clock::now() + std::chrono::duration<double>(options.report_interval_s);
+        while (!g_stop.load() && std::chrono::steady_clock::now() < step_end) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            if (options.report_interval_s > 0.0 && std::chrono::steady_clock::now() >= next_report) {
+                print_stats(stderr, target, generator.get_stats());
+                next_report += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(options.report_interval_s));
+            }
+        }
+        generator.stop();
+
+        const LoadStats stats = generator.get_stats();
+        print_stats(stderr, target, stats);
+        if (options.json) print_json(options, target, planned_rate, stats);
+    }
+
+    ::close(sock);
+    return 0;
+}
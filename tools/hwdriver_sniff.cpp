@@ -0,0 +1,468 @@
+/**
+ * @file hwdriver_sniff.cpp
+ * @brief 按驱动协议解码的总线抓包工具
+ *
+ * 从一个或多个 CAN/CAN FD 接口实时抓包，或读取 candump -l 日志，用库自身的协议解析（frame_decoder）
+ * 解码每一帧，并统计各电机的反馈速率、请求→应答时延和反馈到达间隔抖动。
+ *
+ * 抓包线程用 recvmmsg 批量读取并把原始帧放入单生产者/单消费者环形缓冲区，解码与输出在主线程完成，
+ * 解码或终端输出变慢时不会阻塞抓包。内核丢帧（SO_RXQ_OVFL）与环形缓冲区溢出分别计数并在统计中给出。
+ *
+ * 用法：
+ *   hwdriver-sniff --interface=can0[,can1] [--motor=1,2] [--class=status,param_result] [--quiet]
+ *                  [--stats-interval=S] [--duration=S] [--ring=N]
+ *   hwdriver-sniff --read=candump.log [--motor=...] [--class=...] [--quiet]
+ */
+#include "protocol/frame_decoder.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <signal.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace hardware_driver;
+using namespace hardware_driver::frame_decoder;
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+void handle_signal(int) { g_stop.store(true); }
+
+struct Options {
+    std::vector<std::string> interfaces;
+    std::string read_file;
+    std::set<uint32_t> motors;
+    std::set<FrameClass> classes;
+    bool quiet{false};
+    double stats_interval_s{0.0};
+    double duration_s{0.0};
+    size_t ring_size{1 << 16};
+};
+
+void print_usage() {
+    std::fprintf(stderr,
+        "用法: hwdriver-sniff [选项]\n"
+        "  --interface=IFACE[,IFACE...]  实时抓包的接口\n"
+        "  --read=FILE                   读取 candump -l 日志（- 表示标准输入）\n"
+        "  --motor=ID[,ID...]            只显示这些电机的帧\n"
+        "  --class=NAME[,NAME...]        只显示这些类别：control control_all enable enable_all\n"
+        "                                feedback_req function param control_reply status func_result\n"
+        "                                param_result iap_req iap_status gripper button unknown\n"
+        "  --quiet                       不逐帧输出，只给统计\n"
+        "  --stats-interval=S            每 S 秒向 stderr 输出一次统计\n"
+        "  --duration=S                  抓包 S 秒后退出（默认直到 Ctrl-C）\n"
+        "  --ring=N                      抓包环形缓冲区帧数，默认 65536\n");
+}
+
+std::vector<std::string> split(const std::string& value) {
+    std::vector<std::string> items;
+    std::istringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        const std::string key = arg.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--interface" || key == "-i") {
+            for (const auto& name : split(value)) options.interfaces.push_back(name);
+        } else if (key == "--read" || key == "-r") {
+            options.read_file = value;
+        } else if (key == "--motor") {
+            for (const auto& item : split(value)) {
+                options.motors.insert(static_cast<uint32_t>(std::strtoul(item.c_str(), nullptr, 0)));
+            }
+        } else if (key == "--class") {
+            for (const auto& item : split(value)) {
+                FrameClass frame_class;
+                if (!parse_frame_class(item, frame_class)) {
+                    std::fprintf(stderr, "未知帧类别: %s\n", item.c_str());
+                    return false;
+                }
+                options.classes.insert(frame_class);
+            }
+        } else if (key == "--quiet" || key == "-q") {
+            options.quiet = true;
+        } else if (key == "--stats-interval") {
+            options.stats_interval_s = std::atof(value.c_str());
+        } else if (key == "--duration") {
+            options.duration_s = std::atof(value.c_str());
+        } else if (key == "--ring") {
+            options.ring_size = std::max<size_t>(1024, std::strtoul(value.c_str(), nullptr, 0));
+        } else {
+            print_usage();
+            return false;
+        }
+    }
+    if (options.interfaces.empty() == options.read_file.empty()) {
+        print_usage();
+        return false;
+    }
+    return true;
+}
+
+// 抓包线程与解码线程之间传递的原始帧
+struct CapturedFrame {
+    int64_t timestamp_ns;
+    uint32_t can_id;
+    uint8_t interface_index;
+    uint8_t fd;
+    uint8_t len;
+    uint8_t data[CANFD_MAX_DLEN];
+};
+
+// 单生产者/单消费者环形缓冲区，容量取 2 的幂
+class FrameRing {
+public:
+    explicit FrameRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    CapturedFrame* reserve() {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) > mask_) return nullptr;
+        return &slots_[head & mask_];
+    }
+    void commit() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    const CapturedFrame* front() const {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return nullptr;
+        return &slots_[tail & mask_];
+    }
+    void pop() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    size_t depth() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return slots_.size(); }
+
+private:
+    std::vector<CapturedFrame> slots_;
+    size_t mask_{0};
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+struct CaptureCounters {
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> ring_drops{0};
+    std::atomic<uint64_t> error_frames{0};
+    std::atomic<uint32_t> kernel_drops{0};      // SO_RXQ_OVFL 累计值
+};
+
+int open_capture_socket(const std::string& interface) {
+    int sock = ::socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (sock < 0) {
+        std::fprintf(stderr, "创建 %s 套接字失败: %s\n", interface.c_str(), std::strerror(errno));
+        return -1;
+    }
+    const int enable = 1;
+    setsockopt(sock, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable));
+    setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+    setsockopt(sock, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable));
+    // 5 Mbit/s 满载下解码线程短暂停顿也不应让内核队列溢出；无 CAP_NET_ADMIN 时退回普通上限
+    const int rcvbuf = 8 * 1024 * 1024;
+    if (setsockopt(sock, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf)) < 0) {
+        setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    }
+
+    struct ifreq ifr {};
+    std::strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    if (ioctl(sock, SIOCGIFINDEX, &ifr) < 0) {
+        std::fprintf(stderr, "接口 %s 不存在: %s\n", interface.c_str(), std::strerror(errno));
+        ::close(sock);
+        return -1;
+    }
+    struct sockaddr_can addr {};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (::bind(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::fprintf(stderr, "绑定 %s 失败: %s\n", interface.c_str(), std::strerror(errno));
+        ::close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+int64_t realtime_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// 抓包线程：poll 所有接口，每次 recvmmsg 读一批
+void capture_loop(const std::vector<int>& sockets, FrameRing& ring, std::vector<CaptureCounters>& counters) {
+    constexpr int BATCH = 64;
+    struct canfd_frame frames[BATCH];
+    struct iovec iov[BATCH];
+    struct mmsghdr msgs[BATCH];
+    alignas(struct cmsghdr) char control[BATCH][CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(sizeof(uint32_t))];
+
+    std::vector<struct pollfd> fds(sockets.size());
+    for (size_t i = 0; i < sockets.size(); ++i) fds[i] = {sockets[i], POLLIN, 0};
+
+    while (!g_stop.load(std::memory_order_relaxed)) {
+        if (::poll(fds.data(), fds.size(), 100) <= 0) continue;
+        for (size_t s = 0; s < fds.size(); ++s) {
+            if (!(fds[s].revents & POLLIN)) continue;
+            for (int i = 0; i < BATCH; ++i) {
+                iov[i] = {&frames[i], sizeof(frames[i])};
+                std::memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+                msgs[i].msg_hdr.msg_iov = &iov[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+                msgs[i].msg_hdr.msg_control = control[i];
+                msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+            }
+            const int received = ::recvmmsg(fds[s].fd, msgs, BATCH, MSG_DONTWAIT, nullptr);
+            if (received <= 0) continue;
+
+            CaptureCounters& counter = counters[s];
+            for (int i = 0; i < received; ++i) {
+                int64_t timestamp_ns = 0;
+                for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg;
+                     cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+                    if (cmsg->cmsg_level != SOL_SOCKET) continue;
+                    if (cmsg->cmsg_type == SO_TIMESTAMPNS) {
+                        struct timespec ts;
+                        std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                        timestamp_ns = static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+                    } else if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+                        uint32_t dropped;
+                        std::memcpy(&dropped, CMSG_DATA(cmsg), sizeof(dropped));
+                        counter.kernel_drops.store(dropped, std::memory_order_relaxed);
+                    }
+                }
+                const struct canfd_frame& frame = frames[i];
+                if (frame.can_id & CAN_ERR_FLAG) {
+                    counter.error_frames.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                counter.frames.fetch_add(1, std::memory_order_relaxed);
+                CapturedFrame* slot = ring.reserve();
+                if (!slot) {
+                    counter.ring_drops.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                slot->timestamp_ns = timestamp_ns ? timestamp_ns : realtime_ns();
+                slot->can_id = (frame.can_id & CAN_EFF_FLAG) ? (frame.can_id & CAN_EFF_MASK)
+                                                              : (frame.can_id & CAN_SFF_MASK);
+                slot->interface_index = static_cast<uint8_t>(s);
+                slot->fd = msgs[i].msg_len == CANFD_MTU;
+                slot->len = std::min<uint8_t>(frame.len, CANFD_MAX_DLEN);
+                std::memcpy(slot->data, frame.data, slot->len);
+                ring.commit();
+            }
+        }
+    }
+}
+
+class Printer {
+public:
+    explicit Printer(const Options& options) : options_(options) {
+        // 逐帧输出走大块缓冲，避免每行一次 write；缓冲区交由 stdio 分配，
+        // 生命周期覆盖到进程退出时的最终 flush
+        std::setvbuf(stdout, nullptr, _IOFBF, 1 << 20);
+    }
+
+    bool selected(const FrameInfo& info) const {
+        if (!options_.classes.empty() && !options_.classes.count(info.frame_class)) return false;
+        if (!options_.motors.empty()) {
+            // 批量帧包含所有电机，按电机过滤时保留
+            const bool batch = info.frame_class == FrameClass::CONTROL_ALL ||
+                               info.frame_class == FrameClass::ENABLE_ALL ||
+                               (info.frame_class == FrameClass::FEEDBACK_REQUEST && info.motor_id == 0);
+            if (!batch && !options_.motors.count(info.motor_id)) return false;
+        }
+        return true;
+    }
+
+    void print(const bus::GenericBusPacket& packet, const FrameInfo& info, int64_t timestamp_ns) {
+        if (options_.quiet || !selected(info)) return;
+        const std::string text = describe(packet, info);
+        std::fprintf(stdout, "(%lld.%06lld) %-6s %03X %c %-13s",
+                     static_cast<long long>(timestamp_ns / 1000000000LL),
+                     static_cast<long long>((timestamp_ns % 1000000000LL) / 1000), packet.interface.c_str(),
+                     packet.id, info.from_device ? '<' : '>', frame_class_name(info.frame_class));
+        if (info.motor_id) {
+            std::fprintf(stdout, " m%-3u ", info.motor_id);
+        } else {
+            std::fputs("      ", stdout);
+        }
+        std::fputs(text.c_str(), stdout);
+        std::fputc('\n', stdout);
+    }
+
+private:
+    const Options& options_;
+};
+
+void print_summary(const TrafficAnalyzer& analyzer, const Options& options) {
+    std::fflush(stdout);
+    std::ostringstream report;
+    analyzer.report(report, options.motors);
+    std::cerr << report.str();
+}
+
+int run_file(const Options& options) {
+    std::ifstream file;
+    std::istream* input = &std::cin;
+    if (options.read_file != "-") {
+        file.open(options.read_file);
+        if (!file) {
+            std::fprintf(stderr, "无法打开 %s\n", options.read_file.c_str());
+            return 1;
+        }
+        input = &file;
+    }
+
+    Printer printer(options);
+    TrafficAnalyzer analyzer;
+    bus::GenericBusPacket packet;
+    std::string line;
+    uint64_t skipped = 0;
+    while (!g_stop.load() && std::getline(*input, line)) {
+        int64_t timestamp_ns = 0;
+        if (!parse_candump_line(line, packet, timestamp_ns)) {
+            if (!line.empty()) ++skipped;
+            continue;
+        }
+        const FrameInfo info = classify(packet);
+        analyzer.add(packet, info, timestamp_ns);
+        printer.print(packet, info, timestamp_ns);
+    }
+    print_summary(analyzer, options);
+    if (skipped) std::fprintf(stderr, "skipped %llu unparsable lines\n", static_cast<unsigned long long>(skipped));
+    return 0;
+}
+
+void print_capture_counters(const Options& options, const std::vector<CaptureCounters>& counters,
+                            const FrameRing& ring) {
+    for (size_t i = 0; i < counters.size(); ++i) {
+        std::fprintf(stderr, "%s: captured=%llu kernel_drops=%u ring_drops=%llu error_frames=%llu\n",
+                     options.interfaces[i].c_str(),
+                     static_cast<unsigned long long>(counters[i].frames.load()),
+                     counters[i].kernel_drops.load(),
+                     static_cast<unsigned long long>(counters[i].ring_drops.load()),
+                     static_cast<unsigned long long>(counters[i].error_frames.load()));
+    }
+    std::fprintf(stderr, "ring depth=%zu/%zu\n", ring.depth(), ring.capacity());
+}
+
+int run_capture(const Options& options) {
+    if (options.interfaces.size() > 255) {
+        std::fprintf(stderr, "接口过多\n");
+        return 1;
+    }
+    std::vector<int> sockets;
+    for (const auto& interface : options.interfaces) {
+        const int sock = open_capture_socket(interface);
+        if (sock < 0) {
+            for (int fd : sockets) ::close(fd);
+            return 1;
+        }
+        sockets.push_back(sock);
+    }
+
+    FrameRing ring(options.ring_size);
+    std::vector<CaptureCounters> counters(sockets.size());
+    std::thread capture_thread(capture_loop, std::cref(sockets), std::ref(ring), std::ref(counters));
+
+    Printer printer(options);
+    TrafficAnalyzer analyzer;
+    bus::GenericBusPacket packet;
+    const auto start = std::chrono::steady_clock::now();
+    auto next_stats = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double>(options.stats_interval_s));
+
+    auto drain = [&]() {
+        bool drained = false;
+        while (const CapturedFrame* frame = ring.front()) {
+            packet.interface = options.interfaces[frame->interface_index];
+            packet.id = frame->can_id;
+            packet.len = frame->len;
+            packet.protocol_type = frame->fd ? bus::BusProtocolType::CAN_FD : bus::BusProtocolType::CAN;
+            std::memcpy(packet.data.data(), frame->data, frame->len);
+            std::fill(packet.data.begin() + frame->len, packet.data.end(), 0);
+            const int64_t timestamp_ns = frame->timestamp_ns;
+            ring.pop();
+
+            const FrameInfo info = classify(packet);
+            analyzer.add(packet, info, timestamp_ns);
+            printer.print(packet, info, timestamp_ns);
+            drained = true;
+        }
+        return drained;
+    };
+
+    while (!g_stop.load()) {
+        const bool drained = drain();
+        const auto now = std::chrono::steady_clock::now();
+        if (options.duration_s > 0.0 && now - start >= std::chrono::duration<double>(options.duration_s)) {
+            g_stop.store(true);
+            break;
+        }
+        if (options.stats_interval_s > 0.0 && now >= next_stats) {
+            print_summary(analyzer, options);
+            print_capture_counters(options, counters, ring);
+            next_stats = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                   std::chrono::duration<double>(options.stats_interval_s));
+        }
+        if (!drained) {
+            std::fflush(stdout);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    capture_thread.join();
+    drain();    // 抓包线程退出前放入的帧
+    print_summary(analyzer, options);
+    print_capture_counters(options, counters, ring);
+    for (int fd : sockets) ::close(fd);
+    return 0;
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) return 1;
+
+    struct sigaction action {};
+    action.sa_handler = handle_signal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    return options.read_file.empty() ? run_capture(options) : run_file(options);
+}
@@ -0,0 +1,266 @@
+/**
+ * @file hwdriver_top.cpp
+ * @brief 驱动内部状态的实时查看工具
+ *
+ * 只读映射驱动进程导出的诊断共享内存（MotorDriverImpl::start_diagnostics_export），不与驱动通信，
+ * 按刷新周期显示队列深度、各接口收发速率、各电机反馈时长、控制超时、事件时延和高频模式等。
+ *
+ * 用法：
+ *   hwdriver-top [--pid=N | --name=/hwdriver.N] [--interval-ms=100] [--sort=interface|id|age|rate|error]
+ *                [--interface=can0] [--motor=1,2,3] [--stale-ms=N] [--once] [--list]
+ */
+#include "hardware_driver/driver/diagnostics_shm.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <set>
+#include <signal.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hardware_driver::diagnostics;
+
+namespace {
+
+struct Options {
+    std::string name;
+    int interval_ms{100};
+    std::string sort{"interface"};
+    std::string interface;
+    std::set<uint32_t> motors;
+    double stale_ms{-1.0};
+    bool once{false};
+    bool list{false};
+};
+
+void print_usage() {
+    std::printf(
+        "用法: hwdriver-top [选项]\n"
+        "  --pid=N                查看进程 N（共享内存 /hwdriver.N）\n"
+        "  --name=NAME            指定共享内存名\n"
+        "  --interval-ms=MS       刷新周期，默认 100\n"
+        "  --sort=KEY             电机排序：interface（默认）、id、age、rate、error\n"
+        "  --interface=IFACE      只显示该接口的电机\n"
+        "  --motor=ID[,ID...]     只显示这些电机\n"
+        "  --stale-ms=MS          只显示反馈超过 MS 未更新的电机\n"
+        "  --once                 输出一帧后退出（不清屏，便于脚本采集）\n"
+        "  --list                 列出可查看的进程\n");
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        const std::string key = arg.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--pid") options.name = default_shm_name(std::atoi(value.c_str()));
+        else if (key == "--name") options.name = value;
+        else if (key == "--interval-ms") options.interval_ms = std::max(10, std::atoi(value.c_str()));
+        else if (key == "--sort") options.sort = value;
+        else if (key == "--interface") options.interface = value;
+        else if (key == "--stale-ms") options.stale_ms = std::atof(value.c_str());
+        else if (key == "--once") options.once = true;
+        else if (key == "--list") options.list = true;
+        else if (key == "--motor") {
+            std::istringstream stream(value);
+            std::string item;
+            while (std::getline(stream, item, ',')) {
+                if (!item.empty()) options.motors.insert(static_cast<uint32_t>(std::strtoul(item.c_str(), nullptr, 0)));
+            }
+        } else {
+            print_usage();
+            return false;
+        }
+    }
+    if (options.sort != "interface" && options.sort != "id" && options.sort != "age" &&
+        options.sort != "rate" && options.sort != "error") {
+        std::fprintf(stderr, "未知的排序键: %s\n", options.sort.c_str());
+        return false;
+    }
+    return true;
+}
+
+int64_t monotonic_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool process_alive(int pid) {
+    return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+// 两次采样之间的速率（每秒）
+double rate(uint64_t current, uint64_t previous, double dt) {
+    return dt > 0.0 && current >= previous ? static_cast<double>(current - previous) / dt : 0.0;
+}
+
+const char* receive_mode_name(uint8_t mode) {
+    return mode == 1 ? "run-to-completion" : "queued";
+}
+
+struct MotorRow {
+    const ShmMotor* motor;
+    std::string interface;
+    double age_ms;     // <0 表示从未收到反馈
+    double rate;
+};
+
+void render(const std::string& name, const ShmFrame& frame, const ShmFrame* previous, const Options& options) {
+    const int64_t now = monotonic_ns();
+    const double dt = previous ? (frame.sampled_ns - previous->sampled_ns) / 1e9 : 0.0;
+    const double export_age_ms = (now - frame.sampled_ns) / 1e6;
+
+    std::printf("hwdriver-top  %s  pid %d%s  sample #%llu  export age %.0f ms%s\n",
+                name.c_str(), frame.pid, process_alive(frame.pid) ? "" : " (exited)",
+                static_cast<unsigned long long>(frame.sample_count), export_age_ms,
+                export_age_ms > 5.0 * std::max<uint32_t>(frame.period_ms, 1) ? "  [STALE]" : "");
+    std::printf("feedback: %s%s  receive: %s  airtime pacing: %s\n",
+                frame.high_freq_mode ? "high-freq" : "low-freq", frame.feedback_paused ? " (paused)" : "",
+                receive_mode_name(frame.receive_mode), frame.airtime_pacing ? "on" : "off");
+    std::printf("queues: control %llu  receive %llu  event backlog %llu    deadline misses %llu (+%.0f/s)\n",
+                static_cast<unsigned long long>(frame.control_queue_depth),
+                static_cast<unsigned long long>(frame.receive_queue_depth),
+                static_cast<unsigned long long>(frame.event_backlog),
+                static_cast<unsigned long long>(frame.control_deadline_misses),
+                previous ? rate(frame.control_deadline_misses, previous->control_deadline_misses, dt) : 0.0);
+    std::printf("events: published %llu (+%.0f/s)  lag last %.0f us  max %.0f us\n\n",
+                static_cast<unsigned long long>(frame.events_published),
+                previous ? rate(frame.events_published, previous->events_published, dt) : 0.0,
+                frame.event_lag_last_ns / 1e3, frame.event_lag_max_ns / 1e3);
+
+    std::printf("%-10s %9s %9s %12s %8s %8s %8s %8s %9s\n",
+                "IFACE", "TX/s", "FB/s", "TX", "BACKPR", "RETRY", "DROP", "HARDERR", "HOOK-OVR");
+    for (uint32_t i = 0; i < frame.interface_count && i < MAX_INTERFACES; ++i) {
+        const auto& iface = frame.interfaces[i];
+        const ShmInterface* before = nullptr;
+        if (previous) {
+            for (uint32_t j = 0; j < previous->interface_count && j < MAX_INTERFACES; ++j) {
+                if (std::string(previous->interfaces[j].name) == iface.name) before = &previous->interfaces[j];
+            }
+        }
+        std::printf("%-10s %9.0f %9.0f %12llu %8llu %8llu %8llu %8llu %9llu\n", iface.name,
+                    before ? rate(iface.tx_sent, before->tx_sent, dt) : 0.0,
+                    before ? rate(iface.feedback_frames, before->feedback_frames, dt) : 0.0,
+                    static_cast<unsigned long long>(iface.tx_sent),
+                    static_cast<unsigned long long>(iface.tx_backpressure),
+                    static_cast<unsigned long long>(iface.tx_retried),
+                    static_cast<unsigned long long>(iface.tx_dropped),
+                    static_cast<unsigned long long>(iface.tx_hard_errors),
+                    static_cast<unsigned long long>(iface.hook_overruns));
+    }
+
+    // 电机行：按接口名和电机 ID 对应上一帧计算反馈速率
+    std::map<std::pair<std::string, uint32_t>, uint32_t> previous_counts;
+    if (previous) {
+        for (uint32_t i = 0; i < previous->motor_count && i < MAX_MOTORS; ++i) {
+            const auto& motor = previous->motors[i];
+            if (motor.interface_index >= MAX_INTERFACES) continue;
+            previous_counts[{previous->interfaces[motor.interface_index].name, motor.motor_id}] = motor.feedback_count;
+        }
+    }
+    std::vector<MotorRow> rows;
+    for (uint32_t i = 0; i < frame.motor_count && i < MAX_MOTORS; ++i) {
+        const auto& motor = frame.motors[i];
+        if (motor.interface_index >= MAX_INTERFACES) continue;
+        MotorRow row{&motor, frame.interfaces[motor.interface_index].name, -1.0, 0.0};
+        if (!options.interface.empty() && row.interface != options.interface) continue;
+        if (!options.motors.empty() && options.motors.count(motor.motor_id) == 0) continue;
+        if (motor.last_feedback_ns != 0) row.age_ms = (now - motor.last_feedback_ns) / 1e6;
+        if (options.stale_ms >= 0.0 && row.age_ms >= 0.0 && row.age_ms < options.stale_ms) continue;
+        auto it = previous_counts.find({row.interface, motor.motor_id});
+        if (it != previous_counts.end()) row.rate = rate(motor.feedback_count, it->second, dt);
+        rows.push_back(row);
+    }
+    std::stable_sort(rows.begin(), rows.end(), [&options](const MotorRow& a, const MotorRow& b) {
+        if (options.sort == "id") return a.motor->motor_id < b.motor->motor_id;
+        if (options.sort == "age") {
+            // 从未收到反馈的排在最前
+            const double age_a = a.age_ms < 0.0 ? 1e18 : a.age_ms;
+            const double age_b = b.age_ms < 0.0 ? 1e18 : b.age_ms;
+            return age_a > age_b;
+        }
+        if (options.sort == "rate") return a.rate < b.rate;
+        if (options.sort == "error") return a.motor->error_code > b.motor->error_code;
+        return a.interface != b.interface ? a.interface < b.interface : a.motor->motor_id < b.motor->motor_id;
+    });
+
+    std::printf("\n%-10s %4s %3s %4s %9s %7s %10s %10s %10s %6s\n",
+                "IFACE", "ID", "EN", "MODE", "AGE(ms)", "FB/s", "POS", "VEL", "EFF", "ERR");
+    for (const auto& row : rows) {
+        const auto& motor = *row.motor;
+        char age[16];
+        if (row.age_ms < 0.0) std::snprintf(age, sizeof(age), "%9s", "-");
+        else std::snprintf(age, sizeof(age), "%9.1f", row.age_ms);
+        std::printf("%-10s %4u %3s %4u %s %7.0f %10.4f %10.4f %10.4f 0x%04x\n",
+                    row.interface.c_str(), motor.motor_id, motor.enabled ? "on" : "off", motor.motor_mode, age,
+                    row.rate, motor.position, motor.velocity, motor.effort, motor.error_code);
+    }
+    if (frame.motors_truncated > 0) {
+        std::printf("(%u motors not exported)\n", frame.motors_truncated);
+    }
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) return 2;
+
+    if (options.list || options.name.empty()) {
+        const auto segments = DiagnosticsReader::list_segments();
+        if (options.list || segments.size() != 1) {
+            if (segments.empty()) std::fprintf(stderr, "没有找到导出诊断的进程（需调用 start_diagnostics_export）\n");
+            for (const auto& segment : segments) {
+                DiagnosticsReader reader;
+                ShmFrame frame;
+                const bool ok = reader.open(segment) && reader.read(frame);
+                std::printf("%s  %s\n", segment.c_str(),
+                            !ok ? "(unreadable)" : process_alive(frame.pid) ? "running" : "exited");
+            }
+            return options.list && !segments.empty() ? 0 : 1;
+        }
+        options.name = segments.front();
+    }
+
+    DiagnosticsReader reader;
+    if (!reader.open(options.name)) {
+        std::fprintf(stderr, "无法打开 %s（进程未导出诊断或版本不匹配）\n", options.name.c_str());
+        return 1;
+    }
+
+    // 帧较大，放在堆上；latest 为最近一次新采样，older 为其前一次，用于计算速率
+    auto latest = std::make_unique<ShmFrame>();
+    auto older = std::make_unique<ShmFrame>();
+    auto scratch = std::make_unique<ShmFrame>();
+    bool has_latest = false;
+    bool has_older = false;
+
+    if (options.once) {
+        if (!reader.read(*older)) return 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::max<uint32_t>(older->period_ms, 10) + 10));
+        if (!reader.read(*latest)) return 1;
+        render(options.name, *latest, latest->sample_count != older->sample_count ? older.get() : nullptr, options);
+        return 0;
+    }
+
+    while (true) {
+        if (reader.read(*scratch) && (!has_latest || scratch->sample_count != latest->sample_count)) {
+            std::swap(older, latest);
+            has_older = has_latest;
+            std::swap(latest, scratch);
+            has_latest = true;
+        }
+        if (has_latest) {
+            std::printf("\033[H\033[2J");
+            render(options.name, *latest, has_older ? older.get() : nullptr, options);
+            std::fflush(stdout);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.interval_ms));
+    }
+}